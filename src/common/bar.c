@@ -87,7 +87,8 @@ void ffAppendPercentNum(FFstrbuf* buffer, uint8_t percent, uint8_t green, uint8_
                 ffStrbufAppendS(buffer, "\033[91m");
         }
     }
-    ffStrbufAppendF(buffer, "%u%%", (unsigned) percent);
+    ffStrbufAppendUInt(buffer, percent);
+    ffStrbufAppendC(buffer, '%');
 
     if (colored && !instance.config.pipe)
     {
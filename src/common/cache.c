@@ -0,0 +1,332 @@
+#include "fastfetch.h"
+#include "common/cache.h"
+#include "common/io/io.h"
+#include "common/thread.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+    #include <process.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__)
+    #include <sys/types.h>
+    #include <sys/sysctl.h>
+    #include <sys/time.h>
+#endif
+
+#define FF_CACHE_MAGIC "FFC1"
+
+// Identifies the current boot. Everything we cache is valid until the next reboot at most
+static bool detectBootId(FFstrbuf* result)
+{
+    #if defined(__linux__)
+        if(!ffAppendFileBuffer("/proc/sys/kernel/random/boot_id", result))
+            return false;
+        ffStrbufTrimRight(result, '\n');
+    #elif defined(__APPLE__) || defined(__FreeBSD__)
+        struct timeval bootTime;
+        size_t size = sizeof(bootTime);
+        if(sysctl((int[]) {CTL_KERN, KERN_BOOTTIME}, 2, &bootTime, &size, NULL, 0) != 0)
+            return false;
+        ffStrbufAppendF(result, "%lld.%ld", (long long) bootTime.tv_sec, (long) bootTime.tv_usec);
+    #else
+        FF_UNUSED(result);
+    #endif
+
+    return result->length > 0;
+}
+
+static const FFstrbuf* getBootId(void)
+{
+    static FFThreadMutex mutex = FF_THREAD_MUTEX_INITIALIZER;
+    static FFstrbuf bootId;
+    static bool init = false;
+
+    ffThreadMutexLock(&mutex);
+    if(!init)
+    {
+        ffStrbufInit(&bootId);
+        if(!detectBootId(&bootId))
+            ffStrbufClear(&bootId);
+        init = true;
+    }
+    ffThreadMutexUnlock(&mutex);
+
+    return &bootId;
+}
+
+bool ffCacheKeyInitPersistent(FFstrbuf* key)
+{
+    if(!instance.config.cache || instance.state.platform.cacheDir.length == 0)
+        return false;
+
+    ffStrbufAppendS(key, FASTFETCH_PROJECT_VERSION FASTFETCH_PROJECT_VERSION_TWEAK "\n");
+    return true;
+}
+
+bool ffCacheKeyInit(FFstrbuf* key, const FFModuleArgs* moduleArgs)
+{
+    if(!moduleArgs->cache || !ffCacheKeyInitPersistent(key))
+        return false;
+
+    const FFstrbuf* bootId = getBootId();
+    if(bootId->length == 0)
+        return false;
+
+    ffStrbufAppend(key, bootId);
+    ffStrbufAppendC(key, '\n');
+    return true;
+}
+
+void ffCacheKeyAddFileStat(FFstrbuf* key, const char* path, const struct stat* st)
+{
+    #if defined(__APPLE__)
+        long nsec = (long) st->st_mtimespec.tv_nsec;
+    #elif defined(_WIN32)
+        long nsec = 0;
+    #else
+        long nsec = (long) st->st_mtim.tv_nsec;
+    #endif
+
+    ffStrbufAppendS(key, path);
+    ffStrbufAppendF(key, ":%llu:%llu:%lld:%lld.%09ld\n",
+        (unsigned long long) st->st_dev,
+        (unsigned long long) st->st_ino,
+        (long long) st->st_size,
+        (long long) st->st_mtime,
+        nsec
+    );
+}
+
+void ffCacheKeyAddFile(FFstrbuf* key, const char* path)
+{
+    struct stat st;
+    if(stat(path, &st) != 0)
+    {
+        ffStrbufAppendS(key, path);
+        ffStrbufAppendS(key, ":-\n");
+        return;
+    }
+
+    ffCacheKeyAddFileStat(key, path, &st);
+}
+
+void ffCacheKeyAddEnv(FFstrbuf* key, const char* name)
+{
+    ffStrbufAppendS(key, name);
+
+    const char* value = getenv(name);
+    if(value)
+    {
+        ffStrbufAppendC(key, '=');
+        ffStrbufAppendS(key, value);
+    }
+
+    ffStrbufAppendC(key, '\n');
+}
+
+static void getCachePath(const char* moduleName, FFstrbuf* path)
+{
+    ffStrbufAppend(path, &instance.state.platform.cacheDir);
+    ffStrbufAppendS(path, "fastfetch/cache/");
+    ffStrbufAppendS(path, moduleName);
+}
+
+static inline void appendUInt32(FFstrbuf* buffer, uint32_t value)
+{
+    ffStrbufAppendNS(buffer, sizeof(value), (const char*) &value);
+}
+
+static void storeElements(const char* moduleName, const FFstrbuf* key, const FFCacheSchema* schema, uint32_t count, const uint8_t* elements)
+{
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreateA(1024);
+    ffStrbufAppendS(&content, FF_CACHE_MAGIC);
+    appendUInt32(&content, key->length);
+    ffStrbufAppend(&content, key);
+    appendUInt32(&content, schema->size);
+    appendUInt32(&content, count);
+
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        const uint8_t* element = elements + (size_t) i * schema->size;
+        ffStrbufAppendNS(&content, schema->size, (const char*) element);
+
+        for(uint32_t j = 0; j < schema->strbufCount; ++j)
+        {
+            const FFstrbuf* strbuf = (const FFstrbuf*) (element + schema->strbufOffsets[j]);
+            appendUInt32(&content, strbuf->length);
+            ffStrbufAppendNS(&content, strbuf->length, strbuf->chars);
+        }
+    }
+
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    getCachePath(moduleName, &path);
+    uint32_t pathLength = path.length;
+
+    // Write to a temporary file first, so that concurrent instances never read a partially written entry
+    ffStrbufAppendF(&path, ".%d.tmp", (int) getpid());
+    if(!ffWriteFileBuffer(path.chars, &content))
+        return;
+
+    FF_STRBUF_AUTO_DESTROY target = ffStrbufCreateNS(pathLength, path.chars);
+    if(rename(path.chars, target.chars) != 0)
+        remove(path.chars);
+}
+
+typedef struct FFCacheReader
+{
+    const uint8_t* pos;
+    const uint8_t* end;
+} FFCacheReader;
+
+static inline bool readData(FFCacheReader* reader, uint32_t size, const uint8_t** data)
+{
+    if((size_t) (reader->end - reader->pos) < size)
+        return false;
+    *data = reader->pos;
+    reader->pos += size;
+    return true;
+}
+
+static inline bool readUInt32(FFCacheReader* reader, uint32_t* value)
+{
+    const uint8_t* data;
+    if(!readData(reader, sizeof(*value), &data))
+        return false;
+    memcpy(value, data, sizeof(*value));
+    return true;
+}
+
+// Checks the header and that the whole payload is in bounds, so that parsing it again can't fail
+static bool readHeader(FFCacheReader* reader, const FFstrbuf* key, const FFCacheSchema* schema, uint32_t* count)
+{
+    const uint8_t* data;
+    uint32_t value;
+
+    if(!readData(reader, sizeof(FF_CACHE_MAGIC) - 1, &data) || memcmp(data, FF_CACHE_MAGIC, sizeof(FF_CACHE_MAGIC) - 1) != 0)
+        return false;
+
+    if(!readUInt32(reader, &value) || value != key->length)
+        return false;
+    if(!readData(reader, value, &data) || memcmp(data, key->chars, key->length) != 0)
+        return false;
+
+    if(!readUInt32(reader, &value) || value != schema->size)
+        return false;
+    if(!readUInt32(reader, count))
+        return false;
+
+    FFCacheReader check = *reader;
+    for(uint32_t i = 0; i < *count; ++i)
+    {
+        if(!readData(&check, schema->size, &data))
+            return false;
+
+        for(uint32_t j = 0; j < schema->strbufCount; ++j)
+        {
+            if(!readUInt32(&check, &value) || !readData(&check, value, &data))
+                return false;
+        }
+    }
+
+    return check.pos == check.end;
+}
+
+// The bounds have already been checked by readHeader
+static void readElement(FFCacheReader* reader, const FFCacheSchema* schema, uint8_t* element)
+{
+    memcpy(element, reader->pos, schema->size);
+    reader->pos += schema->size;
+
+    for(uint32_t j = 0; j < schema->strbufCount; ++j)
+    {
+        uint32_t length;
+        memcpy(&length, reader->pos, sizeof(length));
+        reader->pos += sizeof(length);
+
+        ffStrbufInitNS((FFstrbuf*) (element + schema->strbufOffsets[j]), length, (const char*) reader->pos);
+        reader->pos += length;
+    }
+}
+
+static bool readCacheFile(const char* moduleName, FFstrbuf* content)
+{
+    if(instance.config.recache)
+        return false;
+
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    getCachePath(moduleName, &path);
+
+    // Not ffAppendFileBuffer: it trims trailing '\n' and ' ', which may well be the last bytes of an entry
+    #ifdef _WIN32
+        int fd = open(path.chars, O_RDONLY | O_BINARY);
+    #else
+        int fd = open(path.chars, O_RDONLY | O_CLOEXEC);
+    #endif
+    if(fd < 0)
+        return false;
+
+    struct stat st;
+    bool success = fstat(fd, &st) == 0 && st.st_size > 0 && st.st_size < UINT32_MAX;
+    if(success)
+    {
+        // Entries are replaced by renaming, so the size can't change while reading
+        uint32_t size = (uint32_t) st.st_size;
+        ffStrbufEnsureFree(content, size);
+
+        ssize_t readed;
+        while(content->length < size && (readed = read(fd, content->chars + content->length, size - content->length)) > 0)
+            content->length += (uint32_t) readed;
+        content->chars[content->length] = '\0';
+
+        success = content->length == size;
+    }
+
+    close(fd);
+    return success;
+}
+
+bool ffCacheLoad(const char* moduleName, const FFstrbuf* key, const FFCacheSchema* schema, void* result)
+{
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+    if(!readCacheFile(moduleName, &content))
+        return false;
+
+    FFCacheReader reader = { (const uint8_t*) content.chars, (const uint8_t*) content.chars + content.length };
+    uint32_t count;
+    if(!readHeader(&reader, key, schema, &count) || count != 1)
+        return false;
+
+    readElement(&reader, schema, result);
+    return true;
+}
+
+void ffCacheStore(const char* moduleName, const FFstrbuf* key, const FFCacheSchema* schema, const void* result)
+{
+    storeElements(moduleName, key, schema, 1, result);
+}
+
+bool ffCacheLoadList(const char* moduleName, const FFstrbuf* key, const FFCacheSchema* schema, FFlist* result)
+{
+    assert(result->elementSize == schema->size);
+
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+    if(!readCacheFile(moduleName, &content))
+        return false;
+
+    FFCacheReader reader = { (const uint8_t*) content.chars, (const uint8_t*) content.chars + content.length };
+    uint32_t count;
+    if(!readHeader(&reader, key, schema, &count))
+        return false;
+
+    for(uint32_t i = 0; i < count; ++i)
+        readElement(&reader, schema, ffListAdd(result));
+    return true;
+}
+
+void ffCacheStoreList(const char* moduleName, const FFstrbuf* key, const FFCacheSchema* schema, const FFlist* result)
+{
+    assert(result->elementSize == schema->size);
+    storeElements(moduleName, key, schema, result->length, (const uint8_t*) result->data);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#ifndef FF_INCLUDED_common_cache
+#define FF_INCLUDED_common_cache
+
+#include "fastfetch.h"
+
+#include <sys/stat.h>
+
+// Persistent cache of detection results, stored in <cacheDir>/fastfetch/cache/<module name>.
+//
+// Every entry is stored together with a key listing everything its result depends on.
+// The key always contains the fastfetch version and an identifier of the current boot,
+// modules append whatever else may change during a boot (file stats, env vars, options).
+// An entry is only used if its key matches exactly, otherwise the module detects again and replaces it.
+
+// Describes a result struct. It is stored as raw bytes, except its FFstrbuf members.
+// Pointers other than FFstrbuf members are not supported
+typedef struct FFCacheSchema
+{
+    uint32_t size;
+    uint32_t strbufCount;
+    const uint32_t* strbufOffsets;
+} FFCacheSchema;
+
+// FF_CACHE_SCHEMA(FFHostResult, offsetof(FFHostResult, productName), offsetof(FFHostResult, sysVendor))
+#define FF_CACHE_SCHEMA(Type, ...) { \
+    .size = sizeof(Type), \
+    .strbufCount = sizeof((const uint32_t[]) { __VA_ARGS__ }) / sizeof(uint32_t), \
+    .strbufOffsets = (const uint32_t[]) { __VA_ARGS__ }, \
+}
+
+// Starts the key of a module. Returns false if the module must not use the cache,
+// because of `--cache false`, `--<module>-cache false`, or because the current boot can't be identified
+bool ffCacheKeyInit(FFstrbuf* key, const FFModuleArgs* moduleArgs);
+// Starts a key without the boot identifier, for entries that stay valid as long as the files added to it don't change.
+// Returns false because of `--cache false` only
+bool ffCacheKeyInitPersistent(FFstrbuf* key);
+// Appends path, device, inode, size and modification time of a file or directory (following symlinks)
+void ffCacheKeyAddFile(FFstrbuf* key, const char* path);
+// Same, with the result of a stat call already made by the caller
+void ffCacheKeyAddFileStat(FFstrbuf* key, const char* path, const struct stat* st);
+void ffCacheKeyAddEnv(FFstrbuf* key, const char* name);
+
+// Fills `result` from the cache. Returns false if there is no valid entry, or if `--recache` is set.
+// `result` is left untouched on failure
+bool ffCacheLoad(const char* moduleName, const FFstrbuf* key, const FFCacheSchema* schema, void* result);
+void ffCacheStore(const char* moduleName, const FFstrbuf* key, const FFCacheSchema* schema, const void* result);
+
+// Same for modules detecting a list. Loaded elements are appended to `result`
+bool ffCacheLoadList(const char* moduleName, const FFstrbuf* key, const FFCacheSchema* schema, FFlist* result);
+void ffCacheStoreList(const char* moduleName, const FFstrbuf* key, const FFCacheSchema* schema, const FFlist* result);
+
+#endif
@@ -0,0 +1,118 @@
+#include "fastfetch.h"
+#include "common/cache.h"
+#include "common/exeversion.h"
+#include "common/processing.h"
+#include "util/stringUtils.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+typedef struct FFExeVersionEntry
+{
+    FFstrbuf output;
+} FFExeVersionEntry;
+
+static const FFCacheSchema exeVersionCacheSchema = FF_CACHE_SCHEMA(FFExeVersionEntry, offsetof(FFExeVersionEntry, output));
+
+// Resolves `exe` like execvp does, and stats it
+static bool findExecutable(const char* exe, FFstrbuf* path, struct stat* st)
+{
+    #ifdef _WIN32
+        bool isPath = strchr(exe, '/') != NULL || strchr(exe, '\\') != NULL;
+    #else
+        bool isPath = strchr(exe, '/') != NULL;
+    #endif
+
+    if(isPath)
+    {
+        ffStrbufSetS(path, exe);
+        return stat(exe, st) == 0 && S_ISREG(st->st_mode);
+    }
+
+    #ifdef _WIN32
+        // Executables are looked up with PATHEXT, which we don't emulate
+        return false;
+    #else
+        const char* dirs = getenv("PATH");
+        if(!ffStrSet(dirs))
+            return false;
+
+        while(true)
+        {
+            const char* end = strchr(dirs, ':');
+            uint32_t length = end ? (uint32_t) (end - dirs) : (uint32_t) strlen(dirs);
+
+            if(length > 0)
+            {
+                ffStrbufSetNS(path, length, dirs);
+                ffStrbufAppendC(path, '/');
+                ffStrbufAppendS(path, exe);
+                if(stat(path->chars, st) == 0 && S_ISREG(st->st_mode))
+                    return true;
+            }
+
+            if(!end)
+                return false;
+            dirs = end + 1;
+        }
+    #endif
+}
+
+// FNV-1a of the command line, used as the file name of the entry
+static uint64_t hashCommand(char* const argv[], bool useStdErr)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for(char* const* arg = argv; *arg; ++arg)
+    {
+        for(const char* c = *arg; ; ++c)
+        {
+            hash ^= (uint8_t) *c;
+            hash *= 1099511628211ull;
+            if(*c == '\0')
+                break;
+        }
+    }
+    hash ^= useStdErr;
+    hash *= 1099511628211ull;
+    return hash;
+}
+
+const char* ffExeVersionAppendOutput(FFstrbuf* buffer, const char* exe, char* const argv[], bool useStdErr)
+{
+    FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    struct stat st;
+    if(!ffCacheKeyInitPersistent(&key) || !findExecutable(exe, &path, &st))
+        return ffProcessAppendOutput(buffer, argv, useStdErr);
+
+    ffCacheKeyAddFileStat(&key, path.chars, &st);
+    for(char* const* arg = argv; *arg; ++arg)
+    {
+        ffStrbufAppendS(&key, *arg);
+        ffStrbufAppendC(&key, '\n');
+    }
+    ffStrbufAppendS(&key, useStdErr ? "stderr\n" : "stdout\n");
+
+    char entryName[64];
+    snprintf(entryName, sizeof(entryName), "ExeVersion/%016llx", (unsigned long long) hashCommand(argv, useStdErr));
+
+    FFExeVersionEntry entry;
+    if(ffCacheLoad(entryName, &key, &exeVersionCacheSchema, &entry))
+    {
+        ffStrbufAppend(buffer, &entry.output);
+        ffStrbufDestroy(&entry.output);
+        return NULL;
+    }
+
+    uint32_t start = buffer->length;
+    const char* error = ffProcessAppendOutput(buffer, argv, useStdErr);
+    if(error)
+        return error;
+
+    ffStrbufInitNS(&entry.output, buffer->length - start, buffer->chars + start);
+    ffCacheStore(entryName, &key, &exeVersionCacheSchema, &entry);
+    ffStrbufDestroy(&entry.output);
+    return NULL;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#ifndef FF_INCLUDED_common_exeversion
+#define FF_INCLUDED_common_exeversion
+
+#include "util/FFstrbuf.h"
+
+// Version probes (`<exe> --version` and alike). Same as ffProcessAppendOutput, except that the output is stored in
+// <cacheDir>/fastfetch/cache/ExeVersion and reused as long as `exe` is the same file (device, inode, size and mtime).
+// A cache hit costs one stat of `exe` (plus a PATH lookup if it isn't a path) and reading the cache file.
+// `exe` is the executable whose version is printed; usually argv[0], but not if argv[0] is a launcher like `env`
+const char* ffExeVersionAppendOutput(FFstrbuf* buffer, const char* exe, char* const argv[], bool useStdErr);
+
+static inline const char* ffExeVersionAppendStdOut(FFstrbuf* buffer, char* const argv[])
+{
+    return ffExeVersionAppendOutput(buffer, argv[0], argv, false);
+}
+
+static inline const char* ffExeVersionAppendStdErr(FFstrbuf* buffer, char* const argv[])
+{
+    return ffExeVersionAppendOutput(buffer, argv[0], argv, true);
+}
+
+#endif
@@ -4,26 +4,28 @@
 #include "util/textModifier.h"
 #include "util/stringUtils.h"
 
-#include <inttypes.h>
+#include <ctype.h>
 
 void ffFormatAppendFormatArg(FFstrbuf* buffer, const FFformatarg* formatarg)
 {
     if(formatarg->type == FF_FORMAT_ARG_TYPE_INT)
-        ffStrbufAppendF(buffer, "%i", *(int*)formatarg->value);
+        ffStrbufAppendSInt(buffer, *(int*)formatarg->value);
     else if(formatarg->type == FF_FORMAT_ARG_TYPE_UINT)
-        ffStrbufAppendF(buffer, "%" PRIu32, *(uint32_t*)formatarg->value);
+        ffStrbufAppendUInt(buffer, *(uint32_t*)formatarg->value);
+    else if(formatarg->type == FF_FORMAT_ARG_TYPE_UINT64)
+        ffStrbufAppendUInt(buffer, *(uint64_t*)formatarg->value);
     else if(formatarg->type == FF_FORMAT_ARG_TYPE_UINT16)
-        ffStrbufAppendF(buffer, "%" PRIu16, *(uint16_t*)formatarg->value);
+        ffStrbufAppendUInt(buffer, *(uint16_t*)formatarg->value);
     else if(formatarg->type == FF_FORMAT_ARG_TYPE_UINT8)
-        ffStrbufAppendF(buffer, "%" PRIu8, *(uint8_t*)formatarg->value);
+        ffStrbufAppendUInt(buffer, *(uint8_t*)formatarg->value);
     else if(formatarg->type == FF_FORMAT_ARG_TYPE_STRING)
         ffStrbufAppendS(buffer, (const char*)formatarg->value);
     else if(formatarg->type == FF_FORMAT_ARG_TYPE_STRBUF)
         ffStrbufAppend(buffer, (FFstrbuf*)formatarg->value);
     else if(formatarg->type == FF_FORMAT_ARG_TYPE_FLOAT)
-        ffStrbufAppendF(buffer, "%f", *(float*)formatarg->value);
+        ffStrbufAppendFloat(buffer, *(float*)formatarg->value, 6); // %f
     else if(formatarg->type == FF_FORMAT_ARG_TYPE_DOUBLE)
-        ffStrbufAppendF(buffer, "%g", *(double*)formatarg->value);
+        ffStrbufAppendDoubleG(buffer, *(double*)formatarg->value, 6); // %g
     else if(formatarg->type == FF_FORMAT_ARG_TYPE_BOOL)
         ffStrbufAppendS(buffer, *(bool*)formatarg->value ? "true" : "false");
     else if(formatarg->type == FF_FORMAT_ARG_TYPE_LIST)
@@ -42,6 +44,193 @@ void ffFormatAppendFormatArg(FFstrbuf* buffer, const FFformatarg* formatarg)
     }
 }
 
+typedef enum FFformatOpType
+{
+    FF_FORMAT_OP_TEXT,        // Appends the text
+    FF_FORMAT_OP_ARG,         // {N} / {N:spec}: appends argument N, or the text if there is no such argument
+    FF_FORMAT_OP_NEXT_ARG,    // {} / {:spec}: appends the next argument, or the text if all are used
+    FF_FORMAT_OP_IF,          // {?N}: continues if argument N is set, jumps behind the next {?} otherwise
+    FF_FORMAT_OP_IF_NOT,      // {/N}: continues if argument N is not set, jumps behind the next {/} otherwise
+    FF_FORMAT_OP_END_IF,      // {?}: appends the text if no {?N} is open
+    FF_FORMAT_OP_END_IF_NOT,  // {/}: appends the text if no {/N} is open
+    FF_FORMAT_OP_COLOR,       // {#N}: appends the text, an escape sequence
+    FF_FORMAT_OP_END_COLOR,   // {#}: resets the color, or appends the text if no color is open
+    FF_FORMAT_OP_STOP,        // {-}
+} FFformatOpType;
+
+// The part of {N:spec} after the colon: [[fill]align][width][.precision][type]
+typedef struct FFformatSpec
+{
+    uint16_t width; // Minimum number of characters; 0 for no padding
+    uint8_t precision; // UINT8_MAX if not set
+    char fill;
+    char align; // '<', '>' or '^'; 0 to align numbers right and everything else left
+    char type; // 0, 'f', 'g', 'r' or 'h' (hsize)
+} FFformatSpec;
+
+typedef struct FFformatOp
+{
+    uint8_t type; // FFformatOpType
+    bool hasSpec; // FF_FORMAT_OP_ARG, FF_FORMAT_OP_NEXT_ARG
+    FFformatSpec spec;
+    uint32_t index; // Of the argument, starting at 1; UINT32_MAX if invalid
+    uint32_t jump; // Of the op to continue with if the condition is false; ops.length for the end
+    uint32_t textStart;
+    uint32_t textLength;
+} FFformatOp;
+
+#define FF_FORMAT_SPEC_MAX_WIDTH 1024
+#define FF_FORMAT_SPEC_MAX_PRECISION 40
+
+static inline bool isAlign(char c)
+{
+    return c == '<' || c == '>' || c == '^';
+}
+
+static bool parseSpec(const char* spec, uint32_t length, FFformatSpec* result)
+{
+    *result = (FFformatSpec) { .precision = UINT8_MAX, .fill = ' ' };
+
+    uint32_t i = 0;
+    if(length >= 2 && isAlign(spec[1]))
+    {
+        result->fill = spec[0];
+        result->align = spec[1];
+        i = 2;
+    }
+    else if(length >= 1 && isAlign(spec[0]))
+    {
+        result->align = spec[0];
+        i = 1;
+    }
+
+    uint32_t width = 0;
+    for(; i < length && isdigit((unsigned char) spec[i]); ++i)
+    {
+        width = width * 10 + (uint32_t) (spec[i] - '0');
+        if(width > FF_FORMAT_SPEC_MAX_WIDTH)
+            return false;
+    }
+    result->width = (uint16_t) width;
+
+    if(i < length && spec[i] == '.')
+    {
+        if(++i == length || !isdigit((unsigned char) spec[i]))
+            return false;
+
+        uint32_t precision = 0;
+        for(; i < length && isdigit((unsigned char) spec[i]); ++i)
+        {
+            precision = precision * 10 + (uint32_t) (spec[i] - '0');
+            if(precision > FF_FORMAT_SPEC_MAX_PRECISION)
+                return false;
+        }
+        result->precision = (uint8_t) precision;
+    }
+
+    const char* type = spec + i;
+    uint32_t typeLength = length - i;
+    if(typeLength == 1 && (type[0] == 'f' || type[0] == 'g' || type[0] == 'r'))
+        result->type = type[0];
+    else if(typeLength == 5 && memcmp(type, "hsize", 5) == 0)
+        result->type = 'h';
+    else if(typeLength != 0)
+        return false;
+
+    return true;
+}
+
+static void appendNumber(FFstrbuf* buffer, double value, const FFformatarg* formatarg, const FFformatSpec* spec)
+{
+    if(spec->type == 'h')
+    {
+        uint8_t ndigits = spec->precision == UINT8_MAX ? instance.config.sizeNdigits : spec->precision;
+        uint64_t bytes = formatarg->type == FF_FORMAT_ARG_TYPE_UINT64
+            ? *(uint64_t*)formatarg->value // Exact, doubles lose the last bits of large sizes
+            : value >= 18446744073709549568.0 ? UINT64_MAX : value > 0 ? (uint64_t) value : 0; // NaN and negative sizes are 0
+        ffParseSizeWithDigits(bytes, instance.config.binaryPrefixType, ndigits, buffer);
+    }
+    else if(spec->type == 'g')
+        ffStrbufAppendDoubleG(buffer, value, spec->precision == UINT8_MAX ? 6 : spec->precision);
+    else if(spec->type == 'r')
+    {
+        if(formatarg->type == FF_FORMAT_ARG_TYPE_FLOAT)
+            ffStrbufAppendFloat(buffer, (float) value, -1);
+        else
+            ffStrbufAppendDouble(buffer, value, -1);
+    }
+    else
+        ffStrbufAppendDouble(buffer, value, (int8_t) (spec->precision == UINT8_MAX ? 6 : spec->precision));
+}
+
+// Number of characters (UTF-8 sequences) of buffer->chars[start...]
+static uint32_t countChars(const FFstrbuf* buffer, uint32_t start)
+{
+    uint32_t count = 0;
+    for(uint32_t i = start; i < buffer->length; ++i)
+    {
+        if(((unsigned char) buffer->chars[i] & 0xC0) != 0x80)
+            ++count;
+    }
+    return count;
+}
+
+static void appendFormatArgWithSpec(FFstrbuf* buffer, const FFformatarg* formatarg, const FFformatSpec* spec)
+{
+    const uint32_t start = buffer->length;
+    bool isNumber = true;
+
+    double value;
+    switch(formatarg->type)
+    {
+        case FF_FORMAT_ARG_TYPE_INT: value = *(int*)formatarg->value; break;
+        case FF_FORMAT_ARG_TYPE_UINT: value = *(uint32_t*)formatarg->value; break;
+        case FF_FORMAT_ARG_TYPE_UINT64: value = (double) *(uint64_t*)formatarg->value; break;
+        case FF_FORMAT_ARG_TYPE_UINT16: value = *(uint16_t*)formatarg->value; break;
+        case FF_FORMAT_ARG_TYPE_UINT8: value = *(uint8_t*)formatarg->value; break;
+        case FF_FORMAT_ARG_TYPE_FLOAT: value = *(float*)formatarg->value; break;
+        case FF_FORMAT_ARG_TYPE_DOUBLE: value = *(double*)formatarg->value; break;
+        default: value = 0; isNumber = false; break;
+    }
+
+    if(isNumber && (spec->type != 0 || spec->precision != UINT8_MAX))
+        appendNumber(buffer, value, formatarg, spec);
+    else
+    {
+        ffFormatAppendFormatArg(buffer, formatarg);
+
+        // A number type (f, g, r, hsize) doesn't apply to strings; they are printed as is
+        if(!isNumber && spec->precision != UINT8_MAX && spec->type == 0)
+        {
+            // Truncate to `precision` characters
+            uint32_t count = 0, i = start;
+            for(; i < buffer->length; ++i)
+            {
+                if(((unsigned char) buffer->chars[i] & 0xC0) != 0x80 && count++ == spec->precision)
+                    break;
+            }
+            ffStrbufSubstrBefore(buffer, i);
+        }
+    }
+
+    uint32_t count = countChars(buffer, start);
+    if(count >= spec->width)
+        return;
+
+    uint32_t padding = spec->width - count;
+    char align = spec->align ? spec->align : isNumber ? '>' : '<';
+    uint32_t left = align == '>' ? padding : align == '^' ? padding / 2 : 0;
+    uint32_t length = buffer->length - start;
+
+    ffStrbufEnsureFree(buffer, padding);
+    char* chars = buffer->chars + start;
+    memmove(chars + left, chars, length);
+    memset(chars, spec->fill, left);
+    memset(chars + left + length, spec->fill, padding - left);
+    buffer->length += padding;
+    buffer->chars[buffer->length] = '\0';
+}
+
 /**
  * @brief parses a string to a uint32_t
  *
@@ -60,25 +249,6 @@ static inline uint32_t getArgumentIndex(const FFstrbuf* placeholderValue)
     return result == 0 ? UINT32_MAX : result;
 }
 
-static inline void appendInvalidPlaceholder(FFstrbuf* buffer, const char* start, const FFstrbuf* placeholderValue, uint32_t index, uint32_t formatStringLength)
-{
-    ffStrbufAppendS(buffer, start);
-    ffStrbufAppend(buffer, placeholderValue);
-
-    if(index < formatStringLength)
-        ffStrbufAppendC(buffer, '}');
-}
-
-static inline void appendEmptyPlaceholder(FFstrbuf* buffer, const char* placeholder, uint32_t* argCounter, uint32_t numArgs, const FFformatarg* arguments)
-{
-    if(*argCounter >= numArgs)
-        ffStrbufAppendS(buffer, placeholder);
-    else
-        ffFormatAppendFormatArg(buffer, arguments + *argCounter);
-
-    (*argCounter)++;
-}
-
 static inline bool formatArgSet(const FFformatarg* arg)
 {
     return arg->value != NULL && (
@@ -89,172 +259,267 @@ static inline bool formatArgSet(const FFformatarg* arg)
         (arg->type == FF_FORMAT_ARG_TYPE_UINT8 && *(uint8_t*)arg->value > 0) ||
         (arg->type == FF_FORMAT_ARG_TYPE_UINT16 && *(uint16_t*)arg->value > 0) ||
         (arg->type == FF_FORMAT_ARG_TYPE_UINT && *(uint32_t*)arg->value > 0) ||
+        (arg->type == FF_FORMAT_ARG_TYPE_UINT64 && *(uint64_t*)arg->value > 0) ||
         (arg->type == FF_FORMAT_ARG_TYPE_BOOL && arg->value != NULL)
     );
 }
 
-void ffParseFormatString(FFstrbuf* buffer, const FFstrbuf* formatstr, uint32_t numArgs, const FFformatarg* arguments)
+void ffFormatProgramInit(FFformatProgram* program)
 {
-    uint32_t argCounter = 0;
+    ffStrbufInit(&program->text);
+    ffListInit(&program->ops, sizeof(FFformatOp));
+}
 
-    uint32_t numOpenIfs = 0;
-    uint32_t numOpenNotIfs = 0;
-    uint32_t numOpenColors = 0;
+void ffFormatProgramDestroy(FFformatProgram* program)
+{
+    ffStrbufDestroy(&program->text);
+    ffListDestroy(&program->ops);
+}
+
+static FFformatOp* addOp(FFformatProgram* program, FFformatOpType type, const char* text, uint32_t textLength)
+{
+    FFformatOp* op = ffListAdd(&program->ops);
+    *op = (FFformatOp) {
+        .type = (uint8_t) type,
+        .index = UINT32_MAX,
+        .textStart = program->text.length,
+        .textLength = textLength,
+    };
+    ffStrbufAppendNS(&program->text, textLength, text);
+    return op;
+}
+
+// Literal text is merged into the previous op, unless a condition jumps between them
+static void addText(FFformatProgram* program, const char* text, uint32_t textLength, bool jumpTarget)
+{
+    if(!jumpTarget && program->ops.length > 0)
+    {
+        FFformatOp* last = ffListGet(&program->ops, program->ops.length - 1);
+        if(last->type == FF_FORMAT_OP_TEXT && last->textStart + last->textLength == program->text.length)
+        {
+            ffStrbufAppendNS(&program->text, textLength, text);
+            last->textLength += textLength;
+            return;
+        }
+    }
+    addOp(program, FF_FORMAT_OP_TEXT, text, textLength);
+}
+
+// The text is the source of the placeholder, printed if the index is invalid
+static FFformatOp* addIndexOp(FFformatProgram* program, FFformatOpType type, const char* source, uint32_t sourceLength, const char* index, uint32_t indexLength)
+{
+    FFformatOp* op = addOp(program, type, source, sourceLength);
+
+    FF_STRBUF_AUTO_DESTROY value = ffStrbufCreateNS(indexLength, index);
+    op->index = getArgumentIndex(&value);
+    return op;
+}
+
+// The source position behind the next `end` ({?} / {/}) at or after `start`, where a false condition continues
+static uint32_t findJumpTarget(const FFstrbuf* formatstr, uint32_t start, const char* end)
+{
+    uint32_t index = ffStrbufNextIndexS(formatstr, start, end);
+    return index >= formatstr->length ? formatstr->length : index + 3;
+}
+
+void ffFormatProgramCompile(FFformatProgram* program, const FFstrbuf* formatstr)
+{
+    ffStrbufClear(&program->text);
+    program->ops.length = 0;
+
+    const uint32_t length = formatstr->length;
+    const char* chars = formatstr->chars;
+
+    // Conditions continue behind the next {?} / {/}, wherever it is. Those positions always start a token,
+    // literal text is split there. opIndexes maps source positions to the index of the op starting there
+    uint32_t* opIndexes = malloc((length + 1) * sizeof(uint32_t));
+    bool* jumpTargets = calloc(length + 1, sizeof(bool));
+    for(uint32_t i = 0; i + 3 <= length; ++i)
+    {
+        if(chars[i] == '{' && (chars[i + 1] == '?' || chars[i + 1] == '/') && chars[i + 2] == '}')
+            jumpTargets[i + 3] = true;
+    }
 
-    for(uint32_t i = 0; i < formatstr->length; ++i)
+    for(uint32_t i = 0; i < length;)
     {
-        // if we don't have a placeholder start just copy the chars over to output buffer
-        if(formatstr->chars[i] != '{')
+        opIndexes[i] = program->ops.length;
+
+        // if we don't have a placeholder start just copy the chars over
+        if(chars[i] != '{')
         {
-            ffStrbufAppendC(buffer, formatstr->chars[i]);
+            uint32_t end = i + 1;
+            while(end < length && chars[end] != '{' && !jumpTargets[end])
+                ++end;
+            addText(program, chars + i, end - i, jumpTargets[i]);
+            i = end;
             continue;
         }
 
         // if we have an { at the end handle it as {}
-        if(i == formatstr->length - 1)
+        if(i == length - 1)
         {
-            appendEmptyPlaceholder(buffer, "{", &argCounter, numArgs, arguments);
+            addOp(program, FF_FORMAT_OP_NEXT_ARG, "{", 1);
+            ++i;
             continue;
         }
 
-        // jump to next char, the start of the placeholder value
-        ++i;
-
         // double {{ elvaluates to a single { and doesn't count as start
-        if(formatstr->chars[i] == '{')
+        if(chars[i + 1] == '{')
         {
-            ffStrbufAppendC(buffer, '{');
+            addText(program, "{", 1, jumpTargets[i]);
+            i += 2;
             continue;
         }
 
         // placeholder is {}
-        if(formatstr->chars[i] == '}')
+        if(chars[i + 1] == '}')
         {
-            appendEmptyPlaceholder(buffer, "{}", &argCounter, numArgs, arguments);
+            addOp(program, FF_FORMAT_OP_NEXT_ARG, "{}", 2);
+            i += 2;
             continue;
         }
 
-        FF_STRBUF_AUTO_DESTROY placeholderValue = ffStrbufCreate();
-
-        while(i < formatstr->length && formatstr->chars[i] != '}')
-            ffStrbufAppendC(&placeholderValue, formatstr->chars[i++]);
-
-         // test if for stop, if so break the loop
-        if(placeholderValue.length == 1 && placeholderValue.chars[0] == '-')
-            break;
-
-        // test for end of an if, if so do nothing
-        if(placeholderValue.length == 1 && placeholderValue.chars[0] == '?')
+        // the placeholder ends behind the next }, or at the end of the string
+        uint32_t close = i + 1;
+        while(close < length && chars[close] != '}')
+            ++close;
+        const uint32_t end = close < length ? close + 1 : length;
+        const char* value = chars + i + 1;
+        const uint32_t valueLength = close - i - 1;
+
+        if(valueLength == 1 && value[0] == '-')
+            addOp(program, FF_FORMAT_OP_STOP, NULL, 0);
+        else if(valueLength == 1 && value[0] == '?')
+            addOp(program, FF_FORMAT_OP_END_IF, chars + i, end - i);
+        else if(valueLength == 1 && value[0] == '/')
+            addOp(program, FF_FORMAT_OP_END_IF_NOT, chars + i, end - i);
+        else if(valueLength == 1 && value[0] == '#')
+            addOp(program, FF_FORMAT_OP_END_COLOR, chars + i, end - i);
+        else if(value[0] == '?')
+            addIndexOp(program, FF_FORMAT_OP_IF, chars + i, end - i, value + 1, valueLength - 1)->jump = findJumpTarget(formatstr, close, "{?}");
+        else if(value[0] == '/')
+            addIndexOp(program, FF_FORMAT_OP_IF_NOT, chars + i, end - i, value + 1, valueLength - 1)->jump = findJumpTarget(formatstr, close, "{/}");
+        else if(value[0] == '#')
         {
-            if(numOpenIfs == 0)
-                appendInvalidPlaceholder(buffer, "{", &placeholderValue, i, formatstr->length);
-            else
-                --numOpenIfs;
-
-            continue;
+            FFformatOp* op = addOp(program, FF_FORMAT_OP_COLOR, "\033[", 2);
+            ffStrbufAppendNS(&program->text, valueLength - 1, value + 1);
+            ffStrbufAppendC(&program->text, 'm');
+            op->textLength = program->text.length - op->textStart;
         }
-
-        // test for end of a not if, if so do nothing
-        if(placeholderValue.length == 1 && placeholderValue.chars[0] == '/')
+        else
         {
-            if(numOpenNotIfs == 0)
-                appendInvalidPlaceholder(buffer, "{", &placeholderValue, i, formatstr->length);
-            else
-                --numOpenNotIfs;
-
-            continue;
-        }
-
-        // test for end of a color, if so do nothing
-        if(placeholderValue.length == 1 && placeholderValue.chars[0] == '#')
-        {
-            if(numOpenColors == 0)
-                appendInvalidPlaceholder(buffer, "{", &placeholderValue, i, formatstr->length);
+            const char* colon = memchr(value, ':', valueLength);
+            if(colon == NULL)
+                addIndexOp(program, FF_FORMAT_OP_ARG, chars + i, end - i, value, valueLength);
             else
             {
-                ffStrbufAppendS(buffer, FASTFETCH_TEXT_MODIFIER_RESET);
-                --numOpenColors;
+                // A spec needs an index; "{:}" and "{:.2}" are invalid indexes
+                const uint32_t indexLength = (uint32_t) (colon - value);
+                FFformatOp* op = addIndexOp(program, FF_FORMAT_OP_ARG, chars + i, end - i, value, indexLength);
+                op->hasSpec = indexLength > 0 && parseSpec(colon + 1, valueLength - indexLength - 1, &op->spec);
+                if(!op->hasSpec)
+                    op->index = UINT32_MAX; // Printed as is, like invalid indexes
             }
-
-            continue;
         }
 
-        // test for if, if so evaluate it
-        if(placeholderValue.chars[0] == '?')
-        {
-            ffStrbufSubstrAfter(&placeholderValue, 0);
-
-            uint32_t index = getArgumentIndex(&placeholderValue);
-
-            // testing for an invalid index
-            if(index > numArgs)
-            {
-                appendInvalidPlaceholder(buffer, "{?", &placeholderValue, i, formatstr->length);
-                continue;
-            }
+        i = end;
+    }
+    opIndexes[length] = program->ops.length;
 
-            // continue normally if an format arg is set and the value is > 0
-            if(formatArgSet(&arguments[index - 1]))
-            {
-                ++numOpenIfs;
-                continue;
-            }
+    FF_LIST_FOR_EACH(FFformatOp, op, program->ops)
+    {
+        if(op->type == FF_FORMAT_OP_IF || op->type == FF_FORMAT_OP_IF_NOT)
+            op->jump = opIndexes[op->jump];
+    }
 
-            // fastforward to the end of the if without printing the in between
-            i = ffStrbufNextIndexS(formatstr, i, "{?}") + 2; // 2 is the length of "{?}" - 1 because the loop will increament it again directly after continue
-            continue;
-        }
+    free(jumpTargets);
+    free(opIndexes);
+}
 
-        // test for not if, if so evaluate it
-        if(placeholderValue.chars[0] == '/')
-        {
-            ffStrbufSubstrAfter(&placeholderValue, 0);
+void ffFormatProgramRun(FFstrbuf* buffer, const FFformatProgram* program, uint32_t numArgs, const FFformatarg* arguments)
+{
+    uint32_t argCounter = 0;
 
-            uint32_t index = getArgumentIndex(&placeholderValue);
+    uint32_t numOpenIfs = 0;
+    uint32_t numOpenNotIfs = 0;
+    uint32_t numOpenColors = 0;
 
-            // testing for an invalid index
-            if(index > numArgs)
-            {
-                appendInvalidPlaceholder(buffer, "{/", &placeholderValue, i, formatstr->length);
-                continue;
-            }
+    const FFformatOp* ops = (const FFformatOp*) program->ops.data;
+    for(uint32_t i = 0; i < program->ops.length; ++i)
+    {
+        const FFformatOp* op = &ops[i];
+        const char* text = program->text.chars + op->textStart;
 
-            //continue normally if an format arg is not set or the value is 0
-            if(!formatArgSet(&arguments[index - 1]))
+        switch((FFformatOpType) op->type)
+        {
+            case FF_FORMAT_OP_TEXT:
+                ffStrbufAppendNS(buffer, op->textLength, text);
+                break;
+            case FF_FORMAT_OP_ARG:
+                if(op->index > numArgs)
+                    ffStrbufAppendNS(buffer, op->textLength, text);
+                else if(op->hasSpec)
+                    appendFormatArgWithSpec(buffer, &arguments[op->index - 1], &op->spec);
+                else
+                    ffFormatAppendFormatArg(buffer, &arguments[op->index - 1]);
+                break;
+            case FF_FORMAT_OP_NEXT_ARG:
+                if(argCounter >= numArgs)
+                    ffStrbufAppendNS(buffer, op->textLength, text);
+                else if(op->hasSpec)
+                    appendFormatArgWithSpec(buffer, &arguments[argCounter], &op->spec);
+                else
+                    ffFormatAppendFormatArg(buffer, &arguments[argCounter]);
+                ++argCounter;
+                break;
+            case FF_FORMAT_OP_IF:
+            case FF_FORMAT_OP_IF_NOT:
+                if(op->index > numArgs)
+                    ffStrbufAppendNS(buffer, op->textLength, text);
+                else if(formatArgSet(&arguments[op->index - 1]) == (op->type == FF_FORMAT_OP_IF))
+                    ++*(op->type == FF_FORMAT_OP_IF ? &numOpenIfs : &numOpenNotIfs);
+                else
+                    i = op->jump - 1; // fastforward to the end of the condition without printing the in between
+                break;
+            case FF_FORMAT_OP_END_IF:
+            case FF_FORMAT_OP_END_IF_NOT:
             {
-                ++numOpenNotIfs;
-                continue;
+                uint32_t* numOpen = op->type == FF_FORMAT_OP_END_IF ? &numOpenIfs : &numOpenNotIfs;
+                if(*numOpen == 0)
+                    ffStrbufAppendNS(buffer, op->textLength, text);
+                else
+                    --*numOpen;
+                break;
             }
-
-            // fastforward to the end of the if without printing the in between
-            i = ffStrbufNextIndexS(formatstr, i, "{/}") + 2; // 2 is the length of "{/}" - 1 because the loop will increament it again directly after continue
-            continue;
-        }
-
-        //test for color, if so evaluate it
-        if(placeholderValue.chars[0] == '#')
-        {
-            ++numOpenColors;
-            ffStrbufSubstrAfter(&placeholderValue, 0);
-            ffStrbufAppendS(buffer, "\033[");
-            ffStrbufAppend(buffer, &placeholderValue);
-            ffStrbufAppendC(buffer, 'm');
-            continue;
-        }
-
-        uint32_t index = getArgumentIndex(&placeholderValue);
-
-        // test for invalid index
-        if(index > numArgs)
-        {
-            appendInvalidPlaceholder(buffer, "{", &placeholderValue, i, formatstr->length);
-            continue;
+            case FF_FORMAT_OP_COLOR:
+                ffStrbufAppendNS(buffer, op->textLength, text);
+                ++numOpenColors;
+                break;
+            case FF_FORMAT_OP_END_COLOR:
+                if(numOpenColors == 0)
+                    ffStrbufAppendNS(buffer, op->textLength, text);
+                else
+                {
+                    ffStrbufAppendS(buffer, FASTFETCH_TEXT_MODIFIER_RESET);
+                    --numOpenColors;
+                }
+                break;
+            case FF_FORMAT_OP_STOP:
+                i = program->ops.length - 1;
+                break;
         }
-
-        ffFormatAppendFormatArg(buffer, &arguments[index - 1]);
     }
 
     ffStrbufTrimRight(buffer, ' ');
 
     ffStrbufAppendS(buffer, FASTFETCH_TEXT_MODIFIER_RESET);
 }
+
+void ffParseFormatString(FFstrbuf* buffer, const FFstrbuf* formatstr, uint32_t numArgs, const FFformatarg* arguments)
+{
+    FFformatProgram program;
+    ffFormatProgramInit(&program);
+    ffFormatProgramCompile(&program, formatstr);
+    ffFormatProgramRun(buffer, &program, numArgs, arguments);
+    ffFormatProgramDestroy(&program);
+}
@@ -3,6 +3,9 @@
 #ifndef FF_INCLUDED_common_format
 #define FF_INCLUDED_common_format
 
+#include "util/FFstrbuf.h"
+#include "util/FFlist.h"
+
 typedef enum FFformatargtype
 {
     FF_FORMAT_ARG_TYPE_NULL = 0,
@@ -15,7 +18,8 @@ typedef enum FFformatargtype
     FF_FORMAT_ARG_TYPE_FLOAT,
     FF_FORMAT_ARG_TYPE_DOUBLE,
     FF_FORMAT_ARG_TYPE_LIST,
-    FF_FORMAT_ARG_TYPE_BOOL
+    FF_FORMAT_ARG_TYPE_BOOL,
+    FF_FORMAT_ARG_TYPE_UINT64
 } FFformatargtype;
 
 typedef struct FFformatarg
@@ -24,7 +28,22 @@ typedef struct FFformatarg
     const void* value;
 } FFformatarg;
 
+// A format string compiled into a list of ops (literal text, arguments, conditions with their jump targets, colors).
+// Running it doesn't parse or allocate anything but the output. Compiled formats of modules are in FFModuleArgs
+typedef struct FFformatProgram
+{
+    FFstrbuf text; // Literal text, color escape sequences and the source of placeholders, referenced by the ops
+    FFlist ops; // FFformatOp, see format.c
+} FFformatProgram;
+
+void ffFormatProgramInit(FFformatProgram* program);
+void ffFormatProgramCompile(FFformatProgram* program, const FFstrbuf* formatstr);
+// Appends to `buffer` exactly what ffParseFormatString would append for the compiled format
+void ffFormatProgramRun(FFstrbuf* buffer, const FFformatProgram* program, uint32_t numArgs, const FFformatarg* arguments);
+void ffFormatProgramDestroy(FFformatProgram* program);
+
 void ffFormatAppendFormatArg(FFstrbuf* buffer, const FFformatarg* formatarg);
+// Compiles `formatstr` and runs it once. Use a FFformatProgram for formats that are used more than once
 void ffParseFormatString(FFstrbuf* buffer, const FFstrbuf* formatstr, uint32_t numArgs, const FFformatarg* arguments);
 
 #endif
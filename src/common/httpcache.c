@@ -0,0 +1,100 @@
+#include "fastfetch.h"
+#include "common/cache.h"
+#include "common/httpcache.h"
+#include "common/io/io.h"
+#include "common/processing.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <time.h>
+
+// Minimum time between two refreshes of the same URL, in seconds
+#define FF_HTTP_CACHE_REFRESH_INTERVAL 60
+
+typedef struct FFHttpCacheEntry
+{
+    int64_t time; // Unix time the response was received
+    FFstrbuf body;
+} FFHttpCacheEntry;
+
+static const FFCacheSchema httpCacheSchema = FF_CACHE_SCHEMA(FFHttpCacheEntry, offsetof(FFHttpCacheEntry, body));
+
+// Creates the key and the entry name. Returns false if the cache must not be used
+static bool initEntry(const FFModuleArgs* moduleArgs, const char* host, const char* path, FFstrbuf* key, char* entryName, size_t entryNameSize)
+{
+    if(!moduleArgs->cache || !ffCacheKeyInitPersistent(key))
+        return false;
+
+    ffStrbufAppendF(key, "http://%s%s\n", host, path);
+
+    // FNV-1a of the URL
+    uint64_t hash = 14695981039346656037ull;
+    for(const char* c = key->chars; *c; ++c)
+    {
+        hash ^= (uint8_t) *c;
+        hash *= 1099511628211ull;
+    }
+    snprintf(entryName, entryNameSize, "Http/%016llx", (unsigned long long) hash);
+    return true;
+}
+
+FFHttpCacheStatus ffHttpCacheLoad(const FFModuleArgs* moduleArgs, const char* host, const char* path, uint32_t ttl, FFstrbuf* body)
+{
+    FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
+    char entryName[64];
+    if(!initEntry(moduleArgs, host, path, &key, entryName, sizeof(entryName)))
+        return FF_HTTP_CACHE_MISS;
+
+    FFHttpCacheEntry entry;
+    if(!ffCacheLoad(entryName, &key, &httpCacheSchema, &entry))
+        return FF_HTTP_CACHE_MISS;
+
+    ffStrbufAppend(body, &entry.body);
+    ffStrbufDestroy(&entry.body);
+
+    // An entry from the future means that the clock has been changed; treat it as expired
+    int64_t now = (int64_t) time(NULL);
+    return entry.time <= now && now - entry.time < (int64_t) ttl ? FF_HTTP_CACHE_FRESH : FF_HTTP_CACHE_STALE;
+}
+
+void ffHttpCacheStore(const FFModuleArgs* moduleArgs, const char* host, const char* path, const FFstrbuf* body)
+{
+    FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
+    char entryName[64];
+    if(!initEntry(moduleArgs, host, path, &key, entryName, sizeof(entryName)))
+        return;
+
+    FFHttpCacheEntry entry = { .time = (int64_t) time(NULL) };
+    ffStrbufInitCopy(&entry.body, body);
+    ffCacheStore(entryName, &key, &httpCacheSchema, &entry);
+    ffStrbufDestroy(&entry.body);
+}
+
+void ffHttpCacheRefresh(const char* host, const char* path, const char* moduleName, const char* const options[])
+{
+    FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
+    char entryName[64];
+    FFModuleArgs moduleArgs = { .cache = true };
+    if(!initEntry(&moduleArgs, host, path, &key, entryName, sizeof(entryName)))
+        return;
+
+    // The modification time of a marker file records the last refresh
+    FF_STRBUF_AUTO_DESTROY marker = ffStrbufCreateCopy(&instance.state.platform.cacheDir);
+    ffStrbufAppendF(&marker, "fastfetch/cache/%s.refresh", entryName);
+
+    struct stat st;
+    time_t now = time(NULL);
+    if(stat(marker.chars, &st) == 0 && st.st_mtime <= now && now - st.st_mtime < FF_HTTP_CACHE_REFRESH_INTERVAL)
+        return;
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreateF("%lld\n", (long long) now);
+    if(!ffWriteFileBuffer(marker.chars, &content))
+        return;
+
+    char* argv[32] = { NULL, "--recache", "true", "--logo", "none", "--structure", (char*) moduleName };
+    uint32_t argc = 7;
+    for(const char* const* option = options; *option && argc < sizeof(argv) / sizeof(*argv) - 1; ++option)
+        argv[argc++] = (char*) *option;
+
+    ffProcessSpawnSelf(argv);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#ifndef FF_INCLUDED_common_httpcache
+#define FF_INCLUDED_common_httpcache
+
+#include "fastfetch.h"
+
+// Responses of network backed modules (PublicIp, Weather), stored in <cacheDir>/fastfetch/cache/Http and keyed by URL.
+// Unlike other cache entries, they survive reboots; they expire after the `cacheTtl` of the module instead.
+// Expired entries are still printed, while a background instance of fastfetch fetches them again (stale-while-revalidate).
+// So once an entry exists, printing it never waits for the network, and keeps working offline
+
+typedef enum FFHttpCacheStatus
+{
+    FF_HTTP_CACHE_MISS,
+    FF_HTTP_CACHE_FRESH,
+    FF_HTTP_CACHE_STALE, // Older than the TTL
+} FFHttpCacheStatus;
+
+// Appends the cached body to `body`. Always misses with `--recache`, `--cache false` or `--<module>-cache false`
+FFHttpCacheStatus ffHttpCacheLoad(const FFModuleArgs* moduleArgs, const char* host, const char* path, uint32_t ttl, FFstrbuf* body);
+void ffHttpCacheStore(const FFModuleArgs* moduleArgs, const char* host, const char* path, const FFstrbuf* body);
+
+// Runs `fastfetch --recache --structure <moduleName> <options...>` in the background, which stores a new response.
+// Does nothing if a refresh of the same URL was started during the last minute, so that a burst of logins starts one refresh only
+void ffHttpCacheRefresh(const char* host, const char* path, const char* moduleName, const char* const options[]);
+
+#endif
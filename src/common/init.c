@@ -1,5 +1,6 @@
 #include "fastfetch.h"
 #include "common/parsing.h"
+#include "common/output.h"
 #include "common/thread.h"
 #include "detection/displayserver/displayserver.h"
 #include "util/textModifier.h"
@@ -38,6 +39,9 @@ static void defaultConfig(void)
     ffStrbufInit(&instance.config.colorTitle);
     ffStrbufInitS(&instance.config.keyValueSeparator, ": ");
     instance.config.processingTimeout = 1000;
+    instance.config.watchInterval = 0;
+    instance.config.outputFormat = FF_OUTPUT_FORMAT_DEFAULT;
+    ffStrbufInit(&instance.config.root);
 
     #if defined(__linux__) || defined(__FreeBSD__)
     ffStrbufInit(&instance.config.playerName);
@@ -48,6 +52,7 @@ static void defaultConfig(void)
 
     instance.config.showErrors = false;
     instance.config.recache = false;
+    instance.config.cache = true;
     instance.config.allowSlowOperations = false;
     instance.config.pipe = !isatty(STDOUT_FILENO);
 
@@ -67,57 +72,11 @@ static void defaultConfig(void)
     instance.config.stat = false;
     instance.config.noBuffer = false;
 
-    ffInitTitleOptions(&instance.config.title);
-    ffInitOSOptions(&instance.config.os);
-    ffInitHostOptions(&instance.config.host);
-    ffInitBiosOptions(&instance.config.bios);
-    ffInitBoardOptions(&instance.config.board);
-    ffInitBrightnessOptions(&instance.config.brightness);
-    ffInitChassisOptions(&instance.config.chassis);
-    ffInitCommandOptions(&instance.config.command);
-    ffInitCustomOptions(&instance.config.custom);
-    ffInitKernelOptions(&instance.config.kernel);
-    ffInitUptimeOptions(&instance.config.uptime);
-    ffInitProcessesOptions(&instance.config.processes);
-    ffInitPackagesOptions(&instance.config.packages);
-    ffInitShellOptions(&instance.config.shell);
-    ffInitDisplayOptions(&instance.config.display);
-    ffInitDEOptions(&instance.config.de);
-    ffInitWMOptions(&instance.config.wm);
-    ffInitWMThemeOptions(&instance.config.wmTheme);
-    ffInitThemeOptions(&instance.config.theme);
-    ffInitIconsOptions(&instance.config.icons);
-    ffInitFontOptions(&instance.config.font);
-    ffInitCursorOptions(&instance.config.cursor);
-    ffInitTerminalOptions(&instance.config.terminal);
-    ffInitTerminalFontOptions(&instance.config.terminalFont);
-    ffInitCPUOptions(&instance.config.cpu);
-    ffInitCPUUsageOptions(&instance.config.cpuUsage);
-    ffInitGPUOptions(&instance.config.gpu);
-    ffInitMemoryOptions(&instance.config.memory);
-    ffInitSwapOptions(&instance.config.swap);
-    ffInitDiskOptions(&instance.config.disk);
-    ffInitBatteryOptions(&instance.config.battery);
-    ffInitPowerAdapterOptions(&instance.config.powerAdapter);
-    ffInitLMOptions(&instance.config.lm);
-    ffInitLocaleOptions(&instance.config.locale);
-    ffInitLocalIpOptions(&instance.config.localIP);
-    ffInitPublicIpOptions(&instance.config.publicIP);
-    ffInitWeatherOptions(&instance.config.weather);
-    ffInitWifiOptions(&instance.config.wifi);
-    ffInitPlayerOptions(&instance.config.player);
-    ffInitMediaOptions(&instance.config.media);
-    ffInitDateTimeOptions(&instance.config.dateTime);
-    ffInitVulkanOptions(&instance.config.vulkan);
-    ffInitWallpaperOptions(&instance.config.wallpaper);
-    ffInitOpenGLOptions(&instance.config.openGL);
-    ffInitOpenCLOptions(&instance.config.openCL);
-    ffInitUsersOptions(&instance.config.users);
-    ffInitBluetoothOptions(&instance.config.bluetooth);
-    ffInitSoundOptions(&instance.config.sound);
-    ffInitSeparatorOptions(&instance.config.separator);
-    ffInitGamepadOptions(&instance.config.gamepad);
-    ffInitColorsOptions(&instance.config.colors);
+    for(const FFModuleInfo* info = ffModuleInfos; info->name; ++info)
+    {
+        if(info->initOptions)
+            info->initOptions(info->options);
+    }
 
     ffStrbufInit(&instance.config.libPCI);
     ffStrbufInit(&instance.config.libVulkan);
@@ -155,6 +114,7 @@ void ffInitInstance(void)
     #endif
 
     initState(&instance.state);
+    ffInitModuleInfoTable();
     defaultConfig();
 }
 
@@ -233,6 +193,7 @@ void ffStart(void)
     SetConsoleOutputCP(CP_UTF8);
     #else
     if (instance.config.noBuffer) setvbuf(stdout, NULL, _IONBF, 0);
+    ffOutputInit();
     struct sigaction action = { .sa_handler = exitSignalHandler };
     sigaction(SIGINT, &action, NULL);
     sigaction(SIGTERM, &action, NULL);
@@ -249,6 +210,12 @@ void ffStart(void)
     if(ffDisableLinewrap)
         fputs("\033[?7l", stdout);
 
+    #ifndef _WIN32
+    // `--watch` addresses lines by their row on the screen
+    if(instance.config.watchInterval > 0 && !instance.config.pipe)
+        fputs("\033[H\033[2J", stdout);
+    #endif
+
     ffLogoPrint();
 }
 
@@ -257,7 +224,11 @@ void ffFinish(void)
     if(instance.config.logo.printRemaining)
         ffLogoPrintRemaining();
 
+    if(instance.config.stat)
+        ffOutputPrintStat();
+
     resetConsole();
+    ffOutputFlush();
 }
 
 static void destroyConfig(void)
@@ -267,63 +238,18 @@ static void destroyConfig(void)
     ffStrbufDestroy(&instance.config.colorKeys);
     ffStrbufDestroy(&instance.config.colorTitle);
     ffStrbufDestroy(&instance.config.keyValueSeparator);
+    ffStrbufDestroy(&instance.config.root);
 
     #if defined(__linux__) || defined(__FreeBSD__)
     ffStrbufDestroy(&instance.config.playerName);
     ffStrbufDestroy(&instance.config.osFile);
     #endif
 
-    ffDestroyTitleOptions(&instance.config.title);
-    ffDestroyOSOptions(&instance.config.os);
-    ffDestroyHostOptions(&instance.config.host);
-    ffDestroyBiosOptions(&instance.config.bios);
-    ffDestroyBoardOptions(&instance.config.board);
-    ffDestroyBrightnessOptions(&instance.config.brightness);
-    ffDestroyChassisOptions(&instance.config.chassis);
-    ffDestroyCommandOptions(&instance.config.command);
-    ffDestroyCustomOptions(&instance.config.custom);
-    ffDestroyKernelOptions(&instance.config.kernel);
-    ffDestroyUptimeOptions(&instance.config.uptime);
-    ffDestroyProcessesOptions(&instance.config.processes);
-    ffDestroyPackagesOptions(&instance.config.packages);
-    ffDestroyShellOptions(&instance.config.shell);
-    ffDestroyDisplayOptions(&instance.config.display);
-    ffDestroyDEOptions(&instance.config.de);
-    ffDestroyWMOptions(&instance.config.wm);
-    ffDestroyWMThemeOptions(&instance.config.wmTheme);
-    ffDestroyThemeOptions(&instance.config.theme);
-    ffDestroyIconsOptions(&instance.config.icons);
-    ffDestroyFontOptions(&instance.config.font);
-    ffDestroyCursorOptions(&instance.config.cursor);
-    ffDestroyTerminalOptions(&instance.config.terminal);
-    ffDestroyTerminalFontOptions(&instance.config.terminalFont);
-    ffDestroyCPUOptions(&instance.config.cpu);
-    ffDestroyCPUUsageOptions(&instance.config.cpuUsage);
-    ffDestroyGPUOptions(&instance.config.gpu);
-    ffDestroyMemoryOptions(&instance.config.memory);
-    ffDestroySwapOptions(&instance.config.swap);
-    ffDestroyDiskOptions(&instance.config.disk);
-    ffDestroyBatteryOptions(&instance.config.battery);
-    ffDestroyPowerAdapterOptions(&instance.config.powerAdapter);
-    ffDestroyLMOptions(&instance.config.lm);
-    ffDestroyLocaleOptions(&instance.config.locale);
-    ffDestroyLocalIpOptions(&instance.config.localIP);
-    ffDestroyPublicIpOptions(&instance.config.publicIP);
-    ffDestroyWallpaperOptions(&instance.config.wallpaper);
-    ffDestroyWeatherOptions(&instance.config.weather);
-    ffDestroyWifiOptions(&instance.config.wifi);
-    ffDestroyPlayerOptions(&instance.config.player);
-    ffDestroyMediaOptions(&instance.config.media);
-    ffDestroyDateTimeOptions(&instance.config.dateTime);
-    ffDestroyVulkanOptions(&instance.config.vulkan);
-    ffDestroyOpenGLOptions(&instance.config.openGL);
-    ffDestroyOpenCLOptions(&instance.config.openCL);
-    ffDestroyUsersOptions(&instance.config.users);
-    ffDestroyBluetoothOptions(&instance.config.bluetooth);
-    ffDestroySeparatorOptions(&instance.config.separator);
-    ffDestroySoundOptions(&instance.config.sound);
-    ffDestroyGamepadOptions(&instance.config.gamepad);
-    ffDestroyColorsOptions(&instance.config.colors);
+    for(const FFModuleInfo* info = ffModuleInfos; info->name; ++info)
+    {
+        if(info->destroyOptions)
+            info->destroyOptions(info->options);
+    }
 
     ffStrbufDestroy(&instance.config.libPCI);
     ffStrbufDestroy(&instance.config.libVulkan);
@@ -359,6 +285,7 @@ static void destroyState(void)
 
 void ffDestroyInstance(void)
 {
+    ffOutputDestroy();
     destroyConfig();
     destroyState();
 }
@@ -70,6 +70,12 @@ static inline bool ffReadFileBuffer(const char* fileName, FFstrbuf* buffer)
     return ffAppendFileBuffer(fileName, buffer);
 }
 
+// Counts the lines starting with `prefix`. With `allowIndentation`, leading spaces and tabs are skipped.
+// Uses SIMD where available; fast enough for package databases of hundreds of MB
+uint32_t ffCountLinesWithPrefix(const char* data, size_t length, const char* prefix, bool allowIndentation);
+// Same for the content of a file, which is mapped into memory if it is large. Returns 0 if it can't be read
+uint32_t ffCountFileLinesWithPrefix(const char* fileName, const char* prefix, bool allowIndentation);
+
 //Bit flags, combine with |
 typedef enum FFPathType
 {
@@ -88,7 +94,17 @@ bool ffPathExists(const char* path, FFPathType pathType);
     void ffGetTerminalResponse(const char* request, const char* format, ...);
 #endif
 
-// Not thread safe!
+#ifndef _WIN32
+    // Called for every entry of a directory except "." and "..". `dirfd` is the directory itself, for use with openat / fstatat.
+    // `type` is a DT_* constant; DT_UNKNOWN reported by some file systems is resolved with fstatat(AT_SYMLINK_NOFOLLOW).
+    // Return false to stop
+    typedef bool (*FFDirEntryCallback)(void* data, int dirfd, const char* name, unsigned char type);
+    // Reads the entries of `path`, relative to `parentFd` (may be AT_FDCWD), in large batches (getdents64 on Linux).
+    // Returns false if the directory can't be read
+    bool ffDirForEachEntry(int parentFd, const char* path, FFDirEntryCallback callback, void* data);
+#endif
+
+// Blocks output of other modules while suppressed
 bool ffSuppressIO(bool suppress);
 
 static inline void ffUnsuppressIO(bool* suppressed)
@@ -1,4 +1,7 @@
 #include "io.h"
+#include "common/output.h"
+#include "common/scheduler.h"
+#include "util/mallocHelper.h"
 #include "util/stringUtils.h"
 
 #include <fcntl.h>
@@ -7,6 +10,26 @@
 #include <poll.h>
 #include <dirent.h>
 
+#ifdef __linux__
+    #include <sys/syscall.h>
+
+    // Not every libc has a getdents64 wrapper (glibc added it in 2.30)
+    typedef struct FFLinuxDirent64
+    {
+        uint64_t d_ino;
+        int64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[];
+    } FFLinuxDirent64;
+
+    #define FF_DIR_BUFFER_SIZE (64 * 1024)
+#endif
+
+#ifndef IFTODT
+    #define IFTODT(mode) (((mode) & S_IFMT) >> 12)
+#endif
+
 static void createSubfolders(const char* fileName)
 {
     FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
@@ -107,6 +130,69 @@ bool ffPathExists(const char* path, FFPathType type)
     return false;
 }
 
+static inline bool isDotEntry(const char* name)
+{
+    return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+static unsigned char resolveDirEntryType(int dirfd, const char* name, unsigned char type)
+{
+    if(type != DT_UNKNOWN)
+        return type;
+
+    struct stat fileStat;
+    if(fstatat(dirfd, name, &fileStat, AT_SYMLINK_NOFOLLOW) != 0)
+        return DT_UNKNOWN;
+    return (unsigned char) IFTODT(fileStat.st_mode);
+}
+
+bool ffDirForEachEntry(int parentFd, const char* path, FFDirEntryCallback callback, void* data)
+{
+    int FF_AUTO_CLOSE_FD fd = openat(parentFd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if(fd < 0)
+        return false;
+
+    #ifdef __linux__
+        char* FF_AUTO_FREE buffer = malloc(FF_DIR_BUFFER_SIZE);
+        if(!buffer)
+            return false;
+
+        long length;
+        while((length = syscall(SYS_getdents64, fd, buffer, FF_DIR_BUFFER_SIZE)) > 0)
+        {
+            for(long pos = 0; pos < length;)
+            {
+                const FFLinuxDirent64* entry = (const FFLinuxDirent64*) (buffer + pos);
+                pos += entry->d_reclen;
+
+                if(isDotEntry(entry->d_name))
+                    continue;
+                if(!callback(data, fd, entry->d_name, resolveDirEntryType(fd, entry->d_name, entry->d_type)))
+                    return true;
+            }
+        }
+        return length == 0;
+    #else
+        DIR* dir = fdopendir(fd);
+        if(!dir)
+            return false;
+        fd = -1; // Owned by dir now
+
+        int dfd = dirfd(dir);
+        struct dirent* entry;
+        while((entry = readdir(dir)) != NULL)
+        {
+            if(isDotEntry(entry->d_name))
+                continue;
+            if(!callback(data, dfd, entry->d_name, resolveDirEntryType(dfd, entry->d_name, entry->d_type)))
+                break;
+        }
+
+        closedir(dir);
+        return true;
+    #endif
+}
+
 void ffGetTerminalResponse(const char* request, const char* format, ...)
 {
     struct termios oldTerm, newTerm;
@@ -119,7 +205,7 @@ void ffGetTerminalResponse(const char* request, const char* format, ...)
         return;
 
     fputs(request, stdout);
-    fflush(stdout);
+    ffOutputFlush();
 
     struct pollfd pfd;
     pfd.fd = STDIN_FILENO;
@@ -156,25 +242,39 @@ bool ffSuppressIO(bool suppress)
     static int origErr = -1;
     static int nullFile = -1;
 
-    if(!init)
+    if(!suppress)
     {
-        if(!suppress)
+        if(!init)
             return true;
-
-        origOut = dup(STDOUT_FILENO);
-        origErr = dup(STDERR_FILENO);
-        nullFile = open("/dev/null", O_WRONLY);
-        init = true;
     }
+    else
+    {
+        // Modules may run concurrently. Don't redirect fds while another module is printing
+        ffSchedulerLockOutput();
 
-    if(nullFile == -1)
-        return false;
+        if(!init)
+        {
+            origOut = dup(STDOUT_FILENO);
+            origErr = dup(STDERR_FILENO);
+            nullFile = open("/dev/null", O_WRONLY);
+            init = true;
+        }
+
+        if(nullFile == -1)
+        {
+            ffSchedulerUnlockOutput();
+            return false;
+        }
+    }
 
-    fflush(stdout);
+    ffOutputFlush();
     fflush(stderr);
 
     dup2(suppress ? nullFile : origOut, STDOUT_FILENO);
     dup2(suppress ? nullFile : origErr, STDERR_FILENO);
+
+    if(!suppress)
+        ffSchedulerUnlockOutput();
     return true;
 }
 
@@ -0,0 +1,200 @@
+#include "io.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+    #include <sys/mman.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define FF_LINECOUNT_X86 1
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define FF_LINECOUNT_NEON 1
+#endif
+
+// Files smaller than this are read instead of being mapped
+#define FF_LINECOUNT_MMAP_THRESHOLD (64 * 1024)
+
+typedef struct FFLineCountContext
+{
+    const char* data;
+    size_t length;
+    const char* prefix;
+    size_t prefixLength;
+    bool allowIndentation;
+} FFLineCountContext;
+
+// Checks a candidate position whose byte equals prefix[0]
+static inline bool isMatch(const FFLineCountContext* ctx, size_t pos)
+{
+    if(ctx->length - pos < ctx->prefixLength || memcmp(ctx->data + pos + 1, ctx->prefix + 1, ctx->prefixLength - 1) != 0)
+        return false;
+
+    if(!ctx->allowIndentation)
+        return pos == 0 || ctx->data[pos - 1] == '\n';
+
+    while(pos > 0 && (ctx->data[pos - 1] == ' ' || ctx->data[pos - 1] == '\t'))
+        --pos;
+    return pos == 0 || ctx->data[pos - 1] == '\n';
+}
+
+// Calls isMatch for every set bit of mask, which covers the bytes [base, base + 64)
+static inline uint32_t countMask(const FFLineCountContext* ctx, size_t base, uint64_t mask)
+{
+    uint32_t count = 0;
+    while(mask)
+    {
+        count += isMatch(ctx, base + (size_t) __builtin_ctzll(mask));
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+static uint32_t countScalar(const FFLineCountContext* ctx, size_t start)
+{
+    uint32_t count = 0;
+    for(size_t i = start; i < ctx->length; ++i)
+    {
+        if(ctx->data[i] == ctx->prefix[0])
+            count += isMatch(ctx, i);
+    }
+    return count;
+}
+
+// All vector implementations look for positions where the byte equals prefix[0].
+// Without indentation, the previous byte (loaded with an offset of -1) must also be '\n', which rules out almost all candidates.
+// They start at position 1, so that the load of the previous bytes stays in bounds; position 0 is checked separately.
+
+#ifdef FF_LINECOUNT_X86
+
+static uint32_t countSSE2(const FFLineCountContext* ctx)
+{
+    const __m128i first = _mm_set1_epi8(ctx->prefix[0]);
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    uint32_t count = 0;
+    size_t i = 1;
+    for(; i + 16 <= ctx->length; i += 16)
+    {
+        __m128i mask = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (ctx->data + i)), first);
+        if(!ctx->allowIndentation)
+            mask = _mm_and_si128(mask, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) (ctx->data + i - 1)), newline));
+        count += countMask(ctx, i, (uint32_t) _mm_movemask_epi8(mask));
+    }
+    return count + countScalar(ctx, i);
+}
+
+__attribute__((__target__("avx2")))
+static uint32_t countAVX2(const FFLineCountContext* ctx)
+{
+    const __m256i first = _mm256_set1_epi8(ctx->prefix[0]);
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    uint32_t count = 0;
+    size_t i = 1;
+    for(; i + 32 <= ctx->length; i += 32)
+    {
+        __m256i mask = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) (ctx->data + i)), first);
+        if(!ctx->allowIndentation)
+            mask = _mm256_and_si256(mask, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) (ctx->data + i - 1)), newline));
+        count += countMask(ctx, i, (uint32_t) _mm256_movemask_epi8(mask));
+    }
+    return count + countScalar(ctx, i);
+}
+
+static uint32_t countVector(const FFLineCountContext* ctx)
+{
+    // Only reads a variable initialized by libgcc / compiler-rt at startup
+    return __builtin_cpu_supports("avx2") ? countAVX2(ctx) : countSSE2(ctx);
+}
+
+#elif defined(FF_LINECOUNT_NEON)
+
+static uint32_t countVector(const FFLineCountContext* ctx)
+{
+    const uint8x16_t first = vdupq_n_u8((uint8_t) ctx->prefix[0]);
+    const uint8x16_t newline = vdupq_n_u8('\n');
+
+    uint32_t count = 0;
+    size_t i = 1;
+    for(; i + 16 <= ctx->length; i += 16)
+    {
+        uint8x16_t mask = vceqq_u8(vld1q_u8((const uint8_t*) ctx->data + i), first);
+        if(!ctx->allowIndentation)
+            mask = vandq_u8(mask, vceqq_u8(vld1q_u8((const uint8_t*) ctx->data + i - 1), newline));
+
+        // NEON has no movemask; narrow every byte to a nibble, so that byte n maps to bits [4n, 4n + 4)
+        uint64_t nibbles = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(mask), 4)), 0);
+        while(nibbles)
+        {
+            count += isMatch(ctx, i + (size_t) (__builtin_ctzll(nibbles) >> 2));
+            nibbles &= ~(0xFULL << (__builtin_ctzll(nibbles) & ~3));
+        }
+    }
+    return count + countScalar(ctx, i);
+}
+
+#else
+
+static uint32_t countVector(const FFLineCountContext* ctx)
+{
+    return countScalar(ctx, 1);
+}
+
+#endif
+
+uint32_t ffCountLinesWithPrefix(const char* data, size_t length, const char* prefix, bool allowIndentation)
+{
+    FFLineCountContext ctx = {
+        .data = data,
+        .length = length,
+        .prefix = prefix,
+        .prefixLength = strlen(prefix),
+        .allowIndentation = allowIndentation,
+    };
+
+    if(ctx.prefixLength == 0 || length == 0)
+        return 0;
+
+    uint32_t count = data[0] == prefix[0] ? isMatch(&ctx, 0) : 0;
+    return count + countVector(&ctx);
+}
+
+uint32_t ffCountFileLinesWithPrefix(const char* fileName, const char* prefix, bool allowIndentation)
+{
+    #ifndef _WIN32
+        int FF_AUTO_CLOSE_FD fd = open(fileName, O_RDONLY | O_CLOEXEC);
+        if(fd < 0)
+            return 0;
+
+        struct stat fileInfo;
+        if(fstat(fd, &fileInfo) != 0)
+            return 0;
+
+        if(fileInfo.st_size >= FF_LINECOUNT_MMAP_THRESHOLD)
+        {
+            size_t length = (size_t) fileInfo.st_size;
+            void* data = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(data != MAP_FAILED)
+            {
+                madvise(data, length, MADV_SEQUENTIAL);
+                uint32_t count = ffCountLinesWithPrefix(data, length, prefix, allowIndentation);
+                munmap(data, length);
+                return count;
+            }
+        }
+
+        FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+        if(!ffAppendFDBuffer(fd, &content))
+            return 0;
+    #else
+        FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+        if(!ffAppendFileBuffer(fileName, &content))
+            return 0;
+    #endif
+
+    return ffCountLinesWithPrefix(content.chars, content.length, prefix, allowIndentation);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#ifndef FF_INCLUDED_common_io_sysfs
+#define FF_INCLUDED_common_io_sysfs
+
+#include "util/FFstrbuf.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+// Access to sysfs / procfs attributes relative to an open directory.
+// A (class or device) directory is opened once; every attribute then costs openat + pread + close,
+// without path resolution from / and without the fstat ffAppendFileBuffer needs for regular files.
+// Attribute files return their whole content on the first read, so a short read is treated as EOF.
+
+// Opens `path` (relative to `parentFd`, which may be AT_FDCWD) for use as `dirfd` below. Returns -1 on failure
+static inline int ffSysfsOpenDir(int parentFd, const char* path)
+{
+    return openat(parentFd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+}
+
+// Size of a buffer for ffSysfsEntryPath
+#define FF_SYSFS_PATH_MAX (NAME_MAX + 64)
+
+// Writes "<entry>/<attr>" to `path` and returns it. Used to read attributes of the entries passed by ffDirForEachEntry
+// relative to the directory being iterated, which saves opening and closing every entry
+const char* ffSysfsEntryPath(char path[FF_SYSFS_PATH_MAX], const char* entry, const char* attr);
+
+// Reads at most `size` bytes of attribute `name`. Returns the number of bytes read, or -1
+ssize_t ffSysfsReadData(int dirfd, const char* name, void* buf, size_t size);
+
+// Reads attribute `name` into `buf` as a NUL terminated string, with trailing newlines and spaces removed.
+// Values longer than `size - 1` are truncated. Returns the length, or -1 (`buf` is empty then)
+ssize_t ffSysfsReadStr(int dirfd, const char* name, char* buf, size_t size);
+
+// Appends attribute `name` to `buffer`, with trailing newlines and spaces removed
+bool ffSysfsAppendAttr(int dirfd, const char* name, FFstrbuf* buffer);
+
+static inline bool ffSysfsReadAttr(int dirfd, const char* name, FFstrbuf* buffer)
+{
+    ffStrbufClear(buffer);
+    return ffSysfsAppendAttr(dirfd, name, buffer);
+}
+
+// Parse a numeric attribute from a stack buffer. `result` is left untouched on failure
+bool ffSysfsReadUInt(int dirfd, const char* name, int base, uint64_t* result);
+bool ffSysfsReadInt(int dirfd, const char* name, int64_t* result);
+bool ffSysfsReadDouble(int dirfd, const char* name, double* result);
+
+#endif // FF_INCLUDED_common_io_sysfs
@@ -0,0 +1,118 @@
+#include "sysfs.h"
+#include "io.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+const char* ffSysfsEntryPath(char path[FF_SYSFS_PATH_MAX], const char* entry, const char* attr)
+{
+    size_t entryLength = strnlen(entry, NAME_MAX);
+    size_t attrLength = strlen(attr);
+    assert(attrLength < FF_SYSFS_PATH_MAX - NAME_MAX - 1);
+
+    memcpy(path, entry, entryLength);
+    path[entryLength] = '/';
+    memcpy(path + entryLength + 1, attr, attrLength + 1);
+    return path;
+}
+
+ssize_t ffSysfsReadData(int dirfd, const char* name, void* buf, size_t size)
+{
+    int FF_AUTO_CLOSE_FD fd = openat(dirfd, name, O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+        return -1;
+
+    return pread(fd, buf, size, 0);
+}
+
+static inline size_t trimmedLength(const char* buf, size_t length)
+{
+    while(length > 0 && (buf[length - 1] == '\n' || buf[length - 1] == ' '))
+        --length;
+    return length;
+}
+
+ssize_t ffSysfsReadStr(int dirfd, const char* name, char* buf, size_t size)
+{
+    assert(size > 0);
+
+    ssize_t length = ffSysfsReadData(dirfd, name, buf, size - 1);
+    if(length < 0)
+    {
+        buf[0] = '\0';
+        return -1;
+    }
+
+    length = (ssize_t) trimmedLength(buf, (size_t) length);
+    buf[length] = '\0';
+    return length;
+}
+
+bool ffSysfsAppendAttr(int dirfd, const char* name, FFstrbuf* buffer)
+{
+    int FF_AUTO_CLOSE_FD fd = openat(dirfd, name, O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+        return false;
+
+    // One page is the most a sysfs attribute can hold
+    char buf[4096];
+    off_t offset = 0;
+    ssize_t length;
+    while((length = pread(fd, buf, sizeof(buf), offset)) > 0)
+    {
+        ffStrbufAppendNS(buffer, (uint32_t) length, buf);
+        if((size_t) length < sizeof(buf))
+            break;
+        offset += length;
+    }
+
+    ffStrbufTrimRight(buffer, '\n');
+    ffStrbufTrimRight(buffer, ' ');
+
+    return length >= 0;
+}
+
+bool ffSysfsReadUInt(int dirfd, const char* name, int base, uint64_t* result)
+{
+    char buf[32];
+    if(ffSysfsReadStr(dirfd, name, buf, sizeof(buf)) <= 0 || buf[0] == '-')
+        return false;
+
+    char* end;
+    uint64_t value = strtoull(buf, &end, base);
+    if(end == buf)
+        return false;
+
+    *result = value;
+    return true;
+}
+
+bool ffSysfsReadInt(int dirfd, const char* name, int64_t* result)
+{
+    char buf[32];
+    if(ffSysfsReadStr(dirfd, name, buf, sizeof(buf)) <= 0)
+        return false;
+
+    char* end;
+    int64_t value = strtoll(buf, &end, 10);
+    if(end == buf)
+        return false;
+
+    *result = value;
+    return true;
+}
+
+bool ffSysfsReadDouble(int dirfd, const char* name, double* result)
+{
+    char buf[64];
+    if(ffSysfsReadStr(dirfd, name, buf, sizeof(buf)) <= 0)
+        return false;
+
+    char* end;
+    double value = strtod(buf, &end);
+    if(end == buf)
+        return false;
+
+    *result = value;
+    return true;
+}
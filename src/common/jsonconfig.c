@@ -2,19 +2,23 @@
 #include "common/jsonconfig.h"
 #include "common/printing.h"
 #include "common/io/io.h"
-#include "common/time.h"
+#include "common/scheduler.h"
+#include "common/watch.h"
+#include "common/jsonresult.h"
 #include "modules/modules.h"
+#include "util/mallocHelper.h"
 #include "util/stringUtils.h"
 
 #include <assert.h>
-#include <ctype.h>
 #include <inttypes.h>
+#include <stdlib.h>
 
 bool ffJsonConfigParseModuleArgs(const char* key, yyjson_val* val, FFModuleArgs* moduleArgs)
 {
     if(ffStrEqualsIgnCase(key, "key"))
     {
         ffStrbufSetNS(&moduleArgs->key, (uint32_t) yyjson_get_len(val), yyjson_get_str(val));
+        ffFormatProgramCompile(&moduleArgs->keyProgram, &moduleArgs->key);
         return true;
     }
     else if(ffStrEqualsIgnCase(key, "keyColor"))
@@ -25,6 +29,12 @@ bool ffJsonConfigParseModuleArgs(const char* key, yyjson_val* val, FFModuleArgs*
     else if(ffStrEqualsIgnCase(key, "format"))
     {
         ffStrbufSetNS(&moduleArgs->outputFormat, (uint32_t) yyjson_get_len(val), yyjson_get_str(val));
+        ffFormatProgramCompile(&moduleArgs->outputFormatProgram, &moduleArgs->outputFormat);
+        return true;
+    }
+    else if(ffStrEqualsIgnCase(key, "cache"))
+    {
+        moduleArgs->cache = yyjson_get_bool(val);
         return true;
     }
     return false;
@@ -65,160 +75,43 @@ const char* ffJsonConfigParseEnum(yyjson_val* val, int* result, FFKeyValuePair p
         return "Invalid enum value type; must be a string or integer";
 }
 
-static inline bool tryModule(const char* type, yyjson_val* module, const char* moduleName, void (*const f)(yyjson_val *module))
+static bool parseModuleJsonObject(const char* type, yyjson_val* module)
 {
-    if (ffStrEqualsIgnCase(type, moduleName))
+    const FFModuleInfo* info = ffFindModuleInfo(type, (uint32_t) strlen(type));
+    if (!info) return false;
+
+    if (!info->options)
     {
-        f(module);
+        info->print(NULL);
         return true;
     }
-    return false;
+
+    void* FF_AUTO_FREE options = malloc(info->optionsSize);
+    info->initOptions(options);
+    info->parseJsonObject(options, module);
+    info->print(options);
+    info->destroyOptions(options);
+    return true;
 }
 
-static bool parseModuleJsonObject(const char* type, yyjson_val* module)
+typedef struct FFJsonModuleEntry
 {
-    switch (toupper(type[0]))
-    {
-        case 'B': {
-            return
-                tryModule(type, module, FF_BATTERY_MODULE_NAME, ffParseBatteryJsonObject) ||
-                tryModule(type, module, FF_BIOS_MODULE_NAME, ffParseBiosJsonObject) ||
-                tryModule(type, module, FF_BLUETOOTH_MODULE_NAME, ffParseBluetoothJsonObject) ||
-                tryModule(type, module, FF_BOARD_MODULE_NAME, ffParseBoardJsonObject) ||
-                tryModule(type, module, FF_BREAK_MODULE_NAME, ffParseBreakJsonObject) ||
-                tryModule(type, module, FF_BRIGHTNESS_MODULE_NAME, ffParseBrightnessJsonObject) ||
-                false;
-        }
-
-        case 'C': {
-            return
-                tryModule(type, module, FF_CHASSIS_MODULE_NAME, ffParseChassisJsonObject) ||
-                tryModule(type, module, FF_CPU_MODULE_NAME, ffParseCPUJsonObject) ||
-                tryModule(type, module, FF_CPUUSAGE_MODULE_NAME, ffParseCPUUsageJsonObject) ||
-                tryModule(type, module, FF_COMMAND_MODULE_NAME, ffParseCommandJsonObject) ||
-                tryModule(type, module, FF_COLORS_MODULE_NAME, ffParseColorsJsonObject) ||
-                tryModule(type, module, FF_CURSOR_MODULE_NAME, ffParseCursorJsonObject) ||
-                tryModule(type, module, FF_CUSTOM_MODULE_NAME, ffParseCustomJsonObject) ||
-                false;
-        }
-
-        case 'D': {
-            return
-                tryModule(type, module, FF_DATETIME_MODULE_NAME, ffParseDateTimeJsonObject) ||
-                tryModule(type, module, FF_DISPLAY_MODULE_NAME, ffParseDisplayJsonObject) ||
-                tryModule(type, module, FF_DISK_MODULE_NAME, ffParseDiskJsonObject) ||
-                tryModule(type, module, FF_DE_MODULE_NAME, ffParseDEJsonObject) ||
-                false;
-        }
-
-        case 'F': {
-            return
-                tryModule(type, module, FF_FONT_MODULE_NAME, ffParseFontJsonObject) ||
-                false;
-        }
-
-        case 'G': {
-            return
-                tryModule(type, module, FF_GAMEPAD_MODULE_NAME, ffParseGamepadJsonObject) ||
-                tryModule(type, module, FF_GPU_MODULE_NAME, ffParseGPUJsonObject) ||
-                false;
-        }
-
-        case 'H': {
-            return
-                tryModule(type, module, FF_HOST_MODULE_NAME, ffParseHostJsonObject) ||
-                false;
-        }
-
-        case 'I': {
-            return
-                tryModule(type, module, FF_ICONS_MODULE_NAME, ffParseIconsJsonObject) ||
-                false;
-        }
-
-        case 'K': {
-            return
-                tryModule(type, module, FF_KERNEL_MODULE_NAME, ffParseKernelJsonObject) ||
-                false;
-        }
-
-        case 'L': {
-            return
-                tryModule(type, module, FF_LM_MODULE_NAME, ffParseLMJsonObject) ||
-                tryModule(type, module, FF_LOCALE_MODULE_NAME, ffParseLocaleJsonObject) ||
-                tryModule(type, module, FF_LOCALIP_MODULE_NAME, ffParseLocalIpJsonObject) ||
-                false;
-        }
-
-        case 'M': {
-            return
-                tryModule(type, module, FF_MEDIA_MODULE_NAME, ffParseMediaJsonObject) ||
-                tryModule(type, module, FF_MEMORY_MODULE_NAME, ffParseMemoryJsonObject) ||
-                false;
-        }
-
-        case 'O': {
-            return
-                tryModule(type, module, FF_OPENCL_MODULE_NAME, ffParseOpenCLJsonObject) ||
-                tryModule(type, module, FF_OPENGL_MODULE_NAME, ffParseOpenGLJsonObject) ||
-                tryModule(type, module, FF_OS_MODULE_NAME, ffParseOSJsonObject) ||
-                false;
-        }
-
-        case 'P': {
-            return
-                tryModule(type, module, FF_PACKAGES_MODULE_NAME, ffParsePackagesJsonObject) ||
-                tryModule(type, module, FF_PLAYER_MODULE_NAME, ffParsePlayerJsonObject) ||
-                tryModule(type, module, FF_POWERADAPTER_MODULE_NAME, ffParsePowerAdapterJsonObject) ||
-                tryModule(type, module, FF_PROCESSES_MODULE_NAME, ffParseProcessesJsonObject) ||
-                tryModule(type, module, FF_PUBLICIP_MODULE_NAME, ffParsePublicIpJsonObject) ||
-                false;
-        }
-
-        case 'S': {
-            return
-                tryModule(type, module, FF_SEPARATOR_MODULE_NAME, ffParseSeparatorJsonObject) ||
-                tryModule(type, module, FF_SHELL_MODULE_NAME, ffParseShellJsonObject) ||
-                tryModule(type, module, FF_SOUND_MODULE_NAME, ffParseSoundJsonObject) ||
-                tryModule(type, module, FF_SWAP_MODULE_NAME, ffParseSwapJsonObject) ||
-                false;
-        }
-
-        case 'T': {
-            return
-                tryModule(type, module, FF_TERMINAL_MODULE_NAME, ffParseTerminalJsonObject) ||
-                tryModule(type, module, FF_TERMINALFONT_MODULE_NAME, ffParseTerminalFontJsonObject) ||
-                tryModule(type, module, FF_TITLE_MODULE_NAME, ffParseTitleJsonObject) ||
-                tryModule(type, module, FF_THEME_MODULE_NAME, ffParseThemeJsonObject) ||
-                false;
-        }
-
-        case 'U': {
-            return
-                tryModule(type, module, FF_UPTIME_MODULE_NAME, ffParseUptimeJsonObject) ||
-                tryModule(type, module, FF_USERS_MODULE_NAME, ffParseUsersJsonObject) ||
-                false;
-        }
-
-        case 'V': {
-            return
-                tryModule(type, module, FF_VULKAN_MODULE_NAME, ffParseVulkanJsonObject) ||
-                false;
-        }
+    const char* type;
+    yyjson_val* module;
+} FFJsonModuleEntry;
 
-        case 'W': {
-            return
-                tryModule(type, module, FF_WALLPAPER_MODULE_NAME, ffParseWallpaperJsonObject) ||
-                tryModule(type, module, FF_WEATHER_MODULE_NAME, ffParseWeatherJsonObject) ||
-                tryModule(type, module, FF_WM_MODULE_NAME, ffParseWMJsonObject) ||
-                tryModule(type, module, FF_WIFI_MODULE_NAME, ffParseWifiJsonObject) ||
-                tryModule(type, module, FF_WMTHEME_MODULE_NAME, ffParseWMThemeJsonObject) ||
-                false;
-        }
+static void runJsonModuleJob(void* data, uint32_t index)
+{
+    FFJsonModuleEntry* entry = (FFJsonModuleEntry*) ffListGet((FFlist*) data, index);
+    if(!parseModuleJsonObject(entry->type, entry->module))
+        ffPrintErrorString("JsonConfig", 0, NULL, NULL, "Unknown module type: %s", entry->type);
+}
 
-        default:
-            return false;
-    }
+static bool isJsonModuleJobDynamic(void* data, uint32_t index)
+{
+    FFJsonModuleEntry* entry = (FFJsonModuleEntry*) ffListGet((FFlist*) data, index);
+    const FFModuleInfo* info = ffFindModuleInfo(entry->type, (uint32_t) strlen(entry->type));
+    return info && info->dynamic;
 }
 
 static const char* printJsonConfig(void)
@@ -233,14 +126,12 @@ static const char* printJsonConfig(void)
     if (!modules) return NULL;
     if (!yyjson_is_arr(modules)) return "Property 'modules' must be an array of strings or objects";
 
+    FF_LIST_AUTO_DESTROY entries = ffListCreate(sizeof(FFJsonModuleEntry));
+
     yyjson_val* item;
     size_t idx, max;
     yyjson_arr_foreach(modules, idx, max, item)
     {
-        uint64_t ms = 0;
-        if(__builtin_expect(instance.config.stat, false))
-            ms = ffTimeGetTick();
-
         yyjson_val* module = item;
         const char* type = yyjson_get_str(module);
         if (type)
@@ -255,23 +146,24 @@ static const char* printJsonConfig(void)
         else
             return "modules must be an array of strings or objects";
 
-        if(!parseModuleJsonObject(type, module))
-            return "Unknown module type";
+        FFJsonModuleEntry* entry = (FFJsonModuleEntry*) ffListAdd(&entries);
+        entry->type = type;
+        entry->module = module;
+    }
 
-        if(__builtin_expect(instance.config.stat, false))
+    if (instance.config.outputFormat == FF_OUTPUT_FORMAT_JSON)
+    {
+        FF_LIST_AUTO_DESTROY types = ffListCreate(sizeof(const char*));
+        FF_LIST_AUTO_DESTROY objects = ffListCreate(sizeof(yyjson_val*));
+        FF_LIST_FOR_EACH(FFJsonModuleEntry, entry, entries)
         {
-            char str[32];
-            int len = snprintf(str, sizeof str, "%" PRIu64 "ms", ffTimeGetTick() - ms);
-            if(instance.config.pipe)
-                puts(str);
-            else
-                printf("\033[s\033[1A\033[9999999C\033[%dD%s\033[u", len, str); // Save; Up 1; Right 9999999; Left <len>; Print <str>; Load
+            *(const char**) ffListAdd(&types) = entry->type;
+            *(yyjson_val**) ffListAdd(&objects) = entry->module;
         }
-
-        #if defined(_WIN32)
-        if (!instance.config.noBuffer) fflush(stdout);
-        #endif
+        ffPrintJsonResult(types.length, (const char* const*) types.data, (yyjson_val* const*) objects.data);
     }
+    else
+        ffWatchRun(entries.length, runJsonModuleJob, &entries, isJsonModuleJobDynamic);
 
     return NULL;
 }
@@ -300,6 +192,8 @@ const char* ffParseGeneralJsonConfig(void)
             config->allowSlowOperations = yyjson_get_bool(val);
         else if (ffStrEqualsIgnCase(key, "thread") || ffStrEqualsIgnCase(key, "multithreading"))
             config->multithreading = yyjson_get_bool(val);
+        else if (ffStrEqualsIgnCase(key, "cache"))
+            config->cache = yyjson_get_bool(val);
         else if (ffStrEqualsIgnCase(key, "stat"))
         {
             config->stat = yyjson_get_bool(val);
@@ -311,6 +205,21 @@ const char* ffParseGeneralJsonConfig(void)
             config->pipe = yyjson_get_bool(val);
         else if (ffStrEqualsIgnCase(key, "processingTimeout"))
             config->processingTimeout = (int32_t) yyjson_get_int(val);
+        else if (ffStrEqualsIgnCase(key, "watch"))
+            config->watchInterval = (uint32_t) yyjson_get_uint(val);
+        else if (ffStrEqualsIgnCase(key, "format"))
+        {
+            int value;
+            const char* error = ffJsonConfigParseEnum(val, &value, (FFKeyValuePair[]) {
+                { "default", FF_OUTPUT_FORMAT_DEFAULT },
+                { "json", FF_OUTPUT_FORMAT_JSON },
+                {},
+            });
+            if (error) return error;
+            config->outputFormat = (FFOutputFormat) value;
+        }
+        else if (ffStrEqualsIgnCase(key, "root"))
+            ffStrbufSetS(&config->root, yyjson_get_str(val));
 
         #if defined(__linux__) || defined(__FreeBSD__)
         else if (ffStrEqualsIgnCase(key, "playerName"))
@@ -494,6 +403,21 @@ const char* ffParseLibraryJsonConfig(void)
     return NULL;
 }
 
+bool ffJsonConfigHasModule(const char* type)
+{
+    yyjson_val* modules = yyjson_obj_get(yyjson_doc_get_root(instance.state.configDoc), "modules");
+
+    yyjson_val* item;
+    size_t idx, max;
+    yyjson_arr_foreach(modules, idx, max, item)
+    {
+        const char* itemType = yyjson_is_obj(item) ? yyjson_get_str(yyjson_obj_get(item, "type")) : yyjson_get_str(item);
+        if (itemType && ffStrEqualsIgnCase(itemType, type))
+            return true;
+    }
+    return false;
+}
+
 void ffPrintJsonConfig(void)
 {
     const char* error = printJsonConfig();
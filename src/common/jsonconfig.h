@@ -5,6 +5,8 @@
 bool ffJsonConfigParseModuleArgs(const char* key, yyjson_val* val, FFModuleArgs* moduleArgs);
 const char* ffJsonConfigParseEnum(yyjson_val* val, int* result, FFKeyValuePair pairs[]);
 void ffPrintJsonConfig();
+// Returns true if the `modules` array contains a module of the given type
+bool ffJsonConfigHasModule(const char* type);
 const char* ffParseGeneralJsonConfig();
 const char* ffParseDisplayJsonConfig();
 const char* ffParseLibraryJsonConfig();
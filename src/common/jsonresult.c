@@ -0,0 +1,106 @@
+#include "fastfetch.h"
+#include "common/jsonresult.h"
+#include "common/scheduler.h"
+#include "modules/modules.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct FFJsonResultEntry
+{
+    const char* type;
+    const FFModuleInfo* info; // NULL if unknown
+    void* options; // Global options, or a copy allocated for a module object of the JSON config
+    void* result; // Allocated with info->resultSize if the module has detect
+    const char* error;
+} FFJsonResultEntry;
+
+static void detectJob(void* data, uint32_t index)
+{
+    FFJsonResultEntry* entry = (FFJsonResultEntry*) data + index;
+    if(!entry->info || !entry->info->detect)
+        return;
+
+    entry->result = calloc(1, entry->info->resultSize);
+    entry->error = entry->info->detect(entry->options, entry->result);
+}
+
+static void generateEntry(yyjson_mut_doc* doc, yyjson_mut_val* module, const FFJsonResultEntry* entry)
+{
+    if(!entry->info)
+    {
+        yyjson_mut_obj_add_strcpy(doc, module, "type", entry->type);
+        yyjson_mut_obj_add_str(doc, module, "error", "Unknown module");
+        return;
+    }
+
+    yyjson_mut_obj_add_str(doc, module, "type", entry->info->name);
+
+    if(!entry->info->generateJson)
+        yyjson_mut_obj_add_str(doc, module, "error", "Unsupported for JSON format");
+    else if(entry->error)
+        yyjson_mut_obj_add_strcpy(doc, module, "error", entry->error);
+    else
+        entry->info->generateJson(entry->options, entry->result, doc, module);
+}
+
+void ffPrintJsonResult(uint32_t count, const char* const* types, yyjson_val* const* modules)
+{
+    FFJsonResultEntry* entries = calloc(count, sizeof(*entries));
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        FFJsonResultEntry* entry = &entries[i];
+        entry->type = types[i];
+        entry->info = ffFindModuleInfo(types[i], (uint32_t) strlen(types[i]));
+        if(!entry->info)
+            continue;
+
+        entry->options = entry->info->options;
+        if(modules && modules[i] && entry->info->options)
+        {
+            // Parsed here, not in the worker threads, so that errors about unknown keys are printed in order
+            entry->options = malloc(entry->info->optionsSize);
+            entry->info->initOptions(entry->options);
+            entry->info->parseJsonObject(entry->options, modules[i]);
+        }
+    }
+
+    ffSchedulerRun(count, detectJob, entries);
+
+    yyjson_mut_doc* doc = yyjson_mut_doc_new(NULL);
+    yyjson_mut_val* root = yyjson_mut_arr(doc);
+    yyjson_mut_doc_set_root(doc, root);
+
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        FFJsonResultEntry* entry = &entries[i];
+        generateEntry(doc, yyjson_mut_arr_add_obj(doc, root), entry);
+
+        if(entry->result)
+        {
+            if(entry->info->destroyResult)
+                entry->info->destroyResult(entry->result);
+            free(entry->result);
+        }
+
+        if(entry->options != NULL && entry->options != entry->info->options)
+        {
+            entry->info->destroyOptions(entry->options);
+            free(entry->options);
+        }
+    }
+    free(entries);
+
+    size_t length;
+    char* json = yyjson_mut_write(doc, YYJSON_WRITE_PRETTY, &length);
+    yyjson_mut_doc_free(doc);
+    if(!json)
+    {
+        fputs("Error: failed to generate JSON output\n", stderr);
+        return;
+    }
+
+    json[length] = '\n'; // Overwrites the terminating NUL
+    fwrite(json, 1, length + 1, stdout);
+    free(json);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#ifndef FF_INCLUDED_common_jsonresult
+#define FF_INCLUDED_common_jsonresult
+
+#include "fastfetch.h"
+
+#include <math.h>
+
+// `--format json`: instead of the logo and a line per module, print one JSON array with an object per module:
+// `{ "type": "<module>", "result": ... }`, or `{ "type": "<module>", "error": "<message>" }` if detection failed.
+// Results are typed: numbers are numbers, lists are arrays. Modules are detected concurrently (with multithreading);
+// the document is built with yyjson_mut and written at once. See FFModuleInfo::generateJson for the result of a module.
+
+// `types` are module names, as given in the structure or the `modules` array of the JSON config.
+// `modules` are the module objects of the JSON config (an element is NULL for a plain module name), or NULL.
+// A module with an object is detected with its own copy of the options, the others with the global ones
+void ffPrintJsonResult(uint32_t count, const char* const* types, yyjson_val* const* modules);
+
+// Adds an empty object / array as `key` of `obj`, usually "result" of the module
+static inline yyjson_mut_val* ffJsonResultAddObj(yyjson_mut_doc* doc, yyjson_mut_val* obj, const char* key)
+{
+    yyjson_mut_val* val = yyjson_mut_obj(doc);
+    yyjson_mut_obj_add_val(doc, obj, key, val);
+    return val;
+}
+
+static inline yyjson_mut_val* ffJsonResultAddArr(yyjson_mut_doc* doc, yyjson_mut_val* obj, const char* key)
+{
+    yyjson_mut_val* val = yyjson_mut_arr(doc);
+    yyjson_mut_obj_add_val(doc, obj, key, val);
+    return val;
+}
+
+// Strings are copied; results are destroyed before the document is written
+static inline void ffJsonResultAddStrbuf(yyjson_mut_doc* doc, yyjson_mut_val* obj, const char* key, const FFstrbuf* value)
+{
+    yyjson_mut_obj_add_strncpy(doc, obj, key, value->chars, value->length);
+}
+
+static inline void ffJsonResultAppendStrbuf(yyjson_mut_doc* doc, yyjson_mut_val* arr, const FFstrbuf* value)
+{
+    yyjson_mut_arr_append(arr, yyjson_mut_strncpy(doc, value->chars, value->length));
+}
+
+// NaN (e.g. FF_CPU_TEMP_UNSET) is written as null
+static inline void ffJsonResultAddDouble(yyjson_mut_doc* doc, yyjson_mut_val* obj, const char* key, double value)
+{
+    if(isnan(value))
+        yyjson_mut_obj_add_null(doc, obj, key);
+    else
+        yyjson_mut_obj_add_real(doc, obj, key, value);
+}
+
+#endif
@@ -14,25 +14,31 @@ typedef struct FFNetworkingState {
     #ifdef _WIN32
         uintptr_t sockfd;
         OVERLAPPED overlapped;
+        uint32_t timeout;
     #else
-        int sockfd;
+        // Owned by the client until `finished` is set
         FFstrbuf host;
         FFstrbuf command;
-
-        #ifdef FF_HAVE_THREADS
-            FFThreadType thread;
-        #endif
+        FFstrbuf response;
+        uint64_t deadline;
+        bool finished;
+        bool success;
     #endif
 } FFNetworkingState;
 
-bool ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* host, const char* path, const char* headers);
-bool ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buffer, uint32_t timeout);
+// Starts a GET request, which runs in the background together with all other requests.
+// `host` may contain a port ("example.com:8080", "[::1]:8080"; not on Windows).
+// `timeout` (in ms, 0 for none) limits the whole request, from resolving the host to receiving the last byte
+bool ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* host, const char* path, const char* headers, uint32_t timeout);
+// Waits for the request to finish, and appends the status line, the headers and the (dechunked) body to `buffer`.
+// Returns true if the status is 200
+bool ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buffer);
 
 static inline bool ffNetworkingGetHttp(const char* host, const char* path, uint32_t timeout, const char* headers, FFstrbuf* buffer)
 {
     FFNetworkingState state;
-    if(ffNetworkingSendHttpRequest(&state, host, path, headers))
-        return ffNetworkingRecvHttpResponse(&state, buffer, timeout);
+    if(ffNetworkingSendHttpRequest(&state, host, path, headers, timeout))
+        return ffNetworkingRecvHttpResponse(&state, buffer);
     return false;
 }
 
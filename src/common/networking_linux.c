@@ -1,103 +1,866 @@
 #include "fastfetch.h"
 #include "common/networking.h"
+#include "common/time.h"
+#include "util/FFlist.h"
+#include "util/stringUtils.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
-#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
-#include <netdb.h>
 
-static void connectAndSend(FFNetworkingState* state)
+#ifndef MSG_NOSIGNAL
+    #define MSG_NOSIGNAL 0 // Apple platforms use SO_NOSIGPIPE instead
+#endif
+
+// All requests are run by one event loop. It runs on a background thread, started by the first request and exiting once
+// there is nothing left to do. Connections are made with Happy Eyeballs (RFC 8305) and kept alive for later requests to the same host.
+
+// Delay before starting a connection attempt to the next address, while the previous attempts are still pending
+#define FF_HTTP_CONNECTION_ATTEMPT_DELAY 250
+#define FF_HTTP_MAX_ATTEMPTS 4
+
+typedef struct FFHttpResolveJob
+{
+    FFstrbuf host;
+    FFstrbuf port;
+    struct addrinfo* addrs;
+    bool finished;
+    bool abandoned; // The connection is gone; whoever sees the other flag set frees the job
+} FFHttpResolveJob;
+
+typedef enum FFHttpPhase
+{
+    FF_HTTP_PHASE_RESOLVING,
+    FF_HTTP_PHASE_CONNECTING,
+    FF_HTTP_PHASE_SENDING,
+    FF_HTTP_PHASE_RECEIVING,
+    FF_HTTP_PHASE_IDLE,
+} FFHttpPhase;
+
+typedef enum FFHttpBodyType
+{
+    FF_HTTP_BODY_LENGTH,
+    FF_HTTP_BODY_CHUNKED,
+    FF_HTTP_BODY_UNTIL_CLOSE,
+} FFHttpBodyType;
+
+typedef enum FFHttpChunkState
+{
+    FF_HTTP_CHUNK_SIZE,
+    FF_HTTP_CHUNK_DATA,
+    FF_HTTP_CHUNK_DATA_END,
+    FF_HTTP_CHUNK_TRAILER,
+} FFHttpChunkState;
+
+typedef struct FFHttpConnection
+{
+    FFstrbuf host; // As requested, including the port
+    FFHttpPhase phase;
+    int fd;
+
+    FFHttpResolveJob* resolve;
+    struct addrinfo* addrs;
+    FFlist candidates; // struct addrinfo*, interleaved by address family
+    uint32_t nextCandidate;
+    int attempts[FF_HTTP_MAX_ATTEMPTS];
+    uint64_t nextAttemptTick;
+    bool reused; // Connected for an earlier request; the server may have closed it meanwhile
+
+    FFNetworkingState* request;
+    uint32_t sent;
+    FFstrbuf input;
+    uint32_t inputPos;
+    bool headerDone;
+    bool keepAlive;
+    FFHttpBodyType bodyType;
+    FFHttpChunkState chunkState;
+    uint64_t remaining;
+} FFHttpConnection;
+
+static struct
+{
+    FFThreadMutex mutex;
+    #ifdef FF_HAVE_THREADS
+        FFThreadCond cond;
+    #endif
+    bool running; // Some thread is running the event loop
+    FFlist pending; // FFNetworkingState*
+    FFlist connections; // FFHttpConnection*, owned by the event loop
+    int wakeFds[2];
+    bool init;
+} client = {
+    .mutex = FF_THREAD_MUTEX_INITIALIZER,
+    #ifdef FF_HAVE_THREADS
+        .cond = FF_THREAD_COND_INITIALIZER,
+    #endif
+    .wakeFds = { -1, -1 },
+};
+
+static void wakeEventLoop(void)
+{
+    if(client.wakeFds[1] >= 0)
+    {
+        ssize_t written = write(client.wakeFds[1], "", 1);
+        FF_UNUSED(written);
+    }
+}
+
+static void setNonBlocking(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
+// Splits "host", "host:port", "[v6]" and "[v6]:port"
+static void splitHostPort(const FFstrbuf* hostPort, FFstrbuf* host, FFstrbuf* port)
+{
+    ffStrbufSet(host, hostPort);
+    ffStrbufSetS(port, "80");
+
+    uint32_t colon = ffStrbufLastIndexC(host, ':');
+    if(ffStrbufStartsWithC(host, '['))
+    {
+        uint32_t bracket = ffStrbufFirstIndexC(host, ']');
+        if(bracket < host->length && colon == bracket + 1)
+            ffStrbufSetS(port, host->chars + colon + 1);
+        ffStrbufSubstrBefore(host, bracket);
+        ffStrbufSubstrAfter(host, 0);
+    }
+    else if(colon < host->length && colon == ffStrbufFirstIndexC(host, ':'))
+    {
+        ffStrbufSetS(port, host->chars + colon + 1);
+        ffStrbufSubstrBefore(host, colon);
+    }
+}
+
+static void resolve(FFHttpResolveJob* job)
 {
     struct addrinfo hints = {
-        .ai_family = AF_INET,
+        .ai_family = AF_UNSPEC,
         .ai_socktype = SOCK_STREAM,
+        .ai_flags = AI_ADDRCONFIG,
     };
+    struct addrinfo* addrs = NULL;
+    if(getaddrinfo(job->host.chars, job->port.chars, &hints, &addrs) != 0)
+        addrs = NULL;
+
+    ffThreadMutexLock(&client.mutex);
+    bool abandoned = job->abandoned;
+    job->addrs = addrs;
+    job->finished = true;
+    ffThreadMutexUnlock(&client.mutex);
+
+    if(abandoned)
+    {
+        if(addrs)
+            freeaddrinfo(addrs);
+        ffStrbufDestroy(&job->host);
+        ffStrbufDestroy(&job->port);
+        free(job);
+    }
+    else
+        wakeEventLoop();
+}
+
+FF_THREAD_ENTRY_DECL_WRAPPER(resolve, FFHttpResolveJob*)
+
+// getaddrinfo can't be cancelled or bounded. Run it on its own thread, so that the deadline applies to it too
+static void startResolving(FFHttpConnection* conn)
+{
+    FFHttpResolveJob* job = calloc(1, sizeof(*job));
+    ffStrbufInit(&job->host);
+    ffStrbufInit(&job->port);
+    splitHostPort(&conn->host, &job->host, &job->port);
+    conn->resolve = job;
+    conn->phase = FF_HTTP_PHASE_RESOLVING;
+
+    #ifdef FF_HAVE_THREADS
+        FFThreadType thread = ffThreadCreate(resolveThreadMain, job);
+        if(thread)
+        {
+            ffThreadDetach(thread);
+            return;
+        }
+    #endif
 
-    struct addrinfo* addr;
+    resolve(job);
+}
+
+static void releaseResolveJob(FFHttpConnection* conn)
+{
+    FFHttpResolveJob* job = conn->resolve;
+    if(!job)
+        return;
+    conn->resolve = NULL;
 
-    if(getaddrinfo(state->host.chars, "80", &hints, &addr) != 0)
-        goto error;
+    ffThreadMutexLock(&client.mutex);
+    bool finished = job->finished;
+    job->abandoned = true;
+    ffThreadMutexUnlock(&client.mutex);
 
-    state->sockfd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
-    if(state->sockfd == -1)
+    if(finished)
     {
-        freeaddrinfo(addr);
-        goto error;
+        if(job->addrs)
+            freeaddrinfo(job->addrs);
+        ffStrbufDestroy(&job->host);
+        ffStrbufDestroy(&job->port);
+        free(job);
     }
+}
 
-    if(connect(state->sockfd, addr->ai_addr, addr->ai_addrlen) == -1)
+static void closeAttempts(FFHttpConnection* conn)
+{
+    for(uint32_t i = 0; i < FF_HTTP_MAX_ATTEMPTS; ++i)
     {
-        close(state->sockfd);
-        freeaddrinfo(addr);
-        goto error;
+        if(conn->attempts[i] >= 0)
+        {
+            close(conn->attempts[i]);
+            conn->attempts[i] = -1;
+        }
     }
+}
 
-    freeaddrinfo(addr);
+static void destroyConnection(FFHttpConnection* conn)
+{
+    releaseResolveJob(conn);
+    closeAttempts(conn);
+    if(conn->fd >= 0)
+        close(conn->fd);
+    if(conn->addrs)
+        freeaddrinfo(conn->addrs);
+    ffListDestroy(&conn->candidates);
+    ffStrbufDestroy(&conn->host);
+    ffStrbufDestroy(&conn->input);
+    free(conn);
+}
+
+static void finishRequest(FFHttpConnection* conn, bool success)
+{
+    FFNetworkingState* request = conn->request;
+    conn->request = NULL;
 
-    if(send(state->sockfd, state->command.chars, state->command.length, 0) < 0)
+    ffThreadMutexLock(&client.mutex);
+    request->success = success;
+    request->finished = true;
+    #ifdef FF_HAVE_THREADS
+        ffThreadCondBroadcast(&client.cond);
+    #endif
+    ffThreadMutexUnlock(&client.mutex);
+}
+
+// Starts a connection attempt to the next candidate. Returns false if there are none left
+static bool startAttempt(FFHttpConnection* conn, uint64_t now)
+{
+    uint32_t slot = 0;
+    while(slot < FF_HTTP_MAX_ATTEMPTS && conn->attempts[slot] >= 0)
+        ++slot;
+
+    while(slot < FF_HTTP_MAX_ATTEMPTS && conn->nextCandidate < conn->candidates.length)
     {
-        close(state->sockfd);
-        goto error;
+        const struct addrinfo* addr = *(struct addrinfo**) ffListGet(&conn->candidates, conn->nextCandidate++);
+
+        int fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+        if(fd < 0)
+            continue;
+        setNonBlocking(fd);
+
+        if(connect(fd, addr->ai_addr, addr->ai_addrlen) == 0 || errno == EINPROGRESS)
+        {
+            conn->attempts[slot] = fd;
+            conn->nextAttemptTick = now + FF_HTTP_CONNECTION_ATTEMPT_DELAY;
+            return true;
+        }
+        close(fd);
     }
 
-    goto exit;
+    return false;
+}
 
-error:
-    state->sockfd = -1;
+static bool hasAttempts(const FFHttpConnection* conn)
+{
+    for(uint32_t i = 0; i < FF_HTTP_MAX_ATTEMPTS; ++i)
+    {
+        if(conn->attempts[i] >= 0)
+            return true;
+    }
+    return false;
+}
 
-exit:
-    ffStrbufDestroy(&state->host);
-    ffStrbufDestroy(&state->command);
+static void startConnecting(FFHttpConnection* conn, uint64_t now)
+{
+    conn->phase = FF_HTTP_PHASE_CONNECTING;
+    conn->nextCandidate = 0;
+    if(!startAttempt(conn, now))
+        finishRequest(conn, false);
 }
 
-FF_THREAD_ENTRY_DECL_WRAPPER(connectAndSend, FFNetworkingState*);
+// Takes the addresses of a finished resolve job. They are ordered like RFC 8305 wants:
+// the preferred family first (as sorted by getaddrinfo), then alternating between IPv6 and IPv4
+static void takeAddresses(FFHttpConnection* conn, uint64_t now)
+{
+    conn->addrs = conn->resolve->addrs;
+    conn->resolve->addrs = NULL;
+    releaseResolveJob(conn);
 
-bool ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* host, const char* path, const char* headers)
+    if(!conn->addrs)
+    {
+        finishRequest(conn, false);
+        return;
+    }
+
+    FF_LIST_AUTO_DESTROY first = ffListCreate(sizeof(struct addrinfo*));
+    FF_LIST_AUTO_DESTROY second = ffListCreate(sizeof(struct addrinfo*));
+    for(struct addrinfo* addr = conn->addrs; addr; addr = addr->ai_next)
+        *(struct addrinfo**) ffListAdd(addr->ai_family == conn->addrs->ai_family ? &first : &second) = addr;
+
+    for(uint32_t i = 0; i < first.length || i < second.length; ++i)
+    {
+        if(i < first.length)
+            *(struct addrinfo**) ffListAdd(&conn->candidates) = *(struct addrinfo**) ffListGet(&first, i);
+        if(i < second.length)
+            *(struct addrinfo**) ffListAdd(&conn->candidates) = *(struct addrinfo**) ffListGet(&second, i);
+    }
+
+    startConnecting(conn, now);
+}
+
+static void startSending(FFHttpConnection* conn)
+{
+    conn->phase = FF_HTTP_PHASE_SENDING;
+    conn->sent = 0;
+    ffStrbufClear(&conn->input);
+    conn->inputPos = 0;
+    conn->headerDone = false;
+}
+
+static void onAttemptWritable(FFHttpConnection* conn, uint32_t slot, uint64_t now)
+{
+    int fd = conn->attempts[slot];
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if(getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0)
+    {
+        close(fd);
+        conn->attempts[slot] = -1;
+
+        // Don't wait for the delay when an attempt failed
+        if(!startAttempt(conn, now) && !hasAttempts(conn))
+            finishRequest(conn, false);
+        return;
+    }
+
+    // The winner. Cancel all other attempts
+    conn->attempts[slot] = -1;
+    closeAttempts(conn);
+    conn->fd = fd;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &(int) { 1 }, sizeof(int));
+    #ifdef SO_NOSIGPIPE
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &(int) { 1 }, sizeof(int));
+    #endif
+    conn->reused = false;
+    startSending(conn);
+}
+
+static void parseHeaders(FFHttpConnection* conn, const char* headers, uint32_t length)
+{
+    conn->keepAlive = ffStrStartsWith(headers, "HTTP/1.1 ");
+    conn->bodyType = FF_HTTP_BODY_UNTIL_CLOSE;
+
+    // 1xx, 204 and 304 responses have no body
+    int status = length > 12 ? atoi(headers + 9) : 0;
+    if((status >= 100 && status < 200) || status == 204 || status == 304)
+    {
+        conn->bodyType = FF_HTTP_BODY_LENGTH;
+        conn->remaining = 0;
+    }
+
+    const char* end = headers + length;
+    for(const char* line = strstr(headers, "\r\n"); line && line + 2 < end; line = strstr(line + 2, "\r\n"))
+    {
+        const char* name = line + 2;
+        if(strncasecmp(name, "Content-Length:", strlen("Content-Length:")) == 0 && conn->bodyType == FF_HTTP_BODY_UNTIL_CLOSE)
+        {
+            conn->bodyType = FF_HTTP_BODY_LENGTH;
+            conn->remaining = strtoull(name + strlen("Content-Length:"), NULL, 10);
+        }
+        else if(strncasecmp(name, "Transfer-Encoding: chunked", strlen("Transfer-Encoding: chunked")) == 0)
+        {
+            conn->bodyType = FF_HTTP_BODY_CHUNKED;
+            conn->chunkState = FF_HTTP_CHUNK_SIZE;
+        }
+        else if(strncasecmp(name, "Connection:", strlen("Connection:")) == 0)
+        {
+            const char* value = name + strlen("Connection:");
+            while(*value == ' ')
+                ++value;
+            if(strncasecmp(value, "close", strlen("close")) == 0)
+                conn->keepAlive = false;
+            else if(strncasecmp(value, "keep-alive", strlen("keep-alive")) == 0)
+                conn->keepAlive = true;
+        }
+    }
+
+    if(conn->bodyType == FF_HTTP_BODY_UNTIL_CLOSE)
+        conn->keepAlive = false;
+}
+
+// Moves the received bytes to the response. Returns true once it is complete
+static bool parseResponse(FFHttpConnection* conn, bool eof, bool* error)
+{
+    FFstrbuf* input = &conn->input;
+    FFstrbuf* response = &conn->request->response;
+
+    if(!conn->headerDone)
+    {
+        uint32_t end = ffStrbufFirstIndexS(input, "\r\n\r\n");
+        if(end == input->length)
+        {
+            *error = eof;
+            return eof;
+        }
+
+        end += 4;
+        ffStrbufAppendNS(response, end, input->chars);
+        parseHeaders(conn, input->chars, end);
+        conn->inputPos = end;
+        conn->headerDone = true;
+    }
+
+    while(true)
+    {
+        const char* data = input->chars + conn->inputPos;
+        uint32_t available = input->length - conn->inputPos;
+
+        switch(conn->bodyType)
+        {
+            case FF_HTTP_BODY_UNTIL_CLOSE:
+                ffStrbufAppendNS(response, available, data);
+                conn->inputPos += available;
+                return eof;
+
+            case FF_HTTP_BODY_LENGTH: {
+                uint32_t length = available < conn->remaining ? available : (uint32_t) conn->remaining;
+                ffStrbufAppendNS(response, length, data);
+                conn->inputPos += length;
+                conn->remaining -= length;
+                *error = eof && conn->remaining > 0;
+                return conn->remaining == 0 || eof;
+            }
+
+            case FF_HTTP_BODY_CHUNKED: {
+                if(conn->chunkState == FF_HTTP_CHUNK_DATA)
+                {
+                    uint32_t length = available < conn->remaining ? available : (uint32_t) conn->remaining;
+                    ffStrbufAppendNS(response, length, data);
+                    conn->inputPos += length;
+                    conn->remaining -= length;
+                    if(conn->remaining > 0)
+                        break;
+                    conn->chunkState = FF_HTTP_CHUNK_DATA_END;
+                    continue;
+                }
+
+                // The other states consume a whole line
+                const char* lineEnd = memchr(data, '\n', available);
+                if(!lineEnd)
+                    break;
+                conn->inputPos += (uint32_t) (lineEnd - data) + 1;
+
+                if(conn->chunkState == FF_HTTP_CHUNK_SIZE)
+                {
+                    char* sizeEnd;
+                    conn->remaining = strtoull(data, &sizeEnd, 16);
+                    if(sizeEnd == data)
+                    {
+                        *error = true;
+                        return true;
+                    }
+                    conn->chunkState = conn->remaining == 0 ? FF_HTTP_CHUNK_TRAILER : FF_HTTP_CHUNK_DATA;
+                }
+                else if(conn->chunkState == FF_HTTP_CHUNK_DATA_END)
+                    conn->chunkState = FF_HTTP_CHUNK_SIZE;
+                else if(lineEnd - data <= 1) // Empty line ending the trailer
+                    return true;
+                continue;
+            }
+        }
+
+        // Need more data
+        *error = eof;
+        return eof;
+    }
+}
+
+static void onReadable(FFHttpConnection* conn)
+{
+    bool eof = false;
+    while(true)
+    {
+        ffStrbufEnsureFree(&conn->input, 4096);
+        ssize_t received = recv(conn->fd, conn->input.chars + conn->input.length, ffStrbufGetFree(&conn->input), 0);
+        if(received > 0)
+        {
+            conn->input.length += (uint32_t) received;
+            conn->input.chars[conn->input.length] = '\0';
+        }
+        else if(received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+        {
+            eof = true;
+            break;
+        }
+        else if(errno != EINTR)
+            break;
+    }
+
+    if(eof && conn->input.length == 0 && conn->reused)
+    {
+        // The server closed the kept alive connection before we used it. Connect again
+        close(conn->fd);
+        conn->fd = -1;
+        startConnecting(conn, ffTimeGetTick());
+        return;
+    }
+
+    bool error = false;
+    if(!parseResponse(conn, eof, &error))
+        return;
+
+    const FFstrbuf* response = &conn->request->response;
+    bool success = !error && ffStrbufStartsWithS(response, "HTTP/1.") && response->length > 12 && memcmp(response->chars + 8, " 200", 4) == 0;
+    finishRequest(conn, success);
+
+    if(conn->keepAlive && !eof && !error)
+        conn->phase = FF_HTTP_PHASE_IDLE;
+    else
+    {
+        close(conn->fd);
+        conn->fd = -1;
+    }
+}
+
+static void onWritable(FFHttpConnection* conn)
+{
+    const FFstrbuf* command = &conn->request->command;
+    while(conn->sent < command->length)
+    {
+        ssize_t sent = send(conn->fd, command->chars + conn->sent, command->length - conn->sent, MSG_NOSIGNAL);
+        if(sent > 0)
+            conn->sent += (uint32_t) sent;
+        else if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return;
+        else if(conn->reused)
+        {
+            close(conn->fd);
+            conn->fd = -1;
+            startConnecting(conn, ffTimeGetTick());
+            return;
+        }
+        else
+        {
+            finishRequest(conn, false);
+            return;
+        }
+    }
+
+    conn->phase = FF_HTTP_PHASE_RECEIVING;
+}
+
+// Assigns the new requests to kept alive connections, or to new ones
+static void takePendingRequests(void)
+{
+    ffThreadMutexLock(&client.mutex);
+    FFlist pending = client.pending;
+    ffListInit(&client.pending, sizeof(FFNetworkingState*));
+    ffThreadMutexUnlock(&client.mutex);
+
+    FF_LIST_FOR_EACH(FFNetworkingState*, pRequest, pending)
+    {
+        FFNetworkingState* request = *pRequest;
+
+        FFHttpConnection* conn = NULL;
+        FF_LIST_FOR_EACH(FFHttpConnection*, pConn, client.connections)
+        {
+            if((*pConn)->phase == FF_HTTP_PHASE_IDLE && ffStrbufEqual(&(*pConn)->host, &request->host))
+            {
+                conn = *pConn;
+                break;
+            }
+        }
+
+        if(conn)
+        {
+            conn->request = request;
+            conn->reused = true;
+            startSending(conn);
+            continue;
+        }
+
+        conn = calloc(1, sizeof(*conn));
+        ffStrbufInitCopy(&conn->host, &request->host);
+        ffStrbufInit(&conn->input);
+        ffListInit(&conn->candidates, sizeof(struct addrinfo*));
+        conn->fd = -1;
+        for(uint32_t i = 0; i < FF_HTTP_MAX_ATTEMPTS; ++i)
+            conn->attempts[i] = -1;
+        conn->request = request;
+        *(FFHttpConnection**) ffListAdd(&client.connections) = conn;
+        startResolving(conn);
+    }
+
+    ffListDestroy(&pending);
+}
+
+// Advances the connections that are waiting for something other than their sockets. Returns the time to wait at most
+static int updateConnections(uint64_t now)
+{
+    uint64_t wakeup = UINT64_MAX;
+
+    for(uint32_t i = 0; i < client.connections.length; ++i)
+    {
+        FFHttpConnection* conn = *(FFHttpConnection**) ffListGet(&client.connections, i);
+
+        if(conn->request && conn->request->deadline > 0 && now >= conn->request->deadline)
+        {
+            finishRequest(conn, false);
+            if(conn->fd >= 0)
+            {
+                close(conn->fd);
+                conn->fd = -1;
+            }
+        }
+
+        if(conn->request && conn->phase == FF_HTTP_PHASE_RESOLVING)
+        {
+            ffThreadMutexLock(&client.mutex);
+            bool finished = conn->resolve->finished;
+            ffThreadMutexUnlock(&client.mutex);
+            if(finished)
+                takeAddresses(conn, now);
+        }
+
+        if(conn->request && conn->phase == FF_HTTP_PHASE_CONNECTING && now >= conn->nextAttemptTick)
+        {
+            if(!startAttempt(conn, now) && !hasAttempts(conn))
+                finishRequest(conn, false);
+        }
+
+        // Connections without a request are only worth keeping while they are connected and idle
+        if(!conn->request && (conn->phase != FF_HTTP_PHASE_IDLE || conn->fd < 0))
+        {
+            destroyConnection(conn);
+            memmove(ffListGet(&client.connections, i), ffListGet(&client.connections, i + 1), (client.connections.length - i - 1) * sizeof(conn));
+            --client.connections.length;
+            --i;
+            continue;
+        }
+
+        if(conn->request)
+        {
+            if(conn->request->deadline > 0 && conn->request->deadline < wakeup)
+                wakeup = conn->request->deadline;
+            if(conn->phase == FF_HTTP_PHASE_CONNECTING && conn->nextCandidate < conn->candidates.length && conn->nextAttemptTick < wakeup)
+                wakeup = conn->nextAttemptTick;
+        }
+    }
+
+    if(wakeup == UINT64_MAX)
+        return -1;
+    return wakeup > now ? (int) (wakeup - now) : 0;
+}
+
+static bool hasWork(void)
+{
+    if(client.pending.length > 0)
+        return true;
+    FF_LIST_FOR_EACH(FFHttpConnection*, pConn, client.connections)
+    {
+        if((*pConn)->request)
+            return true;
+    }
+    return false;
+}
+
+typedef struct FFHttpPollTarget
+{
+    FFHttpConnection* conn;
+    int32_t slot; // Index into `attempts`, or -1 for `fd`
+} FFHttpPollTarget;
+
+static void runEventLoop(void)
+{
+    FF_LIST_AUTO_DESTROY pollFds = ffListCreate(sizeof(struct pollfd));
+    FF_LIST_AUTO_DESTROY targets = ffListCreate(sizeof(FFHttpPollTarget));
+
+    while(true)
+    {
+        char drain[64];
+        while(read(client.wakeFds[0], drain, sizeof(drain)) > 0);
+
+        uint64_t now = ffTimeGetTick();
+        takePendingRequests();
+        int timeout = updateConnections(now);
+
+        ffThreadMutexLock(&client.mutex);
+        if(!hasWork())
+        {
+            client.running = false;
+            #ifdef FF_HAVE_THREADS
+                ffThreadCondBroadcast(&client.cond);
+            #endif
+            ffThreadMutexUnlock(&client.mutex);
+            return;
+        }
+        ffThreadMutexUnlock(&client.mutex);
+
+        pollFds.length = 0;
+        targets.length = 0;
+        *(struct pollfd*) ffListAdd(&pollFds) = (struct pollfd) { .fd = client.wakeFds[0], .events = POLLIN };
+        *(FFHttpPollTarget*) ffListAdd(&targets) = (FFHttpPollTarget) { NULL, -1 };
+
+        FF_LIST_FOR_EACH(FFHttpConnection*, pConn, client.connections)
+        {
+            FFHttpConnection* conn = *pConn;
+            if(!conn->request)
+                continue;
+
+            if(conn->phase == FF_HTTP_PHASE_CONNECTING)
+            {
+                for(int32_t slot = 0; slot < FF_HTTP_MAX_ATTEMPTS; ++slot)
+                {
+                    if(conn->attempts[slot] < 0)
+                        continue;
+                    *(struct pollfd*) ffListAdd(&pollFds) = (struct pollfd) { .fd = conn->attempts[slot], .events = POLLOUT };
+                    *(FFHttpPollTarget*) ffListAdd(&targets) = (FFHttpPollTarget) { conn, slot };
+                }
+            }
+            else if(conn->phase == FF_HTTP_PHASE_SENDING || conn->phase == FF_HTTP_PHASE_RECEIVING)
+            {
+                *(struct pollfd*) ffListAdd(&pollFds) = (struct pollfd) {
+                    .fd = conn->fd,
+                    .events = conn->phase == FF_HTTP_PHASE_SENDING ? POLLOUT : POLLIN,
+                };
+                *(FFHttpPollTarget*) ffListAdd(&targets) = (FFHttpPollTarget) { conn, -1 };
+            }
+        }
+
+        if(poll((struct pollfd*) pollFds.data, pollFds.length, timeout) <= 0)
+            continue;
+
+        now = ffTimeGetTick();
+        for(uint32_t i = 1; i < pollFds.length; ++i)
+        {
+            const struct pollfd* pfd = ffListGet(&pollFds, i);
+            const FFHttpPollTarget* target = ffListGet(&targets, i);
+            FFHttpConnection* conn = target->conn;
+            if(!pfd->revents || !conn->request)
+                continue;
+
+            if(target->slot >= 0)
+            {
+                // An earlier attempt of the same connection may have won already
+                if(conn->phase == FF_HTTP_PHASE_CONNECTING && conn->attempts[target->slot] == pfd->fd)
+                    onAttemptWritable(conn, (uint32_t) target->slot, now);
+            }
+            else if(conn->fd != pfd->fd)
+                continue;
+            else if(conn->phase == FF_HTTP_PHASE_SENDING)
+                onWritable(conn);
+            else if(conn->phase == FF_HTTP_PHASE_RECEIVING)
+                onReadable(conn);
+        }
+    }
+}
+
+#ifdef FF_HAVE_THREADS
+FF_THREAD_ENTRY_DECL_WRAPPER_NOPARAM(runEventLoop)
+#endif
+
+bool ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* host, const char* path, const char* headers, uint32_t timeout)
 {
     ffStrbufInitS(&state->host, host);
+    ffStrbufInit(&state->response);
+    state->deadline = timeout > 0 ? ffTimeGetTick() + timeout : 0;
+    state->finished = false;
+    state->success = false;
 
     ffStrbufInitA(&state->command, 64);
     ffStrbufAppendS(&state->command, "GET ");
     ffStrbufAppendS(&state->command, path);
-    ffStrbufAppendS(&state->command, " HTTP/1.1\nHost: ");
+    ffStrbufAppendS(&state->command, " HTTP/1.1\r\nHost: ");
     ffStrbufAppendS(&state->command, host);
     ffStrbufAppendS(&state->command, "\r\n");
     ffStrbufAppendS(&state->command, headers);
     ffStrbufAppendS(&state->command, "\r\n");
 
-    #ifdef FF_HAVE_THREADS
-        state->thread = ffThreadCreate(connectAndSendThreadMain, state);
-        return !!state->thread;
-    #else
-        connectAndSend(state);
-        return state->sockfd != -1;
-    #endif
-}
+    ffThreadMutexLock(&client.mutex);
 
-bool ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buffer, uint32_t timeout)
-{
-    #ifdef FF_HAVE_THREADS
-        ffThreadJoin(state->thread);
-    #endif
-    if(state->sockfd == -1)
-        return false;
+    if(!client.init)
+    {
+        if(pipe(client.wakeFds) != 0)
+        {
+            ffThreadMutexUnlock(&client.mutex);
+            ffStrbufDestroy(&state->host);
+            ffStrbufDestroy(&state->command);
+            ffStrbufDestroy(&state->response);
+            return false;
+        }
+        setNonBlocking(client.wakeFds[0]);
+        setNonBlocking(client.wakeFds[1]);
+        ffListInit(&client.pending, sizeof(FFNetworkingState*));
+        ffListInit(&client.connections, sizeof(FFHttpConnection*));
+        client.init = true;
+    }
+
+    *(FFNetworkingState**) ffListAdd(&client.pending) = state;
 
-    if(timeout > 0)
+    if(client.running)
+        wakeEventLoop();
+    else
     {
-        struct timeval timev;
-        timev.tv_sec = 0;
-        timev.tv_usec = (__typeof__(timev.tv_usec)) (timeout * 1000); //milliseconds to microseconds
-        setsockopt(state->sockfd, SOL_SOCKET, SO_RCVTIMEO, &timev, sizeof(timev));
+        #ifdef FF_HAVE_THREADS
+            // Without a background thread, the loop runs in ffNetworkingRecvHttpResponse instead
+            FFThreadType thread = ffThreadCreate(runEventLoopThreadMain, NULL);
+            if(thread)
+            {
+                client.running = true;
+                ffThreadDetach(thread);
+            }
+        #endif
     }
 
-    ssize_t received = recv(state->sockfd, buffer->chars + buffer->length, ffStrbufGetFree(buffer), 0);
+    ffThreadMutexUnlock(&client.mutex);
+    return true;
+}
 
-    if(received > 0)
+bool ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buffer)
+{
+    ffThreadMutexLock(&client.mutex);
+    while(!state->finished)
     {
-        buffer->length += (uint32_t) received;
-        buffer->chars[buffer->length] = '\0';
+        if(!client.running)
+        {
+            client.running = true;
+            ffThreadMutexUnlock(&client.mutex);
+            runEventLoop();
+            ffThreadMutexLock(&client.mutex);
+        }
+        #ifdef FF_HAVE_THREADS
+        else
+            ffThreadCondWait(&client.cond, &client.mutex);
+        #endif
     }
+    ffThreadMutexUnlock(&client.mutex);
 
-    close(state->sockfd);
-    return ffStrbufStartsWithS(buffer, "HTTP/1.1 200 OK\r\n");
+    ffStrbufAppend(buffer, &state->response);
+    ffStrbufDestroy(&state->host);
+    ffStrbufDestroy(&state->command);
+    ffStrbufDestroy(&state->response);
+    return state->success;
 }
@@ -35,7 +35,7 @@ static BOOL WINAPI initWsaData(PINIT_ONCE once, PVOID param, PVOID* context)
     return closesocket(sockfd) == 0;
 }
 
-bool ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* host, const char* path, const char* headers)
+bool ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* host, const char* path, const char* headers, uint32_t timeout)
 {
     static INIT_ONCE once = INIT_ONCE_STATIC_INIT;
     WSADATA* pData;
@@ -43,6 +43,7 @@ bool ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* host, con
         return false;
 
     memset(state, 0, sizeof(*state));
+    state->timeout = timeout;
 
     struct addrinfo hints = {
         .ai_family = AF_INET,
@@ -78,7 +79,7 @@ bool ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* host, con
     FF_STRBUF_AUTO_DESTROY command = ffStrbufCreateA(64);
     ffStrbufAppendS(&command, "GET ");
     ffStrbufAppendS(&command, path);
-    ffStrbufAppendS(&command, " HTTP/1.1\nHost: ");
+    ffStrbufAppendS(&command, " HTTP/1.1\r\nHost: ");
     ffStrbufAppendS(&command, host);
     ffStrbufAppendS(&command, "\r\n");
     ffStrbufAppendS(&command, headers);
@@ -96,7 +97,7 @@ bool ffNetworkingSendHttpRequest(FFNetworkingState* state, const char* host, con
     return true;
 }
 
-bool ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buffer, uint32_t timeout)
+bool ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buffer)
 {
     DWORD transfer, flags;
     if (!WSAGetOverlappedResult(state->sockfd, &state->overlapped, &transfer, TRUE, &flags))
@@ -105,10 +106,10 @@ bool ffNetworkingRecvHttpResponse(FFNetworkingState* state, FFstrbuf* buffer, ui
         return false;
     }
 
-    if(timeout > 0)
+    if(state->timeout > 0)
     {
         //https://learn.microsoft.com/en-us/windows/win32/api/winsock2/nf-winsock2-setsockopt
-        setsockopt(state->sockfd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+        setsockopt(state->sockfd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&state->timeout, sizeof(state->timeout));
     }
 
     ssize_t received = recv(state->sockfd, buffer->chars + buffer->length, (int)ffStrbufGetFree(buffer), 0);
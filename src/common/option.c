@@ -31,6 +31,7 @@ bool ffOptionParseModuleArgs(const char* argumentKey, const char* subKey, const
     if(ffStrEqualsIgnCase(subKey, "key"))
     {
         ffOptionParseString(argumentKey, value, &result->key);
+        ffFormatProgramCompile(&result->keyProgram, &result->key);
         return true;
     }
     else if(ffStrEqualsIgnCase(subKey, "key-color"))
@@ -46,6 +47,12 @@ bool ffOptionParseModuleArgs(const char* argumentKey, const char* subKey, const
     else if(ffStrEqualsIgnCase(subKey, "format"))
     {
         ffOptionParseString(argumentKey, value, &result->outputFormat);
+        ffFormatProgramCompile(&result->outputFormatProgram, &result->outputFormat);
+        return true;
+    }
+    else if(ffStrEqualsIgnCase(subKey, "cache"))
+    {
+        result->cache = ffOptionParseBoolean(value);
         return true;
     }
     return false;
@@ -163,6 +170,9 @@ void ffOptionInitModuleArg(FFModuleArgs* args)
     ffStrbufInit(&args->key);
     ffStrbufInit(&args->keyColor);
     ffStrbufInit(&args->outputFormat);
+    args->cache = true;
+    ffFormatProgramInit(&args->keyProgram);
+    ffFormatProgramInit(&args->outputFormatProgram);
 }
 
 void ffOptionDestroyModuleArg(FFModuleArgs* args)
@@ -170,4 +180,6 @@ void ffOptionDestroyModuleArg(FFModuleArgs* args)
     ffStrbufDestroy(&args->key);
     ffStrbufDestroy(&args->keyColor);
     ffStrbufDestroy(&args->outputFormat);
+    ffFormatProgramDestroy(&args->keyProgram);
+    ffFormatProgramDestroy(&args->outputFormatProgram);
 }
@@ -1,12 +1,18 @@
 #pragma once
 
 #include "util/FFstrbuf.h"
+#include "common/format.h"
 
 typedef struct FFModuleArgs
 {
     FFstrbuf key;
     FFstrbuf keyColor;
     FFstrbuf outputFormat;
+    bool cache;
+
+    // `key` and `outputFormat`, compiled whenever ffOptionParseModuleArgs or ffJsonConfigParseModuleArgs sets them
+    FFformatProgram keyProgram;
+    FFformatProgram outputFormatProgram;
 } FFModuleArgs;
 
 typedef struct FFKeyValuePair
@@ -0,0 +1,255 @@
+#include "fastfetch.h"
+#include "common/output.h"
+#include "common/io/io.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__GLIBC__) || defined(__APPLE__) || defined(__FreeBSD__)
+
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+static struct
+{
+    FILE* original; // stdout before ffOutputInit; NULL if the output is not buffered
+    FILE* file;
+    FFstrbuf buffer; // Printed, not written yet
+    uint64_t writtenBytes;
+    uint32_t syscalls;
+} output;
+
+#ifdef __GLIBC__
+static ssize_t cookieWrite(FF_MAYBE_UNUSED void* cookie, const char* data, size_t length)
+{
+    ffStrbufAppendNS(&output.buffer, (uint32_t) length, data);
+    return (ssize_t) length;
+}
+#else
+static int cookieWrite(FF_MAYBE_UNUSED void* cookie, const char* data, int length)
+{
+    ffStrbufAppendNS(&output.buffer, (uint32_t) length, data);
+    return length;
+}
+#endif
+
+// Called with the stream locked
+static void writeBuffer(const char* data, uint32_t length)
+{
+    struct iovec iov[2] = {
+        { .iov_base = output.buffer.chars, .iov_len = output.buffer.length },
+        { .iov_base = (void*) data, .iov_len = length },
+    };
+    uint32_t first = iov[0].iov_len > 0 ? 0 : 1;
+    uint32_t end = iov[1].iov_len > 0 ? 2 : 1;
+
+    while(first < end)
+    {
+        ssize_t written = writev(STDOUT_FILENO, iov + first, (int) (end - first));
+        ++output.syscalls;
+        if(written < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            break; // The output is gone (e.g. EPIPE); drop it like stdio would
+        }
+
+        output.writtenBytes += (uint64_t) written;
+        for(; first < end && (size_t) written >= iov[first].iov_len; ++first)
+            written -= (ssize_t) iov[first].iov_len;
+        if(first < end)
+        {
+            iov[first].iov_base = (char*) iov[first].iov_base + written;
+            iov[first].iov_len -= (size_t) written;
+        }
+    }
+
+    ffStrbufClear(&output.buffer);
+}
+
+#ifdef FF_HAVE_THREADS
+
+#include <pthread.h>
+#include <time.h>
+
+static struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_t thread;
+    bool running;
+    bool stop;
+} frames = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .cond = PTHREAD_COND_INITIALIZER,
+};
+
+static void* frameThreadMain(FF_MAYBE_UNUSED void* data)
+{
+    pthread_mutex_lock(&frames.mutex);
+    while(!frames.stop)
+    {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += FF_OUTPUT_FRAME_MS * 1000000L;
+        if(deadline.tv_nsec >= 1000000000L)
+        {
+            ++deadline.tv_sec;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        if(pthread_cond_timedwait(&frames.cond, &frames.mutex, &deadline) == ETIMEDOUT && !frames.stop)
+        {
+            pthread_mutex_unlock(&frames.mutex);
+            ffOutputFlush();
+            pthread_mutex_lock(&frames.mutex);
+        }
+    }
+    pthread_mutex_unlock(&frames.mutex);
+    return NULL;
+}
+
+void ffOutputStartFrames(void)
+{
+    if(!output.original || frames.running)
+        return;
+
+    frames.stop = false;
+    frames.running = pthread_create(&frames.thread, NULL, frameThreadMain, NULL) == 0;
+}
+
+void ffOutputStopFrames(void)
+{
+    if(!frames.running)
+        return;
+
+    pthread_mutex_lock(&frames.mutex);
+    frames.stop = true;
+    pthread_cond_signal(&frames.cond);
+    pthread_mutex_unlock(&frames.mutex);
+    pthread_join(frames.thread, NULL);
+    frames.running = false;
+}
+
+#else
+
+void ffOutputStartFrames(void) {}
+void ffOutputStopFrames(void) {}
+
+#endif
+
+static void flushAtExit(void)
+{
+    // Runs before stdio flushes its streams; modules may call exit() while printing
+    ffOutputFlush();
+}
+
+void ffOutputInit(void)
+{
+    if(output.original || instance.config.noBuffer)
+        return;
+
+    #ifdef __GLIBC__
+        FILE* file = fopencookie(NULL, "w", (cookie_io_functions_t) { .write = cookieWrite });
+    #else
+        FILE* file = funopen(NULL, NULL, cookieWrite, NULL, NULL);
+    #endif
+    if(!file)
+        return;
+
+    // The buffer of the stream would only add a copy
+    setvbuf(file, NULL, _IONBF, 0);
+    fflush(stdout);
+
+    static bool atexitRegistered = false;
+    if(!atexitRegistered)
+        atexitRegistered = atexit(flushAtExit) == 0;
+
+    ffStrbufInitA(&output.buffer, 4096);
+    output.original = stdout;
+    output.file = file;
+    stdout = file;
+}
+
+void ffOutputDestroy(void)
+{
+    if(!output.original)
+        return;
+
+    ffOutputFlush();
+    stdout = output.original;
+    output.original = NULL;
+    fclose(output.file);
+    output.file = NULL;
+    ffStrbufDestroy(&output.buffer);
+}
+
+void ffOutputFlush(void)
+{
+    if(!output.original)
+    {
+        fflush(stdout);
+        return;
+    }
+
+    flockfile(output.file);
+    if(output.buffer.length > 0)
+        writeBuffer(NULL, 0);
+    funlockfile(output.file);
+}
+
+void ffOutputWrite(const char* data, uint32_t length)
+{
+    if(!output.original)
+    {
+        fflush(stdout);
+        ffWriteFDData(FFUnixFD2NativeFD(STDOUT_FILENO), length, data);
+        return;
+    }
+
+    flockfile(output.file);
+    writeBuffer(data, length);
+    funlockfile(output.file);
+}
+
+void ffOutputPrintStat(void)
+{
+    if(!output.original)
+        return;
+
+    // The line itself is written by the final flush
+    printf("Output: %" PRIu64 " bytes in %u write syscalls\n",
+        output.writtenBytes + output.buffer.length, output.syscalls + 1);
+}
+
+#else
+
+// Not supported. stdout is used as it is
+
+void ffOutputInit(void) {}
+
+void ffOutputDestroy(void)
+{
+    fflush(stdout);
+}
+
+void ffOutputFlush(void)
+{
+    fflush(stdout);
+}
+
+void ffOutputStartFrames(void) {}
+void ffOutputStopFrames(void) {}
+
+void ffOutputWrite(const char* data, uint32_t length)
+{
+    fflush(stdout);
+    ffWriteFDData(FFUnixFD2NativeFD(STDOUT_FILENO), length, data);
+}
+
+void ffOutputPrintStat(void) {}
+
+#endif
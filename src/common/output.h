@@ -0,0 +1,36 @@
+#pragma once
+
+#ifndef FF_INCLUDED_common_output
+#define FF_INCLUDED_common_output
+
+#include "fastfetch.h"
+
+// Between ffStart and ffDestroyInstance, stdout is replaced by an unbuffered stream that appends everything
+// printed (fputs, printf, putchar, ...) to one growing buffer in memory. Nothing reaches the file descriptor
+// until the buffer is written by a single writev: at the end of the run, and at frame boundaries in between:
+// every FF_OUTPUT_FRAME_MS while modules run on a terminal (see ffOutputStartFrames), after every --watch pass,
+// before the terminal is queried, and before file descriptors are redirected.
+// Requires fopencookie (glibc) or funopen (macOS, BSD). Elsewhere, and with --no-buffer, stdio is used as before.
+
+#define FF_OUTPUT_FRAME_MS 16
+
+void ffOutputInit(void);
+// Writes what is left and restores stdout
+void ffOutputDestroy(void);
+
+// Writes everything printed so far. Use it instead of fflush(stdout) where the output must have reached the fd
+void ffOutputFlush(void);
+
+// Writes everything printed so far followed by `data` (e.g. an image logo), without copying it into the buffer
+void ffOutputWrite(const char* data, uint32_t length);
+
+// Progressive mode: until ffOutputStopFrames, a thread writes what has been printed once per frame, if anything.
+// Lines of fast modules show up while a slow one is still running. Without thread support, output is written at the end
+void ffOutputStartFrames(void);
+void ffOutputStopFrames(void);
+
+// For `--stat`: prints the number of bytes and write syscalls of the whole output, counting the final flush.
+// Prints nothing if the output is not buffered
+void ffOutputPrintStat(void);
+
+#endif
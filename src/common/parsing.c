@@ -2,7 +2,6 @@
 #include "common/parsing.h"
 
 #include <ctype.h>
-#include <inttypes.h>
 
 #ifdef _WIN32
     #pragma GCC diagnostic push
@@ -60,7 +59,7 @@ void ffVersionToPretty(const FFVersion* version, FFstrbuf* pretty)
         ffStrbufAppendF(pretty, ".%u", version->patch);
 }
 
-static void parseSize(FFstrbuf* result, uint64_t bytes, uint32_t base, const char** prefixes)
+static void parseSize(FFstrbuf* result, uint64_t bytes, uint32_t base, uint8_t ndigits, const char** prefixes)
 {
     double size = (double) bytes;
     uint8_t counter = 0;
@@ -72,21 +71,28 @@ static void parseSize(FFstrbuf* result, uint64_t bytes, uint32_t base, const cha
     }
 
     if(counter == 0)
-        ffStrbufAppendF(result, "%"PRIu64" %s", bytes, prefixes[0]);
+        ffStrbufAppendUInt(result, bytes);
     else
-        ffStrbufAppendF(result, "%.*f %s", instance.config.sizeNdigits, size, prefixes[counter]);
+        ffStrbufAppendDouble(result, size, (int8_t) (ndigits > INT8_MAX ? INT8_MAX : ndigits));
+    ffStrbufAppendC(result, ' ');
+    ffStrbufAppendS(result, prefixes[counter]);
 }
 
-void ffParseSize(uint64_t bytes, FFBinaryPrefixType binaryPrefix, FFstrbuf* result)
+void ffParseSizeWithDigits(uint64_t bytes, FFBinaryPrefixType binaryPrefix, uint8_t ndigits, FFstrbuf* result)
 {
     if(binaryPrefix == FF_BINARY_PREFIX_TYPE_IEC)
-        parseSize(result, bytes, 1024, (const char*[]) {"B", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB", "ZiB", "YiB", NULL});
+        parseSize(result, bytes, 1024, ndigits, (const char*[]) {"B", "KiB", "MiB", "GiB", "TiB", "PiB", "EiB", "ZiB", "YiB", NULL});
     else if(binaryPrefix == FF_BINARY_PREFIX_TYPE_SI)
-        parseSize(result, bytes, 1000, (const char*[]) {"B", "kB", "MB", "GB", "TB", "PB", "EB", "ZB", "YB", NULL});
+        parseSize(result, bytes, 1000, ndigits, (const char*[]) {"B", "kB", "MB", "GB", "TB", "PB", "EB", "ZB", "YB", NULL});
     else if(binaryPrefix == FF_BINARY_PREFIX_TYPE_JEDEC)
-        parseSize(result, bytes, 1024, (const char*[]) {"B", "KB", "MB", "GB", "TB", NULL});
+        parseSize(result, bytes, 1024, ndigits, (const char*[]) {"B", "KB", "MB", "GB", "TB", NULL});
     else
-        parseSize(result, bytes, 1024, (const char*[]) {"B", NULL});
+        parseSize(result, bytes, 1024, ndigits, (const char*[]) {"B", NULL});
+}
+
+void ffParseSize(uint64_t bytes, FFBinaryPrefixType binaryPrefix, FFstrbuf* result)
+{
+    ffParseSizeWithDigits(bytes, binaryPrefix, instance.config.sizeNdigits, result);
 }
 
 void ffParseGTK(FFstrbuf* buffer, const FFstrbuf* gtk2, const FFstrbuf* gtk3, const FFstrbuf* gtk4)
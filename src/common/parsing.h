@@ -23,5 +23,7 @@ void ffVersionToPretty(const FFVersion* version, FFstrbuf* pretty);
 int8_t ffVersionCompare(const FFVersion* version1, const FFVersion* version2);
 
 void ffParseSize(uint64_t bytes, FFBinaryPrefixType binaryPrefix, FFstrbuf* result);
+// Like ffParseSize, with `ndigits` digits after the decimal point instead of `--size-ndigits`
+void ffParseSizeWithDigits(uint64_t bytes, FFBinaryPrefixType binaryPrefix, uint8_t ndigits, FFstrbuf* result);
 
 #endif
@@ -2,7 +2,8 @@
 #include "common/printing.h"
 #include "util/textModifier.h"
 
-void ffPrintLogoAndKey(const char* moduleName, uint8_t moduleIndex, const FFstrbuf* customKeyFormat, const FFstrbuf* customKeyColor)
+// The key is formatted by `customKeyProgram` if not NULL, by `customKeyFormat` otherwise
+static void printLogoAndKey(const char* moduleName, uint8_t moduleIndex, const FFstrbuf* customKeyFormat, const FFformatProgram* customKeyProgram, const FFstrbuf* customKeyColor)
 {
     ffLogoPrintLine();
 
@@ -20,7 +21,7 @@ void ffPrintLogoAndKey(const char* moduleName, uint8_t moduleIndex, const FFstrb
     }
 
     //NULL check is required for modules with custom keys, e.g. disk with the folder path
-    if(customKeyFormat == NULL || customKeyFormat->length == 0)
+    if(customKeyProgram != NULL ? customKeyProgram->ops.length == 0 : customKeyFormat == NULL || customKeyFormat->length == 0)
     {
         fputs(moduleName, stdout);
 
@@ -30,9 +31,13 @@ void ffPrintLogoAndKey(const char* moduleName, uint8_t moduleIndex, const FFstrb
     else
     {
         FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
-        ffParseFormatString(&key, customKeyFormat, 1, (FFformatarg[]){
+        FFformatarg arguments[] = {
             {FF_FORMAT_ARG_TYPE_UINT8, &moduleIndex}
-        });
+        };
+        if(customKeyProgram != NULL)
+            ffFormatProgramRun(&key, customKeyProgram, 1, arguments);
+        else
+            ffParseFormatString(&key, customKeyFormat, 1, arguments);
         ffPrintUserString(key.chars);
     }
 
@@ -45,14 +50,19 @@ void ffPrintLogoAndKey(const char* moduleName, uint8_t moduleIndex, const FFstrb
         fputs(FASTFETCH_TEXT_MODIFIER_RESET, stdout);
 }
 
-void ffPrintFormatString(const char* moduleName, uint8_t moduleIndex, const FFstrbuf* customKeyFormat, const FFstrbuf* customKeyColor, const FFstrbuf* format, uint32_t numArgs, const FFformatarg* arguments)
+void ffPrintLogoAndKey(const char* moduleName, uint8_t moduleIndex, const FFstrbuf* customKeyFormat, const FFstrbuf* customKeyColor)
+{
+    printLogoAndKey(moduleName, moduleIndex, customKeyFormat, NULL, customKeyColor);
+}
+
+void ffPrintFormatString(const char* moduleName, uint8_t moduleIndex, const FFformatProgram* customKeyFormat, const FFstrbuf* customKeyColor, const FFformatProgram* format, uint32_t numArgs, const FFformatarg* arguments)
 {
     FF_STRBUF_AUTO_DESTROY buffer = ffStrbufCreateA(256);
-    ffParseFormatString(&buffer, format, numArgs, arguments);
+    ffFormatProgramRun(&buffer, format, numArgs, arguments);
 
     if(buffer.length > 0)
     {
-        ffPrintLogoAndKey(moduleName, moduleIndex, customKeyFormat, customKeyColor);
+        printLogoAndKey(moduleName, moduleIndex, NULL, customKeyFormat, customKeyColor);
         ffPrintUserString(buffer.chars);
         putchar('\n');
     }
@@ -60,7 +70,7 @@ void ffPrintFormatString(const char* moduleName, uint8_t moduleIndex, const FFst
 
 void ffPrintFormat(const char* moduleName, uint8_t moduleIndex, const FFModuleArgs* moduleArgs, uint32_t numArgs, const FFformatarg* arguments)
 {
-    ffPrintFormatString(moduleName, moduleIndex, &moduleArgs->key, &moduleArgs->keyColor, &moduleArgs->outputFormat, numArgs, arguments);
+    ffPrintFormatString(moduleName, moduleIndex, &moduleArgs->keyProgram, &moduleArgs->keyColor, &moduleArgs->outputFormatProgram, numArgs, arguments);
 }
 
 static void printError(const char* moduleName, uint8_t moduleIndex, const FFstrbuf* customKeyFormat, const FFstrbuf* customKeyColor, const char* message, va_list arguments)
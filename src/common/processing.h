@@ -17,4 +17,21 @@ static inline const char* ffProcessAppendStdErr(FFstrbuf* buffer, char* const ar
     return ffProcessAppendOutput(buffer, argv, true);
 }
 
+typedef struct FFProcessCommand
+{
+    char* const* argv;
+    bool useStdErr;
+    FFstrbuf* output; // Output is appended to it
+    const char* error; // Set by ffProcessAppendOutputBatch. NULL on success
+} FFProcessCommand;
+
+// Runs all commands at the same time and waits for them.
+// `--processing-timeout` applies to the batch as a whole; commands still running after it are killed.
+// On Windows, the commands are run one after another
+void ffProcessAppendOutputBatch(uint32_t count, FFProcessCommand* commands);
+
+// Starts another instance of fastfetch with `argv` (argv[0] is ignored) in its own session, and doesn't wait for it.
+// Its stdin, stdout and stderr are /dev/null. Used to refresh caches without delaying the output
+bool ffProcessSpawnSelf(char* argv[]);
+
 #endif
@@ -2,80 +2,301 @@
 #include "common/processing.h"
 #include "common/io/io.h"
 #include "common/time.h"
+#include "util/mallocHelper.h"
 
 #include <stdlib.h>
+#include <limits.h>
 #include <unistd.h>
 #include <signal.h>
 #include <poll.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <sys/wait.h>
+
+#if defined(__APPLE__)
+    #include <mach-o/dyld.h>
+#elif defined(__FreeBSD__)
+    #include <sys/types.h>
+    #include <sys/sysctl.h>
+#endif
+
+// posix_spawn is available since Android 9
+#if !defined(__ANDROID__) || __ANDROID_API__ >= 28
+    #define FF_USE_POSIX_SPAWN 1
+    #include <spawn.h>
+    extern char** environ;
+#endif
 
 enum { FF_PIPE_BUFSIZ = 4096 };
 
-const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool useStdErr)
+// The read end is non blocking. Both ends are close-on-exec, so that children spawned concurrently don't inherit each other's pipe ends
+static bool createPipe(int pipes[2])
 {
-    int pipes[2];
+    #ifdef __APPLE__
+        if(pipe(pipes) == -1)
+            return false;
+        fcntl(pipes[0], F_SETFD, FD_CLOEXEC);
+        fcntl(pipes[1], F_SETFD, FD_CLOEXEC);
+    #else
+        if(pipe2(pipes, O_CLOEXEC) == -1)
+            return false;
+    #endif
+
+    fcntl(pipes[0], F_SETFL, fcntl(pipes[0], F_GETFL) | O_NONBLOCK);
+    return true;
+}
 
-    if(pipe(pipes) == -1)
+// Unlike fork, posix_spawn doesn't copy the page tables of our process, which can be large once libraries like
+// ImageMagick or Vulkan drivers are loaded (glibc and musl use CLONE_VM | CLONE_VFORK, macOS and BSDs have native implementations)
+static const char* spawnChild(char* const argv[], bool useStdErr, pid_t* pid, int* fd)
+{
+    int pipes[2];
+    if(!createPipe(pipes))
         return "pipe() failed";
 
-    pid_t childPid = fork();
-    if(childPid == -1)
-        return "fork() failed";
+    int outputFd = useStdErr ? STDERR_FILENO : STDOUT_FILENO;
+    int otherFd = useStdErr ? STDOUT_FILENO : STDERR_FILENO;
 
-    //Child
-    if(childPid == 0)
-    {
-        dup2(pipes[1], useStdErr ? STDERR_FILENO : STDOUT_FILENO);
-        close(pipes[0]);
+    #ifdef FF_USE_POSIX_SPAWN
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, pipes[1], outputFd);
+        posix_spawn_file_actions_addopen(&actions, otherFd, "/dev/null", O_WRONLY, 0);
+        int ret = posix_spawnp(pid, argv[0], &actions, NULL, argv, environ);
+        posix_spawn_file_actions_destroy(&actions);
         close(pipes[1]);
-        close(useStdErr ? STDOUT_FILENO : STDERR_FILENO);
-        execvp(argv[0], argv);
-        exit(901);
-    }
 
-    //Parent
-    close(pipes[1]);
+        if(ret != 0)
+        {
+            close(pipes[0]);
+            return "posix_spawnp() failed";
+        }
+    #else
+        *pid = fork();
+        if(*pid == -1)
+        {
+            close(pipes[0]);
+            close(pipes[1]);
+            return "fork() failed";
+        }
 
-    int FF_AUTO_CLOSE_FD childPipeFd = pipes[0];
+        //Child
+        if(*pid == 0)
+        {
+            dup2(pipes[1], outputFd);
+            close(otherFd);
+            execvp(argv[0], argv);
+            _exit(901);
+        }
 
-    int timeout = instance.config.processingTimeout;
-    if (timeout >= 0)
-        fcntl(childPipeFd, F_SETFL, fcntl(childPipeFd, F_GETFL) | O_NONBLOCK);
+        close(pipes[1]);
+    #endif
+
+    *fd = pipes[0];
+    return NULL;
+}
 
-    do
+// Returns true once the pipe is closed
+static bool readAvailable(int fd, FFstrbuf* buffer, const char** error)
+{
+    char str[FF_PIPE_BUFSIZ];
+    while(true)
     {
-        if (timeout >= 0)
+        ssize_t nRead = read(fd, str, sizeof(str));
+        if(nRead > 0)
+            ffStrbufAppendNS(buffer, (uint32_t) nRead, str);
+        else if(nRead == 0)
+            return true;
+        else if(errno == EAGAIN)
+            return false;
+        else if(errno != EINTR)
         {
-            struct pollfd pollfd = { childPipeFd, POLLIN, 0 };
-            if (poll(&pollfd, 1, timeout) == 0)
+            *error = "read() failed";
+            return true;
+        }
+    }
+}
+
+// A child may keep running after closing its output, so waiting for it is bound by the deadline too
+static void reapChild(pid_t pid, int timeout, uint64_t deadline)
+{
+    while(true)
+    {
+        pid_t ret = waitpid(pid, NULL, timeout >= 0 ? WNOHANG : 0);
+        if(ret == pid || (ret < 0 && errno != EINTR))
+            return;
+
+        if(ret == 0)
+        {
+            if(ffTimeGetTick() >= deadline)
             {
-                kill(childPid, SIGTERM);
-                return "poll(&pollfd, 1, timeout) timeout";
+                kill(pid, SIGKILL);
+                timeout = -1;
             }
-            else if (pollfd.revents & POLLERR)
+            else
+                nanosleep(&(struct timespec){ 0, 100000 }, NULL); // Usually it's about to exit
+        }
+    }
+}
+
+void ffProcessAppendOutputBatch(uint32_t count, FFProcessCommand* commands)
+{
+    if(count == 0)
+        return;
+
+    pid_t* FF_AUTO_FREE pids = malloc(count * sizeof(*pids));
+    struct pollfd* FF_AUTO_FREE pollfds = malloc(count * sizeof(*pollfds));
+    if(!pids || !pollfds)
+    {
+        for(uint32_t i = 0; i < count; ++i)
+            commands[i].error = "malloc() failed";
+        return;
+    }
+
+    uint32_t running = 0;
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        pollfds[i] = (struct pollfd) { .fd = -1, .events = POLLIN };
+        pids[i] = -1;
+        commands[i].error = spawnChild(commands[i].argv, commands[i].useStdErr, &pids[i], &pollfds[i].fd);
+        if(!commands[i].error)
+            ++running;
+    }
+
+    // One deadline for the whole batch
+    int timeout = instance.config.processingTimeout;
+    uint64_t deadline = timeout >= 0 ? ffTimeGetTick() + (uint64_t) timeout : 0;
+
+    while(running > 0)
+    {
+        int wait = -1;
+        if(timeout >= 0)
+        {
+            uint64_t now = ffTimeGetTick();
+            wait = now >= deadline ? 0 : (int) (deadline - now);
+        }
+
+        // Negative fds (finished or failed commands) are ignored by poll
+        int ready = poll(pollfds, count, wait);
+        if(ready < 0 && errno == EINTR)
+            continue;
+        if(ready <= 0)
+        {
+            for(uint32_t i = 0; i < count; ++i)
             {
-                kill(childPid, SIGTERM);
-                return "poll(&pollfd, 1, timeout) error";
+                if(pollfds[i].fd >= 0)
+                    commands[i].error = ready == 0 ? "poll() timeout" : "poll() failed";
             }
-            else if (pollfd.revents & POLLHUP)
+            break;
+        }
+
+        for(uint32_t i = 0; i < count; ++i)
+        {
+            if(pollfds[i].fd < 0 || pollfds[i].revents == 0)
+                continue;
+
+            if(readAvailable(pollfds[i].fd, commands[i].output, &commands[i].error))
             {
-                return NULL;
+                close(pollfds[i].fd);
+                pollfds[i].fd = -1;
+                --running;
             }
         }
+    }
+
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        if(pids[i] <= 0)
+            continue;
 
-        char str[FF_PIPE_BUFSIZ];
-        while (true)
+        // Still running after the timeout
+        if(pollfds[i].fd >= 0)
         {
-            ssize_t nRead = read(childPipeFd, str, FF_PIPE_BUFSIZ);
-            if (nRead > 0)
-                ffStrbufAppendNS(buffer, (uint32_t) nRead, str);
-            else if (nRead == 0)
-                return NULL;
-            else if (nRead < 0)
-                break;
+            close(pollfds[i].fd);
+            kill(pids[i], SIGKILL);
         }
-    } while (errno == EAGAIN);
 
-    return NULL;
+        reapChild(pids[i], timeout, deadline);
+    }
+}
+
+const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool useStdErr)
+{
+    FFProcessCommand command = {
+        .argv = argv,
+        .useStdErr = useStdErr,
+        .output = buffer,
+    };
+    ffProcessAppendOutputBatch(1, &command);
+    return command.error;
+}
+
+static bool getSelfPath(FFstrbuf* path)
+{
+    #if defined(__linux__)
+        // Executing the link works, even if the binary has been replaced since
+        ffStrbufSetS(path, "/proc/self/exe");
+    #elif defined(__APPLE__)
+        uint32_t size = ffStrbufGetFree(path);
+        if(_NSGetExecutablePath(path->chars, &size) != 0)
+        {
+            ffStrbufEnsureFree(path, size);
+            if(_NSGetExecutablePath(path->chars, &size) != 0)
+                return false;
+        }
+        ffStrbufRecalculateLength(path);
+    #elif defined(__FreeBSD__)
+        size_t size = ffStrbufGetFree(path);
+        if(sysctl((int[]) {CTL_KERN, KERN_PROC, KERN_PROC_PATHNAME, -1}, 4, path->chars, &size, NULL, 0) != 0)
+            return false;
+        ffStrbufRecalculateLength(path);
+    #else
+        ffStrbufSetS(path, "fastfetch");
+    #endif
+    return path->length > 0;
+}
+
+bool ffProcessSpawnSelf(char* argv[])
+{
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreateA(PATH_MAX);
+    if(!getSelfPath(&path))
+        return false;
+    argv[0] = path.chars;
+
+    pid_t pid;
+    #ifdef FF_USE_POSIX_SPAWN
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+        posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+        posix_spawnattr_t attr;
+        posix_spawnattr_init(&attr);
+        #ifdef POSIX_SPAWN_SETSID
+            // Don't get killed by SIGHUP when the terminal closes
+            posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSID);
+        #endif
+
+        int ret = posix_spawnp(&pid, argv[0], &actions, &attr, argv, environ);
+        posix_spawnattr_destroy(&attr);
+        posix_spawn_file_actions_destroy(&actions);
+        return ret == 0;
+    #else
+        pid = fork();
+        if(pid == -1)
+            return false;
+
+        if(pid == 0)
+        {
+            setsid();
+            int nullFd = open("/dev/null", O_RDWR);
+            dup2(nullFd, STDIN_FILENO);
+            dup2(nullFd, STDOUT_FILENO);
+            dup2(nullFd, STDERR_FILENO);
+            execvp(argv[0], argv);
+            _exit(901);
+        }
+        return true;
+    #endif
 }
@@ -113,3 +113,36 @@ const char* ffProcessAppendOutput(FFstrbuf* buffer, char* const argv[], bool use
 
     return NULL;
 }
+
+void ffProcessAppendOutputBatch(uint32_t count, FFProcessCommand* commands)
+{
+    // The named pipe used above can only exist once
+    for(uint32_t i = 0; i < count; ++i)
+        commands[i].error = ffProcessAppendOutput(commands[i].output, commands[i].argv, commands[i].useStdErr);
+}
+
+bool ffProcessSpawnSelf(char* argv[])
+{
+    char path[MAX_PATH];
+    DWORD length = GetModuleFileNameA(NULL, path, sizeof(path));
+    if(length == 0 || length == sizeof(path))
+        return false;
+    argv[0] = path;
+
+    FF_STRBUF_AUTO_DESTROY cmdline = ffStrbufCreateF("\"%s\"", argv[0]);
+    for(char* const* parg = &argv[1]; *parg; ++parg)
+    {
+        ffStrbufAppendS(&cmdline, " \"");
+        ffStrbufAppendS(&cmdline, *parg);
+        ffStrbufAppendC(&cmdline, '"');
+    }
+
+    STARTUPINFOA siStartInfo = { .cb = sizeof(siStartInfo) };
+    PROCESS_INFORMATION piProcInfo = {0};
+    if(!CreateProcessA(NULL, cmdline.chars, NULL, NULL, FALSE, DETACHED_PROCESS | CREATE_NEW_PROCESS_GROUP, NULL, NULL, &siStartInfo, &piProcInfo))
+        return false;
+
+    CloseHandle(piProcInfo.hThread);
+    CloseHandle(piProcInfo.hProcess);
+    return true;
+}
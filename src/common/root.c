@@ -0,0 +1,262 @@
+#include "fastfetch.h"
+#include "common/root.h"
+#include "common/io/io.h"
+#include "common/threadpool.h"
+
+#ifndef _WIN32
+
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+typedef struct FFRootBatchJob
+{
+    const char* root; // Points into the list buffer
+    pid_t pid;
+    int fd; // Read end of the stdout pipe of the child; -1 once it is closed
+    int status; // Of waitpid, once the child is done
+    bool done;
+    FFstrbuf output;
+} FFRootBatchJob;
+
+static const char* batchRoot = NULL;
+
+const char* ffRootGetBatchRoot(void)
+{
+    return batchRoot;
+}
+
+// Splits `list` into lines in place. Empty lines are skipped
+static bool readRoots(const char* listFile, FFstrbuf* list, FFlist* jobs)
+{
+    if(!ffAppendFileBuffer(listFile, list))
+        return false;
+
+    for(uint32_t start = 0; start < list->length;)
+    {
+        uint32_t end = ffStrbufNextIndexC(list, start, '\n');
+        list->chars[end] = '\0';
+        if(end > start && list->chars[end - 1] == '\r')
+            list->chars[end - 1] = '\0';
+
+        if(list->chars[start] != '\0')
+        {
+            FFRootBatchJob* job = ffListAdd(jobs);
+            *job = (FFRootBatchJob) { .root = list->chars + start, .fd = -1 };
+            ffStrbufInit(&job->output);
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+static void startJob(FFlist* jobs, FFRootBatchJob* job, int argc, const char** argv, int (*run)(int argc, const char** argv))
+{
+    int fds[2];
+    if(pipe(fds) < 0)
+    {
+        job->done = true;
+        job->status = EXIT_FAILURE << 8;
+        return;
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+        FF_LIST_FOR_EACH(FFRootBatchJob, other, *jobs)
+        {
+            if(other->fd >= 0)
+                close(other->fd);
+        }
+        close(fds[0]);
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[1]);
+
+        batchRoot = job->root;
+        ffDestroyInstance();
+        exit(run(argc, argv));
+    }
+
+    close(fds[1]);
+    if(pid < 0)
+    {
+        close(fds[0]);
+        job->done = true;
+        job->status = EXIT_FAILURE << 8;
+        return;
+    }
+
+    job->pid = pid;
+    job->fd = fds[0];
+}
+
+// Returns false once the child closed its stdout
+static bool readOutput(FFRootBatchJob* job)
+{
+    char buffer[16384];
+    ssize_t length = read(job->fd, buffer, sizeof(buffer));
+    if(length > 0)
+    {
+        ffStrbufAppendNS(&job->output, (uint32_t) length, buffer);
+        return true;
+    }
+    if(length < 0 && errno == EINTR)
+        return true;
+
+    close(job->fd);
+    job->fd = -1;
+    while(waitpid(job->pid, &job->status, 0) < 0 && errno == EINTR);
+    job->done = true;
+    return false;
+}
+
+static void appendJsonString(FFstrbuf* buffer, const char* value)
+{
+    ffStrbufAppendC(buffer, '"');
+    for(const char* c = value; *c; ++c)
+    {
+        if(*c == '"' || *c == '\\')
+        {
+            ffStrbufAppendC(buffer, '\\');
+            ffStrbufAppendC(buffer, *c);
+        }
+        else if((unsigned char) *c < 0x20)
+            ffStrbufAppendF(buffer, "\\u%04x", (unsigned) *c);
+        else
+            ffStrbufAppendC(buffer, *c);
+    }
+    ffStrbufAppendC(buffer, '"');
+}
+
+static void appendStatusError(FFstrbuf* buffer, int status)
+{
+    if(WIFSIGNALED(status))
+        ffStrbufAppendF(buffer, "Killed by signal %d", WTERMSIG(status));
+    else
+        ffStrbufAppendF(buffer, "Exited with status %d", WEXITSTATUS(status));
+}
+
+static void printJob(const FFRootBatchJob* job, bool first)
+{
+    bool success = WIFEXITED(job->status) && WEXITSTATUS(job->status) == EXIT_SUCCESS;
+    FF_STRBUF_AUTO_DESTROY buffer = ffStrbufCreateA(job->output.length + 64);
+
+    if(instance.config.outputFormat == FF_OUTPUT_FORMAT_JSON)
+    {
+        ffStrbufAppendS(&buffer, first ? "\n{\"root\": " : ",\n{\"root\": ");
+        appendJsonString(&buffer, job->root);
+        if(success && job->output.length > 0)
+        {
+            ffStrbufAppendS(&buffer, ", \"result\": ");
+            ffStrbufAppend(&buffer, &job->output);
+            ffStrbufTrimRight(&buffer, '\n');
+        }
+        else
+        {
+            ffStrbufAppendS(&buffer, ", \"error\": \"");
+            appendStatusError(&buffer, job->status);
+            ffStrbufAppendC(&buffer, '"');
+        }
+        ffStrbufAppendC(&buffer, '}');
+    }
+    else
+    {
+        ffStrbufAppendF(&buffer, first ? "==> %s <==\n" : "\n==> %s <==\n", job->root);
+        ffStrbufAppend(&buffer, &job->output);
+    }
+
+    ffStrbufWriteTo(&buffer, stdout);
+    fflush(stdout);
+
+    if(!success)
+    {
+        FF_STRBUF_AUTO_DESTROY error = ffStrbufCreate();
+        appendStatusError(&error, job->status);
+        fprintf(stderr, "Error: %s: %s\n", job->root, error.chars);
+    }
+}
+
+int ffRootRunBatch(const char* listFile, int argc, const char** argv, int (*run)(int argc, const char** argv))
+{
+    FF_STRBUF_AUTO_DESTROY list = ffStrbufCreate();
+    FF_LIST_AUTO_DESTROY jobs = ffListCreate(sizeof(FFRootBatchJob));
+    if(!readRoots(listFile, &list, &jobs))
+    {
+        fprintf(stderr, "Error: failed to read the root list %s\n", listFile);
+        return EXIT_FAILURE;
+    }
+
+    if(instance.config.outputFormat == FF_OUTPUT_FORMAT_JSON)
+        fputc('[', stdout);
+
+    const uint32_t maxRunning = ffThreadPoolGetCPUCount();
+    FF_LIST_AUTO_DESTROY pollFds = ffListCreate(sizeof(struct pollfd));
+    FF_LIST_AUTO_DESTROY pollJobs = ffListCreate(sizeof(FFRootBatchJob*));
+    uint32_t next = 0, printed = 0, running = 0;
+    int result = EXIT_SUCCESS;
+
+    while(printed < jobs.length)
+    {
+        while(next < jobs.length && running < maxRunning)
+        {
+            FFRootBatchJob* job = ffListGet(&jobs, next++);
+            startJob(&jobs, job, argc, argv, run);
+            if(job->fd >= 0)
+                ++running;
+        }
+
+        pollFds.length = pollJobs.length = 0;
+        for(uint32_t i = printed; i < next; ++i)
+        {
+            FFRootBatchJob* job = ffListGet(&jobs, i);
+            if(job->fd < 0)
+                continue;
+            *(struct pollfd*) ffListAdd(&pollFds) = (struct pollfd) { .fd = job->fd, .events = POLLIN };
+            *(FFRootBatchJob**) ffListAdd(&pollJobs) = job;
+        }
+
+        if(pollFds.length > 0 && poll((struct pollfd*) pollFds.data, pollFds.length, -1) > 0)
+        {
+            for(uint32_t i = 0; i < pollFds.length; ++i)
+            {
+                const struct pollfd* pfd = ffListGet(&pollFds, i);
+                if(pfd->revents != 0 && !readOutput(*(FFRootBatchJob**) ffListGet(&pollJobs, i)))
+                    --running;
+            }
+        }
+
+        for(FFRootBatchJob* job; printed < next && (job = ffListGet(&jobs, printed))->done; ++printed)
+        {
+            printJob(job, printed == 0);
+            if(!WIFEXITED(job->status) || WEXITSTATUS(job->status) != EXIT_SUCCESS)
+                result = EXIT_FAILURE;
+            ffStrbufDestroy(&job->output);
+        }
+    }
+
+    if(instance.config.outputFormat == FF_OUTPUT_FORMAT_JSON)
+        fputs("\n]\n", stdout);
+    fflush(stdout);
+    return result;
+}
+
+#else //_WIN32
+
+int ffRootRunBatch(const char* listFile, int argc, const char** argv, int (*run)(int argc, const char** argv))
+{
+    FF_UNUSED(listFile, argc, argv, run);
+    fputs("Error: --root-list is not supported on Windows\n", stderr);
+    return EXIT_FAILURE;
+}
+
+const char* ffRootGetBatchRoot(void)
+{
+    return NULL;
+}
+
+#endif //_WIN32
@@ -0,0 +1,33 @@
+#pragma once
+
+#ifndef FF_INCLUDED_common_root
+#define FF_INCLUDED_common_root
+
+#include "fastfetch.h"
+
+// `fastfetch --root <dir>` inspects a mounted image or an unpacked container: file based detection reads below <dir> instead of /.
+// Honored by OS (os-release), Packages (system package managers; those in the home directory are skipped),
+// Kernel (the newest kernel in <dir>/lib/modules instead of the running one) and Shell (the shells listed in <dir>/etc/shells).
+// Modules describing the running system (CPU, Memory, Display, ...) are not affected.
+//
+// `fastfetch --root-list <file>` runs fastfetch once for every line of <file> (`/dev/stdin` to pipe the list) as if `--root <line>` was given.
+// Roots are scanned by forked children, as many at once as there are CPUs. Outputs are printed in the order of the list,
+// each as soon as it and all before it are done: after a `==> <dir> <==` line, or with `--format json` as one JSON array
+// of `{ "root": "<dir>", "result": [...] }` (`"error"` instead of `"result"` if the child failed).
+
+// Sets `path` to `absolutePath` (starting with '/') below `--root`
+static inline void ffRootPathSet(FFstrbuf* path, const char* absolutePath)
+{
+    ffStrbufSet(path, &instance.config.root);
+    ffStrbufAppendS(path, absolutePath);
+}
+
+// Runs `--root-list`, before anything starts a thread. The return value is the exit code:
+// EXIT_FAILURE if the list can't be read or one of the children failed.
+// `run` is called in a forked child for every root with the same arguments; the instance is destroyed before
+int ffRootRunBatch(const char* listFile, int argc, const char** argv, int (*run)(int argc, const char** argv));
+
+// In a child of ffRootRunBatch, the root it prints for; NULL otherwise
+const char* ffRootGetBatchRoot(void);
+
+#endif
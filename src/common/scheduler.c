@@ -0,0 +1,188 @@
+#include "fastfetch.h"
+#include "common/output.h"
+#include "common/scheduler.h"
+#include "common/threadpool.h"
+#include "common/thread.h"
+#include "common/time.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+static void printStat(uint64_t ms)
+{
+    char str[32];
+    int len = snprintf(str, sizeof str, "%" PRIu64 "ms", ms);
+    if(instance.config.pipe)
+        puts(str);
+    else
+        printf("\033[s\033[1A\033[9999999C\033[%dD%s\033[u", len, str); // Save; Up 1; Right 9999999; Left <len>; Print <str>; Load
+}
+
+static void runJobSequential(FFSchedulerJob job, void* data, uint32_t index)
+{
+    uint64_t ms = 0;
+    if(__builtin_expect(instance.config.stat, false))
+        ms = ffTimeGetTick();
+
+    job(data, index);
+
+    if(__builtin_expect(instance.config.stat, false))
+        printStat(ffTimeGetTick() - ms);
+
+    #if defined(_WIN32)
+        if (!instance.config.noBuffer) fflush(stdout);
+    #endif
+}
+
+#ifdef FF_HAVE_THREADS
+
+// Min / max size of the worker pool, before being capped by the number of jobs
+#define FF_SCHEDULER_MIN_THREADS 8
+#define FF_SCHEDULER_MAX_THREADS 32
+
+typedef struct FFSchedulerState
+{
+    FFThreadMutex mutex;
+    FFThreadCond cond;
+    FFThreadMutex outputMutex;
+
+    FFSchedulerJob job;
+    void* data;
+    uint32_t count;
+    uint32_t nextOutput; // Index of the job currently allowed to print
+    bool* done;
+} FFSchedulerState;
+
+static FFSchedulerState state = {
+    .mutex = FF_THREAD_MUTEX_INITIALIZER,
+    .cond = FF_THREAD_COND_INITIALIZER,
+    .outputMutex = FF_THREAD_MUTEX_INITIALIZER,
+};
+
+static _Thread_local uint32_t currentJob = UINT32_MAX;
+static _Thread_local bool ownsOutput = false;
+
+void ffSchedulerWaitForOutput(void)
+{
+    if(currentJob == UINT32_MAX || ownsOutput)
+        return;
+
+    ffThreadMutexLock(&state.mutex);
+    while(state.nextOutput != currentJob)
+        ffThreadCondWait(&state.cond, &state.mutex);
+    ffThreadMutexUnlock(&state.mutex);
+
+    ffThreadMutexLock(&state.outputMutex);
+    ownsOutput = true;
+}
+
+void ffSchedulerLockOutput(void)
+{
+    if(!ownsOutput)
+        ffThreadMutexLock(&state.outputMutex);
+}
+
+void ffSchedulerUnlockOutput(void)
+{
+    if(!ownsOutput)
+        ffThreadMutexUnlock(&state.outputMutex);
+}
+
+static void runJobConcurrent(void* data, uint32_t index)
+{
+    FF_UNUSED(data);
+
+    currentJob = index;
+    ownsOutput = false;
+
+    uint64_t ms = 0;
+    if(__builtin_expect(instance.config.stat, false))
+        ms = ffTimeGetTick();
+
+    state.job(state.data, index);
+
+    if(__builtin_expect(instance.config.stat, false))
+    {
+        uint64_t elapsed = ffTimeGetTick() - ms;
+        ffSchedulerWaitForOutput();
+        printStat(elapsed);
+    }
+
+    if(ownsOutput)
+    {
+        #if defined(_WIN32)
+            fflush(stdout);
+        #endif
+        ownsOutput = false;
+        ffThreadMutexUnlock(&state.outputMutex);
+    }
+    currentJob = UINT32_MAX;
+
+    ffThreadMutexLock(&state.mutex);
+    state.done[index] = true;
+    while(state.nextOutput < state.count && state.done[state.nextOutput])
+        ++state.nextOutput;
+    ffThreadCondBroadcast(&state.cond);
+    ffThreadMutexUnlock(&state.mutex);
+}
+
+static void runConcurrent(uint32_t count, FFSchedulerJob job, void* data)
+{
+    uint32_t maxThreads = ffThreadPoolGetCPUCount() * 4;
+    if(maxThreads < FF_SCHEDULER_MIN_THREADS)
+        maxThreads = FF_SCHEDULER_MIN_THREADS;
+    else if(maxThreads > FF_SCHEDULER_MAX_THREADS)
+        maxThreads = FF_SCHEDULER_MAX_THREADS;
+
+    bool* done = calloc(count, sizeof(*done));
+
+    ffThreadMutexLock(&state.mutex);
+    state.job = job;
+    state.data = data;
+    state.count = count;
+    state.nextOutput = 0;
+    state.done = done;
+    ffThreadMutexUnlock(&state.mutex);
+
+    ffThreadPoolRun(count, maxThreads, runJobConcurrent, NULL);
+
+    ffThreadMutexLock(&state.mutex);
+    state.done = NULL;
+    state.count = 0;
+    ffThreadMutexUnlock(&state.mutex);
+
+    free(done);
+}
+
+void ffSchedulerRun(uint32_t count, FFSchedulerJob job, void* data)
+{
+    // On a terminal, lines show up while slow modules are still running, written at most once per frame
+    bool frames = !instance.config.pipe && count > 1;
+    if(frames)
+        ffOutputStartFrames();
+
+    if(!instance.config.multithreading || count <= 1)
+    {
+        for(uint32_t i = 0; i < count; ++i)
+            runJobSequential(job, data, i);
+    }
+    else
+        runConcurrent(count, job, data);
+
+    if(frames)
+        ffOutputStopFrames();
+}
+
+#else //FF_HAVE_THREADS
+
+void ffSchedulerWaitForOutput(void) {}
+void ffSchedulerLockOutput(void) {}
+void ffSchedulerUnlockOutput(void) {}
+
+void ffSchedulerRun(uint32_t count, FFSchedulerJob job, void* data)
+{
+    for(uint32_t i = 0; i < count; ++i)
+        runJobSequential(job, data, i);
+}
+
+#endif //FF_HAVE_THREADS
@@ -0,0 +1,26 @@
+#pragma once
+
+#ifndef FF_INCLUDED_common_scheduler
+#define FF_INCLUDED_common_scheduler
+
+#include <stdint.h>
+
+typedef void (*FFSchedulerJob)(void* data, uint32_t index);
+
+// Runs job(data, 0) .. job(data, count - 1), usually one per module, and waits for all of them.
+// With multithreading enabled, jobs run concurrently on a bounded worker pool, but their output
+// still appears in index order: a job blocks in ffSchedulerWaitForOutput until all previous jobs
+// are done, so each line is printed as soon as everything before it has been printed.
+// Also handles `--stat` timing for every job.
+void ffSchedulerRun(uint32_t count, FFSchedulerJob job, void* data);
+
+// Blocks until the calling job is allowed to write to stdout. Called by ffLogoPrintLine.
+// No-op outside of jobs, or if the calling job already owns the output.
+// A job owning the output must not wait for locks that may be held by a later job.
+void ffSchedulerWaitForOutput(void);
+
+// Exclusive access to the stdout / stderr file descriptors. Used by ffSuppressIO
+void ffSchedulerLockOutput(void);
+void ffSchedulerUnlockOutput(void);
+
+#endif
@@ -388,6 +388,51 @@ bool ffSettingsGetSQLite3String(const char* dbPath, const char* query, FFstrbuf*
 
     return true;
 }
+
+bool ffSettingsGetSQLite3Rows(const char* dbPath, const char* query, FFSQLite3RowCallback callback, void* callbackData)
+{
+    if(!ffPathExists(dbPath, FF_PATHTYPE_FILE))
+        return false;
+
+    const SQLiteData* data = getSQLiteData();
+    if(data == NULL)
+        return false;
+
+    sqlite3* db;
+    if(data->ffsqlite3_open_v2(dbPath, &db, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK)
+        return false;
+
+    sqlite3_stmt* stmt;
+    if(data->ffsqlite3_prepare_v2(db, query, (int) strlen(query), &stmt, NULL) != SQLITE_OK)
+    {
+        data->ffsqlite3_close(db);
+        return false;
+    }
+
+    const char* columns[8];
+    int status;
+    bool aborted = false;
+    while((status = data->ffsqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        int columnCount = data->ffsqlite3_data_count(stmt);
+        if(columnCount > (int) (sizeof(columns) / sizeof(*columns)))
+            columnCount = (int) (sizeof(columns) / sizeof(*columns));
+
+        for(int i = 0; i < columnCount; ++i)
+            columns[i] = (const char*) data->ffsqlite3_column_text(stmt, i);
+
+        if(!callback(callbackData, (uint32_t) columnCount, columns))
+        {
+            aborted = true;
+            break;
+        }
+    }
+
+    data->ffsqlite3_finalize(stmt);
+    data->ffsqlite3_close(db);
+
+    return !aborted && status == SQLITE_DONE;
+}
 #else //FF_HAVE_SQLITE3
 int ffSettingsGetSQLite3Int(const char* dbPath, const char* query)
 {
@@ -399,6 +444,11 @@ bool ffSettingsGetSQLite3String(const char* dbPath, const char* query, FFstrbuf*
     FF_UNUSED(dbPath, query, result)
     return false;
 }
+bool ffSettingsGetSQLite3Rows(const char* dbPath, const char* query, FFSQLite3RowCallback callback, void* data)
+{
+    FF_UNUSED(dbPath, query, callback, data)
+    return false;
+}
 #endif //FF_HAVE_SQLITE3
 
 #ifdef __ANDROID__
@@ -33,6 +33,11 @@ FFvariant ffSettingsGetXFConf(const char* channelName, const char* propertyName,
 int ffSettingsGetSQLite3Int(const char* dbPath, const char* query);
 bool ffSettingsGetSQLite3String(const char* dbPath, const char* query, FFstrbuf* result);
 
+// Called for every row returned by the query, with the first (at most 8) values as strings. Return false to abort
+typedef bool (*FFSQLite3RowCallback)(void* data, uint32_t columnCount, const char* const* columns);
+// Returns true only if every row has been handled: false if the query failed or the callback aborted it
+bool ffSettingsGetSQLite3Rows(const char* dbPath, const char* query, FFSQLite3RowCallback callback, void* data);
+
 #ifdef __ANDROID__
 bool ffSettingsGetAndroidProperty(const char* propName, FFstrbuf* result);
 #elif defined(__FreeBSD__)
@@ -11,10 +11,14 @@
         #include <synchapi.h>
         #include <process.h>
         #define FF_THREAD_MUTEX_INITIALIZER SRWLOCK_INIT
+        #define FF_THREAD_COND_INITIALIZER CONDITION_VARIABLE_INIT
         typedef SRWLOCK FFThreadMutex;
+        typedef CONDITION_VARIABLE FFThreadCond;
         typedef HANDLE FFThreadType;
         static inline void ffThreadMutexLock(FFThreadMutex* mutex) { AcquireSRWLockExclusive(mutex); }
         static inline void ffThreadMutexUnlock(FFThreadMutex* mutex) { ReleaseSRWLockExclusive(mutex); }
+        static inline void ffThreadCondWait(FFThreadCond* cond, FFThreadMutex* mutex) { SleepConditionVariableSRW(cond, mutex, 0xffffffff /*INFINITE*/, 0); }
+        static inline void ffThreadCondBroadcast(FFThreadCond* cond) { WakeAllConditionVariable(cond); }
         static inline FFThreadType ffThreadCreate(unsigned (__stdcall* func)(void*), void* data) {
             return (FFThreadType)_beginthreadex(NULL, 0, func, data, 0, NULL);
         }
@@ -25,10 +29,14 @@
     #else
         #include <pthread.h>
         #define FF_THREAD_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+        #define FF_THREAD_COND_INITIALIZER PTHREAD_COND_INITIALIZER
         typedef pthread_mutex_t FFThreadMutex;
+        typedef pthread_cond_t FFThreadCond;
         typedef pthread_t FFThreadType;
         static inline void ffThreadMutexLock(FFThreadMutex* mutex) { pthread_mutex_lock(mutex); }
         static inline void ffThreadMutexUnlock(FFThreadMutex* mutex) { pthread_mutex_unlock(mutex); }
+        static inline void ffThreadCondWait(FFThreadCond* cond, FFThreadMutex* mutex) { pthread_cond_wait(cond, mutex); }
+        static inline void ffThreadCondBroadcast(FFThreadCond* cond) { pthread_cond_broadcast(cond); }
         static inline FFThreadType ffThreadCreate(void* (* func)(void*), void* data) {
             FFThreadType newThread = 0;
             pthread_create(&newThread, NULL, func, data);
@@ -0,0 +1,97 @@
+#include "fastfetch.h"
+#include "common/threadpool.h"
+#include "common/thread.h"
+
+#ifdef _WIN32
+    #include <sysinfoapi.h>
+#else
+    #include <unistd.h>
+#endif
+
+uint32_t ffThreadPoolGetCPUCount(void)
+{
+    #ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        long count = (long) info.dwNumberOfProcessors;
+    #else
+        long count = sysconf(_SC_NPROCESSORS_ONLN);
+    #endif
+    return count > 0 ? (uint32_t) count : 1;
+}
+
+#ifdef FF_HAVE_THREADS
+
+typedef struct FFThreadPool
+{
+    FFThreadMutex mutex;
+    uint32_t next;
+    uint32_t count;
+    FFThreadPoolTask task;
+    void* data;
+} FFThreadPool;
+
+static void workerMain(FFThreadPool* pool)
+{
+    while(true)
+    {
+        ffThreadMutexLock(&pool->mutex);
+        uint32_t index = pool->next < pool->count ? pool->next++ : UINT32_MAX;
+        ffThreadMutexUnlock(&pool->mutex);
+
+        if(index == UINT32_MAX)
+            break;
+
+        pool->task(pool->data, index);
+    }
+}
+
+FF_THREAD_ENTRY_DECL_WRAPPER(workerMain, FFThreadPool*)
+
+#endif
+
+void ffThreadPoolRun(uint32_t count, uint32_t maxThreads, FFThreadPoolTask task, void* data)
+{
+    #ifdef FF_HAVE_THREADS
+        if(maxThreads > count)
+            maxThreads = count;
+
+        if(maxThreads > 1)
+        {
+            FFThreadPool pool = {
+                .mutex = FF_THREAD_MUTEX_INITIALIZER,
+                .next = 0,
+                .count = count,
+                .task = task,
+                .data = data,
+            };
+
+            // The calling thread is worker #0
+            FFThreadType threads[64];
+            uint32_t threadCount = maxThreads - 1;
+            if(threadCount > sizeof(threads) / sizeof(*threads))
+                threadCount = sizeof(threads) / sizeof(*threads);
+
+            for(uint32_t i = 0; i < threadCount; ++i)
+            {
+                threads[i] = ffThreadCreate(workerMainThreadMain, &pool);
+                if(!threads[i])
+                {
+                    threadCount = i;
+                    break;
+                }
+            }
+
+            workerMain(&pool);
+
+            for(uint32_t i = 0; i < threadCount; ++i)
+                ffThreadJoin(threads[i]);
+            return;
+        }
+    #else
+        FF_UNUSED(maxThreads);
+    #endif
+
+    for(uint32_t i = 0; i < count; ++i)
+        task(data, i);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#ifndef FF_INCLUDED_common_threadpool
+#define FF_INCLUDED_common_threadpool
+
+#include <stdint.h>
+
+typedef void (*FFThreadPoolTask)(void* data, uint32_t index);
+
+// Number of usable logical CPUs, at least 1
+uint32_t ffThreadPoolGetCPUCount(void);
+
+// Runs task(data, 0) .. task(data, count - 1) on at most maxThreads threads and waits for all of them.
+// Tasks are dequeued in index order. The calling thread takes part in the work.
+// Without thread support, or if maxThreads <= 1, the tasks are run sequentially.
+void ffThreadPoolRun(uint32_t count, uint32_t maxThreads, FFThreadPoolTask task, void* data);
+
+#endif
@@ -26,6 +26,21 @@ static inline uint64_t ffTimeGetTick() //In msec
     #endif
 }
 
+static inline uint64_t ffTimeGetTickUs() //In usec
+{
+    #ifdef _WIN32
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        LARGE_INTEGER start;
+        QueryPerformanceCounter(&start);
+        return (uint64_t)(start.QuadPart / frequency.QuadPart * 1000000 + start.QuadPart % frequency.QuadPart * 1000000 / frequency.QuadPart);
+    #else
+        struct timespec timeNow;
+        clock_gettime(CLOCK_MONOTONIC, &timeNow);
+        return (uint64_t)((timeNow.tv_sec * 1000000) + (timeNow.tv_nsec / 1000));
+    #endif
+}
+
 static inline void ffTimeSleep(uint32_t msec)
 {
     #ifdef _WIN32
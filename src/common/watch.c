@@ -0,0 +1,279 @@
+#include "fastfetch.h"
+#include "common/watch.h"
+#include "common/time.h"
+#include "common/output.h"
+
+#ifndef _WIN32
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct FFWatchJob
+{
+    uint32_t index; // Passed to the scheduler job
+    bool dynamic;
+    uint32_t firstLine; // 0 based row of the first line it printed
+    uint32_t lineCount;
+    FFstrbuf output; // Everything it printed the last time it ran
+} FFWatchJob;
+
+typedef struct FFWatchPass
+{
+    FFSchedulerJob job;
+    void* data;
+    FFWatchJob** jobs;
+    off_t* endOffsets; // Size of the captured output once the job at the same index finished
+    uint32_t* endLines; // keysHeight once the job at the same index finished
+} FFWatchPass;
+
+// stdout is redirected to captureFd while jobs run; terminalFd is the original one
+static int captureFd = -1;
+static int terminalFd = -1;
+
+static void runCapturedJob(void* data, uint32_t index)
+{
+    FFWatchPass* pass = (FFWatchPass*) data;
+    pass->job(pass->data, pass->jobs[index]->index);
+
+    // Jobs print in index order. Once this one owns the output, everything before it has been written
+    ffSchedulerWaitForOutput();
+    ffOutputFlush();
+    pass->endOffsets[index] = lseek(STDOUT_FILENO, 0, SEEK_CUR);
+    pass->endLines[index] = instance.state.keysHeight;
+}
+
+// Runs the jobs (concurrently with multithreading) and stores what each one printed in its `output`
+static void runCaptured(FFSchedulerJob job, void* data, FFWatchJob** jobs, uint32_t count)
+{
+    if(count == 0)
+        return;
+
+    FFWatchPass pass = {
+        .job = job,
+        .data = data,
+        .jobs = jobs,
+        .endOffsets = calloc(count, sizeof(*pass.endOffsets)),
+        .endLines = calloc(count, sizeof(*pass.endLines)),
+    };
+
+    // Exiting on a signal while stdout is redirected would write the console reset sequences into the capture file
+    sigset_t signals, oldSignals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGQUIT);
+    sigprocmask(SIG_BLOCK, &signals, &oldSignals);
+
+    ffOutputFlush();
+    lseek(captureFd, 0, SEEK_SET);
+    dup2(captureFd, STDOUT_FILENO);
+
+    uint32_t line = instance.state.keysHeight;
+    ffSchedulerRun(count, runCapturedJob, &pass);
+
+    ffOutputFlush();
+    dup2(terminalFd, STDOUT_FILENO);
+    sigprocmask(SIG_SETMASK, &oldSignals, NULL);
+
+    off_t offset = 0;
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        FFWatchJob* watchJob = jobs[i];
+        ffStrbufClear(&watchJob->output);
+
+        if(pass.endOffsets[i] > offset)
+        {
+            uint32_t length = (uint32_t) (pass.endOffsets[i] - offset);
+            ffStrbufEnsureFree(&watchJob->output, length);
+            ssize_t readed = pread(captureFd, watchJob->output.chars, length, offset);
+            watchJob->output.length = readed > 0 ? (uint32_t) readed : 0;
+            watchJob->output.chars[watchJob->output.length] = '\0';
+        }
+
+        watchJob->lineCount = pass.endLines[i] - line;
+        line = pass.endLines[i];
+        if(pass.endOffsets[i] > offset)
+            offset = pass.endOffsets[i];
+    }
+
+    free(pass.endOffsets);
+    free(pass.endLines);
+}
+
+static uint32_t printAll(FFWatchJob* jobs, uint32_t count)
+{
+    uint32_t line = 0;
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        jobs[i].firstLine = line;
+        line += jobs[i].lineCount;
+        ffStrbufWriteTo(&jobs[i].output, stdout);
+    }
+    return line;
+}
+
+static const char* findLineEnd(const char* line)
+{
+    const char* end = strchr(line, '\n');
+    return end ? end : line + strlen(line);
+}
+
+// Both outputs have the same number of lines
+static void rewriteChangedLines(const FFWatchJob* job, const FFstrbuf* previous)
+{
+    const char* oldLine = previous->chars;
+    const char* newLine = job->output.chars;
+    for(uint32_t i = 0; i < job->lineCount; ++i)
+    {
+        const char* oldEnd = findLineEnd(oldLine);
+        const char* newEnd = findLineEnd(newLine);
+
+        if(oldEnd - oldLine != newEnd - newLine || memcmp(oldLine, newLine, (size_t) (newEnd - newLine)) != 0)
+        {
+            // The line starts with the cursor movement of ffLogoPrintLine, so it is written from column 1.
+            // The new value may be shorter; clear the rest of the line
+            printf("\033[%u;1H", job->firstLine + i + 1);
+            fwrite(newLine, 1, (size_t) (newEnd - newLine), stdout);
+            fputs("\033[K", stdout);
+        }
+
+        oldLine = *oldEnd ? oldEnd + 1 : oldEnd;
+        newLine = *newEnd ? newEnd + 1 : newEnd;
+    }
+}
+
+static void watch(FFSchedulerJob job, void* data, FFWatchJob* jobs, uint32_t count)
+{
+    FFWatchJob** all = malloc(count * sizeof(*all));
+    FFWatchJob** dynamicJobs = malloc(count * sizeof(*dynamicJobs));
+    uint32_t dynamicCount = 0;
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        all[i] = &jobs[i];
+        if(jobs[i].dynamic)
+            dynamicJobs[dynamicCount++] = &jobs[i];
+    }
+
+    runCaptured(job, data, all, count);
+    uint32_t lineCount = printAll(jobs, count);
+    instance.state.keysHeight = lineCount;
+    free(all);
+
+    if(dynamicCount == 0)
+    {
+        free(dynamicJobs);
+        return;
+    }
+
+    FFstrbuf* previous = malloc(dynamicCount * sizeof(*previous));
+    uint32_t* previousLineCounts = malloc(dynamicCount * sizeof(*previousLineCounts));
+    for(uint32_t i = 0; i < dynamicCount; ++i)
+        ffStrbufInit(&previous[i]);
+
+    bool changed = true;
+    uint64_t nextPass = ffTimeGetTick() + instance.config.watchInterval;
+    while(true)
+    {
+        if(changed)
+        {
+            // Park the cursor below the logo and all modules, where it would be after a normal run.
+            // logoHeight doesn't count the first row of the logo; see ffLogoPrintRemaining
+            uint32_t logoRows = instance.state.logoHeight + 1;
+            uint32_t bottom = lineCount > logoRows ? lineCount : logoRows;
+            printf("\033[%u;1H", bottom + 1);
+            ffOutputFlush();
+        }
+
+        // The interval is kept between the starts of two passes
+        uint64_t now = ffTimeGetTick();
+        if(now < nextPass)
+            ffTimeSleep((uint32_t) (nextPass - now));
+        nextPass = ffTimeGetTick() + instance.config.watchInterval;
+
+        for(uint32_t i = 0; i < dynamicCount; ++i)
+        {
+            FFstrbuf temp = previous[i];
+            previous[i] = dynamicJobs[i]->output;
+            dynamicJobs[i]->output = temp;
+            previousLineCounts[i] = dynamicJobs[i]->lineCount;
+        }
+
+        instance.state.keysHeight = 0;
+        runCaptured(job, data, dynamicJobs, dynamicCount);
+
+        bool relayout = false;
+        for(uint32_t i = 0; i < dynamicCount; ++i)
+            relayout |= dynamicJobs[i]->lineCount != previousLineCounts[i];
+
+        changed = relayout;
+        if(relayout)
+        {
+            fputs("\033[H\033[2J", stdout);
+            ffLogoPrint();
+            lineCount = printAll(jobs, count);
+        }
+        else
+        {
+            for(uint32_t i = 0; i < dynamicCount; ++i)
+            {
+                if(ffStrbufEqual(&dynamicJobs[i]->output, &previous[i]))
+                    continue;
+                rewriteChangedLines(dynamicJobs[i], &previous[i]);
+                changed = true;
+            }
+        }
+        instance.state.keysHeight = lineCount;
+    }
+}
+
+void ffWatchRun(uint32_t count, FFSchedulerJob job, void* data, bool (*isDynamic)(void* data, uint32_t index))
+{
+    if(instance.config.watchInterval == 0 || instance.config.pipe)
+    {
+        ffSchedulerRun(count, job, data);
+        return;
+    }
+
+    FILE* capture = tmpfile();
+    terminalFd = dup(STDOUT_FILENO);
+    if(capture == NULL || terminalFd < 0)
+    {
+        if(capture) fclose(capture);
+        ffSchedulerRun(count, job, data);
+        return;
+    }
+    captureFd = fileno(capture);
+
+    // Timings printed by `--stat` can't be assigned to a module when output is captured
+    instance.config.stat = false;
+
+    FFWatchJob* jobs = calloc(count, sizeof(*jobs));
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        jobs[i].index = i;
+        jobs[i].dynamic = isDynamic(data, i);
+        ffStrbufInit(&jobs[i].output);
+    }
+
+    watch(job, data, jobs, count);
+
+    for(uint32_t i = 0; i < count; ++i)
+        ffStrbufDestroy(&jobs[i].output);
+    free(jobs);
+    fclose(capture);
+    close(terminalFd);
+}
+
+#else //_WIN32
+
+void ffWatchRun(uint32_t count, FFSchedulerJob job, void* data, bool (*isDynamic)(void* data, uint32_t index))
+{
+    FF_UNUSED(isDynamic);
+
+    // Not supported. Print everything once
+    ffSchedulerRun(count, job, data);
+}
+
+#endif //_WIN32
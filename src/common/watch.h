@@ -0,0 +1,19 @@
+#pragma once
+
+#ifndef FF_INCLUDED_common_watch
+#define FF_INCLUDED_common_watch
+
+#include "common/scheduler.h"
+
+#include <stdbool.h>
+
+// `--watch <ms>`: after printing everything once, the jobs of dynamic modules (see FFModuleInfo::dynamic) are run again
+// every interval, and only the lines whose output changed are rewritten in place. Other modules are detected once.
+// The screen is cleared at start (see ffStart), so a line is addressed by its row: the keysHeight ffLogoPrintLine counted for it.
+// If a module prints a different number of lines than before, the whole screen is redrawn from the stored output instead.
+
+// Like ffSchedulerRun. With `--watch`, never returns; the process exits on SIGINT / SIGTERM.
+// `isDynamic` tells whether job `index` prints a dynamic module; it is only called with `--watch`
+void ffWatchRun(uint32_t count, FFSchedulerJob job, void* data, bool (*isDynamic)(void* data, uint32_t index));
+
+#endif
@@ -1,105 +1,57 @@
 #include "fastfetch.h"
 #include "common/io/io.h"
+#include "common/io/sysfs.h"
 #include "battery.h"
 #include "util/stringUtils.h"
 
-#include <dirent.h>
-
-static void parseBattery(FFstrbuf* dir, FFlist* results)
+static bool parseBattery(void* data, int parentFd, const char* name, unsigned char type)
 {
-    uint32_t dirLength = dir->length;
+    FF_UNUSED(type);
+    FFlist* results = data;
 
-    FF_STRBUF_AUTO_DESTROY testBatteryBuffer = ffStrbufCreate();
+    char path[FF_SYSFS_PATH_MAX];
+    char buf[32];
 
     //type must exist and be "Battery"
-    ffStrbufAppendS(dir, "/type");
-    ffReadFileBuffer(dir->chars, &testBatteryBuffer);
-    ffStrbufSubstrBefore(dir, dirLength);
-
-    if(ffStrbufIgnCaseCompS(&testBatteryBuffer, "Battery") != 0)
-        return;
+    if(ffSysfsReadStr(parentFd, ffSysfsEntryPath(path, name, "type"), buf, sizeof(buf)) < 0 || !ffStrEqualsIgnCase(buf, "Battery"))
+        return true;
 
     //scope may not exist or must not be "Device"
-    ffStrbufAppendS(dir, "/scope");
-    ffReadFileBuffer(dir->chars, &testBatteryBuffer);
-    ffStrbufSubstrBefore(dir, dirLength);
-
-    if(ffStrbufIgnCaseCompS(&testBatteryBuffer, "Device") == 0)
-        return;
-
-    BatteryResult* result = ffListAdd(results);
+    if(ffSysfsReadStr(parentFd, ffSysfsEntryPath(path, name, "scope"), buf, sizeof(buf)) > 0 && ffStrEqualsIgnCase(buf, "Device"))
+        return true;
 
     //capacity must exist and be not empty
-    ffStrbufAppendS(dir, "/capacity");
-    bool available = ffReadFileBuffer(dir->chars, &testBatteryBuffer);
-    ffStrbufSubstrBefore(dir, dirLength);
-    if(available)
-        result->capacity = ffStrbufToDouble(&testBatteryBuffer);
-
-    if(!available)
-    {
-        result->capacity = 0.0/0.0;
-        --results->length;
-        return;
-    }
+    double capacity;
+    if(!ffSysfsReadDouble(parentFd, ffSysfsEntryPath(path, name, "capacity"), &capacity))
+        return true;
 
     //At this point, we have a battery. Try to get as much values as possible.
 
+    BatteryResult* result = ffListAdd(results);
+    result->capacity = capacity;
+
     ffStrbufInit(&result->manufacturer);
-    ffStrbufAppendS(dir, "/manufacturer");
-    ffReadFileBuffer(dir->chars, &result->manufacturer);
-    ffStrbufSubstrBefore(dir, dirLength);
+    ffSysfsAppendAttr(parentFd, ffSysfsEntryPath(path, name, "manufacturer"), &result->manufacturer);
 
     ffStrbufInit(&result->modelName);
-    ffStrbufAppendS(dir, "/model_name");
-    ffReadFileBuffer(dir->chars, &result->modelName);
-    ffStrbufSubstrBefore(dir, dirLength);
+    ffSysfsAppendAttr(parentFd, ffSysfsEntryPath(path, name, "model_name"), &result->modelName);
 
     ffStrbufInit(&result->technology);
-    ffStrbufAppendS(dir, "/technology");
-    ffReadFileBuffer(dir->chars, &result->technology);
-    ffStrbufSubstrBefore(dir, dirLength);
+    ffSysfsAppendAttr(parentFd, ffSysfsEntryPath(path, name, "technology"), &result->technology);
 
     ffStrbufInit(&result->status);
-    ffStrbufAppendS(dir, "/status");
-    ffReadFileBuffer(dir->chars, &result->status);
-    ffStrbufSubstrBefore(dir, dirLength);
+    ffSysfsAppendAttr(parentFd, ffSysfsEntryPath(path, name, "status"), &result->status);
 
     result->temperature = FF_BATTERY_TEMP_UNSET;
+    return true;
 }
 
 const char* ffDetectBattery(FFBatteryOptions* options, FFlist* results)
 {
-    FF_STRBUF_AUTO_DESTROY baseDir = ffStrbufCreateA(64);
-
-    if(options->dir.length > 0)
-    {
-        ffStrbufAppend(&baseDir, &options->dir);
-        ffStrbufEnsureEndsWithC(&baseDir, '/');
-    }
-    else
-    {
-        ffStrbufAppendS(&baseDir, "/sys/class/power_supply/");
-    }
-
-    uint32_t baseDirLength = baseDir.length;
-
-    DIR* dirp = opendir(baseDir.chars);
-    if(dirp == NULL)
-        return "opendir(batteryDir) == NULL";
-
-    struct dirent* entry;
-    while((entry = readdir(dirp)) != NULL)
-    {
-        if(ffStrEquals(entry->d_name, ".") || ffStrEquals(entry->d_name, ".."))
-            continue;
+    const char* baseDir = options->dir.length > 0 ? options->dir.chars : "/sys/class/power_supply/";
 
-        ffStrbufAppendS(&baseDir, entry->d_name);
-        parseBattery(&baseDir, results);
-        ffStrbufSubstrBefore(&baseDir, baseDirLength);
-    }
-
-    closedir(dirp);
+    if(!ffDirForEachEntry(AT_FDCWD, baseDir, parseBattery, results))
+        return "opendir(batteryDir) == NULL";
 
     if(results->length == 0)
         return "batteryDir doesn't contain any battery folder";
@@ -4,24 +4,12 @@
 
 #include <stdlib.h>
 
-static void getSmbiosValue(const char* devicesPath, const char* classPath, FFstrbuf* buffer)
-{
-    ffReadFileBuffer(devicesPath, buffer);
-    if(ffIsSmbiosValueSet(buffer))
-        return;
-
-    ffReadFileBuffer(classPath, buffer);
-    if(ffIsSmbiosValueSet(buffer))
-        return;
-
-    ffStrbufClear(buffer);
-}
-
 const char*  ffDetectBios(FFBiosResult* bios)
 {
-    getSmbiosValue("/sys/devices/virtual/dmi/id/bios_date", "/sys/class/dmi/id/bios_date", &bios->date);
-    getSmbiosValue("/sys/devices/virtual/dmi/id/bios_release", "/sys/class/dmi/id/bios_release", &bios->release);
-    getSmbiosValue("/sys/devices/virtual/dmi/id/bios_vendor", "/sys/class/dmi/id/bios_vendor", &bios->vendor);
-    getSmbiosValue("/sys/devices/virtual/dmi/id/bios_version", "/sys/class/dmi/id/bios_version", &bios->version);
+    int FF_AUTO_CLOSE_FD dmiDirFd = ffSmbiosOpenDmiDir();
+    ffSmbiosReadDmiValue(dmiDirFd, "bios_date", &bios->date);
+    ffSmbiosReadDmiValue(dmiDirFd, "bios_release", &bios->release);
+    ffSmbiosReadDmiValue(dmiDirFd, "bios_vendor", &bios->vendor);
+    ffSmbiosReadDmiValue(dmiDirFd, "bios_version", &bios->version);
     return NULL;
 }
@@ -1,64 +1,53 @@
 #include "brightness.h"
 #include "common/io/io.h"
+#include "common/io/sysfs.h"
 #include "util/stringUtils.h"
 
-#include <dirent.h>
 #include <ctype.h>
 #include <limits.h>
+#include <string.h>
 
-static const char* detectWithBacklight(FFlist* result)
+static bool parseBacklight(void* data, int parentFd, const char* name, unsigned char type)
 {
     //https://www.kernel.org/doc/Documentation/ABI/stable/sysfs-class-backlight
-    const char* backlightDirPath = "/sys/class/backlight/";
-
-    DIR* dirp = opendir(backlightDirPath);
-    if(dirp == NULL)
-        return "Failed to open `/sys/class/backlight/`";
+    FF_UNUSED(type);
+    FFlist* result = data;
 
-    FF_STRBUF_AUTO_DESTROY backlightDir = ffStrbufCreateA(64);
-    ffStrbufAppendS(&backlightDir, backlightDirPath);
+    char path[FF_SYSFS_PATH_MAX];
 
-    uint32_t backlightDirLength = backlightDir.length;
+    double actualBrightness, maxBrightness;
+    if(!ffSysfsReadDouble(parentFd, ffSysfsEntryPath(path, name, "actual_brightness"), &actualBrightness) ||
+        !ffSysfsReadDouble(parentFd, ffSysfsEntryPath(path, name, "max_brightness"), &maxBrightness))
+        return true;
 
-    FF_STRBUF_AUTO_DESTROY buffer = ffStrbufCreate();
+    FFBrightnessResult* brightness = (FFBrightnessResult*) ffListAdd(result);
+    brightness->value = (float) (actualBrightness * 100 / maxBrightness);
 
-    struct dirent* entry;
-    while((entry = readdir(dirp)) != NULL)
+    // `device` links to the parent device, whose name is the last component of the link target
+    char target[PATH_MAX];
+    ssize_t length = readlinkat(parentFd, ffSysfsEntryPath(path, name, "device"), target, sizeof(target) - 1);
+    if(length > 0)
     {
-        if(ffStrEquals(entry->d_name, ".") || ffStrEquals(entry->d_name, ".."))
-            continue;
-
-        ffStrbufAppendS(&backlightDir, entry->d_name);
-        ffStrbufAppendS(&backlightDir, "/actual_brightness");
-        if(ffReadFileBuffer(backlightDir.chars, &buffer))
+        target[length] = '\0';
+        const char* deviceName = strrchr(target, '/');
+        deviceName = deviceName ? deviceName + 1 : target;
+        if(ffStrStartsWith(deviceName, "card") && isdigit(deviceName[4]))
         {
-            double actualBrightness = ffStrbufToDouble(&buffer);
-            ffStrbufSubstrBefore(&backlightDir, backlightDirLength);
-            ffStrbufAppendS(&backlightDir, entry->d_name);
-            ffStrbufAppendS(&backlightDir, "/max_brightness");
-            if(ffReadFileBuffer(backlightDir.chars, &buffer))
-            {
-                FFBrightnessResult* brightness = (FFBrightnessResult*) ffListAdd(result);
-                ffStrbufSubstrBeforeLastC(&backlightDir, '/');
-                ffStrbufAppendS(&backlightDir, "/device");
-                ffStrbufInitA(&brightness->name, PATH_MAX + 1);
-                if(realpath(backlightDir.chars, brightness->name.chars))
-                {
-                    ffStrbufRecalculateLength(&brightness->name);
-                    ffStrbufSubstrAfterLastC(&brightness->name, '/');
-                    if(ffStrbufStartsWithS(&brightness->name, "card") && isdigit(brightness->name.chars[4]))
-                        ffStrbufSubstrAfterFirstC(&brightness->name, '-');
-                }
-                else
-                    ffStrbufInitS(&brightness->name, entry->d_name);
-                double maxBrightness = ffStrbufToDouble(&buffer);
-                brightness->value = (float) (actualBrightness * 100 / maxBrightness);
-            }
+            const char* connector = strchr(deviceName, '-');
+            if(connector) deviceName = connector + 1;
         }
-        ffStrbufSubstrBefore(&backlightDir, backlightDirLength);
+        ffStrbufInitS(&brightness->name, deviceName);
     }
+    else
+        ffStrbufInitS(&brightness->name, name);
+
+    return true;
+}
 
-    closedir(dirp);
+static const char* detectWithBacklight(FFlist* result)
+{
+    if(!ffDirForEachEntry(AT_FDCWD, "/sys/class/backlight/", parseBacklight, result))
+        return "Failed to open `/sys/class/backlight/`";
 
     return NULL;
 }
@@ -70,44 +59,33 @@ static const char* detectWithBacklight(FFlist* result)
 
 #include <ddcutil_c_api.h>
 
-static bool findDrmByEdid(const uint8_t srcEdidData[128], FFstrbuf* result)
+typedef struct FFDrmEdidQuery
 {
-    const char* drmDirPath = "/sys/class/drm/";
-
-    DIR* dirp = opendir(drmDirPath);
-    if(dirp == NULL)
-        return false;
-
-    FF_STRBUF_AUTO_DESTROY drmDir = ffStrbufCreateA(64);
-    ffStrbufAppendS(&drmDir, drmDirPath);
-
-    uint32_t drmDirLength = drmDir.length;
+    const uint8_t* edidData;
+    FFstrbuf* result;
+} FFDrmEdidQuery;
 
-    struct dirent* entry;
-    while((entry = readdir(dirp)) != NULL)
-    {
-        if(ffStrEquals(entry->d_name, ".") || ffStrEquals(entry->d_name, ".."))
-            continue;
+static bool matchDrmEdid(void* data, int parentFd, const char* name, unsigned char type)
+{
+    FF_UNUSED(type);
+    FFDrmEdidQuery* query = data;
 
-        ffStrbufAppendS(&drmDir, entry->d_name);
-        ffStrbufAppendS(&drmDir, "/edid");
+    char path[FF_SYSFS_PATH_MAX];
+    uint8_t edidData[128];
+    if(ffSysfsReadData(parentFd, ffSysfsEntryPath(path, name, "edid"), edidData, sizeof(edidData)) != sizeof(edidData) ||
+        memcmp(query->edidData, edidData, sizeof(edidData)) != 0)
+        return true;
 
-        uint8_t edidData[128];
-        if(ffReadFileData(drmDir.chars, sizeof(edidData), edidData) != sizeof(edidData))
-        {
-            ffStrbufSubstrBefore(&drmDir, drmDirLength);
-            continue;
-        }
-        if (memcmp(srcEdidData, edidData, sizeof(edidData)) == 0)
-        {
-            ffStrbufAppendS(result, entry->d_name);
-            closedir(dirp);
-            return true;
-        }
-    }
+    ffStrbufAppendS(query->result, name);
     return false;
 }
 
+static bool findDrmByEdid(const uint8_t srcEdidData[128], FFstrbuf* result)
+{
+    ffDirForEachEntry(AT_FDCWD, "/sys/class/drm/", matchDrmEdid, &(FFDrmEdidQuery) { srcEdidData, result });
+    return result->length > 0;
+}
+
 static const char* detectWithDdcci(FFlist* result)
 {
     FF_LIBRARY_LOAD(libddcutil, &instance.config.libDdcutil, "dlopen ddcutil failed", "libddcutil" FF_LIBRARY_EXTENSION, 4);
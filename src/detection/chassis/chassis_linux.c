@@ -4,24 +4,12 @@
 
 #include <stdlib.h>
 
-static void getSmbiosValue(const char* devicesPath, const char* classPath, FFstrbuf* buffer)
-{
-    ffReadFileBuffer(devicesPath, buffer);
-    if(ffIsSmbiosValueSet(buffer))
-        return;
-
-    ffReadFileBuffer(classPath, buffer);
-    if(ffIsSmbiosValueSet(buffer))
-        return;
-
-    ffStrbufClear(buffer);
-}
-
 const char* ffDetectChassis(FFChassisResult* result)
 {
-    getSmbiosValue("/sys/devices/virtual/dmi/id/chassis_type", "/sys/class/dmi/id/chassis_type", &result->type);
-    getSmbiosValue("/sys/devices/virtual/dmi/id/chassis_vendor", "/sys/class/dmi/id/chassis_vendor", &result->vendor);
-    getSmbiosValue("/sys/devices/virtual/dmi/id/chassis_version", "/sys/class/dmi/id/chassis_version", &result->version);
+    int FF_AUTO_CLOSE_FD dmiDirFd = ffSmbiosOpenDmiDir();
+    ffSmbiosReadDmiValue(dmiDirFd, "chassis_type", &result->type);
+    ffSmbiosReadDmiValue(dmiDirFd, "chassis_vendor", &result->vendor);
+    ffSmbiosReadDmiValue(dmiDirFd, "chassis_version", &result->version);
 
     if(result->type.length)
     {
@@ -1,7 +1,8 @@
 #include "cpu.h"
 #include "common/io/io.h"
+#include "common/io/sysfs.h"
 #include "common/properties.h"
-#include "detection/temps/temps_linux.h"
+#include "detection/sensors/sensors.h"
 
 #include <sys/sysinfo.h>
 #include <stdlib.h>
@@ -41,48 +42,71 @@ static const char* parseCpuInfo(FFCPUResult* cpu, FFstrbuf* physicalCoresBuffer,
     return NULL;
 }
 
-static double getGHz(const char* file)
+static double getGHz(int dirfd, const char* name)
 {
-    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
-    if(ffAppendFileBuffer(file, &content))
-    {
-        double herz = ffStrbufToDouble(&content);
-
-        //ffStrbufToDouble failed
-        if(herz != herz)
-            return 0;
+    double herz;
+    if(!ffSysfsReadDouble(dirfd, name, &herz))
+        return 0;
 
-        herz /= 1000.0; //to MHz
-        return herz / 1000.0; //to GHz
-    }
-    return 0;
+    herz /= 1000.0; //to MHz
+    return herz / 1000.0; //to GHz
 }
 
-static double getFrequency(const char* info, const char* scaling)
+static double getFrequency(int dirfd, const char* info, const char* scaling)
 {
-    double frequency = getGHz(info);
+    double frequency = getGHz(dirfd, info);
     if(frequency > 0.0)
         return frequency;
 
-    return getGHz(scaling);
+    return getGHz(dirfd, scaling);
+}
+
+static bool isCPUSensorChip(const FFSensorChip* chip)
+{
+    return
+        ffStrbufFirstIndexS(&chip->name, "cpu") < chip->name.length || // cpu_thermal and friends of ARM SoCs
+        ffStrbufEqualS(&chip->name, "k10temp") ||
+        ffStrbufEqualS(&chip->name, "zenpower") ||
+        ffStrbufEqualS(&chip->name, "coretemp");
 }
 
 static double detectCPUTemp(void)
 {
-    const FFTempsResult* temps = ffDetectTemps();
+    // Control temperature of AMD CPUs, and the package temperature of Intel CPUs.
+    // Chips without these labels fall back to their first temperature channel
+    static const char* const labels[] = { "Tctl", "Tdie", "Package id 0" };
+
+    double result = FF_CPU_TEMP_UNSET;
+    const FFlist* chips = ffSensorsLock(false);
 
-    for(uint32_t i = 0; i < temps->values.length; i++)
+    for(uint32_t i = 0; i < sizeof(labels) / sizeof(labels[0]) && result != result; ++i)
     {
-        FFTempValue* value = ffListGet(&temps->values, i);
+        FF_LIST_FOR_EACH(FFSensorChip, chip, *chips)
+        {
+            const FFSensorChannel* channel;
+            if(isCPUSensorChip(chip) && (channel = ffSensorsFindChannel(chip, FF_SENSOR_TYPE_TEMPERATURE, labels[i])))
+            {
+                result = channel->value;
+                break;
+            }
+        }
+    }
 
-        if(
-            ffStrbufFirstIndexS(&value->name, "cpu") < value->name.length ||
-            ffStrbufCompS(&value->name, "k10temp") == 0 ||
-            ffStrbufCompS(&value->name, "coretemp") == 0
-        ) return value->value;
+    if(result != result)
+    {
+        FF_LIST_FOR_EACH(FFSensorChip, chip, *chips)
+        {
+            const FFSensorChannel* channel;
+            if(isCPUSensorChip(chip) && (channel = ffSensorsFindChannel(chip, FF_SENSOR_TYPE_TEMPERATURE, NULL)))
+            {
+                result = channel->value;
+                break;
+            }
+        }
     }
 
-    return FF_CPU_TEMP_UNSET;
+    ffSensorsUnlock();
+    return result;
 }
 
 static void parseIsa(FFstrbuf* cpuIsa)
@@ -121,11 +145,11 @@ const char* ffDetectCPUImpl(const FFCPUOptions* options, FFCPUResult* cpu)
     cpu->coresLogical = (uint16_t) get_nprocs_conf();
     cpu->coresOnline = (uint16_t) get_nprocs();
 
-    #define BP "/sys/devices/system/cpu/cpufreq/policy0/"
-    if(ffPathExists(BP, FF_PATHTYPE_DIRECTORY))
+    int FF_AUTO_CLOSE_FD policyFd = ffSysfsOpenDir(AT_FDCWD, "/sys/devices/system/cpu/cpufreq/policy0");
+    if(policyFd >= 0)
     {
-        cpu->frequencyMin = getFrequency(BP"cpuinfo_min_freq", BP"scaling_min_freq");
-        cpu->frequencyMax = getFrequency(BP"cpuinfo_max_freq", BP"scaling_max_freq");
+        cpu->frequencyMin = getFrequency(policyFd, "cpuinfo_min_freq", "scaling_min_freq");
+        cpu->frequencyMax = getFrequency(policyFd, "cpuinfo_max_freq", "scaling_max_freq");
     }
     else
     {
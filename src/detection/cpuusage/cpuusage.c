@@ -1,43 +1,116 @@
 #include "fastfetch.h"
 #include "detection/cpuusage/cpuusage.h"
 #include "common/time.h"
+#include "common/thread.h"
 
 #include <stdint.h>
 
-// We need to use uint64_t because sizeof(long) == 4 on Windows
-const char* ffGetCpuUsageInfo(uint64_t* inUseAll, uint64_t* totalAll);
+// Counters are updated once per scheduler tick (usually 1 - 10 ms); give up if they don't change in 10 intervals
+#define FF_CPUUSAGE_MAX_RETRIES 10
 
-static uint64_t inUseAll1, totalAll1;
+static FFCpuUsageSample preparedSample = { .cores = { .elementSize = sizeof(FFCpuUsageCounters) } };
+static const char* preparedError;
+static FFThreadMutex preparedMutex = FF_THREAD_MUTEX_INITIALIZER;
+
+static void copySample(FFCpuUsageSample* dst, const FFCpuUsageSample* src)
+{
+    dst->tick = src->tick;
+    dst->all = src->all;
+    dst->cores.length = 0;
+    FF_LIST_FOR_EACH(FFCpuUsageCounters, core, src->cores)
+        *(FFCpuUsageCounters*) ffListAdd(&dst->cores) = *core;
+}
+
+const char* ffCpuUsageTakeSample(FFCpuUsageSample* sample)
+{
+    sample->cores.length = 0;
+    sample->tick = ffTimeGetTick();
+    return ffGetCpuUsageInfo(&sample->all, &sample->cores);
+}
 
 void ffPrepareCPUUsage(void)
 {
-    ffGetCpuUsageInfo(&inUseAll1, &totalAll1);
+    preparedError = ffCpuUsageTakeSample(&preparedSample);
+}
+
+const char* ffCpuUsageGetPreparedSample(FFCpuUsageSample* sample)
+{
+    ffThreadMutexLock(&preparedMutex);
+    if(preparedSample.tick == 0)
+        ffPrepareCPUUsage();
+
+    const char* error = preparedError;
+    if(!error)
+        copySample(sample, &preparedSample);
+    ffThreadMutexUnlock(&preparedMutex);
+    return error;
 }
 
-const char* ffGetCpuUsageResult(double* result)
+void ffCpuUsageUpdatePreparedSample(const FFCpuUsageSample* sample)
 {
-    const char* error = NULL;
-    if(inUseAll1 == 0 && totalAll1 == 0)
+    ffThreadMutexLock(&preparedMutex);
+    if(sample->tick > preparedSample.tick)
     {
-        error = ffGetCpuUsageInfo(&inUseAll1, &totalAll1);
-        if(error)
-            return error;
-        ffTimeSleep(200);
+        copySample(&preparedSample, sample);
+        preparedError = NULL;
+    }
+    ffThreadMutexUnlock(&preparedMutex);
+}
+
+static inline double getUsage(const FFCpuUsageCounters* before, const FFCpuUsageCounters* after)
+{
+    return (double)(after->inUse - before->inUse) / (double)(after->total - before->total) * 100;
+}
+
+static void computeCores(const FFCpuUsageSample* baseline, const FFCpuUsageSample* sample, FFlist* result)
+{
+    // Both lists are ordered by id; CPUs going on- or offline in between are skipped
+    uint32_t i = 0, j = 0;
+    while(i < baseline->cores.length && j < sample->cores.length)
+    {
+        const FFCpuUsageCounters* before = ffListGet(&baseline->cores, i);
+        const FFCpuUsageCounters* after = ffListGet(&sample->cores, j);
+
+        if(before->id < after->id)
+            ++i;
+        else if(before->id > after->id)
+            ++j;
+        else
+        {
+            if(after->total > before->total && after->inUse >= before->inUse)
+            {
+                FFCpuUsageCore* core = ffListAdd(result);
+                core->id = after->id;
+                core->node = after->node;
+                core->usage = getUsage(before, after);
+            }
+            ++i;
+            ++j;
+        }
     }
+}
+
+const char* ffGetCpuUsageResult(const FFCpuUsageSample* baseline, FFCpuUsageSample* sample, FFCpuUsageResult* result)
+{
+    uint64_t elapsed = ffTimeGetTick() - baseline->tick;
+    if(elapsed < FF_CPUUSAGE_MIN_INTERVAL)
+        ffTimeSleep((uint32_t) (FF_CPUUSAGE_MIN_INTERVAL - elapsed));
 
-    while(true)
+    for(uint32_t retry = 0; ; ++retry)
     {
-        uint64_t inUseAll2, totalAll2;
-        error = ffGetCpuUsageInfo(&inUseAll2, &totalAll2);
+        const char* error = ffCpuUsageTakeSample(sample);
         if(error)
             return error;
 
-        if(inUseAll2 != inUseAll1)
-        {
-            *result = (double)(inUseAll2 - inUseAll1) / (double)(totalAll2 - totalAll1) * 100;
-            return NULL;
-        }
-        else
-            ffTimeSleep(200);
+        if(sample->all.total > baseline->all.total && sample->all.inUse >= baseline->all.inUse)
+            break;
+
+        if(retry == FF_CPUUSAGE_MAX_RETRIES)
+            return "CPU time counters didn't change";
+        ffTimeSleep(FF_CPUUSAGE_MIN_INTERVAL);
     }
+
+    result->all = getUsage(&baseline->all, &sample->all);
+    computeCores(baseline, sample, &result->cores);
+    return NULL;
 }
@@ -3,6 +3,55 @@
 #ifndef FF_INCLUDED_detection_cpuusage_cpuusage
 #define FF_INCLUDED_detection_cpuusage_cpuusage
 
-const char* ffGetCpuUsageResult(double* result);
+#include "util/FFlist.h"
+
+#include <stdint.h>
+
+// Usage is computed between two samples. If they are closer than this, the second one is delayed until they aren't
+#define FF_CPUUSAGE_MIN_INTERVAL 100 // ms
+
+// Time a CPU was busy / spent in total since boot, in platform specific units
+typedef struct FFCpuUsageCounters
+{
+    uint32_t id; // CPU number
+    uint32_t node; // NUMA node; 0 if unknown
+    uint64_t inUse;
+    uint64_t total;
+} FFCpuUsageCounters;
+
+typedef struct FFCpuUsageSample
+{
+    uint64_t tick; // ffTimeGetTick() when taken; comparable between processes of the same boot
+    FFCpuUsageCounters all; // Sum of all CPUs
+    FFlist cores; // FFCpuUsageCounters, ordered by id. Empty if the platform only reports the sum
+} FFCpuUsageSample;
+
+typedef struct FFCpuUsageCore
+{
+    uint32_t id;
+    uint32_t node;
+    double usage; // Percent
+} FFCpuUsageCore;
+
+typedef struct FFCpuUsageResult
+{
+    double all; // Percent
+    FFlist cores; // FFCpuUsageCore, of the CPUs that are in both samples
+} FFCpuUsageResult;
+
+// Implemented per platform. Fills `all`, and appends to `cores` if the platform reports single CPUs
+const char* ffGetCpuUsageInfo(FFCpuUsageCounters* all, FFlist* cores);
+
+// `sample->cores` must have been initialized; it is cleared first
+const char* ffCpuUsageTakeSample(FFCpuUsageSample* sample);
+// Copies the sample taken by ffPrepareCPUUsage at startup, or the last one passed to ffCpuUsageUpdatePreparedSample.
+// Takes it now if neither happened
+const char* ffCpuUsageGetPreparedSample(FFCpuUsageSample* sample);
+// Makes `sample` the baseline of later calls, so that `--watch` prints the usage since the previous interval. Ignored if older
+void ffCpuUsageUpdatePreparedSample(const FFCpuUsageSample* sample);
+// Takes a second sample into `sample` and computes the usage since `baseline`.
+// Only sleeps for what's left of FF_CPUUSAGE_MIN_INTERVAL since the baseline was taken.
+// `result->cores` must have been initialized
+const char* ffGetCpuUsageResult(const FFCpuUsageSample* baseline, FFCpuUsageSample* sample, FFCpuUsageResult* result);
 
 #endif
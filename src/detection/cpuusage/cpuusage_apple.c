@@ -3,21 +3,33 @@
 
 #include <mach/processor_info.h>
 #include <mach/mach_host.h>
+#include <mach/vm_map.h>
 
-const char* ffGetCpuUsageInfo(uint64_t* inUseAll, uint64_t* totalAll)
+const char* ffGetCpuUsageInfo(FFCpuUsageCounters* all, FFlist* cores)
 {
-	host_cpu_load_info_data_t cpustats;
-	mach_msg_type_number_t count = HOST_CPU_LOAD_INFO_COUNT;
+    natural_t cpuCount;
+    processor_cpu_load_info_t cpuLoad;
+    mach_msg_type_number_t infoCount;
 
-    *inUseAll = *totalAll = 0;
+    *all = (FFCpuUsageCounters) { .id = UINT32_MAX };
 
-    if (host_statistics(mach_host_self(), HOST_CPU_LOAD_INFO, (host_info_t)(&cpustats), &count) != KERN_SUCCESS)
-        return "host_statistics() failed";
+    if (host_processor_info(mach_host_self(), PROCESSOR_CPU_LOAD_INFO, &cpuCount, (processor_info_array_t*) &cpuLoad, &infoCount) != KERN_SUCCESS)
+        return "host_processor_info() failed";
 
-    *inUseAll = cpustats.cpu_ticks[CPU_STATE_USER]
-        + cpustats.cpu_ticks[CPU_STATE_SYSTEM]
-        + cpustats.cpu_ticks[CPU_STATE_NICE];
-    *totalAll = *inUseAll + cpustats.cpu_ticks[CPU_STATE_IDLE];
+    for (natural_t i = 0; i < cpuCount; ++i)
+    {
+        FFCpuUsageCounters* core = ffListAdd(cores);
+        core->id = i;
+        core->node = 0;
+        core->inUse = (uint64_t) cpuLoad[i].cpu_ticks[CPU_STATE_USER]
+            + cpuLoad[i].cpu_ticks[CPU_STATE_SYSTEM]
+            + cpuLoad[i].cpu_ticks[CPU_STATE_NICE];
+        core->total = core->inUse + cpuLoad[i].cpu_ticks[CPU_STATE_IDLE];
 
+        all->inUse += core->inUse;
+        all->total += core->total;
+    }
+
+    vm_deallocate(mach_task_self(), (vm_address_t) cpuLoad, infoCount * sizeof(integer_t));
     return NULL;
 }
@@ -1,19 +1,39 @@
 #include "detection/cpuusage/cpuusage.h"
+#include "util/mallocHelper.h"
 
+#include <stdlib.h>
 #include <sys/types.h>
+#include <sys/resource.h>
 #include <sys/user.h>
 #include <sys/sysctl.h>
 
-const char* ffGetCpuUsageInfo(uint64_t* inUseAll, uint64_t* totalAll)
+const char* ffGetCpuUsageInfo(FFCpuUsageCounters* all, FFlist* cores)
 {
-    // interrupt processing, user processes, system processing, lock spinning, and idling
-    uint64_t cpTime[5];
-    size_t neededLength = sizeof(cpTime);
-    if(sysctlbyname("kern.cp_time", cpTime, &neededLength, NULL, 0) != 0)
-        return "sysctlbyname(kern.cp_time) failed";
-
-    *inUseAll = cpTime[0] + cpTime[1] + cpTime[2] + cpTime[3];
-    *totalAll = *inUseAll + cpTime[4];
+    // For every CPU: interrupt processing, user processes, system processing, lock spinning, and idling
+    size_t neededLength = 0;
+    if(sysctlbyname("kern.cp_times", NULL, &neededLength, NULL, 0) != 0 || neededLength == 0)
+        return "sysctlbyname(kern.cp_times, NULL) failed";
+
+    long* FF_AUTO_FREE cpTimes = malloc(neededLength);
+    if(sysctlbyname("kern.cp_times", cpTimes, &neededLength, NULL, 0) != 0)
+        return "sysctlbyname(kern.cp_times) failed";
+
+    *all = (FFCpuUsageCounters) { .id = UINT32_MAX };
+
+    uint32_t cpuCount = (uint32_t) (neededLength / (sizeof(long) * CPUSTATES));
+    for(uint32_t i = 0; i < cpuCount; ++i)
+    {
+        const long* cpTime = cpTimes + i * CPUSTATES;
+
+        FFCpuUsageCounters* core = ffListAdd(cores);
+        core->id = i;
+        core->node = 0;
+        core->inUse = (uint64_t) (cpTime[CP_USER] + cpTime[CP_NICE] + cpTime[CP_SYS] + cpTime[CP_INTR]);
+        core->total = core->inUse + (uint64_t) cpTime[CP_IDLE];
+
+        all->inUse += core->inUse;
+        all->total += core->total;
+    }
 
     return NULL;
 }
@@ -1,32 +1,156 @@
 #include "fastfetch.h"
 #include "detection/cpuusage/cpuusage.h"
+#include "common/io/io.h"
+#include "common/io/sysfs.h"
+#include "common/thread.h"
+#include "util/mallocHelper.h"
 
+#include <fcntl.h>
 #include <stdio.h>
-#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
-const char* ffGetCpuUsageInfo(uint64_t* inUseAll, uint64_t* totalAll)
+// /proc/stat is opened once and read with a single pread from offset 0 per sample, which makes the kernel generate it again.
+// Only the "cpu" lines at its start are parsed; the buffer grows until they fit (~70 bytes per CPU)
+
+static FFThreadMutex mutex = FF_THREAD_MUTEX_INITIALIZER;
+static bool init;
+static int statFd = -1;
+static FFlist cpuNodes; // uint32_t, NUMA node of every CPU number
+static uint32_t bufferSize = 4096;
+
+static void addNodeCpus(uint32_t node, const char* cpuList)
 {
-    uint64_t user = 0, nice = 0, system = 0, idle = 0, iowait = 0, irq = 0, softirq = 0;
+    // "0-3,8-11\n"
+    const char* p = cpuList;
+    while(*p >= '0' && *p <= '9')
+    {
+        char* end;
+        uint32_t first = (uint32_t) strtoul(p, &end, 10);
+        uint32_t last = *end == '-' ? (uint32_t) strtoul(end + 1, &end, 10) : first;
+        for(uint32_t cpu = first; cpu <= last && cpu < 65536; ++cpu)
+        {
+            while(cpuNodes.length <= cpu)
+                *(uint32_t*) ffListAdd(&cpuNodes) = 0;
+            *(uint32_t*) ffListGet(&cpuNodes, cpu) = node;
+        }
+        p = *end == ',' ? end + 1 : end;
+    }
+}
+
+static bool addNode(void* data, int parentFd, const char* name, unsigned char type)
+{
+    FF_UNUSED(data, type);
+
+    if(strncmp(name, "node", 4) != 0 || name[4] < '0' || name[4] > '9')
+        return true;
+
+    char path[FF_SYSFS_PATH_MAX];
+    FF_STRBUF_AUTO_DESTROY cpuList = ffStrbufCreate();
+    if(ffSysfsAppendAttr(parentFd, ffSysfsEntryPath(path, name, "cpulist"), &cpuList))
+        addNodeCpus((uint32_t) strtoul(name + 4, NULL, 10), cpuList.chars);
+    return true;
+}
 
-    FILE* procStat = fopen("/proc/stat", "r");
-    if(procStat == NULL)
+static void initOnce(void)
+{
+    ffThreadMutexLock(&mutex);
+    if(!init)
+    {
+        statFd = open("/proc/stat", O_RDONLY | O_CLOEXEC);
+        ffListInit(&cpuNodes, sizeof(uint32_t));
+        ffDirForEachEntry(AT_FDCWD, "/sys/devices/system/node", addNode, NULL);
+        init = true;
+    }
+    ffThreadMutexUnlock(&mutex);
+}
+
+// Parses a decimal number after optional spaces. Stops at the first non digit
+static inline const char* parseNumber(const char* p, uint64_t* value)
+{
+    while(*p == ' ')
+        ++p;
+
+    uint64_t result = 0;
+    for(uint32_t digit; (digit = (uint32_t) (uint8_t) *p - '0') < 10; ++p)
+        result = result * 10 + digit;
+    *value = result;
+    return p;
+}
+
+// Parses the rest of a "cpu" line: user nice system idle iowait irq softirq steal guest guest_nice.
+// guest and guest_nice are already accounted in user and nice. Older kernels print less fields
+static const char* parseCounters(const char* p, FFCpuUsageCounters* counters)
+{
+    uint64_t values[8] = {};
+    for(uint32_t i = 0; i < 8 && *p != '\n' && *p != '\0'; ++i)
+        p = parseNumber(p, &values[i]);
+
+    uint64_t idle = values[3] + values[4];
+    counters->total = values[0] + values[1] + values[2] + values[5] + values[6] + values[7] + idle;
+    counters->inUse = counters->total - idle;
+
+    const char* end = strchr(p, '\n');
+    return end ? end + 1 : NULL;
+}
+
+// Returns false if the buffer may end before the last cpu line does
+static bool parseStat(const char* p, FFCpuUsageCounters* all, FFlist* cores)
+{
+    *all = (FFCpuUsageCounters) { .id = UINT32_MAX };
+    if(strncmp(p, "cpu ", 4) != 0)
+        return true;
+
+    p = parseCounters(p + 4, all);
+
+    while(p && p[0] == 'c' && p[1] == 'p' && p[2] == 'u')
+    {
+        uint64_t id;
+        const char* next = parseNumber(p + 3, &id);
+        FFCpuUsageCounters* core = ffListAdd(cores);
+        core->id = (uint32_t) id;
+        core->node = id < cpuNodes.length ? *(uint32_t*) ffListGet(&cpuNodes, (uint32_t) id) : 0;
+        p = parseCounters(next, core);
+        if(!p)
+            --cores->length; // Truncated
+    }
+
+    return p && *p != '\0';
+}
+
+const char* ffGetCpuUsageInfo(FFCpuUsageCounters* all, FFlist* cores)
+{
+    initOnce();
+    if(statFd < 0)
     {
         #ifdef __ANDROID__
         return "Accessing \"/proc/stat\" is restricted on Android O+";
         #else
-        return "fopen(\"""/proc/stat\", \"r\") == NULL";
+        return "open(\"/proc/stat\", O_RDONLY) failed";
         #endif
     }
 
-    if (fscanf(procStat, "cpu%" PRIu64 "%" PRIu64 "%" PRIu64 "%" PRIu64 "%" PRIu64 "%" PRIu64 "%" PRIu64, &user, &nice, &system, &idle, &iowait, &irq, &softirq) < 0)
+    uint32_t size = __atomic_load_n(&bufferSize, __ATOMIC_RELAXED);
+    while(true)
     {
-        fclose(procStat);
-        return "fscanf() failed";
+        char* FF_AUTO_FREE buffer = malloc(size);
+        ssize_t length = pread(statFd, buffer, size - 1, 0);
+        if(length <= 0)
+            return "pread(\"/proc/stat\") failed";
+        buffer[length] = '\0';
+
+        uint32_t coreCount = cores->length;
+        if(parseStat(buffer, all, cores) || (size_t) length < size - 1)
+            break;
+
+        cores->length = coreCount;
+        size *= 2;
+        __atomic_store_n(&bufferSize, size, __ATOMIC_RELAXED);
     }
-    *inUseAll = user + nice + system;
-    *totalAll = *inUseAll + idle + iowait + irq + softirq;
 
-    fclose(procStat);
+    if(all->total == 0)
+        return "No \"cpu\" line found in \"/proc/stat\"";
 
     return NULL;
 }
@@ -6,7 +6,7 @@
 #include <ntstatus.h>
 #include <winternl.h>
 
-const char* ffGetCpuUsageInfo(uint64_t* inUseAll, uint64_t* totalAll)
+const char* ffGetCpuUsageInfo(FFCpuUsageCounters* all, FFlist* cores)
 {
     ULONG size = 0;
     if(NtQuerySystemInformation(SystemProcessorPerformanceInformation, NULL, 0, &size) != STATUS_INFO_LENGTH_MISMATCH)
@@ -16,7 +16,7 @@ const char* ffGetCpuUsageInfo(uint64_t* inUseAll, uint64_t* totalAll)
     if(!NT_SUCCESS(NtQuerySystemInformation(SystemProcessorPerformanceInformation, pinfo, size, &size)))
         return "NtQuerySystemInformation(SystemProcessorPerformanceInformation, size) failed";
 
-    *inUseAll = *totalAll = 0;
+    *all = (FFCpuUsageCounters) { .id = UINT32_MAX };
 
     for (uint32_t i = 0; i < size / sizeof(SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION); ++i)
     {
@@ -29,8 +29,15 @@ const char* ffGetCpuUsageInfo(uint64_t* inUseAll, uint64_t* totalAll)
         coreInfo->KernelTime.QuadPart += dpcTime + interruptTime;
 
         LONGLONG inUse = coreInfo->UserTime.QuadPart + coreInfo->KernelTime.QuadPart;
-        *inUseAll += (uint64_t)inUse;
-        *totalAll += (uint64_t)(inUse + coreInfo->IdleTime.QuadPart);
+
+        FFCpuUsageCounters* core = ffListAdd(cores);
+        core->id = i;
+        core->node = 0;
+        core->inUse = (uint64_t)inUse;
+        core->total = (uint64_t)(inUse + coreInfo->IdleTime.QuadPart);
+
+        all->inUse += core->inUse;
+        all->total += core->total;
     }
 
     return NULL;
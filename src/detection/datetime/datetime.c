@@ -4,43 +4,62 @@
 
 #include <time.h>
 
+static void setTimeString(FFstrbuf* buffer, const char* format, const struct tm* tm)
+{
+    ffStrbufClear(buffer);
+    buffer->length = (uint32_t) strftime(buffer->chars, ffStrbufGetFree(buffer), format, tm);
+}
+
 const FFDateTimeResult* ffDetectDateTime(void)
 {
     static FFDateTimeResult result;
     static FFThreadMutex mutex = FF_THREAD_MUTEX_INITIALIZER;
     static bool init = false;
+    static time_t resultTime;
+
+    // The result is shared by all DateTime modules, and updated when the time changes (`--watch`).
+    // The buffers are never reallocated, so a module printing it meanwhile may only mix up two seconds
+    const time_t t = time(NULL);
 
     ffThreadMutexLock(&mutex);
-    if (init)
+    if (init && t == resultTime)
     {
         ffThreadMutexUnlock(&mutex);
         return &result;
     }
-    init = true;
 
-    const time_t t = time(NULL);
+    if (!init)
+    {
+        ffStrbufInitA(&result.monthPretty, FASTFETCH_STRBUF_DEFAULT_ALLOC);
+        ffStrbufInitA(&result.monthName, FASTFETCH_STRBUF_DEFAULT_ALLOC);
+        ffStrbufInitA(&result.monthNameShort, FASTFETCH_STRBUF_DEFAULT_ALLOC);
+        ffStrbufInitA(&result.weekday, FASTFETCH_STRBUF_DEFAULT_ALLOC);
+        ffStrbufInitA(&result.weekdayShort, FASTFETCH_STRBUF_DEFAULT_ALLOC);
+        ffStrbufInitA(&result.hourPretty, FASTFETCH_STRBUF_DEFAULT_ALLOC);
+        ffStrbufInitA(&result.hour12Pretty, FASTFETCH_STRBUF_DEFAULT_ALLOC);
+        ffStrbufInitA(&result.minutePretty, FASTFETCH_STRBUF_DEFAULT_ALLOC);
+        ffStrbufInitA(&result.secondPretty, FASTFETCH_STRBUF_DEFAULT_ALLOC);
+        init = true;
+    }
+    resultTime = t;
+
     struct tm* tm = localtime(&t);
 
     result.year = (uint16_t) (tm->tm_year + 1900);
     result.yearShort = (uint8_t) (result.year % 100);
     result.month = (uint8_t) (tm->tm_mon + 1);
 
-    ffStrbufInitA(&result.monthPretty, FASTFETCH_STRBUF_DEFAULT_ALLOC);
-    result.monthPretty.length = (uint32_t) strftime(result.monthPretty.chars, ffStrbufGetFree(&result.monthPretty), "%m", tm);
+    setTimeString(&result.monthPretty, "%m", tm);
 
-    ffStrbufInitA(&result.monthName, FASTFETCH_STRBUF_DEFAULT_ALLOC);
-    result.monthName.length = (uint32_t) strftime(result.monthName.chars, ffStrbufGetFree(&result.monthName), "%B", tm);
+    setTimeString(&result.monthName, "%B", tm);
 
-    ffStrbufInitA(&result.monthNameShort, FASTFETCH_STRBUF_DEFAULT_ALLOC);
-    result.monthNameShort.length = (uint32_t) strftime(result.monthNameShort.chars, ffStrbufGetFree(&result.monthNameShort), "%b", tm);
+    setTimeString(&result.monthNameShort, "%b", tm);
 
     result.week = (uint8_t) (tm->tm_yday / 7 + 1);
 
-    ffStrbufInitA(&result.weekday, FASTFETCH_STRBUF_DEFAULT_ALLOC);
-    result.weekday.length = (uint32_t) strftime(result.weekday.chars, ffStrbufGetFree(&result.weekday), "%A", tm);
+    setTimeString(&result.weekday, "%A", tm);
 
-    ffStrbufInitA(&result.weekdayShort, FASTFETCH_STRBUF_DEFAULT_ALLOC);
-    result.weekdayShort.length = (uint32_t) strftime(result.weekdayShort.chars, ffStrbufGetFree(&result.weekdayShort), "%a", tm);
+    setTimeString(&result.weekdayShort, "%a", tm);
 
     result.dayInYear = (uint8_t) (tm->tm_yday + 1);
     result.dayInMonth = (uint8_t) tm->tm_mday;
@@ -48,23 +67,19 @@ const FFDateTimeResult* ffDetectDateTime(void)
 
     result.hour = (uint8_t) tm->tm_hour;
 
-    ffStrbufInitA(&result.hourPretty, FASTFETCH_STRBUF_DEFAULT_ALLOC);
-    result.hourPretty.length = (uint32_t) strftime(result.hourPretty.chars, ffStrbufGetFree(&result.hourPretty), "%H", tm);
+    setTimeString(&result.hourPretty, "%H", tm);
 
     result.hour12 = (uint8_t) (result.hour % 12);
 
-    ffStrbufInitA(&result.hour12Pretty, FASTFETCH_STRBUF_DEFAULT_ALLOC);
-    result.hour12Pretty.length = (uint32_t) strftime(result.hour12Pretty.chars, ffStrbufGetFree(&result.hour12Pretty), "%I", tm);
+    setTimeString(&result.hour12Pretty, "%I", tm);
 
     result.minute = (uint8_t) tm->tm_min;
 
-    ffStrbufInitA(&result.minutePretty, FASTFETCH_STRBUF_DEFAULT_ALLOC);
-    result.minutePretty.length = (uint32_t) strftime(result.minutePretty.chars, ffStrbufGetFree(&result.minutePretty), "%M", tm);
+    setTimeString(&result.minutePretty, "%M", tm);
 
     result.second = (uint8_t) tm->tm_sec;
 
-    ffStrbufInitA(&result.secondPretty, FASTFETCH_STRBUF_DEFAULT_ALLOC);
-    result.secondPretty.length = (uint32_t) strftime(result.secondPretty.chars, ffStrbufGetFree(&result.secondPretty), "%S", tm);
+    setTimeString(&result.secondPretty, "%S", tm);
 
     ffThreadMutexUnlock(&mutex);
     return &result;
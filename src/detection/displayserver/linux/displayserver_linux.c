@@ -1,68 +1,56 @@
 #include "displayserver_linux.h"
+#include "common/io/io.h"
+#include "common/io/sysfs.h"
 #include "util/stringUtils.h"
 
-#include <dirent.h>
+#include <stdlib.h>
 
-static void parseDRM(FFDisplayServerResult* result)
+static bool parseDRMConnector(void* data, int parentFd, const char* name, unsigned char type)
 {
-    const char* drmDirPath = "/sys/class/drm/";
-
-    DIR* dirp = opendir(drmDirPath);
-    if(dirp == NULL)
-        return;
-
-    FF_STRBUF_AUTO_DESTROY drmDir = ffStrbufCreateA(64);
-    ffStrbufAppendS(&drmDir, drmDirPath);
-
-    uint32_t drmDirLength = drmDir.length;
-
-    struct dirent* entry;
-    while((entry = readdir(dirp)) != NULL)
+    FF_UNUSED(type);
+    FFDisplayServerResult* result = data;
+
+    // Only the first (preferred) mode is needed, e.g. "1920x1080"
+    char path[FF_SYSFS_PATH_MAX];
+    char mode[32];
+    if(ffSysfsReadStr(parentFd, ffSysfsEntryPath(path, name, "modes"), mode, sizeof(mode)) <= 0)
+        return true;
+
+    char* end;
+    uint32_t width = (uint32_t) strtoul(mode, &end, 10);
+    if(*end != 'x')
+        return true;
+    uint32_t height = (uint32_t) strtoul(end + 1, NULL, 10);
+
+    if(width > 0 && height > 0)
     {
-        if(ffStrEquals(entry->d_name, ".") || ffStrEquals(entry->d_name, ".."))
-            continue;
-
-        ffStrbufAppendS(&drmDir, entry->d_name);
-        ffStrbufAppendS(&drmDir, "/modes");
-
-        FILE* modeFile = fopen(drmDir.chars, "r");
-        if(modeFile == NULL)
+        const char* plainName = name;
+        if (ffStrStartsWith(plainName, "card"))
         {
-            ffStrbufSubstrBefore(&drmDir, drmDirLength);
-            continue;
+            const char* tmp = strchr(plainName + strlen("card"), '-');
+            if (tmp) plainName = tmp + 1;
         }
 
-        uint32_t width = 0, height = 0;
-
-        int scanned = fscanf(modeFile, "%ux%u", &width, &height);
-        if(scanned == 2 && width > 0 && height > 0)
-        {
-            const char* plainName = entry->d_name;
-            if (ffStrStartsWith(plainName, "card"))
-            {
-                const char* tmp = strchr(plainName + strlen("card"), '-');
-                if (tmp) plainName = tmp + 1;
-            }
-
-            FF_STRBUF_AUTO_DESTROY name = ffStrbufCreateS(plainName);
-            ffdsAppendDisplay(
-                result,
-                width, height,
-                0,
-                0, 0,
-                0,
-                &name,
-                FF_DISPLAY_TYPE_UNKNOWN,
-                false,
-                0
-            );
-        }
-
-        fclose(modeFile);
-        ffStrbufSubstrBefore(&drmDir, drmDirLength);
+        FF_STRBUF_AUTO_DESTROY displayName = ffStrbufCreateS(plainName);
+        ffdsAppendDisplay(
+            result,
+            width, height,
+            0,
+            0, 0,
+            0,
+            &displayName,
+            FF_DISPLAY_TYPE_UNKNOWN,
+            false,
+            0
+        );
     }
 
-    closedir(dirp);
+    return true;
+}
+
+static void parseDRM(FFDisplayServerResult* result)
+{
+    ffDirForEachEntry(AT_FDCWD, "/sys/class/drm/", parseDRMConnector, result);
 }
 
 void ffConnectDisplayServerImpl(FFDisplayServerResult* ds)
@@ -2,7 +2,7 @@
 #include "common/io/io.h"
 #include "common/properties.h"
 #include "common/parsing.h"
-#include "common/processing.h"
+#include "common/exeversion.h"
 #include "util/stringUtils.h"
 
 #include <stdlib.h>
@@ -156,7 +156,7 @@ static void getKDE(FFDisplayServerResult* result)
 
     if(result->deVersion.length == 0 && instance.config.allowSlowOperations)
     {
-        if (ffProcessAppendStdOut(&result->deVersion, (char* const[]){
+        if (ffExeVersionAppendStdOut(&result->deVersion, (char* const[]){
             "plasmashell",
             "--version",
             NULL
@@ -181,7 +181,7 @@ static void getGnome(FFDisplayServerResult* result)
 
     if (result->deVersion.length == 0)
     {
-        if (ffProcessAppendStdOut(&result->deVersion, (char* const[]){
+        if (ffExeVersionAppendStdOut(&result->deVersion, (char* const[]){
             "gnome-shell",
             "--version",
             NULL
@@ -216,7 +216,7 @@ static void getMate(FFDisplayServerResult* result)
 
     if(result->deVersion.length == 0 && instance.config.allowSlowOperations)
     {
-        ffProcessAppendStdOut(&result->deVersion, (char* const[]){
+        ffExeVersionAppendStdOut(&result->deVersion, (char* const[]){
             "mate-session",
             "--version",
             NULL
@@ -236,7 +236,7 @@ static void getXFCE4(FFDisplayServerResult* result)
     if(result->deVersion.length == 0 && instance.config.allowSlowOperations)
     {
         //This is somewhat slow
-        ffProcessAppendStdOut(&result->deVersion, (char* const[]){
+        ffExeVersionAppendStdOut(&result->deVersion, (char* const[]){
             "xfce4-session",
             "--version",
             NULL
@@ -262,7 +262,7 @@ static void getLXQt(FFDisplayServerResult* result)
     if(result->deVersion.length == 0 && instance.config.allowSlowOperations)
     {
         //This is really, really, really slow. Thank you, LXQt developers
-        ffProcessAppendStdOut(&result->deVersion, (char* const[]){
+        ffExeVersionAppendStdOut(&result->deVersion, (char* const[]){
             "lxqt-session",
             "-v",
             NULL
@@ -1,42 +1,33 @@
 #include "gamepad.h"
 #include "common/io/io.h"
+#include "common/io/sysfs.h"
 #include "util/stringUtils.h"
 
-#include <dirent.h>
 #include <ctype.h>
 
-const char* ffDetectGamepad(FFlist* devices /* List of FFGamepadDevice */)
+static bool addJoystick(void* data, int parentFd, const char* name, unsigned char type)
 {
-    DIR* dirp = opendir("/sys/class/input/");
-    if(dirp == NULL)
-        return "opendir(\"/sys/class/input/\") == NULL";
-
-    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreateS("/sys/class/input/");
-    uint32_t baseLen = path.length;
-
-    struct dirent* entry;
-    while((entry = readdir(dirp)) != NULL)
-    {
-        if(!ffStrStartsWith(entry->d_name, "js"))
-            continue;
-        if(!isdigit(entry->d_name[2]))
-            continue;
+    FF_UNUSED(type);
+    FFlist* devices = data;
 
-        ffStrbufAppendS(&path, entry->d_name);
-        ffStrbufAppendS(&path, "/device/name");
+    if(!ffStrStartsWith(name, "js") || !isdigit(name[2]))
+        return true;
 
-        if (ffPathExists(path.chars, FF_PATHTYPE_FILE))
-        {
-            FFGamepadDevice* device = (FFGamepadDevice*) ffListAdd(devices);
-            ffStrbufInitS(&device->identifier, entry->d_name);
-            ffStrbufInit(&device->name);
-            ffAppendFileBuffer(path.chars, &device->name);
-        }
+    char path[FF_SYSFS_PATH_MAX];
+    FF_STRBUF_AUTO_DESTROY deviceName = ffStrbufCreate();
+    if(!ffSysfsAppendAttr(parentFd, ffSysfsEntryPath(path, name, "device/name"), &deviceName))
+        return true;
 
-        ffStrbufSubstrBefore(&path, baseLen);
-    }
+    FFGamepadDevice* device = (FFGamepadDevice*) ffListAdd(devices);
+    ffStrbufInitS(&device->identifier, name);
+    ffStrbufInitMove(&device->name, &deviceName);
+    return true;
+}
 
-    closedir(dirp);
+const char* ffDetectGamepad(FFlist* devices /* List of FFGamepadDevice */)
+{
+    if(!ffDirForEachEntry(AT_FDCWD, "/sys/class/input/", addJoystick, devices))
+        return "opendir(\"/sys/class/input/\") == NULL";
 
     return NULL;
 }
@@ -5,8 +5,9 @@
 #include "common/library.h"
 #include "common/properties.h"
 #include "common/parsing.h"
-#include "detection/temps/temps_linux.h"
+#include "detection/sensors/sensors.h"
 #include "util/stringUtils.h"
+#include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 #include <pci/pci.h>
@@ -132,19 +133,36 @@ static void pciDetectDriverName(FFGPUResult* gpu, PCIData* pci, struct pci_dev*
 
 FF_MAYBE_UNUSED static void pciDetectTemp(FFGPUResult* gpu, struct pci_dev* device)
 {
-    const FFTempsResult* tempsResult = ffDetectTemps();
+    char address[32];
+    snprintf(address, sizeof(address), "%04x:%02x:%02x.%d", device->domain, device->bus, device->dev, device->func);
 
-    for(uint32_t i = 0; i < tempsResult->values.length; i++)
-    {
-        FFTempValue* tempValue = ffListGet(&tempsResult->values, i);
+    const FFlist* chips = ffSensorsLock(false);
 
-        //The kernel exposes the device class multiplied by 256 for some reason
-        if(tempValue->deviceClass == device->device_class * 256)
+    // Match the hwmon chip of this very device; fall back to the first chip of the same device class
+    const FFSensorChip* gpuChip = NULL;
+    FF_LIST_FOR_EACH(FFSensorChip, chip, *chips)
+    {
+        if(ffStrbufEqualS(&chip->device, address))
         {
-            gpu->temperature = tempValue->value;
-            return;
+            gpuChip = chip;
+            break;
         }
+        //The kernel exposes the device class multiplied by 256 for some reason
+        if(!gpuChip && chip->deviceClass == device->device_class * 256u)
+            gpuChip = chip;
     }
+
+    if(gpuChip)
+    {
+        // amdgpu reports edge, junction (hotspot) and mem temperatures; edge is what other tools show
+        const FFSensorChannel* channel = ffSensorsFindChannel(gpuChip, FF_SENSOR_TYPE_TEMPERATURE, "edge");
+        if(!channel)
+            channel = ffSensorsFindChannel(gpuChip, FF_SENSOR_TYPE_TEMPERATURE, NULL);
+        if(channel)
+            gpu->temperature = channel->value;
+    }
+
+    ffSensorsUnlock();
 }
 
 static bool pciDetectMemory(FFGPUResult* gpu, const PCIData* pci, struct pci_dev* device)
@@ -1,30 +1,18 @@
 #include "host.h"
 #include "common/io/io.h"
-#include "common/processing.h"
+#include "common/io/sysfs.h"
+#include "common/exeversion.h"
 #include "util/smbiosHelper.h"
 
 #include <stdlib.h>
 
-static void getSmbiosValue(const char* devicesPath, const char* classPath, FFstrbuf* buffer)
+static void getHostProductName(int dmiDirFd, FFstrbuf* name)
 {
-    ffReadFileBuffer(devicesPath, buffer);
-    if(ffIsSmbiosValueSet(buffer))
-        return;
-
-    ffReadFileBuffer(classPath, buffer);
-    if(ffIsSmbiosValueSet(buffer))
-        return;
-
-    ffStrbufClear(buffer);
-}
-
-static void getHostProductName(FFstrbuf* name)
-{
-    getSmbiosValue("/sys/devices/virtual/dmi/id/product_name", "/sys/class/dmi/id/product_name", name);
+    ffSmbiosReadDmiValue(dmiDirFd, "product_name", name);
     if(name->length > 0)
         return;
 
-    ffReadFileBuffer("/sys/firmware/devicetree/base/model", name);
+    ffSysfsReadAttr(AT_FDCWD, "/sys/firmware/devicetree/base/model", name);
     if(ffIsSmbiosValueSet(name))
         return;
 
@@ -38,11 +26,12 @@ static void getHostProductName(FFstrbuf* name)
 
 const char* ffDetectHost(FFHostResult* host)
 {
-    getSmbiosValue("/sys/devices/virtual/dmi/id/product_family", "/sys/class/dmi/id/product_family", &host->productFamily);
-    getHostProductName(&host->productName);
-    getSmbiosValue("/sys/devices/virtual/dmi/id/product_version", "/sys/class/dmi/id/product_version", &host->productVersion);
-    getSmbiosValue("/sys/devices/virtual/dmi/id/product_sku", "/sys/class/dmi/id/product_sku", &host->productSku);
-    getSmbiosValue("/sys/devices/virtual/dmi/id/sys_vendor", "/sys/class/dmi/id/sys_vendor", &host->sysVendor);
+    int FF_AUTO_CLOSE_FD dmiDirFd = ffSmbiosOpenDmiDir();
+    ffSmbiosReadDmiValue(dmiDirFd, "product_family", &host->productFamily);
+    getHostProductName(dmiDirFd, &host->productName);
+    ffSmbiosReadDmiValue(dmiDirFd, "product_version", &host->productVersion);
+    ffSmbiosReadDmiValue(dmiDirFd, "product_sku", &host->productSku);
+    ffSmbiosReadDmiValue(dmiDirFd, "sys_vendor", &host->sysVendor);
 
     //KVM/Qemu virtual machine
     if(ffStrbufStartsWithS(&host->productName, "Standard PC"))
@@ -57,7 +46,7 @@ const char* ffDetectHost(FFHostResult* host)
             ffStrbufAppendS(&host->productFamily, "WSL");
 
             FF_STRBUF_AUTO_DESTROY wslVer = ffStrbufCreate(); //Wide charactors
-            if(!ffProcessAppendStdOut(&wslVer, (char* const[]){
+            if(!ffExeVersionAppendStdOut(&wslVer, (char* const[]){
                 "wsl.exe",
                 "--version",
                 NULL
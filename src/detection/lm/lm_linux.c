@@ -1,7 +1,7 @@
 #include "lm.h"
 #include "common/properties.h"
 #include "common/dbus.h"
-#include "common/processing.h"
+#include "common/exeversion.h"
 #include "detection/displayserver/displayserver.h"
 
 #include <unistd.h>
@@ -11,7 +11,7 @@
 
 static const char* getGdmVersion(FFstrbuf* version)
 {
-    const char* error = ffProcessAppendStdOut(version, (char* const[]) {
+    const char* error = ffExeVersionAppendStdOut(version, (char* const[]) {
         "gdm",
         "--version",
         NULL
@@ -26,7 +26,7 @@ static const char* getGdmVersion(FFstrbuf* version)
 
 static const char* getSshdVersion(FFstrbuf* version)
 {
-    const char* error = ffProcessAppendStdErr(version, (char* const[]) {
+    const char* error = ffExeVersionAppendStdErr(version, (char* const[]) {
         "sshd",
         "-qv",
         NULL
@@ -95,7 +95,7 @@ static const char* getSddmVersion(FF_MAYBE_UNUSED FFstrbuf* version)
 
 static const char* getXfwmVersion(FFstrbuf* version)
 {
-    const char* error = ffProcessAppendStdOut(version, (char* const[]) {
+    const char* error = ffExeVersionAppendStdOut(version, (char* const[]) {
         "xfwm4",
         "--version",
         NULL
@@ -112,7 +112,7 @@ static const char* getXfwmVersion(FFstrbuf* version)
 
 static const char* getLightdmVersion(FFstrbuf* version)
 {
-    const char* error = ffProcessAppendStdErr(version, (char* const[]) {
+    const char* error = ffExeVersionAppendStdErr(version, (char* const[]) {
         "lightdm",
         "--version",
         NULL
@@ -1,6 +1,7 @@
 #include "os.h"
 #include "common/properties.h"
 #include "common/parsing.h"
+#include "common/root.h"
 #include "util/stringUtils.h"
 
 #include <string.h>
@@ -14,7 +15,7 @@ static inline bool allRelevantValuesSet(const FFOSResult* result)
     ;
 }
 
-static bool parseFile(const char* fileName, FFOSResult* result)
+static bool parseFileValues(const char* fileName, FFOSResult* result)
 {
     return ffParsePropFileValues(fileName, 13, (FFpropquery[]) {
         {"NAME =", &result->name},
@@ -33,6 +34,17 @@ static bool parseFile(const char* fileName, FFOSResult* result)
     });
 }
 
+// `fileName` is below `--root`
+static bool parseFile(const char* fileName, FFOSResult* result)
+{
+    if(instance.config.root.length == 0)
+        return parseFileValues(fileName, result);
+
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    ffRootPathSet(&path, fileName);
+    return parseFileValues(path.chars, result);
+}
+
 static void getUbuntuFlavour(FFOSResult* result)
 {
     const char* xdgConfigDirs = getenv("XDG_CONFIG_DIRS");
@@ -98,7 +110,7 @@ static void detectOS(FFOSResult* os)
 {
     if(instance.config.osFile.length > 0)
     {
-        parseFile(instance.config.osFile.chars, os);
+        parseFileValues(instance.config.osFile.chars, os);
         return;
     }
 
@@ -142,6 +154,7 @@ void ffDetectOSImpl(FFOSResult* os)
 
     detectOS(os);
 
-    if(ffStrbufIgnCaseCompS(&os->id, "ubuntu") == 0)
+    // The flavour is guessed from the environment of the running system
+    if(ffStrbufIgnCaseCompS(&os->id, "ubuntu") == 0 && instance.config.root.length == 0)
         getUbuntuFlavour(os);
 }
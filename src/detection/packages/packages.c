@@ -3,13 +3,15 @@
 
 #include <stddef.h>
 
+static_assert(offsetof(FFPackagesResult, all) == FF_PACKAGES_NUM_MANAGERS * sizeof(uint32_t), "FF_PACKAGES_NUM_MANAGERS is outdated");
+
 void ffDetectPackagesImpl(FFPackagesResult* result);
 
 const char* ffDetectPackages(FFPackagesResult* result)
 {
     ffDetectPackagesImpl(result);
 
-    for(uint32_t i = 0; i < offsetof(FFPackagesResult, all) / sizeof(uint32_t); ++i)
+    for(uint32_t i = 0; i < FF_PACKAGES_NUM_MANAGERS; ++i)
         result->all += ((uint32_t *)result)[i];
 
     if (result->all == 0)
@@ -5,6 +5,9 @@
 
 #include "fastfetch.h"
 
+// Number of counters before `all`
+#define FF_PACKAGES_NUM_MANAGERS 20
+
 typedef struct FFPackagesResult
 {
     uint32_t apk;
@@ -31,6 +34,10 @@ typedef struct FFPackagesResult
     uint32_t all; //Make sure this goes last
 
     FFstrbuf pacmanBranch;
+
+    // Time spent counting the packages of each manager in microseconds, indexed like the counters above.
+    // Only set with `--stat`, and only on platforms measuring it
+    uint32_t statUs[FF_PACKAGES_NUM_MANAGERS];
 } FFPackagesResult;
 
 const char* ffDetectPackages(FFPackagesResult* result);
@@ -3,32 +3,42 @@
 #include "common/parsing.h"
 #include "common/processing.h"
 #include "common/properties.h"
+#include "common/root.h"
 #include "common/settings.h"
+#include "common/threadpool.h"
+#include "common/time.h"
 #include "detection/os/os.h"
+#include "util/mallocHelper.h"
 #include "util/stringUtils.h"
 
+#include <ctype.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/stat.h>
 
-static uint32_t getNumElementsImpl(const char* dirname, unsigned char type)
+typedef struct FFDirEntryCount
 {
-    DIR* dirp = opendir(dirname);
-    if(dirp == NULL)
-        return 0;
-
-    uint32_t num_elements = 0;
-
-    struct dirent *entry;
-    while((entry = readdir(dirp)) != NULL) {
-        if(entry->d_type == type)
-            ++num_elements;
-    }
-
-    if(type == DT_DIR && num_elements >= 2)
-        num_elements -= 2; // accounting for . and ..
+    unsigned char type;
+    uint32_t count;
+} FFDirEntryCount;
 
-    closedir(dirp);
+static bool countDirEntry(void* data, int dirfd, const char* name, unsigned char type)
+{
+    FF_UNUSED(dirfd, name);
+    FFDirEntryCount* count = data;
+    if(type == count->type)
+        ++count->count;
+    return true;
+}
 
-    return num_elements;
+static uint32_t getNumElementsImpl(const char* dirname, unsigned char type)
+{
+    FFDirEntryCount count = { .type = type };
+    ffDirForEachEntry(AT_FDCWD, dirname, countDirEntry, &count);
+    return count.count;
 }
 
 static uint32_t getNumElements(FFstrbuf* baseDir, const char* dirname, unsigned char type)
@@ -40,36 +50,11 @@ static uint32_t getNumElements(FFstrbuf* baseDir, const char* dirname, unsigned
     return num_elements;
 }
 
-static uint32_t getNumStringsImpl(const char* filename, const char* needle)
-{
-    FILE* file = fopen(filename, "r");
-    if(file == NULL)
-        return 0;
-
-    uint32_t count = 0;
-
-    char* line = NULL;
-    size_t len = 0;
-
-    while(getline(&line, &len, file) != EOF)
-    {
-        if(strstr(line, needle) != NULL)
-            ++count;
-    }
-
-    if(line != NULL)
-        free(line);
-
-    fclose(file);
-
-    return count;
-}
-
-static uint32_t getNumStrings(FFstrbuf* baseDir, const char* filename, const char* needle)
+static uint32_t getNumLines(FFstrbuf* baseDir, const char* filename, const char* prefix)
 {
     uint32_t baseDirLength = baseDir->length;
     ffStrbufAppendS(baseDir, filename);
-    uint32_t num_elements = getNumStringsImpl(baseDir->chars, needle);
+    uint32_t num_elements = ffCountFileLinesWithPrefix(baseDir->chars, prefix, false);
     ffStrbufSubstrBefore(baseDir, baseDirLength);
     return num_elements;
 }
@@ -83,38 +68,97 @@ static uint32_t getSQLite3Int(FFstrbuf* baseDir, const char* dbPath, const char*
     return num_elements;
 }
 
-static uint32_t countFilesRecursiveImpl(FFstrbuf* baseDirPath, const char* filename)
+// Max number of threads used to count packages. Most probes only wait for I/O
+#define FF_PACKAGES_MAX_THREADS 8
+
+typedef struct FFCountFilesContext
+{
+    const char* filename;
+    uint32_t count;
+} FFCountFilesContext;
+
+static uint32_t countFilesRecursiveAt(int dirfd, const char* dirname, const char* filename);
+
+static bool countFilesRecursiveEntry(void* data, int dirfd, const char* name, unsigned char type)
 {
-    uint32_t baseDirPathLength = baseDirPath->length;
+    // According to the PMS, neither category nor package name can begin with '.'
+    if(type != DT_DIR || name[0] == '.')
+        return true;
+
+    FFCountFilesContext* context = data;
+    context->count += countFilesRecursiveAt(dirfd, name, context->filename);
+    return true;
+}
+
+// Counts the directories below `dirname` (relative to `dirfd`) containing `filename`. Doesn't descend into those
+static uint32_t countFilesRecursiveAt(int dirfd, const char* dirname, const char* filename)
+{
+    char path[PATH_MAX];
+    if(snprintf(path, sizeof(path), "%s/%s", dirname, filename) >= (int) sizeof(path))
+        return 0;
 
-    ffStrbufAppendC(baseDirPath, '/');
-    ffStrbufAppendS(baseDirPath, filename);
-    bool exists = ffPathExists(baseDirPath->chars, FF_PATHTYPE_FILE);
-    ffStrbufSubstrBefore(baseDirPath, baseDirPathLength);
-    if(exists)
+    struct stat fileStat;
+    if(fstatat(dirfd, path, &fileStat, AT_SYMLINK_NOFOLLOW) == 0 && (S_ISREG(fileStat.st_mode) || S_ISLNK(fileStat.st_mode)))
         return 1;
 
-    DIR* dirp = opendir(baseDirPath->chars);
-    if(dirp == NULL)
+    FFCountFilesContext context = { .filename = filename };
+    ffDirForEachEntry(dirfd, dirname, countFilesRecursiveEntry, &context);
+    return context.count;
+}
+
+typedef struct FFCountFilesJob
+{
+    int dirfd;
+    const char* filename;
+    FFlist subdirs; // FFstrbuf
+    uint32_t* counts;
+} FFCountFilesJob;
+
+static bool addSubdir(void* data, int dirfd, const char* name, unsigned char type)
+{
+    FF_UNUSED(dirfd);
+    if(type == DT_DIR && name[0] != '.')
+        ffStrbufInitS((FFstrbuf*) ffListAdd(&((FFCountFilesJob*) data)->subdirs), name);
+    return true;
+}
+
+static void runCountFilesJob(void* data, uint32_t index)
+{
+    FFCountFilesJob* job = data;
+    job->counts[index] = countFilesRecursiveAt(job->dirfd, ((FFstrbuf*) ffListGet(&job->subdirs, index))->chars, job->filename);
+}
+
+// The subdirectories (package categories of a Gentoo VDB) are counted in parallel, each relative to the file descriptor of its parent
+static uint32_t countFilesRecursiveImpl(const char* dirname, const char* filename)
+{
+    int FF_AUTO_CLOSE_FD dirfd = open(dirname, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if(dirfd < 0)
         return 0;
 
-    ffStrbufAppendC(baseDirPath, '/');
-    baseDirPathLength = baseDirPath->length;
+    struct stat fileStat;
+    if(fstatat(dirfd, filename, &fileStat, AT_SYMLINK_NOFOLLOW) == 0 && (S_ISREG(fileStat.st_mode) || S_ISLNK(fileStat.st_mode)))
+        return 1;
+
+    FFCountFilesJob job = { .dirfd = dirfd, .filename = filename };
+    ffListInit(&job.subdirs, sizeof(FFstrbuf));
+    ffDirForEachEntry(dirfd, ".", addSubdir, &job);
 
     uint32_t sum = 0;
+    uint32_t* FF_AUTO_FREE counts = job.subdirs.length > 0 ? calloc(job.subdirs.length, sizeof(*counts)) : NULL;
+    if(counts)
+    {
+        job.counts = counts;
 
-    struct dirent *entry;
-    while((entry = readdir(dirp)) != NULL) {
-        // According to the PMS, neither category nor package name can begin with '.', so no need to check for . or .. specifically
-        if(entry->d_type != DT_DIR || entry->d_name[0] == '.')
-            continue;
+        uint32_t maxThreads = instance.config.multithreading ? ffThreadPoolGetCPUCount() : 1;
+        ffThreadPoolRun(job.subdirs.length, maxThreads < FF_PACKAGES_MAX_THREADS ? maxThreads : FF_PACKAGES_MAX_THREADS, runCountFilesJob, &job);
 
-        ffStrbufAppendS(baseDirPath, entry->d_name);
-        sum += countFilesRecursiveImpl(baseDirPath, filename);
-        ffStrbufSubstrBefore(baseDirPath, baseDirPathLength);
+        for(uint32_t i = 0; i < job.subdirs.length; ++i)
+            sum += counts[i];
     }
 
-    closedir(dirp);
+    FF_LIST_FOR_EACH(FFstrbuf, subdir, job.subdirs)
+        ffStrbufDestroy(subdir);
+    ffListDestroy(&job.subdirs);
     return sum;
 }
 
@@ -122,17 +166,281 @@ static uint32_t countFilesRecursive(FFstrbuf* baseDir, const char* dirname, cons
 {
     uint32_t baseDirLength = baseDir->length;
     ffStrbufAppendS(baseDir, dirname);
-    uint32_t sum = countFilesRecursiveImpl(baseDir, filename);
+    uint32_t sum = countFilesRecursiveImpl(baseDir->chars, filename);
     ffStrbufSubstrBefore(baseDir, baseDirLength);
     return sum;
 }
 
+#define FF_NIX_STORE_DIR "/nix/store/"
+
+// Same as nix's followLinksToStorePath: follows symlinks until the path is in the store, and strips everything after the store path.
+// `path` is below `--root`, and so are absolute link targets. The result is the store path as the database knows it, without the root
+static bool followLinksToNixStorePath(const char* path, FFstrbuf* result)
+{
+    const FFstrbuf* root = &instance.config.root;
+    ffStrbufSetS(result, path);
+
+    for(uint32_t i = 0; result->length < root->length || !ffStrStartsWith(result->chars + root->length, FF_NIX_STORE_DIR); ++i)
+    {
+        char target[PATH_MAX];
+        ssize_t length = i < 32 ? readlink(result->chars, target, sizeof(target)) : -1;
+        if(length <= 0)
+            return false;
+
+        if(target[0] == '/')
+            ffStrbufSet(result, root);
+        else
+        {
+            ffStrbufSubstrBeforeLastC(result, '/');
+            ffStrbufAppendC(result, '/');
+        }
+        ffStrbufAppendNS(result, (uint32_t) length, target);
+    }
+
+    ffStrbufRemoveSubstr(result, 0, root->length);
+    uint32_t end = ffStrbufNextIndexC(result, (uint32_t) strlen(FF_NIX_STORE_DIR), '/');
+    ffStrbufSubstrBefore(result, end);
+
+    // The path is put into SQL queries as it is
+    for(uint32_t i = 0; i < result->length; ++i)
+    {
+        char c = result->chars[i];
+        if(!isalnum((unsigned char) c) && !strchr("/+-._?=", c))
+            return false;
+    }
+
+    return result->length > strlen(FF_NIX_STORE_DIR);
+}
+
+typedef struct FFNixStorePath
+{
+    int64_t id;
+    FFstrbuf path;
+    FFlist references; // uint32_t, indices of referenced paths in the closure
+    bool visited;
+} FFNixStorePath;
+
+typedef struct FFNixStorePathId
+{
+    int64_t id;
+    uint32_t index;
+} FFNixStorePathId;
+
+typedef struct FFNixClosure
+{
+    FFlist paths; // FFNixStorePath, sorted by path
+    FFNixStorePathId* byId; // Sorted by id
+} FFNixClosure;
+
+static bool addNixStorePath(void* data, uint32_t columnCount, const char* const* columns)
+{
+    if(columnCount < 2 || !columns[0] || !columns[1])
+        return false;
+
+    FFNixStorePath* storePath = (FFNixStorePath*) ffListAdd(&((FFNixClosure*) data)->paths);
+    storePath->id = strtoll(columns[0], NULL, 10);
+    ffStrbufInitS(&storePath->path, columns[1]);
+    ffListInit(&storePath->references, sizeof(uint32_t));
+    storePath->visited = false;
+    return true;
+}
+
+static uint32_t findNixStorePath(const FFNixClosure* closure, int64_t id)
+{
+    uint32_t low = 0, high = closure->paths.length;
+    while(low < high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        int64_t midId = closure->byId[mid].id;
+        if(midId == id)
+            return closure->byId[mid].index;
+        if(midId < id)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return UINT32_MAX;
+}
+
+static bool addNixReference(void* data, uint32_t columnCount, const char* const* columns)
+{
+    if(columnCount < 2 || !columns[0] || !columns[1])
+        return false;
+
+    FFNixClosure* closure = (FFNixClosure*) data;
+    uint32_t referrer = findNixStorePath(closure, strtoll(columns[0], NULL, 10));
+    uint32_t reference = findNixStorePath(closure, strtoll(columns[1], NULL, 10));
+    if(referrer == UINT32_MAX || reference == UINT32_MAX)
+        return false;
+
+    // Self references are skipped by nix's topoSort
+    if(referrer != reference)
+        *(uint32_t*) ffListAdd(&((FFNixStorePath*) ffListGet(&closure->paths, referrer))->references) = reference;
+    return true;
+}
+
+static int compareUInt32(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*) a, y = *(const uint32_t*) b;
+    return x < y ? -1 : x > y;
+}
+
+static int compareNixStorePathIds(const void* a, const void* b)
+{
+    int64_t x = ((const FFNixStorePathId*) a)->id, y = ((const FFNixStorePathId*) b)->id;
+    return x < y ? -1 : x > y;
+}
+
+// Appends the paths in the order `nix-store --query --requisites` prints them: the reverse of nix's topoSortPaths,
+// which is a depth first post order traversal, iterating paths and references in path order
+static void visitNixStorePath(FFNixClosure* closure, uint32_t index, FFlist* order)
+{
+    FFNixStorePath* storePath = (FFNixStorePath*) ffListGet(&closure->paths, index);
+    if(storePath->visited)
+        return;
+    storePath->visited = true;
+
+    FF_LIST_FOR_EACH(uint32_t, reference, storePath->references)
+        visitNixStorePath(closure, *reference, order);
+
+    *(uint32_t*) ffListAdd(order) = index;
+}
+
+// Matches `egrep '([0-9]{1,}\.)+[0-9]{1,}'`
+static bool nixNameHasVersion(const char* name)
+{
+    for(const char* dot = strchr(name, '.'); dot; dot = strchr(dot + 1, '.'))
+    {
+        if(dot > name && isdigit((unsigned char) dot[-1]) && isdigit((unsigned char) dot[1]))
+            return true;
+    }
+    return false;
+}
+
+// Matches `egrep -v '\-doc$|\-man$|\-info$|\-dev$|\-bin$|^nixos-system-nixos-'`
+static bool nixNameIsExcluded(const char* name)
+{
+    return
+        ffStrEndsWith(name, "-doc") ||
+        ffStrEndsWith(name, "-man") ||
+        ffStrEndsWith(name, "-info") ||
+        ffStrEndsWith(name, "-dev") ||
+        ffStrEndsWith(name, "-bin") ||
+        ffStrStartsWith(name, "nixos-system-nixos-");
+}
+
+// for x in <requisites>; do if [ -d $x ]; then echo $x ; fi ; done | cut -d- -f2- | egrep ... | egrep -v ... | uniq | wc -l
+static uint32_t countNixStorePaths(FFNixClosure* closure)
+{
+    FF_LIST_AUTO_DESTROY order = ffListCreate(sizeof(uint32_t));
+    for(uint32_t i = 0; i < closure->paths.length; ++i)
+        visitNixStorePath(closure, i, &order);
+
+    // Store paths are checked below `--root`
+    FF_STRBUF_AUTO_DESTROY fullPath = ffStrbufCreateCopy(&instance.config.root);
+    uint32_t rootLength = fullPath.length;
+
+    uint32_t count = 0;
+    const char* previous = NULL;
+    FF_LIST_FOR_EACH(uint32_t, index, order)
+    {
+        const char* path = ((const FFNixStorePath*) ffListGet(&closure->paths, *index))->path.chars;
+        ffStrbufSubstrBefore(&fullPath, rootLength);
+        ffStrbufAppendS(&fullPath, path);
+        if(!ffPathExists(fullPath.chars, FF_PATHTYPE_DIRECTORY))
+            continue;
+
+        const char* name = strchr(path, '-');
+        name = name ? name + 1 : path;
+        if(!nixNameHasVersion(name) || nixNameIsExcluded(name))
+            continue;
+
+        if(previous && ffStrEquals(previous, name))
+            continue;
+        previous = name;
+        ++count;
+    }
+    return count;
+}
+
+// Reads the closure of the profile from the nix database, and counts it like the shell pipeline below does.
+// Returns false if the database can't be read
+static bool getNixPackagesFromDb(const char* profile, uint32_t* count)
+{
+    FF_STRBUF_AUTO_DESTROY storePath = ffStrbufCreate();
+    if(!followLinksToNixStorePath(profile, &storePath))
+        return false;
+
+    FF_STRBUF_AUTO_DESTROY query = ffStrbufCreateA(512);
+    ffStrbufAppendF(&query,
+        "WITH RECURSIVE closure(id) AS ("
+            "SELECT id FROM ValidPaths WHERE path = '%s' "
+            "UNION SELECT reference FROM Refs JOIN closure ON referrer = closure.id"
+        ") ",
+        storePath.chars
+    );
+    uint32_t queryPrefixLength = query.length;
+
+    FF_STRBUF_AUTO_DESTROY dbPath = ffStrbufCreate();
+    ffRootPathSet(&dbPath, FASTFETCH_TARGET_DIR_ROOT "/nix/var/nix/db/db.sqlite");
+
+    FFNixClosure closure = { .byId = NULL };
+    ffListInitA(&closure.paths, sizeof(FFNixStorePath), 1024);
+
+    bool success = false;
+
+    ffStrbufAppendS(&query, "SELECT id, path FROM ValidPaths WHERE id IN closure ORDER BY path");
+    if(!ffSettingsGetSQLite3Rows(dbPath.chars, query.chars, addNixStorePath, &closure))
+        goto exit;
+
+    closure.byId = malloc(closure.paths.length * sizeof(*closure.byId) + 1);
+    for(uint32_t i = 0; i < closure.paths.length; ++i)
+    {
+        closure.byId[i].id = ((const FFNixStorePath*) ffListGet(&closure.paths, i))->id;
+        closure.byId[i].index = i;
+    }
+    qsort(closure.byId, closure.paths.length, sizeof(*closure.byId), compareNixStorePathIds);
+
+    ffStrbufSubstrBefore(&query, queryPrefixLength);
+    ffStrbufAppendS(&query, "SELECT referrer, reference FROM Refs WHERE referrer IN closure");
+    if(!ffSettingsGetSQLite3Rows(dbPath.chars, query.chars, addNixReference, &closure))
+        goto exit;
+
+    FF_LIST_FOR_EACH(FFNixStorePath, path, closure.paths)
+    {
+        // `data` is NULL for paths without references
+        if(path->references.length > 1)
+            qsort(path->references.data, path->references.length, sizeof(uint32_t), compareUInt32);
+    }
+
+    *count = countNixStorePaths(&closure);
+    success = true;
+
+exit:
+    FF_LIST_FOR_EACH(FFNixStorePath, path, closure.paths)
+    {
+        ffStrbufDestroy(&path->path);
+        ffListDestroy(&path->references);
+    }
+    ffListDestroy(&closure.paths);
+    free(closure.byId);
+    return success;
+}
+
 static uint32_t getNixPackagesImpl(char* path)
 {
     //Nix detection is kinda slow, so we only do it if the dir exists
     if(!ffPathExists(path, FF_PATHTYPE_DIRECTORY))
         return 0;
 
+    uint32_t count;
+    if(getNixPackagesFromDb(path, &count))
+        return count;
+
+    // nix-store only knows the store of the running system
+    if(instance.config.root.length > 0)
+        return 0;
+
     FF_STRBUF_AUTO_DESTROY output = ffStrbufCreateA(128);
 
     //https://github.com/fastfetch-cli/fastfetch/issues/195#issuecomment-1191748222
@@ -160,28 +468,26 @@ static uint32_t getNixPackages(FFstrbuf* baseDir, const char* dirname)
     return num_elements;
 }
 
-static uint32_t getXBPSImpl(FFstrbuf* baseDir)
+static bool findXBPSPkgdb(void* data, int dirfd, const char* name, unsigned char type)
 {
-    DIR* dir = opendir(baseDir->chars);
-    if(dir == NULL)
-        return 0;
-
-    uint32_t result = 0;
+    FF_UNUSED(dirfd);
+    if(type != DT_REG || !ffStrStartsWithIgnCase(name, "pkgdb-"))
+        return true;
 
-    struct dirent *entry;
-    while((entry = readdir(dir)) != NULL)
-    {
-        if(entry->d_type != DT_REG || !ffStrStartsWithIgnCase(entry->d_name, "pkgdb-"))
-            continue;
+    ffStrbufAppendS((FFstrbuf*) data, name);
+    return false;
+}
 
-        ffStrbufAppendC(baseDir, '/');
-        ffStrbufAppendS(baseDir, entry->d_name);
-        result = getNumStringsImpl(baseDir->chars, "<string>installed</string>");
-        break;
-    }
+static uint32_t getXBPSImpl(FFstrbuf* baseDir)
+{
+    FF_STRBUF_AUTO_DESTROY pkgdb = ffStrbufCreate();
+    ffDirForEachEntry(AT_FDCWD, baseDir->chars, findXBPSPkgdb, &pkgdb);
+    if(pkgdb.length == 0)
+        return 0;
 
-    closedir(dir);
-    return result;
+    ffStrbufAppendC(baseDir, '/');
+    ffStrbufAppend(baseDir, &pkgdb);
+    return ffCountFileLinesWithPrefix(baseDir->chars, "<string>installed</string>", true);
 }
 
 static uint32_t getXBPS(FFstrbuf* baseDir, const char* dirname)
@@ -259,88 +565,184 @@ static uint32_t getRpmFromLibrpm(void)
 
 #endif //FF_HAVE_RPM
 
-static void getPackageCounts(FFstrbuf* baseDir, FFPackagesResult* packageCounts)
+static uint32_t countApk(FFstrbuf* baseDir) { return getNumLines(baseDir, "/lib/apk/db/installed", "C:Q"); }
+static uint32_t countDpkg(FFstrbuf* baseDir) { return getNumLines(baseDir, "/var/lib/dpkg/status", "Status: "); }
+static uint32_t countEmerge(FFstrbuf* baseDir) { return countFilesRecursive(baseDir, "/var/db/pkg", "SIZE"); }
+static uint32_t countEopkg(FFstrbuf* baseDir) { return getNumElements(baseDir, "/var/lib/eopkg/package", DT_DIR); }
+static uint32_t countFlatpakSystem(FFstrbuf* baseDir) { return getFlatpak(baseDir, "/var/lib/flatpak"); }
+static uint32_t countNixDefault(FFstrbuf* baseDir) { return getNixPackages(baseDir, "/nix/var/nix/profiles/default"); }
+static uint32_t countNixSystem(FFstrbuf* baseDir) { return getNixPackages(baseDir, "/run/current-system"); }
+static uint32_t countPacman(FFstrbuf* baseDir) { return getNumElements(baseDir, "/var/lib/pacman/local", DT_DIR); }
+static uint32_t countPkg(FFstrbuf* baseDir) { return getSQLite3Int(baseDir, "/var/db/pkg/local.sqlite", "SELECT count(id) FROM packages"); }
+static uint32_t countPkgtool(FFstrbuf* baseDir) { return getNumElements(baseDir, "/var/log/packages", DT_REG); }
+static uint32_t countRpm(FFstrbuf* baseDir) { return getSQLite3Int(baseDir, "/var/lib/rpm/rpmdb.sqlite", "SELECT count(blob) FROM Packages"); }
+static uint32_t countXbps(FFstrbuf* baseDir) { return getXBPS(baseDir, "/var/db/xbps"); }
+static uint32_t countBrewCask(FFstrbuf* baseDir) { return getNumElements(baseDir, "/home/linuxbrew/.linuxbrew/Caskroom", DT_DIR); }
+static uint32_t countBrew(FFstrbuf* baseDir) { return getNumElements(baseDir, "/home/linuxbrew/.linuxbrew/Cellar", DT_DIR); }
+static uint32_t countNixUser(FFstrbuf* baseDir) { return getNixPackages(baseDir, "/.nix-profile"); }
+static uint32_t countFlatpakUser(FFstrbuf* baseDir) { return getFlatpak(baseDir, "/.local/share/flatpak"); }
+
+typedef struct FFPackageManager
 {
-    packageCounts->apk += getNumStrings(baseDir, "/lib/apk/db/installed", "C:Q");
-    packageCounts->dpkg += getNumStrings(baseDir, "/var/lib/dpkg/status", "Status: ");
-    packageCounts->emerge += countFilesRecursive(baseDir, "/var/db/pkg", "SIZE");
-    packageCounts->eopkg += getNumElements(baseDir, "/var/lib/eopkg/package", DT_DIR);
-    packageCounts->flatpakSystem += getFlatpak(baseDir, "/var/lib/flatpak");
-    packageCounts->nixDefault += getNixPackages(baseDir, "/nix/var/nix/profiles/default");
-    packageCounts->nixSystem += getNixPackages(baseDir, "/run/current-system");
-    packageCounts->pacman += getNumElements(baseDir, "/var/lib/pacman/local", DT_DIR);
-    packageCounts->pkg += getSQLite3Int(baseDir, "/var/db/pkg/local.sqlite", "SELECT count(id) FROM packages");
-    packageCounts->pkgtool += getNumElements(baseDir, "/var/log/packages", DT_REG);
-    packageCounts->rpm += getSQLite3Int(baseDir, "/var/lib/rpm/rpmdb.sqlite", "SELECT count(blob) FROM Packages");
-    packageCounts->snap += getSnap(baseDir);
-    packageCounts->xbps += getXBPS(baseDir, "/var/db/xbps");
-    packageCounts->brewCask += getNumElements(baseDir, "/home/linuxbrew/.linuxbrew/Caskroom", DT_DIR);
-    packageCounts->brew += getNumElements(baseDir, "/home/linuxbrew/.linuxbrew/Cellar", DT_DIR);
-}
+    uint32_t (*count)(FFstrbuf* baseDir);
+    uint32_t offset; // Of the counter in FFPackagesResult
+} FFPackageManager;
+
+#define FF_PACKAGE_MANAGER(counter, field) { counter, offsetof(FFPackagesResult, field) }
+
+// Counted in the root directory, or in every stratum on Bedrock Linux
+static const FFPackageManager systemManagers[] = {
+    FF_PACKAGE_MANAGER(countApk, apk),
+    FF_PACKAGE_MANAGER(countDpkg, dpkg),
+    FF_PACKAGE_MANAGER(countEmerge, emerge),
+    FF_PACKAGE_MANAGER(countEopkg, eopkg),
+    FF_PACKAGE_MANAGER(countFlatpakSystem, flatpakSystem),
+    FF_PACKAGE_MANAGER(countNixDefault, nixDefault),
+    FF_PACKAGE_MANAGER(countNixSystem, nixSystem),
+    FF_PACKAGE_MANAGER(countPacman, pacman),
+    FF_PACKAGE_MANAGER(countPkg, pkg),
+    FF_PACKAGE_MANAGER(countPkgtool, pkgtool),
+    FF_PACKAGE_MANAGER(countRpm, rpm),
+    FF_PACKAGE_MANAGER(getSnap, snap),
+    FF_PACKAGE_MANAGER(countXbps, xbps),
+    FF_PACKAGE_MANAGER(countBrewCask, brewCask),
+    FF_PACKAGE_MANAGER(countBrew, brew),
+};
+
+// Counted in the home directory
+static const FFPackageManager userManagers[] = {
+    FF_PACKAGE_MANAGER(countNixUser, nixUser),
+    FF_PACKAGE_MANAGER(countFlatpakUser, flatpakUser),
+};
+
+typedef struct FFPackageCountJob
+{
+    const FFstrbuf* baseDir;
+    const FFPackageManager* manager;
+    uint32_t count;
+    uint32_t microseconds;
+} FFPackageCountJob;
 
-static void getPackageCountsRegular(FFstrbuf* baseDir, FFPackagesResult* packageCounts)
+static void runPackageCountJob(void* jobs, uint32_t index)
 {
-    getPackageCounts(baseDir, packageCounts);
+    FFPackageCountJob* job = (FFPackageCountJob*) jobs + index;
 
-    uint32_t baseDirLength = baseDir->length;
-    ffStrbufAppendS(baseDir, FASTFETCH_TARGET_DIR_ETC"/pacman-mirrors.conf");
-    if(ffParsePropFile(baseDir->chars, "Branch =", &packageCounts->pacmanBranch) && packageCounts->pacmanBranch.length == 0)
-        ffStrbufAppendS(&packageCounts->pacmanBranch, "stable");
-    ffStrbufSubstrBefore(baseDir, baseDirLength);
-}
+    uint64_t start = 0;
+    if(__builtin_expect(instance.config.stat, false))
+        start = ffTimeGetTickUs();
 
-static void getPackageCountsBedrock(FFstrbuf* baseDir, FFPackagesResult* packageCounts)
-{
-    uint32_t baseDirLength = baseDir->length;
+    FF_STRBUF_AUTO_DESTROY baseDir = ffStrbufCreateCopy(job->baseDir);
+    job->count = job->manager->count(&baseDir);
 
-    ffStrbufAppendS(baseDir, "/bedrock/strata");
+    if(__builtin_expect(instance.config.stat, false))
+        job->microseconds = (uint32_t) (ffTimeGetTickUs() - start);
+}
 
-    DIR* dir = opendir(baseDir->chars);
-    if(dir == NULL)
+static void addPackageCountJobs(FFlist* jobs, const FFstrbuf* baseDir, const FFPackageManager* managers, uint32_t managerCount)
+{
+    for(uint32_t i = 0; i < managerCount; ++i)
     {
-        ffStrbufSubstrBefore(baseDir, baseDirLength);
-        return;
+        FFPackageCountJob* job = (FFPackageCountJob*) ffListAdd(jobs);
+        job->baseDir = baseDir;
+        job->manager = &managers[i];
+        job->count = 0;
+        job->microseconds = 0;
     }
+}
 
-    ffStrbufAppendC(baseDir, '/');
-    uint32_t baseDirLength2 = baseDir->length;
+typedef struct FFBedrockStrata
+{
+    const FFstrbuf* dir;
+    FFlist* strata;
+} FFBedrockStrata;
 
-    struct dirent* entry;
-    while((entry = readdir(dir)) != NULL)
-    {
-        if(entry->d_type != DT_DIR)
-            continue;
-        if(ffStrEquals(entry->d_name, ".") || ffStrEquals(entry->d_name, ".."))
-            continue;
+static bool addBedrockStratum(void* data, int dirfd, const char* name, unsigned char type)
+{
+    FF_UNUSED(dirfd);
+    if(type != DT_DIR)
+        return true;
+
+    FFBedrockStrata* strata = data;
+    FFstrbuf* stratum = (FFstrbuf*) ffListAdd(strata->strata);
+    ffStrbufInitCopy(stratum, strata->dir);
+    ffStrbufAppendS(stratum, name);
+    return true;
+}
 
-        ffStrbufAppendS(baseDir, entry->d_name);
-        getPackageCounts(baseDir, packageCounts);
-        ffStrbufSubstrBefore(baseDir, baseDirLength2);
-    }
+// Adds the root directory of every stratum to `strata`
+static void getBedrockStrata(FFstrbuf* baseDir, FFlist* strata)
+{
+    uint32_t baseDirLength = baseDir->length;
+
+    ffStrbufAppendS(baseDir, "/bedrock/strata/");
+    ffDirForEachEntry(AT_FDCWD, baseDir->chars, addBedrockStratum, &(FFBedrockStrata) { baseDir, strata });
+
+    ffStrbufSubstrBefore(baseDir, baseDirLength);
+}
 
-    closedir(dir);
+static void getPacmanBranch(FFstrbuf* baseDir, FFPackagesResult* result)
+{
+    uint32_t baseDirLength = baseDir->length;
+    ffStrbufAppendS(baseDir, FASTFETCH_TARGET_DIR_ETC"/pacman-mirrors.conf");
+    if(ffParsePropFile(baseDir->chars, "Branch =", &result->pacmanBranch) && result->pacmanBranch.length == 0)
+        ffStrbufAppendS(&result->pacmanBranch, "stable");
     ffStrbufSubstrBefore(baseDir, baseDirLength);
 }
 
 void ffDetectPackagesImpl(FFPackagesResult* result)
 {
     FF_STRBUF_AUTO_DESTROY baseDir = ffStrbufCreateA(512);
-    ffStrbufAppendS(&baseDir, FASTFETCH_TARGET_DIR_ROOT);
+    ffRootPathSet(&baseDir, FASTFETCH_TARGET_DIR_ROOT);
 
-    if(ffStrbufIgnCaseEqualS(&ffDetectOS()->id, "bedrock"))
-        getPackageCountsBedrock(&baseDir, result);
+    FF_LIST_AUTO_DESTROY strata = ffListCreate(sizeof(FFstrbuf));
+    bool bedrock = ffStrbufIgnCaseEqualS(&ffDetectOS()->id, "bedrock");
+    if(bedrock)
+        getBedrockStrata(&baseDir, &strata);
+
+    // Every probe of every stratum is an independent job. Their counts are merged in a fixed order afterwards
+    FF_LIST_AUTO_DESTROY jobs = ffListCreate(sizeof(FFPackageCountJob));
+    const uint32_t systemManagerCount = sizeof(systemManagers) / sizeof(systemManagers[0]);
+    if(bedrock)
+    {
+        FF_LIST_FOR_EACH(FFstrbuf, stratum, strata)
+            addPackageCountJobs(&jobs, stratum, systemManagers, systemManagerCount);
+    }
     else
-        getPackageCountsRegular(&baseDir, result);
+        addPackageCountJobs(&jobs, &baseDir, systemManagers, systemManagerCount);
+    // The home directory belongs to the running system
+    if(instance.config.root.length == 0)
+        addPackageCountJobs(&jobs, &instance.state.platform.homeDir, userManagers, sizeof(userManagers) / sizeof(userManagers[0]));
+
+    ffThreadPoolRun(
+        jobs.length,
+        instance.config.multithreading ? FF_PACKAGES_MAX_THREADS : 1,
+        runPackageCountJob,
+        jobs.data
+    );
+
+    FF_LIST_FOR_EACH(FFPackageCountJob, job, jobs)
+    {
+        *(uint32_t*) ((uint8_t*) result + job->manager->offset) += job->count;
+        result->statUs[job->manager->offset / sizeof(uint32_t)] += job->microseconds;
+    }
+
+    FF_LIST_FOR_EACH(FFstrbuf, stratum, strata)
+        ffStrbufDestroy(stratum);
+
+    if(!bedrock)
+        getPacmanBranch(&baseDir, result);
 
     // If SQL failed, we can still try with librpm.
     // This is needed on openSUSE, which seems to use a proprietary database file
     // This method doesn't work on bedrock, so we do it here.
+    // librpm reads the database of the running system, so it is skipped with `--root`
     #ifdef FF_HAVE_RPM
-        if(result->rpm == 0)
+        if(result->rpm == 0 && instance.config.root.length == 0)
+        {
+            uint64_t start = instance.config.stat ? ffTimeGetTickUs() : 0;
             result->rpm = getRpmFromLibrpm();
+            if(instance.config.stat)
+                result->statUs[offsetof(FFPackagesResult, rpm) / sizeof(uint32_t)] += (uint32_t) (ffTimeGetTickUs() - start);
+        }
     #endif
-
-    ffStrbufSet(&baseDir, &instance.state.platform.homeDir);
-    result->nixUser = getNixPackages(&baseDir, "/.nix-profile");
-    result->flatpakUser = getFlatpak(&baseDir, "/.local/share/flatpak");
 }
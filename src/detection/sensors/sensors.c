@@ -0,0 +1,23 @@
+#include "sensors.h"
+
+const FFSensorChannel* ffSensorsFindChannel(const FFSensorChip* chip, FFSensorType type, const char* label)
+{
+    FF_LIST_FOR_EACH(FFSensorChannel, channel, chip->channels)
+    {
+        if(channel->type == type && (label == NULL || ffStrbufEqualS(&channel->label, label)))
+            return channel;
+    }
+    return NULL;
+}
+
+const char* ffSensorTypeToString(FFSensorType type)
+{
+    switch(type)
+    {
+        case FF_SENSOR_TYPE_TEMPERATURE: return "temp";
+        case FF_SENSOR_TYPE_FAN: return "fan";
+        case FF_SENSOR_TYPE_POWER: return "power";
+        case FF_SENSOR_TYPE_VOLTAGE: return "in";
+    }
+    return "unknown";
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#ifndef FF_INCLUDED_detection_sensors_sensors
+#define FF_INCLUDED_detection_sensors_sensors
+
+#include "fastfetch.h"
+
+typedef enum FFSensorType
+{
+    FF_SENSOR_TYPE_TEMPERATURE, // °C
+    FF_SENSOR_TYPE_FAN,         // RPM
+    FF_SENSOR_TYPE_POWER,       // W
+    FF_SENSOR_TYPE_VOLTAGE,     // V
+} FFSensorType;
+
+typedef struct FFSensorChannel
+{
+    FFSensorType type;
+    uint32_t index; // N of tempN_input, fanN_input, ...
+    FFstrbuf label; // e.g. "Tctl"; empty if the chip doesn't label the channel
+    double value;
+    double max; // Thresholds, NaN if not reported. For power, max is the power cap
+    double crit;
+    char attr[24]; // Attribute holding the value, e.g. "temp1_input"
+} FFSensorChannel;
+
+typedef struct FFSensorChip
+{
+    FFstrbuf name; // e.g. "k10temp"
+    FFstrbuf device; // Name of the parent device, e.g. the PCI address "0000:03:00.0"; may be empty
+    uint32_t deviceClass; // PCI class of the parent device (e.g. 0x030000), or 0
+    FFlist channels; // List of FFSensorChannel, sorted by type and index
+} FFSensorChip;
+
+// The chips are indexed once per process (one pass over the entries of every hwmon directory); their values
+// are read then, and again on every call with `refresh`. The returned list (of FFSensorChip) is shared:
+// it may only be used until ffSensorsUnlock is called. Never NULL
+const FFlist* ffSensorsLock(bool refresh);
+void ffSensorsUnlock(void);
+
+// Returns the channel of `type` labelled `label`, or the first channel of `type` if `label` is NULL
+const FFSensorChannel* ffSensorsFindChannel(const FFSensorChip* chip, FFSensorType type, const char* label);
+
+// Name of the channel type as used in attribute names, e.g. "temp"
+const char* ffSensorTypeToString(FFSensorType type);
+
+#endif
@@ -0,0 +1,284 @@
+#include "sensors.h"
+#include "common/io/io.h"
+#include "common/io/sysfs.h"
+#include "common/thread.h"
+#include "util/stringUtils.h"
+
+#include <ctype.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//https://www.kernel.org/doc/Documentation/hwmon/sysfs-interface
+
+enum
+{
+    FF_HWMON_ATTR_LABEL = 1 << 0,
+    FF_HWMON_ATTR_MAX = 1 << 1,
+    FF_HWMON_ATTR_CRIT = 1 << 2,
+    FF_HWMON_ATTR_CAP = 1 << 3,
+};
+
+typedef struct FFHwmonChannel
+{
+    FFSensorChannel channel;
+    uint32_t attrs; // FF_HWMON_ATTR_*, found while indexing
+} FFHwmonChannel;
+
+static FFThreadMutex mutex = FF_THREAD_MUTEX_INITIALIZER;
+static bool indexed = false;
+static FFlist chips; // FFSensorChip
+static FFlist chipFds; // int, one per chip; kept open to refresh the values
+
+static const struct
+{
+    const char* prefix;
+    uint32_t length;
+    FFSensorType type;
+    double scale; // temp: millidegree Celsius, fan: RPM, power: microwatt, in: millivolt
+} channelTypes[] = {
+    { "temp", 4, FF_SENSOR_TYPE_TEMPERATURE, 1000 },
+    { "fan", 3, FF_SENSOR_TYPE_FAN, 1 },
+    { "power", 5, FF_SENSOR_TYPE_POWER, 1000000 },
+    { "in", 2, FF_SENSOR_TYPE_VOLTAGE, 1000 },
+};
+
+static double readScaled(int dirfd, const char* attr, FFSensorType type)
+{
+    int64_t raw;
+    if(!ffSysfsReadInt(dirfd, attr, &raw))
+        return 0.0/0.0;
+    return (double) raw / channelTypes[type].scale;
+}
+
+// Called for every file of a hwmon directory; collects the channels from names like "temp1_input" in one pass
+static bool addChannelAttr(void* data, int dirfd, const char* name, unsigned char type)
+{
+    FF_UNUSED(dirfd);
+    FFlist* channels = data;
+
+    if(type != DT_REG)
+        return true;
+
+    uint32_t typeIndex = 0;
+    while(typeIndex < sizeof(channelTypes) / sizeof(channelTypes[0]) &&
+        (strncmp(name, channelTypes[typeIndex].prefix, channelTypes[typeIndex].length) != 0 || !isdigit(name[channelTypes[typeIndex].length])))
+        ++typeIndex;
+    if(typeIndex == sizeof(channelTypes) / sizeof(channelTypes[0]))
+        return true;
+
+    char* suffix;
+    uint32_t index = (uint32_t) strtoul(name + channelTypes[typeIndex].length, &suffix, 10);
+    if(*suffix != '_' || strlen(name) >= sizeof(((FFSensorChannel*) NULL)->attr))
+        return true;
+    ++suffix;
+
+    FFHwmonChannel* hwmonChannel = NULL;
+    FF_LIST_FOR_EACH(FFHwmonChannel, item, *channels)
+    {
+        if(item->channel.type == channelTypes[typeIndex].type && item->channel.index == index)
+        {
+            hwmonChannel = item;
+            break;
+        }
+    }
+
+    if(!hwmonChannel)
+    {
+        hwmonChannel = ffListAdd(channels);
+        hwmonChannel->channel.type = channelTypes[typeIndex].type;
+        hwmonChannel->channel.index = index;
+        hwmonChannel->channel.attr[0] = '\0';
+        hwmonChannel->attrs = 0;
+    }
+
+    if(ffStrEquals(suffix, "input"))
+        strcpy(hwmonChannel->channel.attr, name);
+    else if(ffStrEquals(suffix, "average"))
+    {
+        // powerN_input is the instantaneous power; older drivers only report the average
+        if(hwmonChannel->channel.attr[0] == '\0')
+            strcpy(hwmonChannel->channel.attr, name);
+    }
+    else if(ffStrEquals(suffix, "label"))
+        hwmonChannel->attrs |= FF_HWMON_ATTR_LABEL;
+    else if(ffStrEquals(suffix, "max"))
+        hwmonChannel->attrs |= FF_HWMON_ATTR_MAX;
+    else if(ffStrEquals(suffix, "crit"))
+        hwmonChannel->attrs |= FF_HWMON_ATTR_CRIT;
+    else if(ffStrEquals(suffix, "cap"))
+        hwmonChannel->attrs |= FF_HWMON_ATTR_CAP;
+
+    return true;
+}
+
+static int compareChannels(const void* a, const void* b)
+{
+    const FFSensorChannel* x = a;
+    const FFSensorChannel* y = b;
+    if(x->type != y->type)
+        return x->type < y->type ? -1 : 1;
+    return x->index < y->index ? -1 : x->index > y->index;
+}
+
+// Reads the labels and thresholds of the channels found by addChannelAttr. They don't change, so this is done once
+static void initChannels(int dirfd, FFlist* hwmonChannels, FFlist* channels)
+{
+    ffListInitA(channels, sizeof(FFSensorChannel), hwmonChannels->length);
+
+    FF_LIST_FOR_EACH(FFHwmonChannel, hwmonChannel, *hwmonChannels)
+    {
+        if(hwmonChannel->channel.attr[0] == '\0')
+            continue;
+
+        FFSensorChannel* channel = ffListAdd(channels);
+        *channel = hwmonChannel->channel;
+        ffStrbufInit(&channel->label);
+        channel->max = channel->crit = 0.0/0.0;
+
+        // "temp1_input" => "temp1_label", ...
+        char attr[sizeof(channel->attr) + 8];
+        size_t prefixLength = (size_t) (strchr(channel->attr, '_') - channel->attr) + 1;
+        memcpy(attr, channel->attr, prefixLength);
+
+        if(hwmonChannel->attrs & FF_HWMON_ATTR_LABEL)
+        {
+            strcpy(attr + prefixLength, "label");
+            ffSysfsAppendAttr(dirfd, attr, &channel->label);
+        }
+        if(hwmonChannel->attrs & (FF_HWMON_ATTR_MAX | FF_HWMON_ATTR_CAP))
+        {
+            strcpy(attr + prefixLength, hwmonChannel->attrs & FF_HWMON_ATTR_MAX ? "max" : "cap");
+            channel->max = readScaled(dirfd, attr, channel->type);
+        }
+        if(hwmonChannel->attrs & FF_HWMON_ATTR_CRIT)
+        {
+            strcpy(attr + prefixLength, "crit");
+            channel->crit = readScaled(dirfd, attr, channel->type);
+        }
+        channel->value = readScaled(dirfd, channel->attr, channel->type);
+    }
+
+    ffListSort(channels, compareChannels);
+}
+
+static void addChip(int classFd, uint32_t hwmonIndex)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "hwmon%u", hwmonIndex);
+
+    int hwmonFd = ffSysfsOpenDir(classFd, name);
+    if(hwmonFd < 0)
+        return;
+
+    FF_LIST_AUTO_DESTROY hwmonChannels = ffListCreate(sizeof(FFHwmonChannel));
+    ffDirForEachEntry(hwmonFd, ".", addChannelAttr, &hwmonChannels);
+
+    int dirfd = hwmonFd;
+    if(hwmonChannels.length == 0)
+    {
+        // Drivers written before Linux 3.x put the attributes in the parent device directory
+        dirfd = ffSysfsOpenDir(hwmonFd, "device");
+        if(dirfd >= 0)
+            ffDirForEachEntry(dirfd, ".", addChannelAttr, &hwmonChannels);
+    }
+
+    FFSensorChip chip;
+    initChannels(dirfd, &hwmonChannels, &chip.channels);
+    if(chip.channels.length == 0)
+    {
+        ffListDestroy(&chip.channels);
+        if(dirfd != hwmonFd && dirfd >= 0)
+            close(dirfd);
+        close(hwmonFd);
+        return;
+    }
+
+    ffStrbufInit(&chip.name);
+    ffSysfsAppendAttr(dirfd, "name", &chip.name);
+
+    ffStrbufInit(&chip.device);
+    uint64_t deviceClass = 0;
+    char target[256];
+    ssize_t length = readlinkat(hwmonFd, "device", target, sizeof(target) - 1);
+    if(length > 0)
+    {
+        target[length] = '\0';
+        const char* slash = strrchr(target, '/');
+        ffStrbufAppendS(&chip.device, slash ? slash + 1 : target);
+
+        // Virtual chips (acpitz, k10temp, coretemp, ...) have no parent device
+        if(!ffSysfsReadUInt(hwmonFd, "device/class", 16, &deviceClass))
+            ffSysfsReadUInt(hwmonFd, "device/device/class", 16, &deviceClass);
+    }
+    chip.deviceClass = (uint32_t) deviceClass;
+
+    if(dirfd != hwmonFd)
+        close(hwmonFd);
+
+    *(FFSensorChip*) ffListAdd(&chips) = chip;
+    *(int*) ffListAdd(&chipFds) = dirfd;
+}
+
+static bool addHwmonIndex(void* data, int dirfd, const char* name, unsigned char type)
+{
+    FF_UNUSED(dirfd, type);
+
+    if(ffStrStartsWith(name, "hwmon") && isdigit(name[5]))
+        *(uint32_t*) ffListAdd(data) = (uint32_t) strtoul(name + 5, NULL, 10);
+    return true;
+}
+
+static int compareUInt32(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*) a, y = *(const uint32_t*) b;
+    return x < y ? -1 : x > y;
+}
+
+static void indexChips(void)
+{
+    ffListInitA(&chips, sizeof(FFSensorChip), 8);
+    ffListInitA(&chipFds, sizeof(int), 8);
+
+    int FF_AUTO_CLOSE_FD classFd = ffSysfsOpenDir(AT_FDCWD, "/sys/class/hwmon");
+    if(classFd < 0)
+        return;
+
+    // Sorted, so that hwmon10 comes after hwmon9 and the order doesn't depend on the directory
+    FF_LIST_AUTO_DESTROY indices = ffListCreate(sizeof(uint32_t));
+    ffDirForEachEntry(classFd, ".", addHwmonIndex, &indices);
+    ffListSort(&indices, compareUInt32);
+
+    FF_LIST_FOR_EACH(uint32_t, index, indices)
+        addChip(classFd, *index);
+}
+
+static void refreshValues(void)
+{
+    for(uint32_t i = 0; i < chips.length; ++i)
+    {
+        FFSensorChip* chip = ffListGet(&chips, i);
+        int dirfd = *(int*) ffListGet(&chipFds, i);
+        FF_LIST_FOR_EACH(FFSensorChannel, channel, chip->channels)
+            channel->value = readScaled(dirfd, channel->attr, channel->type);
+    }
+}
+
+const FFlist* ffSensorsLock(bool refresh)
+{
+    ffThreadMutexLock(&mutex);
+    if(!indexed)
+    {
+        indexChips();
+        indexed = true;
+    }
+    else if(refresh)
+        refreshValues();
+    return &chips;
+}
+
+void ffSensorsUnlock(void)
+{
+    ffThreadMutexUnlock(&mutex);
+}
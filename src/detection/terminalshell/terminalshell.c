@@ -1,6 +1,6 @@
 #include "fastfetch.h"
 #include "common/io/io.h"
-#include "common/processing.h"
+#include "common/exeversion.h"
 #include "common/properties.h"
 #include "util/stringUtils.h"
 
@@ -41,7 +41,7 @@ static bool getFileVersion(const char* exePath, FFstrbuf* version)
 
 static bool getExeVersionRaw(FFstrbuf* exe, FFstrbuf* version)
 {
-    bool ok = ffProcessAppendStdOut(version, (char* const[]) {
+    bool ok = ffExeVersionAppendStdOut(version, (char* const[]) {
         exe->chars,
         "--version",
         NULL
@@ -109,7 +109,7 @@ static bool getShellVersionPwsh(FFstrbuf* exe, FFstrbuf* version)
 #ifdef _WIN32
 static bool getShellVersionWinPowerShell(FFstrbuf* exe, FFstrbuf* version)
 {
-    if(ffProcessAppendStdOut(version, (char* const[]) {
+    if(ffExeVersionAppendStdOut(version, (char* const[]) {
         exe->chars,
         "-NoLogo",
         "-NoProfile",
@@ -162,7 +162,7 @@ FF_MAYBE_UNUSED static bool getTerminalVersionTermux(FFstrbuf* version)
 
 FF_MAYBE_UNUSED static bool getTerminalVersionGnome(FFstrbuf* version)
 {
-    if(ffProcessAppendStdOut(version, (char* const[]){
+    if(ffExeVersionAppendStdOut(version, (char* const[]){
         "gnome-terminal",
         "--version",
         NULL
@@ -226,7 +226,7 @@ FF_MAYBE_UNUSED static bool getTerminalVersionCockpit(FFstrbuf* exe, FFstrbuf* v
 
 FF_MAYBE_UNUSED static bool getTerminalVersionXterm(FFstrbuf* exe, FFstrbuf* version)
 {
-    if(ffProcessAppendStdOut(version, (char* const[]){
+    if(ffExeVersionAppendStdOut(version, (char* const[]){
         exe->chars,
         "-v",
         NULL
@@ -24,6 +24,8 @@ typedef struct FFTerminalShellResult
     FFstrbuf userShellExe;
     const char* userShellExeName; //pointer to a char in userShellExe
     FFstrbuf userShellVersion;
+
+    FFlist installedShells; // FFstrbuf; with `--root`, the paths listed in <root>/etc/shells. No process is detected then
 } FFTerminalShellResult;
 
 const FFTerminalShellResult* ffDetectTerminalShell();
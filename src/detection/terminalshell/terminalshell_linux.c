@@ -1,7 +1,8 @@
 #include "terminalshell.h"
 #include "common/io/io.h"
 #include "common/parsing.h"
-#include "common/processing.h"
+#include "common/root.h"
+#include "common/exeversion.h"
 #include "common/thread.h"
 #include "util/stringUtils.h"
 
@@ -286,14 +287,14 @@ static void getShellVersionGeneric(FFstrbuf* exe, const char* exeName, FFstrbuf*
     ffStrbufAppendTransformS(&command, exeName, toupper);
     ffStrbufAppendS(&command, "_VERSION\"");
 
-    ffProcessAppendStdOut(version, (char* const[]) {
+    ffExeVersionAppendOutput(version, exe->chars, (char* const[]) {
         "env",
         "-i",
         exe->chars,
         "-c",
         command.chars,
         NULL
-    });
+    }, false);
     ffStrbufSubstrBeforeFirstC(version, '(');
     ffStrbufRemoveStrings(version, 2, "-release", "release");
 }
@@ -309,6 +310,44 @@ static void getShellVersion(FFstrbuf* exe, const char* exeName, FFstrbuf* versio
 
 bool fftsGetTerminalVersion(FFstrbuf* processName, FFstrbuf* exe, FFstrbuf* version);
 
+// Fills installedShells, and shellPrettyName with their distinct exe names
+static void getInstalledShells(FFTerminalShellResult* result)
+{
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    ffRootPathSet(&path, FASTFETCH_TARGET_DIR_ETC "/shells");
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreate();
+    if(!ffReadFileBuffer(path.chars, &content))
+        return;
+
+    for(uint32_t start = 0; start < content.length;)
+    {
+        uint32_t end = ffStrbufNextIndexC(&content, start, '\n');
+        if(content.chars[start] == '/') // Skips comments and empty lines
+        {
+            FFstrbuf* shell = ffListAdd(&result->installedShells);
+            ffStrbufInitNS(shell, end - start, content.chars + start);
+            ffStrbufTrimRight(shell, ' ');
+        }
+        start = end + 1;
+    }
+
+    for(uint32_t i = 0; i < result->installedShells.length; ++i)
+    {
+        const char* exeName = strrchr(((FFstrbuf*) ffListGet(&result->installedShells, i))->chars, '/') + 1;
+
+        // The same shell is often listed in /bin and /usr/bin
+        bool duplicate = false;
+        for(uint32_t j = 0; j < i && !duplicate; ++j)
+            duplicate = ffStrEquals(strrchr(((FFstrbuf*) ffListGet(&result->installedShells, j))->chars, '/') + 1, exeName);
+        if(duplicate)
+            continue;
+
+        if(result->shellPrettyName.length > 0)
+            ffStrbufAppendS(&result->shellPrettyName, ", ");
+        ffStrbufAppendS(&result->shellPrettyName, exeName);
+    }
+}
+
 const FFTerminalShellResult* ffDetectTerminalShell()
 {
     static FFThreadMutex mutex = FF_THREAD_MUTEX_INITIALIZER;
@@ -345,6 +384,18 @@ const FFTerminalShellResult* ffDetectTerminalShell()
     result.userShellExeName = result.userShellExe.chars;
     ffStrbufInit(&result.userShellVersion);
 
+    ffListInit(&result.installedShells, sizeof(FFstrbuf));
+    if(instance.config.root.length > 0)
+    {
+        // Processes belong to the running system, not to the root
+        ffStrbufInit(&result.shellPrettyName);
+        getInstalledShells(&result);
+        ffStrbufInit(&result.terminalPrettyName);
+        ffStrbufInit(&result.terminalVersion);
+        ffThreadMutexUnlock(&mutex);
+        return &result;
+    }
+
     getTerminalShell(&result, getppid());
 
     getTerminalFromEnv(&result);
@@ -336,6 +336,7 @@ const FFTerminalShellResult* ffDetectTerminalShell(void)
     ffStrbufInit(&result.userShellExe);
     result.userShellExeName = "";
     ffStrbufInit(&result.userShellVersion);
+    ffListInit(&result.installedShells, sizeof(FFstrbuf));
 
     uint32_t ppid;
     if(!getProcessInfo(0, &ppid, NULL, NULL, NULL))
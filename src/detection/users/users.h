@@ -5,6 +5,6 @@
 
 #include "fastfetch.h"
 
-void ffDetectUsers(FFlist* users /* List of FFstrbuf */, FFstrbuf* error);
+const char* ffDetectUsers(FFlist* users /* List of FFstrbuf */);
 
 #endif
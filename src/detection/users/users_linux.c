@@ -11,7 +11,7 @@
     #define getutxent getutent
 #endif
 
-void ffDetectUsers(FFlist* users, FFstrbuf* error)
+const char* ffDetectUsers(FFlist* users)
 {
     struct utmpx* n = NULL;
     setutxent();
@@ -32,5 +32,7 @@ next:
     }
 
     if(users->length == 0)
-        ffStrbufAppendS(error, "Unable to detect users");
+        return "Unable to detect users";
+
+    return NULL;
 }
@@ -4,17 +4,14 @@
 #include <windows.h>
 #include <wtsapi32.h>
 
-void ffDetectUsers(FFlist* users, FFstrbuf* error)
+const char* ffDetectUsers(FFlist* users)
 {
     WTS_SESSION_INFO_1W* sessionInfo;
     DWORD sessionCount;
     DWORD level = 1;
 
     if(!WTSEnumerateSessionsExW(WTS_CURRENT_SERVER_HANDLE, &level, 0, &sessionInfo, &sessionCount))
-    {
-        ffStrbufAppendS(error, "WTSEnumerateSessionsW(WTS_CURRENT_SERVER_HANDLE) failed");
-        return;
-    }
+        return "WTSEnumerateSessionsW(WTS_CURRENT_SERVER_HANDLE) failed";
 
     for (DWORD i = 0; i < sessionCount; i++)
     {
@@ -31,5 +28,7 @@ void ffDetectUsers(FFlist* users, FFstrbuf* error)
     WTSFreeMemoryExW(WTSTypeSessionInfoLevel1, sessionInfo, 1);
 
     if(users->length == 0)
-        ffStrbufAppendS(error, "Unable to detect users");
+        return "Unable to detect users";
+
+    return NULL;
 }
@@ -9,6 +9,7 @@
 #include "common/processing.h"
 #include "common/properties.h"
 #include "common/library.h"
+#include "util/mallocHelper.h"
 
 #include <glib.h>
 #define NM_NO_INCLUDE_EXTRA_HEADERS 1
@@ -20,6 +21,59 @@
     #define NM_802_11_AP_SEC_KEY_MGMT_OWE_TM 0x00001000
 #endif
 
+static void parseIwLink(const FFstrbuf* output, FFstrbuf* protocol)
+{
+    if(!ffParsePropLines(output->chars, "tx bitrate: ", protocol))
+        return;
+
+    if(ffStrbufContainS(protocol, " HE-MCS "))
+        ffStrbufSetS(protocol, "802.11ax (Wi-Fi 6)");
+    else if(ffStrbufContainS(protocol, " VHT-MCS "))
+        ffStrbufSetS(protocol, "802.11ac (Wi-Fi 5)");
+    else if(ffStrbufContainS(protocol, " MCS "))
+        ffStrbufSetS(protocol, "802.11n (Wi-Fi 4)");
+    else
+        ffStrbufSetS(protocol, "802.11a/b/g");
+}
+
+typedef struct FFIwLinkProbe
+{
+    char* argv[5];
+    FFstrbuf output;
+} FFIwLinkProbe;
+
+// Runs `iw dev <interface> link` for the given items at the same time
+static void detectProtocolsWithIw(FFlist* result, const FFlist* indices)
+{
+    if(indices->length == 0)
+        return;
+
+    FFIwLinkProbe* FF_AUTO_FREE probes = malloc(indices->length * sizeof(*probes));
+    FFProcessCommand* FF_AUTO_FREE commands = malloc(indices->length * sizeof(*commands));
+    if(!probes || !commands)
+        return;
+
+    for(uint32_t i = 0; i < indices->length; ++i)
+    {
+        FFWifiResult* item = ffListGet(result, *(uint32_t*) ffListGet(indices, i));
+        probes[i] = (FFIwLinkProbe) { .argv = { "iw", "dev", item->inf.description.chars, "link", NULL } };
+        ffStrbufInit(&probes[i].output);
+        commands[i] = (FFProcessCommand) { .argv = probes[i].argv, .output = &probes[i].output };
+    }
+
+    ffProcessAppendOutputBatch(indices->length, commands);
+
+    for(uint32_t i = 0; i < indices->length; ++i)
+    {
+        if(!commands[i].error)
+        {
+            FFWifiResult* item = ffListGet(result, *(uint32_t*) ffListGet(indices, i));
+            parseIwLink(&probes[i].output, &item->conn.protocol);
+        }
+        ffStrbufDestroy(&probes[i].output);
+    }
+}
+
 static const char* detectWifiWithLibnm(FFlist* result)
 {
     FF_LIBRARY_LOAD(nm, &instance.config.libnm, "dlopen libnm failed", "libnm" FF_LIBRARY_EXTENSION, 0);
@@ -48,6 +102,8 @@ static const char* detectWifiWithLibnm(FFlist* result)
     if(!client)
         return "Could not create NMClient";
 
+    FF_LIST_AUTO_DESTROY iwIndices = ffListCreate(sizeof(uint32_t));
+
     /* Get all devices managed by NetworkManager */
     const GPtrArray* devices = ffnm_client_get_devices(client);
 
@@ -144,26 +200,7 @@ static const char* detectWifiWithLibnm(FFlist* result)
         item->conn.rxRate = ffnm_access_point_get_max_bitrate(ap);
 
         if(instance.config.allowSlowOperations)
-        {
-            FF_STRBUF_AUTO_DESTROY output = ffStrbufCreate();
-            if(!ffProcessAppendStdOut(&output, (char* const[]){
-                "iw",
-                "dev",
-                item->inf.description.chars,
-                "link",
-                NULL
-            }) && ffParsePropLines(output.chars, "tx bitrate: ", &item->conn.protocol))
-            {
-                if(ffStrbufContainS(&item->conn.protocol, " HE-MCS "))
-                    ffStrbufSetS(&item->conn.protocol, "802.11ax (Wi-Fi 6)");
-                else if(ffStrbufContainS(&item->conn.protocol, " VHT-MCS "))
-                    ffStrbufSetS(&item->conn.protocol, "802.11ac (Wi-Fi 5)");
-                else if(ffStrbufContainS(&item->conn.protocol, " MCS "))
-                    ffStrbufSetS(&item->conn.protocol, "802.11n (Wi-Fi 4)");
-                else
-                    ffStrbufSetS(&item->conn.protocol, "802.11a/b/g");
-            }
-        }
+            *(uint32_t*) ffListAdd(&iwIndices) = result->length - 1;
 
         NM80211ApFlags flags = ffnm_access_point_get_flags(ap);
         NM80211ApSecurityFlags wpaFlags = ffnm_access_point_get_wpa_flags(ap);
@@ -197,6 +234,8 @@ static const char* detectWifiWithLibnm(FFlist* result)
 
     ffg_object_unref(client);
 
+    detectProtocolsWithIw(result, &iwIndices);
+
     return NULL;
 }
 
@@ -206,6 +245,7 @@ static const char* detectWifiWithLibnm(FFlist* result)
 #define FF_DETECT_WIFI_WITH_IOCTLS
 
 #include "common/io/io.h"
+#include "common/io/sysfs.h"
 
 #include <net/if.h>
 #include <sys/ioctl.h>
@@ -219,12 +259,12 @@ static const char* detectWifiWithIoctls(FFlist* result)
     if(!infs)
         return "if_nameindex() failed";
 
-    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    int FF_AUTO_CLOSE_FD netFd = ffSysfsOpenDir(AT_FDCWD, "/sys/class/net");
 
     for(struct if_nameindex* i = infs; !(i->if_index == 0 && i->if_name == NULL); ++i)
     {
-        ffStrbufSetF(&path, "/sys/class/net/%s/phy80211", i->if_name);
-        if(!ffPathExists(path.chars, FF_PATHTYPE_DIRECTORY))
+        char path[FF_SYSFS_PATH_MAX];
+        if(faccessat(netFd, ffSysfsEntryPath(path, i->if_name, "phy80211"), F_OK, 0) != 0)
             continue;
 
         FFWifiResult* item = (FFWifiResult*)ffListAdd(result);
@@ -239,8 +279,7 @@ static const char* detectWifiWithIoctls(FFlist* result)
         item->conn.rxRate = 0.0/0.0;
         item->conn.txRate = 0.0/0.0;
 
-        ffStrbufSetF(&path, "/sys/class/net/%s/operstate", i->if_name);
-        if(!ffAppendFileBuffer(path.chars, &item->inf.status) || !ffStrbufEqualS(&item->inf.status, "up"))
+        if(!ffSysfsAppendAttr(netFd, ffSysfsEntryPath(path, i->if_name, "operstate"), &item->inf.status) || !ffStrbufEqualS(&item->inf.status, "up"))
             continue;
 
         int sock = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
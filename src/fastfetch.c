@@ -2,15 +2,17 @@
 #include "common/printing.h"
 #include "common/parsing.h"
 #include "common/io/io.h"
-#include "common/time.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "common/scheduler.h"
+#include "common/watch.h"
+#include "common/root.h"
 #include "util/stringUtils.h"
 #include "logo/logo.h"
 
 #include <stdlib.h>
 #include <ctype.h>
 #include <string.h>
-#include <inttypes.h>
 
 #ifdef WIN32
     #include "util/windows/getline.h"
@@ -31,6 +33,7 @@ typedef struct FFdata
     FFstrbuf structure;
     FFlist customValues; // List of FFCustomValue
     bool loadUserConfig;
+    FFstrbuf rootList; // `--root-list`
 } FFdata;
 
 static void constructAndPrintCommandHelpFormat(const char* name, const char* def, uint32_t numArgs, ...)
@@ -286,8 +289,16 @@ static inline void printCommandHelp(const char* command)
     }
     else if(ffStrEqualsIgnCase(command, "cpu-usage-format"))
     {
-        constructAndPrintCommandHelpFormat("cpu-usage", "{0}%", 1,
-            "CPU usage without percent mark"
+        constructAndPrintCommandHelpFormat("cpu-usage", "{1}%", 9,
+            "CPU usage without percent mark",
+            "Average usage of single cores",
+            "Usage of the least busy core",
+            "Number of the least busy core",
+            "Usage of the busiest core",
+            "Number of the busiest core",
+            "The busiest cores with their usage",
+            "Usage of every NUMA node",
+            "Usage of every core, one bar character each"
         );
     }
     else if(ffStrEqualsIgnCase(command, "gpu-format"))
@@ -303,23 +314,27 @@ static inline void printCommandHelp(const char* command)
     }
     else if(ffStrEqualsIgnCase(command, "memory-format"))
     {
-        constructAndPrintCommandHelpFormat("memory", "{} / {} ({}%)", 3,
+        constructAndPrintCommandHelpFormat("memory", "{} / {} ({}%)", 5,
             "Used size",
             "Total size",
-            "Percentage used"
+            "Percentage used",
+            "Used bytes",
+            "Total bytes"
         );
     }
     else if(ffStrEqualsIgnCase(command, "swap-format"))
     {
-        constructAndPrintCommandHelpFormat("swap", "{} / {} ({}%)", 3,
+        constructAndPrintCommandHelpFormat("swap", "{} / {} ({}%)", 5,
             "Used size",
             "Total size",
-            "Percentage used"
+            "Percentage used",
+            "Used bytes",
+            "Total bytes"
         );
     }
     else if(ffStrEqualsIgnCase(command, "disk-format"))
     {
-        constructAndPrintCommandHelpFormat("disk", "{1} / {2} ({3}%)", 9,
+        constructAndPrintCommandHelpFormat("disk", "{1} / {2} ({3}%)", 12,
             "Size used",
             "Size total",
             "Size percentage",
@@ -328,7 +343,10 @@ static inline void printCommandHelp(const char* command)
             "Files percentage",
             "True if external volume",
             "True if hidden volume",
-            "Filesystem"
+            "Filesystem",
+            "Label / name",
+            "Used bytes",
+            "Total bytes"
         );
     }
     else if(ffStrEqualsIgnCase(command, "battery-format"))
@@ -484,6 +502,19 @@ static inline void printCommandHelp(const char* command)
             "Identifier"
         );
     }
+    else if(ffStrEqualsIgnCase(command, "sensors-format"))
+    {
+        constructAndPrintCommandHelpFormat("sensors", "{3}", 8,
+            "Chip name",
+            "Device",
+            "Readings",
+            "Highest temperature",
+            "Label of the highest temperature",
+            "Fastest fan speed",
+            "Total power",
+            "Number of channels"
+        );
+    }
     else
         fprintf(stderr, "No specific help for command %s provided\n", command);
 }
@@ -690,6 +721,17 @@ static inline void optionCheckString(const char* key, const char* value, FFstrbu
     ffStrbufEnsureFree(buffer, 63); //This is not needed, as ffStrbufSetS will resize capacity if needed, but giving a higher start should improve performance
 }
 
+static bool parseModuleOption(const char* key, const char* value)
+{
+    // `--<module>-<subkey>`; module names contain no `-`
+    if(key[0] != '-' || key[1] != '-')
+        return false;
+
+    const char* name = key + 2;
+    const FFModuleInfo* info = ffFindModuleInfo(name, (uint32_t) strcspn(name, "-"));
+    return info && info->parseCommandOptions && info->parseCommandOptions(info->options, key, value);
+}
+
 static void parseOption(FFdata* data, const char* key, const char* value)
 {
     ///////////////////////
@@ -838,6 +880,8 @@ static void parseOption(FFdata* data, const char* key, const char* value)
 
     else if(ffStrEqualsIgnCase(key, "-r") || ffStrEqualsIgnCase(key, "--recache"))
         instance.config.recache = ffOptionParseBoolean(value);
+    else if(ffStrEqualsIgnCase(key, "--cache"))
+        instance.config.cache = ffOptionParseBoolean(value);
     else if(ffStrEqualsIgnCase(key, "--load-config"))
         optionParseConfigFile(data, key, value);
     else if(ffStrEqualsIgnCase(key, "--gen-config"))
@@ -861,6 +905,20 @@ static void parseOption(FFdata* data, const char* key, const char* value)
         data->loadUserConfig = ffOptionParseBoolean(value);
     else if(ffStrEqualsIgnCase(key, "--processing-timeout"))
         instance.config.processingTimeout = ffOptionParseInt32(key, value);
+    else if(ffStrEqualsIgnCase(key, "--watch"))
+        instance.config.watchInterval = ffOptionParseUInt32(key, value);
+    else if(ffStrEqualsIgnCase(key, "--format"))
+    {
+        instance.config.outputFormat = (FFOutputFormat) ffOptionParseEnum(key, value, (FFKeyValuePair[]) {
+            { "default", FF_OUTPUT_FORMAT_DEFAULT },
+            { "json", FF_OUTPUT_FORMAT_JSON },
+            {}
+        });
+    }
+    else if(ffStrEqualsIgnCase(key, "--root"))
+        ffOptionParseString(key, value, &instance.config.root);
+    else if(ffStrEqualsIgnCase(key, "--root-list"))
+        ffOptionParseString(key, value, &data->rootList);
 
     #if defined(__linux__) || defined(__FreeBSD__)
     else if(ffStrEqualsIgnCase(key, "--player-name"))
@@ -943,56 +1001,7 @@ static void parseOption(FFdata* data, const char* key, const char* value)
     //Module args options//
     ///////////////////////
 
-    else if(ffParseOSCommandOptions(&instance.config.os, key, value)) {}
-    else if(ffParseHostCommandOptions(&instance.config.host, key, value)) {}
-    else if(ffParseOSCommandOptions(&instance.config.os, key, value)) {}
-    else if(ffParseBiosCommandOptions(&instance.config.bios, key, value)) {}
-    else if(ffParseBoardCommandOptions(&instance.config.board, key, value)) {}
-    else if(ffParseChassisCommandOptions(&instance.config.chassis, key, value)) {}
-    else if(ffParseCommandCommandOptions(&instance.config.command, key, value)) {}
-    else if(ffParseCustomCommandOptions(&instance.config.custom, key, value)) {}
-    else if(ffParseKernelCommandOptions(&instance.config.kernel, key, value)) {}
-    else if(ffParseUptimeCommandOptions(&instance.config.uptime, key, value)) {}
-    else if(ffParseProcessesCommandOptions(&instance.config.processes, key, value)) {}
-    else if(ffParsePackagesCommandOptions(&instance.config.packages, key, value)) {}
-    else if(ffParseShellCommandOptions(&instance.config.shell, key, value)) {}
-    else if(ffParseDisplayCommandOptions(&instance.config.display, key, value)) {}
-    else if(ffParseBrightnessCommandOptions(&instance.config.brightness, key, value)) {}
-    else if(ffParseDECommandOptions(&instance.config.de, key, value)) {}
-    else if(ffParseWifiCommandOptions(&instance.config.wifi, key, value)) {}
-    else if(ffParseWMCommandOptions(&instance.config.wm, key, value)) {}
-    else if(ffParseWMThemeCommandOptions(&instance.config.wmTheme, key, value)) {}
-    else if(ffParseThemeCommandOptions(&instance.config.theme, key, value)) {}
-    else if(ffParseIconsCommandOptions(&instance.config.icons, key, value)) {}
-    else if(ffParseWallpaperCommandOptions(&instance.config.wallpaper, key, value)) {}
-    else if(ffParseFontCommandOptions(&instance.config.font, key, value)) {}
-    else if(ffParseCursorCommandOptions(&instance.config.cursor, key, value)) {}
-    else if(ffParseTerminalCommandOptions(&instance.config.terminal, key, value)) {}
-    else if(ffParseTerminalFontCommandOptions(&instance.config.terminalFont, key, value)) {}
-    else if(ffParseCPUCommandOptions(&instance.config.cpu, key, value)) {}
-    else if(ffParseCPUUsageCommandOptions(&instance.config.cpuUsage, key, value)) {}
-    else if(ffParseGPUCommandOptions(&instance.config.gpu, key, value)) {}
-    else if(ffParseMemoryCommandOptions(&instance.config.memory, key, value)) {}
-    else if(ffParseSwapCommandOptions(&instance.config.swap, key, value)) {}
-    else if(ffParseDiskCommandOptions(&instance.config.disk, key, value)) {}
-    else if(ffParseBatteryCommandOptions(&instance.config.battery, key, value)) {}
-    else if(ffParsePowerAdapterCommandOptions(&instance.config.powerAdapter, key, value)) {}
-    else if(ffParseLocaleCommandOptions(&instance.config.locale, key, value)) {}
-    else if(ffParseLocalIpCommandOptions(&instance.config.localIP, key, value)) {}
-    else if(ffParsePublicIpCommandOptions(&instance.config.publicIP, key, value)) {}
-    else if(ffParseWeatherCommandOptions(&instance.config.weather, key, value)) {}
-    else if(ffParsePlayerCommandOptions(&instance.config.player, key, value)) {}
-    else if(ffParseMediaCommandOptions(&instance.config.media, key, value)) {}
-    else if(ffParseDateTimeCommandOptions(&instance.config.dateTime, key, value)) {}
-    else if(ffParseVulkanCommandOptions(&instance.config.vulkan, key, value)) {}
-    else if(ffParseOpenGLCommandOptions(&instance.config.openGL, key, value)) {}
-    else if(ffParseOpenCLCommandOptions(&instance.config.openCL, key, value)) {}
-    else if(ffParseUsersCommandOptions(&instance.config.users, key, value)) {}
-    else if(ffParseBluetoothCommandOptions(&instance.config.bluetooth, key, value)) {}
-    else if(ffParseSeparatorCommandOptions(&instance.config.separator, key, value)) {}
-    else if(ffParseSoundCommandOptions(&instance.config.sound, key, value)) {}
-    else if(ffParseGamepadCommandOptions(&instance.config.gamepad, key, value)) {}
-    else if(ffParseColorsCommandOptions(&instance.config.colors, key, value)) {}
+    else if(parseModuleOption(key, value)) {}
 
     ///////////////////
     //Library options//
@@ -1130,115 +1139,53 @@ static void parseStructureCommand(const char* line, FFlist* customValues)
         }
     }
 
-    if(ffStrEqualsIgnCase(line, FF_BREAK_MODULE_NAME))
-        ffPrintBreak();
-    else if(ffStrEqualsIgnCase(line, FF_TITLE_MODULE_NAME))
-        ffPrintTitle(&instance.config.title);
-    else if(ffStrEqualsIgnCase(line, FF_SEPARATOR_MODULE_NAME))
-        ffPrintSeparator(&instance.config.separator);
-    else if(ffStrEqualsIgnCase(line, FF_OS_MODULE_NAME))
-        ffPrintOS(&instance.config.os);
-    else if(ffStrEqualsIgnCase(line, FF_HOST_MODULE_NAME))
-        ffPrintHost(&instance.config.host);
-    else if(ffStrEqualsIgnCase(line, FF_BIOS_MODULE_NAME))
-        ffPrintBios(&instance.config.bios);
-    else if(ffStrEqualsIgnCase(line, FF_BOARD_MODULE_NAME))
-        ffPrintBoard(&instance.config.board);
-    else if(ffStrEqualsIgnCase(line, FF_BRIGHTNESS_MODULE_NAME))
-        ffPrintBrightness(&instance.config.brightness);
-    else if(ffStrEqualsIgnCase(line, FF_CHASSIS_MODULE_NAME))
-        ffPrintChassis(&instance.config.chassis);
-    else if(ffStrEqualsIgnCase(line, FF_KERNEL_MODULE_NAME))
-        ffPrintKernel(&instance.config.kernel);
-    else if(ffStrEqualsIgnCase(line, FF_PROCESSES_MODULE_NAME))
-        ffPrintProcesses(&instance.config.processes);
-    else if(ffStrEqualsIgnCase(line, FF_UPTIME_MODULE_NAME))
-        ffPrintUptime(&instance.config.uptime);
-    else if(ffStrEqualsIgnCase(line, FF_PACKAGES_MODULE_NAME))
-        ffPrintPackages(&instance.config.packages);
-    else if(ffStrEqualsIgnCase(line, FF_SHELL_MODULE_NAME))
-        ffPrintShell(&instance.config.shell);
-    else if(ffStrEqualsIgnCase(line, FF_DISPLAY_MODULE_NAME))
-        ffPrintDisplay(&instance.config.display);
-    else if(ffStrEqualsIgnCase(line, FF_DE_MODULE_NAME))
-        ffPrintDE(&instance.config.de);
-    else if(ffStrEqualsIgnCase(line, FF_WM_MODULE_NAME))
-        ffPrintWM(&instance.config.wm);
-    else if(ffStrEqualsIgnCase(line, FF_THEME_MODULE_NAME))
-        ffPrintTheme(&instance.config.theme);
-    else if(ffStrEqualsIgnCase(line, FF_WMTHEME_MODULE_NAME))
-        ffPrintWMTheme(&instance.config.wmTheme);
-    else if(ffStrEqualsIgnCase(line, FF_ICONS_MODULE_NAME))
-        ffPrintIcons(&instance.config.icons);
-    else if(ffStrEqualsIgnCase(line, FF_WALLPAPER_MODULE_NAME))
-        ffPrintWallpaper(&instance.config.wallpaper);
-    else if(ffStrEqualsIgnCase(line, FF_FONT_MODULE_NAME))
-        ffPrintFont(&instance.config.font);
-    else if(ffStrEqualsIgnCase(line, FF_CURSOR_MODULE_NAME))
-        ffPrintCursor(&instance.config.cursor);
-    else if(ffStrEqualsIgnCase(line, FF_TERMINAL_MODULE_NAME))
-        ffPrintTerminal(&instance.config.terminal);
-    else if(ffStrEqualsIgnCase(line, FF_TERMINALFONT_MODULE_NAME))
-        ffPrintTerminalFont(&instance.config.terminalFont);
-    else if(ffStrEqualsIgnCase(line, FF_CPU_MODULE_NAME))
-        ffPrintCPU(&instance.config.cpu);
-    else if(ffStrEqualsIgnCase(line, FF_CPUUSAGE_MODULE_NAME))
-        ffPrintCPUUsage(&instance.config.cpuUsage);
-    else if(ffStrEqualsIgnCase(line, FF_CUSTOM_MODULE_NAME))
-        ffPrintCustom(&instance.config.custom);
-    else if(ffStrEqualsIgnCase(line, FF_GPU_MODULE_NAME))
-        ffPrintGPU(&instance.config.gpu);
-    else if(ffStrEqualsIgnCase(line, FF_MEMORY_MODULE_NAME))
-        ffPrintMemory(&instance.config.memory);
-    else if(ffStrEqualsIgnCase(line, FF_SWAP_MODULE_NAME))
-        ffPrintSwap(&instance.config.swap);
-    else if(ffStrEqualsIgnCase(line, FF_DISK_MODULE_NAME))
-        ffPrintDisk(&instance.config.disk);
-    else if(ffStrEqualsIgnCase(line, FF_BATTERY_MODULE_NAME))
-        ffPrintBattery(&instance.config.battery);
-    else if(ffStrEqualsIgnCase(line, FF_POWERADAPTER_MODULE_NAME))
-        ffPrintPowerAdapter(&instance.config.powerAdapter);
-    else if(ffStrEqualsIgnCase(line, FF_LM_MODULE_NAME))
-        ffPrintLM(&instance.config.lm);
-    else if(ffStrEqualsIgnCase(line, FF_LOCALE_MODULE_NAME))
-        ffPrintLocale(&instance.config.locale);
-    else if(ffStrEqualsIgnCase(line, FF_LOCALIP_MODULE_NAME))
-        ffPrintLocalIp(&instance.config.localIP);
-    else if(ffStrEqualsIgnCase(line, FF_PUBLICIP_MODULE_NAME))
-        ffPrintPublicIp(&instance.config.publicIP);
-    else if(ffStrEqualsIgnCase(line, FF_WIFI_MODULE_NAME))
-        ffPrintWifi(&instance.config.wifi);
-    else if(ffStrEqualsIgnCase(line, FF_WEATHER_MODULE_NAME))
-        ffPrintWeather(&instance.config.weather);
-    else if(ffStrEqualsIgnCase(line, FF_PLAYER_MODULE_NAME))
-        ffPrintPlayer(&instance.config.player);
-    else if(ffStrEqualsIgnCase(line, FF_MEDIA_MODULE_NAME))
-        ffPrintMedia(&instance.config.media);
-    else if(ffStrEqualsIgnCase(line, FF_DATETIME_MODULE_NAME))
-        ffPrintDateTime(&instance.config.dateTime);
-    else if(ffStrEqualsIgnCase(line, FF_COLORS_MODULE_NAME))
-        ffPrintColors(&instance.config.colors);
-    else if(ffStrEqualsIgnCase(line, FF_VULKAN_MODULE_NAME))
-        ffPrintVulkan(&instance.config.vulkan);
-    else if(ffStrEqualsIgnCase(line, FF_OPENGL_MODULE_NAME))
-        ffPrintOpenGL(&instance.config.openGL);
-    else if(ffStrEqualsIgnCase(line, FF_OPENCL_MODULE_NAME))
-        ffPrintOpenCL(&instance.config.openCL);
-    else if(ffStrEqualsIgnCase(line, FF_USERS_MODULE_NAME))
-        ffPrintUsers(&instance.config.users);
-    else if(ffStrEqualsIgnCase(line, FF_COMMAND_MODULE_NAME))
-        ffPrintCommand(&instance.config.command);
-    else if(ffStrEqualsIgnCase(line, FF_BLUETOOTH_MODULE_NAME))
-        ffPrintBluetooth(&instance.config.bluetooth);
-    else if(ffStrEqualsIgnCase(line, FF_SOUND_MODULE_NAME))
-        ffPrintSound(&instance.config.sound);
-    else if(ffStrEqualsIgnCase(line, FF_GAMEPAD_MODULE_NAME))
-        ffPrintGamepad(&instance.config.gamepad);
+    const FFModuleInfo* info = ffFindModuleInfo(line, (uint32_t) strlen(line));
+    if(info)
+        info->print(info->options);
     else
         ffPrintErrorString(line, 0, NULL, NULL, "<no implementation provided>");
 }
 
-int main(int argc, const char** argv)
+typedef struct FFStructureJobData
+{
+    FFlist* commands;
+    FFlist* customValues;
+} FFStructureJobData;
+
+static void runStructureJob(void* data, uint32_t index)
+{
+    FFStructureJobData* jobData = (FFStructureJobData*) data;
+    parseStructureCommand(*(const char**) ffListGet(jobData->commands, index), jobData->customValues);
+}
+
+static bool isStructureJobDynamic(void* data, uint32_t index)
+{
+    FFStructureJobData* jobData = (FFStructureJobData*) data;
+    const char* line = *(const char**) ffListGet(jobData->commands, index);
+
+    FF_LIST_FOR_EACH(FFCustomValue, customValue, *jobData->customValues)
+    {
+        if (ffStrbufEqualS(&customValue->key, line))
+            return false;
+    }
+
+    const FFModuleInfo* info = ffFindModuleInfo(line, (uint32_t) strlen(line));
+    return info && info->dynamic;
+}
+
+static void destroyData(FFdata* data)
+{
+    ffStrbufDestroy(&data->structure);
+    ffStrbufDestroy(&data->rootList);
+    FF_LIST_FOR_EACH(FFCustomValue, customValue, data->customValues)
+    {
+        ffStrbufDestroy(&customValue->key);
+        ffStrbufDestroy(&customValue->value);
+    }
+    ffListDestroy(&data->customValues);
+}
+
+static int run(int argc, const char** argv)
 {
     ffInitInstance();
 
@@ -1247,6 +1194,7 @@ int main(int argc, const char** argv)
     ffStrbufInit(&data.structure);
     ffListInit(&data.customValues, sizeof(FFCustomValue));
     data.loadUserConfig = true;
+    ffStrbufInit(&data.rootList);
 
     if(!getenv("NO_CONFIG"))
         parseConfigFiles(&data);
@@ -1268,6 +1216,40 @@ int main(int argc, const char** argv)
         }
     }
 
+    const char* batchRoot = ffRootGetBatchRoot();
+    if(batchRoot)
+    {
+        ffStrbufSetS(&instance.config.root, batchRoot);
+        // Every root would replace the cache entries of the previous one
+        instance.config.cache = false;
+        instance.config.watchInterval = 0;
+    }
+    else if(data.rootList.length > 0)
+    {
+        int status = ffRootRunBatch(data.rootList.chars, argc, argv, run);
+        destroyData(&data);
+        ffDestroyInstance();
+        return status;
+    }
+    // `--root /` is the same as no root
+    ffStrbufTrimRight(&instance.config.root, '/');
+    if(instance.config.root.length > 0 && !ffPathExists(instance.config.root.chars, FF_PATHTYPE_DIRECTORY))
+    {
+        fprintf(stderr, "Error: --root %s is not a directory\n", instance.config.root.chars);
+        destroyData(&data);
+        ffDestroyInstance();
+        return EXIT_FAILURE;
+    }
+
+    if(instance.config.outputFormat == FF_OUTPUT_FORMAT_JSON)
+    {
+        // Nothing but the document is printed
+        instance.config.logo.type = FF_LOGO_TYPE_NONE;
+        instance.config.pipe = true;
+        instance.config.stat = false;
+        instance.config.watchInterval = 0;
+    }
+
     if(data.structure.length > 0 || !instance.state.configDoc)
     {
         //If we don't have a custom structure, use the default one
@@ -1286,6 +1268,8 @@ int main(int argc, const char** argv)
                 ffPrepareWeather(&instance.config.weather);
         }
     }
+    else if(ffJsonConfigHasModule(FF_CPUUSAGE_MODULE_NAME))
+        ffPrepareCPUUsage();
 
     ffStart();
 
@@ -1300,45 +1284,33 @@ int main(int argc, const char** argv)
     else
     {
         //Parse the structure and call the modules
+        FF_LIST_AUTO_DESTROY commands = ffListCreate(sizeof(const char*));
         uint32_t startIndex = 0;
         while (startIndex < data.structure.length)
         {
             uint32_t colonIndex = ffStrbufNextIndexC(&data.structure, startIndex, ':');
             data.structure.chars[colonIndex] = '\0';
-
-            uint64_t ms = 0;
-            if(__builtin_expect(instance.config.stat, false))
-                ms = ffTimeGetTick();
-
-            parseStructureCommand(data.structure.chars + startIndex, &data.customValues);
-
-            if(__builtin_expect(instance.config.stat, false))
-            {
-                char str[32];
-                int len = snprintf(str, sizeof str, "%" PRIu64 "ms", ffTimeGetTick() - ms);
-                if(instance.config.pipe)
-                    puts(str);
-                else
-                    printf("\033[s\033[1A\033[9999999C\033[%dD%s\033[u", len, str); // Save; Up 1; Right 9999999; Left <len>; Print <str>; Load
-            }
-
-            #if defined(_WIN32)
-                if (!instance.config.noBuffer) fflush(stdout);
-            #endif
-
+            *(const char**) ffListAdd(&commands) = data.structure.chars + startIndex;
             startIndex = colonIndex + 1;
         }
+
+        if(instance.config.outputFormat == FF_OUTPUT_FORMAT_JSON)
+            ffPrintJsonResult(commands.length, (const char* const*) commands.data, NULL);
+        else
+        {
+            FFStructureJobData jobData = { &commands, &data.customValues };
+            ffWatchRun(commands.length, runStructureJob, &jobData, isStructureJobDynamic);
+        }
     }
 
     ffFinish();
 
-    ffStrbufDestroy(&data.structure);
-    FF_LIST_FOR_EACH(FFCustomValue, customValue, data.customValues)
-    {
-        ffStrbufDestroy(&customValue->key);
-        ffStrbufDestroy(&customValue->value);
-    }
-    ffListDestroy(&data.customValues);
-
+    destroyData(&data);
     ffDestroyInstance();
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, const char** argv)
+{
+    return run(argc, argv);
 }
@@ -27,6 +27,12 @@ typedef enum FFBinaryPrefixType
     FF_BINARY_PREFIX_TYPE_JEDEC, // 1024 Bytes = 1 kB, 1024 K = 1 MB, ...
 } FFBinaryPrefixType;
 
+typedef enum FFOutputFormat
+{
+    FF_OUTPUT_FORMAT_DEFAULT, // Logo and a line per module
+    FF_OUTPUT_FORMAT_JSON,    // One JSON document with the detection result of every module, see common/jsonresult.h
+} FFOutputFormat;
+
 typedef struct FFconfig
 {
     FFLogoOptions logo;
@@ -39,6 +45,7 @@ typedef struct FFconfig
 
     bool showErrors;
     bool recache;
+    bool cache;
     bool allowSlowOperations;
     bool disableLinewrap;
     bool hideCursor;
@@ -51,6 +58,9 @@ typedef struct FFconfig
     bool stat;
     bool noBuffer;
     int32_t processingTimeout;
+    uint32_t watchInterval; // ms; 0 if disabled
+    FFOutputFormat outputFormat;
+    FFstrbuf root; // `--root`: file based detection reads below this directory instead of /. Empty if unset, see common/root.h
 
     // Module options that cannot be put in module option structure
     #if defined(__linux__) || defined(__FreeBSD__)
@@ -110,6 +120,7 @@ typedef struct FFconfig
     FFSeparatorOptions separator;
     FFSoundOptions sound;
     FFGamepadOptions gamepad;
+    FFSensorsOptions sensors;
     FFColorsOptions colors;
 
     FFstrbuf libPCI;
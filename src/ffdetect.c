@@ -0,0 +1,140 @@
+#include "ffdetect.h"
+#include "common/thread.h"
+#include "modules/modules.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+struct FFDetectContext
+{
+    uint32_t moduleCount;
+    void* options[]; // Indexed like ffModuleInfos
+};
+
+static void initProcessState(void)
+{
+    static FFThreadMutex mutex = FF_THREAD_MUTEX_INITIALIZER;
+    static bool init = false;
+
+    ffThreadMutexLock(&mutex);
+    if(!init)
+    {
+        ffInitInstance();
+        instance.config.cache = false;
+        init = true;
+    }
+    ffThreadMutexUnlock(&mutex);
+}
+
+FFDetectContext* ffDetectContextCreate(void)
+{
+    initProcessState();
+
+    uint32_t count = 0;
+    while(ffModuleInfos[count].name)
+        ++count;
+
+    FFDetectContext* context = calloc(1, sizeof(*context) + count * sizeof(context->options[0]));
+    if(!context)
+        return NULL;
+    context->moduleCount = count;
+
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        const FFModuleInfo* info = &ffModuleInfos[i];
+        if(!info->initOptions)
+            continue;
+
+        context->options[i] = malloc(info->optionsSize);
+        if(!context->options[i])
+        {
+            ffDetectContextDestroy(context);
+            return NULL;
+        }
+        info->initOptions(context->options[i]);
+    }
+
+    return context;
+}
+
+void ffDetectContextDestroy(FFDetectContext* context)
+{
+    if(!context)
+        return;
+
+    for(uint32_t i = 0; i < context->moduleCount; ++i)
+    {
+        if(!context->options[i])
+            continue;
+
+        ffModuleInfos[i].destroyOptions(context->options[i]);
+        free(context->options[i]);
+    }
+
+    free(context);
+}
+
+static const FFModuleInfo* findModule(const char* moduleName)
+{
+    return ffFindModuleInfo(moduleName, (uint32_t) strlen(moduleName));
+}
+
+void* ffDetectContextGetOptions(FFDetectContext* context, const char* moduleName)
+{
+    const FFModuleInfo* info = findModule(moduleName);
+    return info ? context->options[info - ffModuleInfos] : NULL;
+}
+
+uint32_t ffDetectContextGetResultSize(const char* moduleName)
+{
+    const FFModuleInfo* info = findModule(moduleName);
+    return info && info->detect ? info->resultSize : 0;
+}
+
+const char* ffDetectContextRun(FFDetectContext* context, const char* moduleName, void* result)
+{
+    const FFModuleInfo* info = findModule(moduleName);
+    if(!info)
+        return "Unknown module";
+    if(!info->detect)
+        return "Module has no detection step";
+
+    return info->detect(context->options[info - ffModuleInfos], result);
+}
+
+void ffDetectContextDestroyResult(const char* moduleName, void* result)
+{
+    const FFModuleInfo* info = findModule(moduleName);
+    if(info && info->destroyResult)
+        info->destroyResult(result);
+}
+
+const char* ffDetectContextCPU(FFDetectContext* context, FFCPUResult* result)
+{
+    return ffDetectContextRun(context, FF_CPU_MODULE_NAME, result);
+}
+
+const char* ffDetectContextGPU(FFDetectContext* context, FFlist* result)
+{
+    return ffDetectContextRun(context, FF_GPU_MODULE_NAME, result);
+}
+
+const char* ffDetectContextMemory(FFDetectContext* context, FFMemoryResult* result)
+{
+    return ffDetectContextRun(context, FF_MEMORY_MODULE_NAME, result);
+}
+
+const char* ffDetectContextDisk(FFDetectContext* context, FFlist* result)
+{
+    return ffDetectContextRun(context, FF_DISK_MODULE_NAME, result);
+}
+
+const char* ffDetectContextOS(FFDetectContext* context, const FFOSResult** result)
+{
+    return ffDetectContextRun(context, FF_OS_MODULE_NAME, result);
+}
+
+const char* ffDetectContextPackages(FFDetectContext* context, FFPackagesResult* result)
+{
+    return ffDetectContextRun(context, FF_PACKAGES_MODULE_NAME, result);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#ifndef FF_INCLUDED_ffdetect
+#define FF_INCLUDED_ffdetect
+
+// Public API of libffdetect: the detection part of fastfetch, without any printing.
+//
+// Every detection runs against an explicit FFDetectContext holding the module options to use.
+// Contexts are independent from each other and may be used from multiple threads at the same time.
+// Results are the same plain structs fastfetch uses internally; strings are FFstrbuf (`chars` / `length`)
+// and lists are FFlist (see util/FFlist.h).
+//
+// Process wide state (platform information, library paths, caches of detected singletons and loaded libraries)
+// is initialized by the first context and kept until the process exits, so repeated detections stay cheap.
+// Unlike the fastfetch executable, detection results are never read from or written to the persistent cache.
+
+#include "fastfetch.h"
+#include "detection/cpu/cpu.h"
+#include "detection/disk/disk.h"
+#include "detection/gpu/gpu.h"
+#include "detection/memory/memory.h"
+#include "detection/os/os.h"
+#include "detection/packages/packages.h"
+
+#define FF_DETECT_API_VERSION 1
+
+typedef struct FFDetectContext FFDetectContext;
+
+// Returns NULL if out of memory
+FFDetectContext* ffDetectContextCreate(void);
+void ffDetectContextDestroy(FFDetectContext* context);
+
+// Options used by the context for the given module (case insensitive), e.g. `FFCPUOptions*` for "CPU".
+// NULL if the module doesn't exist. Must not be modified while a detection is running on this context
+void* ffDetectContextGetOptions(FFDetectContext* context, const char* moduleName);
+
+// Generic interface, for every module that has a detection step.
+// `result` must point to at least ffDetectContextGetResultSize(moduleName) bytes.
+// It is always initialized, and must be released with ffDetectContextDestroyResult, even if an error is returned
+uint32_t ffDetectContextGetResultSize(const char* moduleName); // 0 if the module doesn't exist or detects nothing
+const char* ffDetectContextRun(FFDetectContext* context, const char* moduleName, void* result);
+void ffDetectContextDestroyResult(const char* moduleName, void* result);
+
+// Typed shortcuts. Results must be released with ffDestroyXxxModuleResult (see modules/xxx/xxx.h),
+// or with ffDetectContextDestroyResult("Xxx", result)
+const char* ffDetectContextCPU(FFDetectContext* context, FFCPUResult* result);
+const char* ffDetectContextGPU(FFDetectContext* context, FFlist* result /* FFGPUResult */);
+const char* ffDetectContextMemory(FFDetectContext* context, FFMemoryResult* result);
+const char* ffDetectContextDisk(FFDetectContext* context, FFlist* result /* FFDisk */);
+const char* ffDetectContextOS(FFDetectContext* context, const FFOSResult** result); // Not to be released
+const char* ffDetectContextPackages(FFDetectContext* context, FFPackagesResult* result);
+
+#endif
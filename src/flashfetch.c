@@ -62,6 +62,7 @@ int main(void)
     //ffPrintBluetooth(&instance.config.bluetooth);
     //ffPrintSound(&instance.config.sound);
     //ffPrintGamepad(&instance.config.gamepad);
+    //ffPrintSensors(&instance.config.sensors);
     ffPrintBreak();
     ffPrintColors(&instance.config.colors);
 
@@ -1,6 +1,41 @@
 #include "logo.h"
 
-#define FF_LOGO_INIT static FFlogo logo; static bool init = false; if(init) return &logo; init = true;
+#include <string.h>
+
+// Names are looked up in a perfect hash table generated at build time: the seed of the bucket
+// `logoNameHash(name, 0) % FF_LOGO_BUILTIN_INDEX_BUCKETS` maps the name to its slot in ffLogoBuiltinIndex
+typedef struct FFLogoBuiltinIndexEntry
+{
+    const char* name; // Lower case; NULL if the slot is empty
+    uint8_t logos[3]; // Index in ffLogoBuiltinGetAll by FFLogoSize; UINT8_MAX if no logo matches
+} FFLogoBuiltinIndexEntry;
+
+// FNV-1a of the lower case name
+static inline uint32_t logoNameHash(const char* name, uint32_t length, uint32_t seed)
+{
+    uint32_t hash = 2166136261u ^ seed;
+    for(uint32_t i = 0; i < length; ++i)
+    {
+        char c = name[i];
+        hash ^= (uint8_t) (c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Every logo gets an id in the order of the definitions below, the index of its rendered version
+#if defined(FF_LOGO_CODEGEN)
+    void ffLogoCodegenAdd(uint32_t id, const FFlogo* logo);
+    #define FF_LOGO_RENDERED(id) ffLogoCodegenAdd(id, &logo);
+#elif defined(FF_HAVE_LOGO_CODEGEN)
+    #include "fastfetch_logo_builtin.h"
+    #define FF_LOGO_RENDERED(id) logo.rendered = &ffLogoBuiltinRendered[id];
+#else
+    #define FF_LOGO_RENDERED(id)
+#endif
+enum { FF_LOGO_ID_BASE = __COUNTER__ + 1 };
+
+#define FF_LOGO_INIT static FFlogo logo; static bool init = false; if(init) return &logo; init = true; FF_LOGO_RENDERED((uint32_t) (__COUNTER__ - FF_LOGO_ID_BASE))
 // The names of small logo must end with `_small` or `-small`
 #define FF_LOGO_INIT_SMALL FF_LOGO_INIT logo.small = true;
 #define FF_LOGO_NAMES(...) static const char* names[] = (const char*[]) { __VA_ARGS__, NULL }; logo.names = names;
@@ -2733,3 +2768,70 @@ GetLogoMethod* ffLogoBuiltinGetAll(void)
 
     return logoMethods;
 }
+
+#ifndef FF_HAVE_LOGO_CODEGEN
+static bool logoHasName(const FFlogo* logo, const FFstrbuf* name, bool small)
+{
+    for(const char** logoName = logo->names; *logoName != NULL; ++logoName)
+    {
+        if(small)
+        {
+            uint32_t logoNameLength = (uint32_t) (strlen(*logoName) - strlen("_small"));
+            if(name->length == logoNameLength && strncasecmp(*logoName, name->chars, logoNameLength) == 0) return true;
+        }
+        if(ffStrbufIgnCaseEqualS(name, *logoName))
+            return true;
+    }
+
+    return false;
+}
+
+// The first logo of ffLogoBuiltinGetAll with the name; UINT8_MAX if there is none
+static uint8_t logoFindLinear(const FFstrbuf* name, FFLogoSize size)
+{
+    GetLogoMethod* methods = ffLogoBuiltinGetAll();
+    for(uint8_t i = 0; methods[i]; ++i)
+    {
+        const FFlogo* logo = methods[i]();
+
+        switch (size)
+        {
+            case FF_LOGO_SIZE_NORMAL:
+                if(logo->small) continue;
+                break;
+            case FF_LOGO_SIZE_SMALL:
+                if(!logo->small) continue;
+                break;
+            default:
+                break;
+        }
+
+        if(logoHasName(logo, name, size == FF_LOGO_SIZE_SMALL))
+            return i;
+    }
+
+    return UINT8_MAX;
+}
+#endif
+
+const FFlogo* ffLogoBuiltinFind(const FFstrbuf* name, FFLogoSize size)
+{
+    if (name->length == 0)
+        return NULL;
+
+    #ifdef FF_HAVE_LOGO_CODEGEN
+        uint32_t seed = ffLogoBuiltinIndexSeeds[logoNameHash(name->chars, name->length, 0) % FF_LOGO_BUILTIN_INDEX_BUCKETS];
+        const FFLogoBuiltinIndexEntry* entry = &ffLogoBuiltinIndex[logoNameHash(name->chars, name->length, seed) % FF_LOGO_BUILTIN_INDEX_SIZE];
+        if(entry->name == NULL || strncasecmp(entry->name, name->chars, name->length) != 0 || entry->name[name->length] != '\0')
+            return NULL;
+        uint8_t index = entry->logos[size];
+    #else
+        uint8_t index = logoFindLinear(name, size);
+    #endif
+
+    return index == UINT8_MAX ? NULL : ffLogoBuiltinGetAll()[index]();
+}
+
+#ifdef FF_HAVE_LOGO_CODEGEN
+    _Static_assert(__COUNTER__ - FF_LOGO_ID_BASE == FF_LOGO_BUILTIN_RENDERED_COUNT, "fastfetch_logo_builtin.h is outdated");
+#endif
@@ -0,0 +1,401 @@
+// Build time tool: renders the builtin logos of builtin.c with their builtin colors into fastfetch_logo_builtin.h, see FFlogoRendered,
+// and generates the perfect hash table of their names, see FFLogoBuiltinIndexEntry.
+// Usage: fastfetch-logo-codegen <output header>
+// Must render byte for byte what ffLogoPrintChars prints between the paddings
+
+#define FF_LOGO_CODEGEN
+#include "logo/builtin.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FF_LOGO_CODEGEN_MAX 1024
+
+static const FFlogo* logos[FF_LOGO_CODEGEN_MAX];
+static uint32_t logoCount;
+
+void ffLogoCodegenAdd(uint32_t id, const FFlogo* logo)
+{
+    if(id >= FF_LOGO_CODEGEN_MAX)
+    {
+        fputs("fastfetch-logo-codegen: too many logos\n", stderr);
+        exit(EXIT_FAILURE);
+    }
+    logos[id] = logo;
+    if(id >= logoCount)
+        logoCount = id + 1;
+}
+
+typedef struct Buffer
+{
+    char* chars;
+    uint32_t length;
+    uint32_t capacity;
+} Buffer;
+
+static void appendN(Buffer* buffer, const char* value, uint32_t length)
+{
+    if(buffer->length + length > buffer->capacity)
+    {
+        while(buffer->length + length > buffer->capacity)
+            buffer->capacity = buffer->capacity ? buffer->capacity * 2 : 4096;
+        buffer->chars = realloc(buffer->chars, buffer->capacity);
+        if(!buffer->chars)
+            exit(EXIT_FAILURE);
+    }
+    memcpy(buffer->chars + buffer->length, value, length);
+    buffer->length += length;
+}
+
+static inline void append(Buffer* buffer, const char* value)
+{
+    appendN(buffer, value, (uint32_t) strlen(value));
+}
+
+static inline void appendC(Buffer* buffer, char c)
+{
+    appendN(buffer, &c, 1);
+}
+
+static void appendColor(Buffer* buffer, const char* color)
+{
+    if(*color == '\0')
+        return;
+    append(buffer, "\033[");
+    append(buffer, color);
+    appendC(buffer, 'm');
+}
+
+// Mirrors ffLogoPrintChars with doColorReplacement, writing '\n' only between lines.
+// Appends the start offset of every line and a last entry of length + 1 to `lineStarts`, returns the width
+static uint32_t renderLogo(const FFlogo* logo, Buffer* data, Buffer* lineStarts)
+{
+    // Colors after the builtin ones stay empty, which ffPrintColor doesn't print
+    const char* colors[FASTFETCH_LOGO_MAX_COLORS];
+    for(uint32_t i = 0; i < FASTFETCH_LOGO_MAX_COLORS; ++i)
+        colors[i] = "";
+    for(uint32_t i = 0; i < FASTFETCH_LOGO_MAX_COLORS && logo->builtinColors[i]; ++i)
+        colors[i] = logo->builtinColors[i];
+
+    uint32_t width = 0, currentlineLength = 0;
+    appendN(lineStarts, (const char*) &data->length, sizeof(uint32_t));
+    appendColor(data, colors[0]);
+
+    for(const char* p = logo->data; *p != '\0';)
+    {
+        if(*p == '\n' || (*p == '\r' && p[1] == '\n'))
+        {
+            p += *p == '\r' ? 2 : 1;
+            appendC(data, '\n');
+            appendN(lineStarts, (const char*) &data->length, sizeof(uint32_t));
+            if(currentlineLength > width)
+                width = currentlineLength;
+            currentlineLength = 0;
+            continue;
+        }
+
+        if(*p == '\t')
+        {
+            append(data, "    ");
+            ++p;
+            continue;
+        }
+
+        if(*p == '\033' && p[1] == '[')
+        {
+            const char* start = p;
+            append(data, "\033[");
+            p += 2;
+            while((*p >= '0' && *p <= '9') || *p == ';')
+                appendC(data, *p++);
+            if(*p > 0 && (unsigned char) *p < 128)
+            {
+                appendC(data, *p++);
+                continue;
+            }
+            currentlineLength += (uint32_t) (p - start - 1);
+        }
+
+        if(*p == '$')
+        {
+            ++p;
+            if(*p == '$' || *p == '\0')
+            {
+                appendC(data, '$');
+                ++currentlineLength;
+                if(*p == '$')
+                    ++p;
+                continue;
+            }
+
+            int index = ((int) *p) - '1';
+            if(index < 0 || index >= FASTFETCH_LOGO_MAX_COLORS)
+            {
+                appendC(data, '$');
+                ++currentlineLength;
+            }
+            else
+            {
+                appendColor(data, colors[index]);
+                ++p;
+                continue;
+            }
+        }
+
+        ++currentlineLength;
+
+        unsigned char codepoint = (unsigned char) *p;
+        uint32_t bytes = 1;
+        if((codepoint & 0xE0) == 0xC0)
+            bytes = 2;
+        else if((codepoint & 0xF0) == 0xE0)
+            bytes = 3;
+        else if((codepoint & 0xF8) == 0xF0)
+            bytes = 4;
+        for(uint32_t i = 0; i < bytes && *p != '\0'; ++i)
+            appendC(data, *p++);
+    }
+
+    if(currentlineLength > width)
+        width = currentlineLength;
+
+    uint32_t end = data->length + 1;
+    appendN(lineStarts, (const char*) &end, sizeof(uint32_t));
+    return width;
+}
+
+// Octal escapes for everything but printable ASCII; '?' too, to never form a trigraph
+static void writeLiteral(FILE* file, const char* chars, uint32_t length)
+{
+    fputc('"', file);
+    for(uint32_t i = 0; i < length; ++i)
+    {
+        unsigned char c = (unsigned char) chars[i];
+        if(c == '\n')
+            fputs(i + 1 < length ? "\\n\"\n    \"" : "\\n", file);
+        else if(c == '"' || c == '\\')
+        {
+            fputc('\\', file);
+            fputc(c, file);
+        }
+        else if(c < 0x20 || c >= 0x7F || c == '?')
+            fprintf(file, "\\%03o", c);
+        else
+            fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+typedef struct IndexKey
+{
+    char name[128];
+    uint32_t length;
+    uint32_t bucket;
+    uint32_t slot;
+} IndexKey;
+
+static void addIndexKey(IndexKey* keys, uint32_t* count, const char* name, uint32_t length)
+{
+    if(length >= sizeof(keys->name))
+    {
+        fprintf(stderr, "fastfetch-logo-codegen: logo name %s is too long\n", name);
+        exit(EXIT_FAILURE);
+    }
+
+    IndexKey key = { .length = length };
+    for(uint32_t i = 0; i < length; ++i)
+        key.name[i] = (char) (name[i] >= 'A' && name[i] <= 'Z' ? name[i] - 'A' + 'a' : name[i]);
+
+    for(uint32_t i = 0; i < *count; ++i)
+    {
+        if(strcmp(keys[i].name, key.name) == 0)
+            return;
+    }
+    keys[(*count)++] = key;
+}
+
+// Hash and displace: the keys of a bucket are placed with the first seed that maps all of them to free slots, biggest buckets first
+static void writeIndex(FILE* file)
+{
+    GetLogoMethod* methods = ffLogoBuiltinGetAll();
+    uint32_t methodCount = 0, nameCount = 0;
+    for(; methods[methodCount]; ++methodCount)
+    {
+        for(const char** name = methods[methodCount]()->names; *name; ++name)
+            ++nameCount;
+    }
+    if(methodCount >= UINT8_MAX)
+    {
+        fputs("fastfetch-logo-codegen: too many logos for FFLogoBuiltinIndexEntry\n", stderr);
+        exit(EXIT_FAILURE);
+    }
+
+    // Every name, and the names of small logos without `_small`
+    IndexKey* keys = calloc(nameCount * 2, sizeof(IndexKey));
+    uint32_t keyCount = 0;
+    for(uint32_t i = 0; i < methodCount; ++i)
+    {
+        const FFlogo* logo = methods[i]();
+        for(const char** name = logo->names; *name; ++name)
+        {
+            uint32_t length = (uint32_t) strlen(*name);
+            addIndexKey(keys, &keyCount, *name, length);
+            if(logo->small && length > strlen("_small"))
+                addIndexKey(keys, &keyCount, *name, length - (uint32_t) strlen("_small"));
+        }
+    }
+
+    const uint32_t bucketCount = keyCount / 2 + 1;
+    const uint32_t size = keyCount + keyCount / 4 + 1;
+    uint32_t* seeds = calloc(bucketCount, sizeof(uint32_t));
+    uint32_t* bucketSizes = calloc(bucketCount, sizeof(uint32_t));
+    IndexKey** slots = calloc(size, sizeof(IndexKey*));
+
+    for(uint32_t i = 0; i < keyCount; ++i)
+    {
+        keys[i].bucket = logoNameHash(keys[i].name, keys[i].length, 0) % bucketCount;
+        ++bucketSizes[keys[i].bucket];
+    }
+
+    for(uint32_t bucketSize = keyCount; bucketSize > 0; --bucketSize)
+    {
+        for(uint32_t bucket = 0; bucket < bucketCount; ++bucket)
+        {
+            if(bucketSizes[bucket] != bucketSize)
+                continue;
+
+            for(uint32_t seed = 1;; ++seed)
+            {
+                if(seed == 1 << 24)
+                {
+                    fputs("fastfetch-logo-codegen: no perfect hash found\n", stderr);
+                    exit(EXIT_FAILURE);
+                }
+
+                bool free = true;
+                for(uint32_t i = 0; i < keyCount && free; ++i)
+                {
+                    if(keys[i].bucket != bucket)
+                        continue;
+                    keys[i].slot = logoNameHash(keys[i].name, keys[i].length, seed) % size;
+                    free = slots[keys[i].slot] == NULL;
+                    for(uint32_t j = 0; j < i && free; ++j)
+                        free = keys[j].bucket != bucket || keys[j].slot != keys[i].slot;
+                }
+                if(!free)
+                    continue;
+
+                seeds[bucket] = seed;
+                for(uint32_t i = 0; i < keyCount; ++i)
+                {
+                    if(keys[i].bucket == bucket)
+                        slots[keys[i].slot] = &keys[i];
+                }
+                break;
+            }
+        }
+    }
+
+    fprintf(file, "#define FF_LOGO_BUILTIN_INDEX_BUCKETS %u\n", bucketCount);
+    fprintf(file, "#define FF_LOGO_BUILTIN_INDEX_SIZE %u\n\n", size);
+
+    fputs("static const uint32_t ffLogoBuiltinIndexSeeds[] = {", file);
+    for(uint32_t i = 0; i < bucketCount; ++i)
+        fprintf(file, "%s%u,", i % 16 == 0 ? "\n    " : " ", seeds[i]);
+    fputs("\n};\n\n", file);
+
+    fputs("static const FFLogoBuiltinIndexEntry ffLogoBuiltinIndex[] = {\n", file);
+    for(uint32_t i = 0; i < size; ++i)
+    {
+        if(!slots[i])
+        {
+            fputs("    { NULL, { UINT8_MAX, UINT8_MAX, UINT8_MAX } },\n", file);
+            continue;
+        }
+
+        // Resolved with the linear search, so the table can't disagree with it
+        FFstrbuf name = { .length = slots[i]->length, .chars = slots[i]->name };
+        fputs("    { ", file);
+        writeLiteral(file, name.chars, name.length);
+        fputs(", {", file);
+        for(FFLogoSize logoSize = FF_LOGO_SIZE_UNKNOWN; logoSize <= FF_LOGO_SIZE_SMALL; ++logoSize)
+        {
+            uint8_t index = logoFindLinear(&name, logoSize);
+            if(index == UINT8_MAX)
+                fputs(" UINT8_MAX,", file);
+            else
+                fprintf(file, " %u,", index);
+        }
+        fputs(" } },\n", file);
+    }
+    fputs("};\n", file);
+
+    free(slots);
+    free(bucketSizes);
+    free(seeds);
+    free(keys);
+}
+
+int main(int argc, char** argv)
+{
+    if(argc != 2)
+    {
+        fputs("Usage: fastfetch-logo-codegen <output header>\n", stderr);
+        return EXIT_FAILURE;
+    }
+
+    // Every logo registers itself when it is initialized
+    ffLogoBuiltinGetUnknown();
+    for(GetLogoMethod* methods = ffLogoBuiltinGetAll(); *methods; ++methods)
+        (*methods)();
+
+    FILE* file = fopen(argv[1], "w");
+    if(!file)
+    {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    fputs("// Generated from src/logo/builtin.c by src/logo/builtin_codegen.c. Do not edit\n\n", file);
+    fputs("#pragma once\n\n", file);
+    fprintf(file, "#define FF_LOGO_BUILTIN_RENDERED_COUNT %u\n\n", logoCount);
+
+    Buffer data = { NULL, 0, 0 }, lineStarts = { NULL, 0, 0 };
+    uint32_t* widths = calloc(logoCount, sizeof(uint32_t));
+    uint32_t* lines = calloc(logoCount, sizeof(uint32_t));
+    for(uint32_t id = 0; id < logoCount; ++id)
+    {
+        if(!logos[id])
+        {
+            fprintf(stderr, "fastfetch-logo-codegen: logo %u is not returned by ffLogoBuiltinGetAll\n", id);
+            return EXIT_FAILURE;
+        }
+
+        data.length = lineStarts.length = 0;
+        widths[id] = renderLogo(logos[id], &data, &lineStarts);
+        lines[id] = lineStarts.length / (uint32_t) sizeof(uint32_t) - 1;
+
+        fprintf(file, "// %s\n", logos[id]->names[0]);
+        fprintf(file, "static const uint32_t ffLogoBuiltinRenderedLines%u[] = {", id);
+        for(uint32_t i = 0; i <= lines[id]; ++i)
+            fprintf(file, "%s%u", i > 0 ? ", " : " ", ((uint32_t*) lineStarts.chars)[i]);
+        fputs(" };\n", file);
+        fprintf(file, "static const char ffLogoBuiltinRenderedData%u[] =\n    ", id);
+        writeLiteral(file, data.chars, data.length);
+        fputs(";\n\n", file);
+    }
+
+    fputs("static const FFlogoRendered ffLogoBuiltinRendered[] = {\n", file);
+    for(uint32_t id = 0; id < logoCount; ++id)
+        fprintf(file, "    { ffLogoBuiltinRenderedData%u, ffLogoBuiltinRenderedLines%u, %u, %u },\n", id, id, widths[id], lines[id]);
+    fputs("};\n\n", file);
+
+    writeIndex(file);
+
+    free(widths);
+    free(lines);
+    free(data.chars);
+    free(lineStarts.chars);
+    return fclose(file) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,5 +1,6 @@
 #include "image.h"
 #include "common/io/io.h"
+#include "common/output.h"
 #include "common/printing.h"
 
 #include <limits.h>
@@ -223,8 +224,7 @@ static void printImagePixels(FFLogoRequestData* requestData, const FFstrbuf* res
     //Write result to stdout
     ffPrintCharTimes('\n', instance.config.logo.paddingTop);
     ffPrintCharTimes(' ', instance.config.logo.paddingLeft);
-    fflush(stdout);
-    ffWriteFDBuffer(FFUnixFD2NativeFD(STDOUT_FILENO), result);
+    ffOutputWrite(result->chars, result->length);
 
     //Go to upper left corner
     fputs("\033[9999999D", stdout);
@@ -589,17 +589,19 @@ static bool printCachedPixel(FFLogoRequestData* requestData)
     if(fd == -1)
         return false;
 
-    ffPrintCharTimes('\n', instance.config.logo.paddingTop);
-    ffPrintCharTimes(' ', instance.config.logo.paddingLeft);
-    fflush(stdout);
-
+    // Written together with the padding, in one go
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreateA(32768);
     char buffer[32768];
     ssize_t readBytes;
     while((readBytes = ffReadFDData(FFUnixFD2NativeFD(fd), sizeof(buffer), buffer)) > 0)
-        ffWriteFDData(FFUnixFD2NativeFD(STDOUT_FILENO), (size_t) readBytes, buffer);
+        ffStrbufAppendNS(&content, (uint32_t) readBytes, buffer);
 
     close(fd);
 
+    ffPrintCharTimes('\n', instance.config.logo.paddingTop);
+    ffPrintCharTimes(' ', instance.config.logo.paddingLeft);
+    ffOutputWrite(content.chars, content.length);
+
     instance.state.logoWidth = requestData->logoCharacterWidth + instance.config.logo.paddingLeft + instance.config.logo.paddingRight;
     instance.state.logoHeight = requestData->logoCharacterHeight + instance.config.logo.paddingTop;
 
@@ -1,5 +1,6 @@
 #include "logo/logo.h"
 #include "common/io/io.h"
+#include "common/scheduler.h"
 #include "common/printing.h"
 #include "detection/os/os.h"
 #include "detection/terminalshell/terminalshell.h"
@@ -9,13 +10,6 @@
 #include <ctype.h>
 #include <string.h>
 
-typedef enum FFLogoSize
-{
-    FF_LOGO_SIZE_UNKNOWN,
-    FF_LOGO_SIZE_NORMAL,
-    FF_LOGO_SIZE_SMALL,
-} FFLogoSize;
-
 static void ffLogoPrintCharsRaw(const char* data, size_t length)
 {
     FFLogoOptions* options = &instance.config.logo;
@@ -176,80 +170,68 @@ void ffLogoPrintChars(const char* data, bool doColorReplacement)
         printf("\033[%uA", instance.state.logoHeight);
 }
 
-static void logoApplyColors(const FFlogo* logo)
+// Same output as ffLogoPrintChars, written as one slice per line (or at once without left and right padding)
+static void logoPrintRendered(const FFlogoRendered* rendered)
 {
-    if(instance.config.colorKeys.length == 0)
-        ffStrbufAppendS(&instance.config.colorKeys, logo->colorKeys);
+    FFLogoOptions* options = &instance.config.logo;
 
-    if(instance.config.colorTitle.length == 0)
-        ffStrbufAppendS(&instance.config.colorTitle, logo->colorTitle);
-}
+    fputs(FASTFETCH_TEXT_MODIFIER_BOLT, stdout);
+    ffPrintCharTimes('\n', options->paddingTop);
 
-static bool logoHasName(const FFlogo* logo, const FFstrbuf* name, bool small)
-{
-    for(const char** logoName = logo->names; *logoName != NULL; ++logoName)
+    if(options->paddingLeft == 0 && options->paddingRight == 0)
+        fwrite(rendered->data, rendered->lineStarts[rendered->lines] - 1, 1, stdout);
+    else
     {
-        if(small)
+        for(uint32_t i = 0; i < rendered->lines; ++i)
         {
-            uint32_t logoNameLength = (uint32_t) (strlen(*logoName) - strlen("_small"));
-            if(name->length == logoNameLength && strncasecmp(*logoName, name->chars, logoNameLength) == 0) return true;
+            if(i > 0)
+                putchar('\n');
+            ffPrintCharTimes(' ', options->paddingLeft);
+            fwrite(rendered->data + rendered->lineStarts[i], rendered->lineStarts[i + 1] - rendered->lineStarts[i] - 1, 1, stdout);
+            ffPrintCharTimes(' ', options->paddingRight);
         }
-        if(ffStrbufIgnCaseEqualS(name, *logoName))
-            return true;
     }
 
-    return false;
-}
-
-static const FFlogo* logoGetBuiltin(const FFstrbuf* name, FFLogoSize size)
-{
-    if (name->length == 0)
-        return NULL;
+    fputs(FASTFETCH_TEXT_MODIFIER_RESET, stdout);
 
-    for(GetLogoMethod* methods = ffLogoBuiltinGetAll(); *methods; ++methods)
-    {
-        const FFlogo* logo = (*methods)();
+    instance.state.logoHeight = options->paddingTop + rendered->lines - 1;
+    instance.state.logoWidth = options->paddingLeft + rendered->width + options->paddingRight;
 
-        switch (size)
-        {
-            case FF_LOGO_SIZE_NORMAL:
-                if(logo->small) continue;
-                break;
-            case FF_LOGO_SIZE_SMALL:
-                if(!logo->small) continue;
-                break;
-            default:
-                break;
-        }
+    fputs("\033[9999999D", stdout);
+    if(instance.state.logoHeight > 0)
+        printf("\033[%uA", instance.state.logoHeight);
+}
 
-        if(logoHasName(logo, name, size == FF_LOGO_SIZE_SMALL))
-            return logo;
-    }
+static void logoApplyColors(const FFlogo* logo)
+{
+    if(instance.config.colorKeys.length == 0)
+        ffStrbufAppendS(&instance.config.colorKeys, logo->colorKeys);
 
-    return NULL;
+    if(instance.config.colorTitle.length == 0)
+        ffStrbufAppendS(&instance.config.colorTitle, logo->colorTitle);
 }
 
 static const FFlogo* logoGetBuiltinDetected(FFLogoSize size)
 {
     const FFOSResult* os = ffDetectOS();
 
-    const FFlogo* logo = logoGetBuiltin(&os->id, size);
+    const FFlogo* logo = ffLogoBuiltinFind(&os->id, size);
     if(logo != NULL)
         return logo;
 
-    logo = logoGetBuiltin(&os->name, size);
+    logo = ffLogoBuiltinFind(&os->name, size);
     if(logo != NULL)
         return logo;
 
-    logo = logoGetBuiltin(&os->prettyName, size);
+    logo = ffLogoBuiltinFind(&os->prettyName, size);
     if(logo != NULL)
         return logo;
 
-    logo = logoGetBuiltin(&os->idLike, size);
+    logo = ffLogoBuiltinFind(&os->idLike, size);
     if(logo != NULL)
         return logo;
 
-    logo = logoGetBuiltin(&instance.state.platform.systemName, size);
+    logo = ffLogoBuiltinFind(&instance.state.platform.systemName, size);
     if(logo != NULL)
         return logo;
 
@@ -274,7 +256,20 @@ static void logoPrintStruct(const FFlogo* logo)
             ffStrbufAppendS(&options->colors[i], *colors);
     }
 
-    ffLogoPrintChars(logo->data, true);
+    //The rendered logo can only be used if no color was changed (--logo-color-*)
+    bool builtinColors = logo->rendered != NULL;
+    colors = logo->builtinColors;
+    for(int i = 0; builtinColors && i < FASTFETCH_LOGO_MAX_COLORS; i++)
+    {
+        builtinColors = ffStrbufEqualS(&options->colors[i], *colors ? *colors : "");
+        if(*colors)
+            colors++;
+    }
+
+    if(builtinColors)
+        logoPrintRendered(logo->rendered);
+    else
+        ffLogoPrintChars(logo->data, true);
 }
 
 static void logoPrintNone(void)
@@ -292,7 +287,7 @@ static bool logoPrintBuiltinIfExists(const FFstrbuf* name, FFLogoSize size)
         return true;
     }
 
-    const FFlogo* logo = logoGetBuiltin(name, size);
+    const FFlogo* logo = ffLogoBuiltinFind(name, size);
     if(logo == NULL)
         return false;
 
@@ -484,6 +479,8 @@ void ffLogoPrint(void)
 
 void ffLogoPrintLine(void)
 {
+    ffSchedulerWaitForOutput();
+
     if(instance.state.logoWidth > 0)
         printf("\033[%uC", instance.state.logoWidth);
 
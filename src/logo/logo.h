@@ -5,9 +5,19 @@
 
 #include "fastfetch.h"
 
+// A builtin logo with its builtin colors expanded at build time by builtin_codegen.c
+typedef struct FFlogoRendered
+{
+    const char* data; // Lines without paddings, separated by '\n'; starts with the color 1 escape sequence
+    const uint32_t* lineStarts; // `lines` + 1 offsets into `data`; line i ends at lineStarts[i + 1] - 1
+    uint32_t width; // In characters, of the longest line
+    uint32_t lines;
+} FFlogoRendered;
+
 typedef struct FFlogo
 {
     const char* data;
+    const FFlogoRendered* rendered; // NULL if not generated (e.g. cross compiling)
     const char** names; //Null terminated
     const char** builtinColors; //Null terminated
     const char* colorKeys;
@@ -17,12 +27,21 @@ typedef struct FFlogo
 
 typedef const FFlogo*(*GetLogoMethod)();
 
+typedef enum FFLogoSize
+{
+    FF_LOGO_SIZE_UNKNOWN,
+    FF_LOGO_SIZE_NORMAL,
+    FF_LOGO_SIZE_SMALL,
+} FFLogoSize;
+
 //logo.c
 void ffLogoPrintChars(const char* data, bool doColorReplacement);
 
 //builtin.c
 const FFlogo* ffLogoBuiltinGetUnknown();
 GetLogoMethod* ffLogoBuiltinGetAll();
+// Case insensitive. With FF_LOGO_SIZE_SMALL, small logos match their names without `_small` too. NULL if there is no such logo
+const FFlogo* ffLogoBuiltinFind(const FFstrbuf* name, FFLogoSize size);
 
 //image/image.c
 bool ffLogoPrintImageIfExists(FFLogoType type, bool printError);
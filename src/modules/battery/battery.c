@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "common/bar.h"
 #include "detection/battery/battery.h"
 #include "modules/battery/battery.h"
@@ -9,7 +10,7 @@
 
 static void printBattery(FFBatteryOptions* options, BatteryResult* result, uint8_t index)
 {
-    if(instance.config.battery.moduleArgs.outputFormat.length == 0)
+    if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_BATTERY_MODULE_NAME, index, &options->moduleArgs.key, &options->moduleArgs.keyColor);
 
@@ -72,34 +73,64 @@ static void printBattery(FFBatteryOptions* options, BatteryResult* result, uint8
     }
 }
 
-void ffPrintBattery(FFBatteryOptions* options)
+const char* ffDetectBatteryModule(FFBatteryOptions* options, FFlist* results)
 {
-    FFlist results;
-    ffListInitA(&results, sizeof(BatteryResult), 0);
+    ffListInitA(results, sizeof(BatteryResult), 0);
+
+    const char* error = ffDetectBattery(options, results);
+    if(error)
+        return error;
+
+    if(results->length == 0)
+        return "No batteries found";
 
-    const char* error = ffDetectBattery(options, &results);
+    return NULL;
+}
+
+void ffRenderBatteryModule(FFBatteryOptions* options, FFlist* results)
+{
+    for(uint8_t i = 0; i < (uint8_t) results->length; i++)
+        printBattery(options, ffListGet(results, i), i);
+}
 
-    if (error)
+void ffGenerateBatteryJsonResult(FF_MAYBE_UNUSED FFBatteryOptions* options, FFlist* results, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(BatteryResult, battery, *results)
     {
-        ffPrintError(FF_BATTERY_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+        ffJsonResultAddStrbuf(doc, obj, "manufacturer", &battery->manufacturer);
+        ffJsonResultAddStrbuf(doc, obj, "modelName", &battery->modelName);
+        ffJsonResultAddStrbuf(doc, obj, "technology", &battery->technology);
+        ffJsonResultAddDouble(doc, obj, "capacity", battery->capacity);
+        ffJsonResultAddStrbuf(doc, obj, "status", &battery->status);
+        ffJsonResultAddDouble(doc, obj, "temperature", battery->temperature);
     }
-    else
-    {
-        for(uint8_t i = 0; i < (uint8_t) results.length; i++)
-        {
-            BatteryResult* result = ffListGet(&results, i);
-            printBattery(options, result, i);
+}
 
-            ffStrbufDestroy(&result->manufacturer);
-            ffStrbufDestroy(&result->modelName);
-            ffStrbufDestroy(&result->technology);
-            ffStrbufDestroy(&result->status);
-        }
-        if(results.length == 0)
-            ffPrintError(FF_BATTERY_MODULE_NAME, 0, &options->moduleArgs, "No batteries found");
+void ffDestroyBatteryModuleResult(FFlist* results)
+{
+    FF_LIST_FOR_EACH(BatteryResult, result, *results)
+    {
+        ffStrbufDestroy(&result->manufacturer);
+        ffStrbufDestroy(&result->modelName);
+        ffStrbufDestroy(&result->technology);
+        ffStrbufDestroy(&result->status);
     }
+    ffListDestroy(results);
+}
 
-    ffListDestroy(&results);
+void ffPrintBattery(FFBatteryOptions* options)
+{
+    FFlist results;
+    const char* error = ffDetectBatteryModule(options, &results);
+
+    if(error)
+        ffPrintError(FF_BATTERY_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderBatteryModule(options, &results);
+
+    ffDestroyBatteryModuleResult(&results);
 }
 
 void ffInitBatteryOptions(FFBatteryOptions* options)
@@ -146,11 +177,8 @@ void ffDestroyBatteryOptions(FFBatteryOptions* options)
     #endif
 }
 
-void ffParseBatteryJsonObject(yyjson_val* module)
+void ffParseBatteryJsonObject(FFBatteryOptions* options, yyjson_val* module)
 {
-    FFBatteryOptions __attribute__((__cleanup__(ffDestroyBatteryOptions))) options;
-    ffInitBatteryOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -161,26 +189,24 @@ void ffParseBatteryJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             #ifdef __linux__
             if (ffStrEqualsIgnCase(key, "dir"))
             {
-                ffStrbufSetS(&options.dir, yyjson_get_str(val));
+                ffStrbufSetS(&options->dir, yyjson_get_str(val));
                 continue;
             }
             #endif
 
             if (ffStrEqualsIgnCase(key, "temp"))
             {
-                options.temp = yyjson_get_bool(val);
+                options->temp = yyjson_get_bool(val);
                 continue;
             }
 
-            ffPrintError(FF_BATTERY_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_BATTERY_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintBattery(&options);
 }
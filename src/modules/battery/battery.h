@@ -5,8 +5,12 @@
 #define FF_BATTERY_MODULE_NAME "Battery"
 
 void ffPrintBattery(FFBatteryOptions* options);
+const char* ffDetectBatteryModule(FFBatteryOptions* options, FFlist* results /* BatteryResult */);
+void ffRenderBatteryModule(FFBatteryOptions* options, FFlist* results);
+void ffGenerateBatteryJsonResult(FFBatteryOptions* options, FFlist* results, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyBatteryModuleResult(FFlist* results);
 
 void ffInitBatteryOptions(FFBatteryOptions* options);
 bool ffParseBatteryCommandOptions(FFBatteryOptions* options, const char* key, const char* value);
 void ffDestroyBatteryOptions(FFBatteryOptions* options);
-void ffParseBatteryJsonObject(yyjson_val* module);
+void ffParseBatteryJsonObject(FFBatteryOptions* options, yyjson_val* module);
@@ -1,56 +1,94 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "common/cache.h"
 #include "detection/bios/bios.h"
 #include "modules/bios/bios.h"
 #include "util/stringUtils.h"
 
 #define FF_BIOS_NUM_FORMAT_ARGS 4
 
-void ffPrintBios(FFBiosOptions* options)
+static const FFCacheSchema biosCacheSchema = FF_CACHE_SCHEMA(FFBiosResult,
+    offsetof(FFBiosResult, date),
+    offsetof(FFBiosResult, release),
+    offsetof(FFBiosResult, vendor),
+    offsetof(FFBiosResult, version),
+);
+
+const char* ffDetectBiosModule(FFBiosOptions* options, FFBiosResult* bios)
 {
-    FFBiosResult bios;
-    ffStrbufInit(&bios.date);
-    ffStrbufInit(&bios.release);
-    ffStrbufInit(&bios.vendor);
-    ffStrbufInit(&bios.version);
+    FF_STRBUF_AUTO_DESTROY cacheKey = ffStrbufCreate();
+    bool cache = ffCacheKeyInit(&cacheKey, &options->moduleArgs);
+    if(cache && ffCacheLoad(FF_BIOS_MODULE_NAME, &cacheKey, &biosCacheSchema, bios))
+        return NULL;
 
-    const char* error = ffDetectBios(&bios);
+    ffStrbufInit(&bios->date);
+    ffStrbufInit(&bios->release);
+    ffStrbufInit(&bios->vendor);
+    ffStrbufInit(&bios->version);
 
+    const char* error = ffDetectBios(bios);
     if(error)
-    {
-        ffPrintError(FF_BIOS_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        goto exit;
-    }
+        return error;
 
-    if(bios.version.length == 0)
-    {
-        ffPrintError(FF_BIOS_MODULE_NAME, 0, &options->moduleArgs, "bios_version is not set.");
-        goto exit;
-    }
+    if(bios->version.length == 0)
+        return "bios_version is not set.";
 
+    if(cache)
+        ffCacheStore(FF_BIOS_MODULE_NAME, &cacheKey, &biosCacheSchema, bios);
+
+    return NULL;
+}
+
+void ffRenderBiosModule(FFBiosOptions* options, FFBiosResult* bios)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_BIOS_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        ffStrbufWriteTo(&bios.version, stdout);
-        if (bios.release.length)
-            printf(" (%s)", bios.release.chars);
+        ffStrbufWriteTo(&bios->version, stdout);
+        if (bios->release.length)
+            printf(" (%s)", bios->release.chars);
         putchar('\n');
     }
     else
     {
         ffPrintFormat(FF_BIOS_MODULE_NAME, 0, &options->moduleArgs, FF_BIOS_NUM_FORMAT_ARGS, (FFformatarg[]) {
-            {FF_FORMAT_ARG_TYPE_STRBUF, &bios.date},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &bios.release},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &bios.vendor},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &bios.version},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &bios->date},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &bios->release},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &bios->vendor},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &bios->version},
         });
     }
+}
 
-exit:
-    ffStrbufDestroy(&bios.date);
-    ffStrbufDestroy(&bios.release);
-    ffStrbufDestroy(&bios.vendor);
-    ffStrbufDestroy(&bios.version);
+void ffGenerateBiosJsonResult(FF_MAYBE_UNUSED FFBiosOptions* options, FFBiosResult* bios, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "date", &bios->date);
+    ffJsonResultAddStrbuf(doc, obj, "release", &bios->release);
+    ffJsonResultAddStrbuf(doc, obj, "vendor", &bios->vendor);
+    ffJsonResultAddStrbuf(doc, obj, "version", &bios->version);
+}
+
+void ffDestroyBiosModuleResult(FFBiosResult* bios)
+{
+    ffStrbufDestroy(&bios->date);
+    ffStrbufDestroy(&bios->release);
+    ffStrbufDestroy(&bios->vendor);
+    ffStrbufDestroy(&bios->version);
+}
+
+void ffPrintBios(FFBiosOptions* options)
+{
+    FFBiosResult bios;
+    const char* error = ffDetectBiosModule(options, &bios);
+
+    if(error)
+        ffPrintError(FF_BIOS_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderBiosModule(options, &bios);
+
+    ffDestroyBiosModuleResult(&bios);
 }
 
 void ffInitBiosOptions(FFBiosOptions* options)
@@ -74,11 +112,8 @@ void ffDestroyBiosOptions(FFBiosOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseBiosJsonObject(yyjson_val* module)
+void ffParseBiosJsonObject(FFBiosOptions* options, yyjson_val* module)
 {
-    FFBiosOptions __attribute__((__cleanup__(ffDestroyBiosOptions))) options;
-    ffInitBiosOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -89,12 +124,10 @@ void ffParseBiosJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_BIOS_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_BIOS_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintBios(&options);
 }
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/bios/bios.h"
 
 #define FF_BIOS_MODULE_NAME "Bios"
 
 void ffPrintBios(FFBiosOptions* options);
+const char* ffDetectBiosModule(FFBiosOptions* options, FFBiosResult* bios);
+void ffRenderBiosModule(FFBiosOptions* options, FFBiosResult* bios);
+void ffGenerateBiosJsonResult(FFBiosOptions* options, FFBiosResult* bios, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyBiosModuleResult(FFBiosResult* bios);
 void ffInitBiosOptions(FFBiosOptions* options);
 bool ffParseBiosCommandOptions(FFBiosOptions* options, const char* key, const char* value);
 void ffDestroyBiosOptions(FFBiosOptions* options);
-void ffParseBiosJsonObject(yyjson_val* module);
+void ffParseBiosJsonObject(FFBiosOptions* options, yyjson_val* module);
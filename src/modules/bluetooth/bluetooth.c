@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/bluetooth/bluetooth.h"
 #include "modules/bluetooth/bluetooth.h"
 #include "util/stringUtils.h"
@@ -32,47 +33,83 @@ static void printDevice(FFBluetoothOptions* options, const FFBluetoothDevice* de
     }
 }
 
-void ffPrintBluetooth(FFBluetoothOptions* options)
+static void destroyDevice(FFBluetoothDevice* device)
 {
-    FF_LIST_AUTO_DESTROY devices = ffListCreate(sizeof (FFBluetoothDevice));
-    const char* error = ffDetectBluetooth(&devices);
+    ffStrbufDestroy(&device->name);
+    ffStrbufDestroy(&device->type);
+    ffStrbufDestroy(&device->address);
+}
 
+const char* ffDetectBluetoothModule(FFBluetoothOptions* options, FFlist* devices)
+{
+    ffListInit(devices, sizeof(FFBluetoothDevice));
+
+    const char* error = ffDetectBluetooth(devices);
     if(error)
-    {
-        ffPrintError(FF_BLUETOOTH_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-    }
-    else
-    {
-        FF_LIST_AUTO_DESTROY filtered = ffListCreate(sizeof(FFBluetoothDevice*));
+        return error;
 
-        FF_LIST_FOR_EACH(FFBluetoothDevice, device, devices)
+    if(!options->showDisconnected)
+    {
+        uint32_t count = 0;
+        FF_LIST_FOR_EACH(FFBluetoothDevice, device, *devices)
         {
-            if(!device->connected && !options->showDisconnected)
-                continue;
-
-            *(FFBluetoothDevice**)ffListAdd(&filtered) = device;
+            if(device->connected)
+                *(FFBluetoothDevice*) ffListGet(devices, count++) = *device;
+            else
+                destroyDevice(device);
         }
+        devices->length = count;
+    }
 
-        if(filtered.length == 0)
-        {
-            ffPrintError(FF_BLUETOOTH_MODULE_NAME, 0, &options->moduleArgs, "No bluetooth devices found");
-        }
+    if(devices->length == 0)
+        return "No bluetooth devices found";
 
-        for(uint32_t i = 0; i < filtered.length; i++)
-        {
-            uint8_t index = (uint8_t) (filtered.length == 1 ? 0 : i + 1);
-            printDevice(options, *(FFBluetoothDevice**)ffListGet(&filtered, i), index);
-        }
+    return NULL;
+}
+
+void ffRenderBluetoothModule(FFBluetoothOptions* options, FFlist* devices)
+{
+    for(uint32_t i = 0; i < devices->length; i++)
+    {
+        uint8_t index = (uint8_t) (devices->length == 1 ? 0 : i + 1);
+        printDevice(options, ffListGet(devices, i), index);
     }
+}
 
-    FF_LIST_FOR_EACH(FFBluetoothDevice, device, devices)
+void ffGenerateBluetoothJsonResult(FF_MAYBE_UNUSED FFBluetoothOptions* options, FFlist* devices, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(FFBluetoothDevice, device, *devices)
     {
-        ffStrbufDestroy(&device->name);
-        ffStrbufDestroy(&device->type);
-        ffStrbufDestroy(&device->address);
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+        ffJsonResultAddStrbuf(doc, obj, "name", &device->name);
+        ffJsonResultAddStrbuf(doc, obj, "address", &device->address);
+        ffJsonResultAddStrbuf(doc, obj, "type", &device->type);
+        yyjson_mut_obj_add_uint(doc, obj, "battery", device->battery);
+        yyjson_mut_obj_add_bool(doc, obj, "connected", device->connected);
     }
 }
 
+void ffDestroyBluetoothModuleResult(FFlist* devices)
+{
+    FF_LIST_FOR_EACH(FFBluetoothDevice, device, *devices)
+        destroyDevice(device);
+    ffListDestroy(devices);
+}
+
+void ffPrintBluetooth(FFBluetoothOptions* options)
+{
+    FFlist devices;
+    const char* error = ffDetectBluetoothModule(options, &devices);
+
+    if(error)
+        ffPrintError(FF_BLUETOOTH_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderBluetoothModule(options, &devices);
+
+    ffDestroyBluetoothModuleResult(&devices);
+}
+
 void ffInitBluetoothOptions(FFBluetoothOptions* options)
 {
     options->moduleName = FF_BLUETOOTH_MODULE_NAME;
@@ -101,11 +138,8 @@ void ffDestroyBluetoothOptions(FFBluetoothOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseBluetoothJsonObject(yyjson_val* module)
+void ffParseBluetoothJsonObject(FFBluetoothOptions* options, yyjson_val* module)
 {
-    FFBluetoothOptions __attribute__((__cleanup__(ffDestroyBluetoothOptions))) options;
-    ffInitBluetoothOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -116,18 +150,16 @@ void ffParseBluetoothJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             if (ffStrEqualsIgnCase(key, "showDisconnected"))
             {
-                options.showDisconnected = yyjson_get_bool(val);
+                options->showDisconnected = yyjson_get_bool(val);
                 continue;
             }
 
-            ffPrintError(FF_BLUETOOTH_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_BLUETOOTH_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintBluetooth(&options);
 }
@@ -5,7 +5,11 @@
 #define FF_BLUETOOTH_MODULE_NAME "Bluetooth"
 
 void ffPrintBluetooth(FFBluetoothOptions* options);
+const char* ffDetectBluetoothModule(FFBluetoothOptions* options, FFlist* devices /* FFBluetoothDevice */);
+void ffRenderBluetoothModule(FFBluetoothOptions* options, FFlist* devices);
+void ffGenerateBluetoothJsonResult(FFBluetoothOptions* options, FFlist* devices, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyBluetoothModuleResult(FFlist* devices);
 void ffInitBluetoothOptions(FFBluetoothOptions* options);
 bool ffParseBluetoothCommandOptions(FFBluetoothOptions* options, const char* key, const char* value);
 void ffDestroyBluetoothOptions(FFBluetoothOptions* options);
-void ffParseBluetoothJsonObject(yyjson_val* module);
+void ffParseBluetoothJsonObject(FFBluetoothOptions* options, yyjson_val* module);
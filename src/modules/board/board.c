@@ -1,52 +1,89 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "common/cache.h"
 #include "detection/board/board.h"
 #include "modules/board/board.h"
 #include "util/stringUtils.h"
 
 #define FF_BOARD_NUM_FORMAT_ARGS 3
 
-void ffPrintBoard(FFBoardOptions* options)
+static const FFCacheSchema boardCacheSchema = FF_CACHE_SCHEMA(FFBoardResult,
+    offsetof(FFBoardResult, name),
+    offsetof(FFBoardResult, vendor),
+    offsetof(FFBoardResult, version),
+);
+
+const char* ffDetectBoardModule(FFBoardOptions* options, FFBoardResult* result)
 {
-    FFBoardResult result;
-    ffStrbufInit(&result.name);
-    ffStrbufInit(&result.vendor);
-    ffStrbufInit(&result.version);
-    const char* error = ffDetectBoard(&result);
+    FF_STRBUF_AUTO_DESTROY cacheKey = ffStrbufCreate();
+    bool cache = ffCacheKeyInit(&cacheKey, &options->moduleArgs);
+    if(cache && ffCacheLoad(FF_BOARD_MODULE_NAME, &cacheKey, &boardCacheSchema, result))
+        return NULL;
+
+    ffStrbufInit(&result->name);
+    ffStrbufInit(&result->vendor);
+    ffStrbufInit(&result->version);
 
+    const char* error = ffDetectBoard(result);
     if(error)
-    {
-        ffPrintError(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        goto exit;
-    }
+        return error;
 
-    if(result.name.length == 0)
-    {
-        ffPrintError(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs, "board_name is not set.");
-        goto exit;
-    }
+    if(result->name.length == 0)
+        return "board_name is not set.";
+
+    if(cache)
+        ffCacheStore(FF_BOARD_MODULE_NAME, &cacheKey, &boardCacheSchema, result);
+
+    return NULL;
+}
 
+void ffRenderBoardModule(FFBoardOptions* options, FFBoardResult* result)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        ffStrbufWriteTo(&result.name, stdout);
-        if (result.version.length)
-            printf(" (%s)", result.version.chars);
+        ffStrbufWriteTo(&result->name, stdout);
+        if (result->version.length)
+            printf(" (%s)", result->version.chars);
         putchar('\n');
     }
     else
     {
         ffPrintFormat(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs, FF_BOARD_NUM_FORMAT_ARGS, (FFformatarg[]) {
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.name},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.vendor},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.version},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->name},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->vendor},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->version},
         });
     }
+}
+
+void ffGenerateBoardJsonResult(FF_MAYBE_UNUSED FFBoardOptions* options, FFBoardResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "name", &result->name);
+    ffJsonResultAddStrbuf(doc, obj, "vendor", &result->vendor);
+    ffJsonResultAddStrbuf(doc, obj, "version", &result->version);
+}
 
-exit:
-    ffStrbufDestroy(&result.name);
-    ffStrbufDestroy(&result.vendor);
-    ffStrbufDestroy(&result.version);
+void ffDestroyBoardModuleResult(FFBoardResult* result)
+{
+    ffStrbufDestroy(&result->name);
+    ffStrbufDestroy(&result->vendor);
+    ffStrbufDestroy(&result->version);
+}
+
+void ffPrintBoard(FFBoardOptions* options)
+{
+    FFBoardResult result;
+    const char* error = ffDetectBoardModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderBoardModule(options, &result);
+
+    ffDestroyBoardModuleResult(&result);
 }
 
 void ffInitBoardOptions(FFBoardOptions* options)
@@ -70,11 +107,8 @@ void ffDestroyBoardOptions(FFBoardOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseBoardJsonObject(yyjson_val* module)
+void ffParseBoardJsonObject(FFBoardOptions* options, yyjson_val* module)
 {
-    FFBoardOptions __attribute__((__cleanup__(ffDestroyBoardOptions))) options;
-    ffInitBoardOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -85,12 +119,10 @@ void ffParseBoardJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_BOARD_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_BOARD_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintBoard(&options);
 }
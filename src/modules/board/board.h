@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/board/board.h"
 
 #define FF_BOARD_MODULE_NAME "Board"
 
 void ffPrintBoard(FFBoardOptions* options);
+const char* ffDetectBoardModule(FFBoardOptions* options, FFBoardResult* result);
+void ffRenderBoardModule(FFBoardOptions* options, FFBoardResult* result);
+void ffGenerateBoardJsonResult(FFBoardOptions* options, FFBoardResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyBoardModuleResult(FFBoardResult* result);
 void ffInitBoardOptions(FFBoardOptions* options);
 bool ffParseBoardCommandOptions(FFBoardOptions* options, const char* key, const char* value);
 void ffDestroyBoardOptions(FFBoardOptions* options);
-void ffParseBoardJsonObject(yyjson_val* module);
+void ffParseBoardJsonObject(FFBoardOptions* options, yyjson_val* module);
@@ -6,8 +6,3 @@ void ffPrintBreak(void)
     ffLogoPrintLine();
     putchar('\n');
 }
-
-void ffParseBreakJsonObject(FF_MAYBE_UNUSED yyjson_val* module)
-{
-    return ffPrintBreak();
-}
@@ -5,4 +5,3 @@
 #define FF_BREAK_MODULE_NAME "Break"
 
 void ffPrintBreak();
-void ffParseBreakJsonObject(yyjson_val* module);
@@ -1,33 +1,32 @@
 #include "common/bar.h"
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/brightness/brightness.h"
 #include "modules/brightness/brightness.h"
 #include "util/stringUtils.h"
 
 #define FF_BRIGHTNESS_NUM_FORMAT_ARGS 2
 
-void ffPrintBrightness(FFBrightnessOptions* options)
+const char* ffDetectBrightnessModule(FF_MAYBE_UNUSED FFBrightnessOptions* options, FFlist* result)
 {
-    FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFBrightnessResult));
-
-    const char* error = ffDetectBrightness(&result);
+    ffListInit(result, sizeof(FFBrightnessResult));
 
+    const char* error = ffDetectBrightness(result);
     if(error)
-    {
-        ffPrintError(FF_BRIGHTNESS_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+        return error;
 
-    if(result.length == 0)
-    {
-        ffPrintError(FF_BRIGHTNESS_MODULE_NAME, 0, &options->moduleArgs, "No result is detected.");
-        return;
-    }
+    if(result->length == 0)
+        return "No result is detected.";
+
+    return NULL;
+}
 
+void ffRenderBrightnessModule(FFBrightnessOptions* options, FFlist* result)
+{
     FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
 
-    FF_LIST_FOR_EACH(FFBrightnessResult, item, result)
+    FF_LIST_FOR_EACH(FFBrightnessResult, item, *result)
     {
         if(options->moduleArgs.key.length == 0)
         {
@@ -35,7 +34,7 @@ void ffPrintBrightness(FFBrightnessOptions* options)
         }
         else
         {
-            ffParseFormatString(&key, &options->moduleArgs.key, 1, (FFformatarg[]){
+            ffFormatProgramRun(&key, &options->moduleArgs.keyProgram, 1, (FFformatarg[]){
                 {FF_FORMAT_ARG_TYPE_STRBUF, &item->name}
             });
         }
@@ -63,17 +62,47 @@ void ffPrintBrightness(FFBrightnessOptions* options)
         }
         else
         {
-            ffPrintFormatString(key.chars, 0, NULL, &options->moduleArgs.keyColor, &options->moduleArgs.outputFormat, FF_BRIGHTNESS_NUM_FORMAT_ARGS, (FFformatarg[]) {
-                {FF_FORMAT_ARG_TYPE_STRBUF, &item->value},
-                {FF_FORMAT_ARG_TYPE_FLOAT, &item->name}
+            ffPrintFormatString(key.chars, 0, NULL, &options->moduleArgs.keyColor, &options->moduleArgs.outputFormatProgram, FF_BRIGHTNESS_NUM_FORMAT_ARGS, (FFformatarg[]) {
+                {FF_FORMAT_ARG_TYPE_FLOAT, &item->value},
+                {FF_FORMAT_ARG_TYPE_STRBUF, &item->name}
             });
         }
 
         ffStrbufClear(&key);
-        ffStrbufDestroy(&item->name);
     }
 }
 
+void ffGenerateBrightnessJsonResult(FF_MAYBE_UNUSED FFBrightnessOptions* options, FFlist* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(FFBrightnessResult, item, *result)
+    {
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+        ffJsonResultAddStrbuf(doc, obj, "name", &item->name);
+        ffJsonResultAddDouble(doc, obj, "value", item->value);
+    }
+}
+
+void ffDestroyBrightnessModuleResult(FFlist* result)
+{
+    FF_LIST_FOR_EACH(FFBrightnessResult, item, *result)
+        ffStrbufDestroy(&item->name);
+    ffListDestroy(result);
+}
+
+void ffPrintBrightness(FFBrightnessOptions* options)
+{
+    FFlist result;
+    const char* error = ffDetectBrightnessModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_BRIGHTNESS_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderBrightnessModule(options, &result);
+
+    ffDestroyBrightnessModuleResult(&result);
+}
+
 void ffInitBrightnessOptions(FFBrightnessOptions* options)
 {
     options->moduleName = FF_BRIGHTNESS_MODULE_NAME;
@@ -95,11 +124,8 @@ void ffDestroyBrightnessOptions(FFBrightnessOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseBrightnessJsonObject(yyjson_val* module)
+void ffParseBrightnessJsonObject(FFBrightnessOptions* options, yyjson_val* module)
 {
-    FFBrightnessOptions __attribute__((__cleanup__(ffDestroyBrightnessOptions))) options;
-    ffInitBrightnessOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -110,12 +136,10 @@ void ffParseBrightnessJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_BRIGHTNESS_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_BRIGHTNESS_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintBrightness(&options);
 }
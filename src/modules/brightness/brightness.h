@@ -5,7 +5,11 @@
 #define FF_BRIGHTNESS_MODULE_NAME "Brightness"
 
 void ffPrintBrightness(FFBrightnessOptions* options);
+const char* ffDetectBrightnessModule(FFBrightnessOptions* options, FFlist* result /* FFBrightnessResult */);
+void ffRenderBrightnessModule(FFBrightnessOptions* options, FFlist* result);
+void ffGenerateBrightnessJsonResult(FFBrightnessOptions* options, FFlist* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyBrightnessModuleResult(FFlist* result);
 void ffInitBrightnessOptions(FFBrightnessOptions* options);
 bool ffParseBrightnessCommandOptions(FFBrightnessOptions* options, const char* key, const char* value);
 void ffDestroyBrightnessOptions(FFBrightnessOptions* options);
-void ffParseBrightnessJsonObject(yyjson_val* module);
+void ffParseBrightnessJsonObject(FFBrightnessOptions* options, yyjson_val* module);
@@ -1,53 +1,89 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "common/cache.h"
 #include "detection/chassis/chassis.h"
 #include "modules/chassis/chassis.h"
 #include "util/stringUtils.h"
 
 #define FF_CHASSIS_NUM_FORMAT_ARGS 3
 
-void ffPrintChassis(FFChassisOptions* options)
+static const FFCacheSchema chassisCacheSchema = FF_CACHE_SCHEMA(FFChassisResult,
+    offsetof(FFChassisResult, type),
+    offsetof(FFChassisResult, vendor),
+    offsetof(FFChassisResult, version),
+);
+
+const char* ffDetectChassisModule(FFChassisOptions* options, FFChassisResult* result)
 {
-    FFChassisResult result;
-    ffStrbufInit(&result.type);
-    ffStrbufInit(&result.vendor);
-    ffStrbufInit(&result.version);
+    FF_STRBUF_AUTO_DESTROY cacheKey = ffStrbufCreate();
+    bool cache = ffCacheKeyInit(&cacheKey, &options->moduleArgs);
+    if(cache && ffCacheLoad(FF_CHASSIS_MODULE_NAME, &cacheKey, &chassisCacheSchema, result))
+        return NULL;
 
-    const char* error = ffDetectChassis(&result);
+    ffStrbufInit(&result->type);
+    ffStrbufInit(&result->vendor);
+    ffStrbufInit(&result->version);
 
+    const char* error = ffDetectChassis(result);
     if(error)
-    {
-        ffPrintError(FF_CHASSIS_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        goto exit;
-    }
+        return error;
 
-    if(result.type.length == 0)
-    {
-        ffPrintError(FF_CHASSIS_MODULE_NAME, 0, &options->moduleArgs, "chassis_type is not set by O.E.M.");
-        goto exit;
-    }
+    if(result->type.length == 0)
+        return "chassis_type is not set by O.E.M.";
 
+    if(cache)
+        ffCacheStore(FF_CHASSIS_MODULE_NAME, &cacheKey, &chassisCacheSchema, result);
+
+    return NULL;
+}
+
+void ffRenderChassisModule(FFChassisOptions* options, FFChassisResult* result)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_CHASSIS_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        ffStrbufWriteTo(&result.type, stdout);
-        if (result.version.length)
-            printf(" (%s)", result.version.chars);
+        ffStrbufWriteTo(&result->type, stdout);
+        if (result->version.length)
+            printf(" (%s)", result->version.chars);
         putchar('\n');
     }
     else
     {
         ffPrintFormat(FF_CHASSIS_MODULE_NAME, 0, &options->moduleArgs, FF_CHASSIS_NUM_FORMAT_ARGS, (FFformatarg[]) {
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.type},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.vendor},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.version},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->type},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->vendor},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->version},
         });
     }
+}
 
-exit:
-    ffStrbufDestroy(&result.type);
-    ffStrbufDestroy(&result.vendor);
-    ffStrbufDestroy(&result.version);
+void ffGenerateChassisJsonResult(FF_MAYBE_UNUSED FFChassisOptions* options, FFChassisResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "type", &result->type);
+    ffJsonResultAddStrbuf(doc, obj, "vendor", &result->vendor);
+    ffJsonResultAddStrbuf(doc, obj, "version", &result->version);
+}
+
+void ffDestroyChassisModuleResult(FFChassisResult* result)
+{
+    ffStrbufDestroy(&result->type);
+    ffStrbufDestroy(&result->vendor);
+    ffStrbufDestroy(&result->version);
+}
+
+void ffPrintChassis(FFChassisOptions* options)
+{
+    FFChassisResult result;
+    const char* error = ffDetectChassisModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_CHASSIS_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderChassisModule(options, &result);
+
+    ffDestroyChassisModuleResult(&result);
 }
 
 void ffInitChassisOptions(FFChassisOptions* options)
@@ -71,11 +107,8 @@ void ffDestroyChassisOptions(FFChassisOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseChassisJsonObject(yyjson_val* module)
+void ffParseChassisJsonObject(FFChassisOptions* options, yyjson_val* module)
 {
-    FFChassisOptions __attribute__((__cleanup__(ffDestroyChassisOptions))) options;
-    ffInitChassisOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -86,12 +119,10 @@ void ffParseChassisJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_CHASSIS_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_CHASSIS_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintChassis(&options);
 }
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/chassis/chassis.h"
 
 #define FF_CHASSIS_MODULE_NAME "Chassis"
 
 void ffPrintChassis(FFChassisOptions* options);
+const char* ffDetectChassisModule(FFChassisOptions* options, FFChassisResult* result);
+void ffRenderChassisModule(FFChassisOptions* options, FFChassisResult* result);
+void ffGenerateChassisJsonResult(FFChassisOptions* options, FFChassisResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyChassisModuleResult(FFChassisResult* result);
 void ffInitChassisOptions(FFChassisOptions* options);
 bool ffParseChassisCommandOptions(FFChassisOptions* options, const char* key, const char* value);
 void ffDestroyChassisOptions(FFChassisOptions* options);
-void ffParseChassisJsonObject(yyjson_val* module);
+void ffParseChassisJsonObject(FFChassisOptions* options, yyjson_val* module);
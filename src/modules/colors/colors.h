@@ -8,4 +8,4 @@ void ffPrintColors(FFColorsOptions* options);
 void ffInitColorsOptions(FFColorsOptions* options);
 void ffDestroyColorsOptions(FFColorsOptions* options);
 bool ffParseColorsCommandOptions(FFColorsOptions* options, const char* key, const char* value);
-void ffParseColorsJsonObject(yyjson_val* module);
+void ffParseColorsJsonObject(FFColorsOptions* options, yyjson_val* module);
@@ -1,13 +1,15 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "common/processing.h"
 #include "modules/command/command.h"
 #include "util/stringUtils.h"
 
-void ffPrintCommand(FFCommandOptions* options)
+const char* ffDetectCommandModule(FFCommandOptions* options, FFstrbuf* result)
 {
-    FF_STRBUF_AUTO_DESTROY result = ffStrbufCreate();
-    const char* error = ffProcessAppendStdOut(&result, (char* const[]){
+    ffStrbufInit(result);
+
+    const char* error = ffProcessAppendStdOut(result, (char* const[]){
         options->shell.chars,
         #ifdef _WIN32
         "/c",
@@ -17,21 +19,42 @@ void ffPrintCommand(FFCommandOptions* options)
         options->text.chars,
         NULL
     });
-
     if(error)
-    {
-        ffPrintError(FF_COMMAND_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+        return error;
 
-    if(!result.length)
-    {
-        ffPrintError(FF_COMMAND_MODULE_NAME, 0, &options->moduleArgs, "No result printed");
-        return;
-    }
+    if(!result->length)
+        return "No result printed";
+
+    return NULL;
+}
 
+void ffRenderCommandModule(FFCommandOptions* options, FFstrbuf* result)
+{
     ffPrintLogoAndKey(FF_COMMAND_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-    ffStrbufPutTo(&result, stdout);
+    ffStrbufPutTo(result, stdout);
+}
+
+void ffGenerateCommandJsonResult(FF_MAYBE_UNUSED FFCommandOptions* options, FFstrbuf* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    ffJsonResultAddStrbuf(doc, module, "result", result);
+}
+
+void ffDestroyCommandModuleResult(FFstrbuf* result)
+{
+    ffStrbufDestroy(result);
+}
+
+void ffPrintCommand(FFCommandOptions* options)
+{
+    FFstrbuf result;
+    const char* error = ffDetectCommandModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_COMMAND_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderCommandModule(options, &result);
+
+    ffDestroyCommandModuleResult(&result);
 }
 
 void ffInitCommandOptions(FFCommandOptions* options)
@@ -81,11 +104,8 @@ void ffDestroyCommandOptions(FFCommandOptions* options)
     ffStrbufDestroy(&options->text);
 }
 
-void ffParseCommandJsonObject(yyjson_val* module)
+void ffParseCommandJsonObject(FFCommandOptions* options, yyjson_val* module)
 {
-    FFCommandOptions __attribute__((__cleanup__(ffDestroyCommandOptions))) options;
-    ffInitCommandOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -96,24 +116,22 @@ void ffParseCommandJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             if (ffStrEqualsIgnCase(key, "shell"))
             {
-                ffStrbufSetS(&options.shell, yyjson_get_str(val));
+                ffStrbufSetS(&options->shell, yyjson_get_str(val));
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "text"))
             {
-                ffStrbufSetS(&options.text, yyjson_get_str(val));
+                ffStrbufSetS(&options->text, yyjson_get_str(val));
                 continue;
             }
 
-            ffPrintError(FF_COMMAND_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_COMMAND_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintCommand(&options);
 }
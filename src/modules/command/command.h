@@ -5,7 +5,11 @@
 #define FF_COMMAND_MODULE_NAME "Command"
 
 void ffPrintCommand(FFCommandOptions* options);
+const char* ffDetectCommandModule(FFCommandOptions* options, FFstrbuf* result);
+void ffRenderCommandModule(FFCommandOptions* options, FFstrbuf* result);
+void ffGenerateCommandJsonResult(FFCommandOptions* options, FFstrbuf* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyCommandModuleResult(FFstrbuf* result);
 void ffInitCommandOptions(FFCommandOptions* options);
 bool ffParseCommandCommandOptions(FFCommandOptions* options, const char* key, const char* value);
 void ffDestroyCommandOptions(FFCommandOptions* options);
-void ffParseCommandJsonObject(yyjson_val* module);
+void ffParseCommandJsonObject(FFCommandOptions* options, yyjson_val* module);
@@ -1,74 +1,126 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "common/cache.h"
+#include "common/io/io.h"
 #include "detection/cpu/cpu.h"
 #include "modules/cpu/cpu.h"
 #include "util/stringUtils.h"
 
 #define FF_CPU_NUM_FORMAT_ARGS 8
 
-void ffPrintCPU(FFCPUOptions* options)
+static const FFCacheSchema cpuCacheSchema = FF_CACHE_SCHEMA(FFCPUResult,
+    offsetof(FFCPUResult, name),
+    offsetof(FFCPUResult, vendor),
+);
+
+const char* ffDetectCPUModule(FFCPUOptions* options, FFCPUResult* cpu)
 {
-    FFCPUResult cpu;
-    cpu.temperature = FF_CPU_TEMP_UNSET;
-    cpu.coresPhysical = cpu.coresLogical = cpu.coresOnline = 0;
-    cpu.frequencyMax = cpu.frequencyMin = 0;
-    ffStrbufInit(&cpu.name);
-    ffStrbufInit(&cpu.vendor);
+    FF_STRBUF_AUTO_DESTROY cacheKey = ffStrbufCreate();
+    bool cache = !options->temp && ffCacheKeyInit(&cacheKey, &options->moduleArgs);
+    if(cache)
+    {
+        #ifdef __linux__
+            // CPUs may be taken offline
+            ffAppendFileBuffer("/sys/devices/system/cpu/online", &cacheKey);
+        #endif
+        if(ffCacheLoad(FF_CPU_MODULE_NAME, &cacheKey, &cpuCacheSchema, cpu))
+            return NULL;
+    }
 
-    const char* error = ffDetectCPU(options, &cpu);
+    cpu->temperature = FF_CPU_TEMP_UNSET;
+    cpu->coresPhysical = cpu->coresLogical = cpu->coresOnline = 0;
+    cpu->frequencyMax = cpu->frequencyMin = 0;
+    ffStrbufInit(&cpu->name);
+    ffStrbufInit(&cpu->vendor);
 
+    const char* error = ffDetectCPU(options, cpu);
     if(error)
-    {
-        ffPrintError(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-    }
-    else if(cpu.vendor.length == 0 && cpu.name.length == 0 && cpu.coresOnline <= 1)
-    {
-        ffPrintError(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, "No CPU detected");
-    }
-    else
-    {
-        if(options->moduleArgs.outputFormat.length == 0)
-        {
-            ffPrintLogoAndKey(FF_CPU_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
+        return error;
 
-            if(cpu.name.length > 0)
-                ffStrbufWriteTo(&cpu.name, stdout);
-            else if(cpu.vendor.length > 0)
-            {
-                ffStrbufWriteTo(&cpu.vendor, stdout);
-                fputs(" CPU", stdout);
-            }
-            else
-                fputs("CPU", stdout);
+    if(cpu->vendor.length == 0 && cpu->name.length == 0 && cpu->coresOnline <= 1)
+        return "No CPU detected";
 
-            if(cpu.coresOnline > 1)
-                printf(" (%u)", cpu.coresOnline);
+    if(cache)
+        ffCacheStore(FF_CPU_MODULE_NAME, &cacheKey, &cpuCacheSchema, cpu);
 
-            if(cpu.frequencyMax > 0.0)
-                printf(" @ %.9g GHz", cpu.frequencyMax);
+    return NULL;
+}
 
-            if(cpu.temperature == cpu.temperature) //FF_CPU_TEMP_UNSET
-                printf(" - %.1f°C", cpu.temperature);
+void ffRenderCPUModule(FFCPUOptions* options, FFCPUResult* cpu)
+{
+    if(options->moduleArgs.outputFormat.length == 0)
+    {
+        ffPrintLogoAndKey(FF_CPU_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
 
-            putchar('\n');
-        }
-        else
+        if(cpu->name.length > 0)
+            ffStrbufWriteTo(&cpu->name, stdout);
+        else if(cpu->vendor.length > 0)
         {
-            ffPrintFormat(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, FF_CPU_NUM_FORMAT_ARGS, (FFformatarg[]){
-                {FF_FORMAT_ARG_TYPE_STRBUF, &cpu.name},
-                {FF_FORMAT_ARG_TYPE_STRBUF, &cpu.vendor},
-                {FF_FORMAT_ARG_TYPE_UINT16, &cpu.coresPhysical},
-                {FF_FORMAT_ARG_TYPE_UINT16, &cpu.coresLogical},
-                {FF_FORMAT_ARG_TYPE_UINT16, &cpu.coresOnline},
-                {FF_FORMAT_ARG_TYPE_DOUBLE, &cpu.frequencyMin},
-                {FF_FORMAT_ARG_TYPE_DOUBLE, &cpu.frequencyMax},
-                {FF_FORMAT_ARG_TYPE_DOUBLE, &cpu.temperature}
-            });
+            ffStrbufWriteTo(&cpu->vendor, stdout);
+            fputs(" CPU", stdout);
         }
+        else
+            fputs("CPU", stdout);
+
+        if(cpu->coresOnline > 1)
+            printf(" (%u)", cpu->coresOnline);
+
+        if(cpu->frequencyMax > 0.0)
+            printf(" @ %.9g GHz", cpu->frequencyMax);
+
+        if(cpu->temperature == cpu->temperature) //FF_CPU_TEMP_UNSET
+            printf(" - %.1f°C", cpu->temperature);
+
+        putchar('\n');
+    }
+    else
+    {
+        ffPrintFormat(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, FF_CPU_NUM_FORMAT_ARGS, (FFformatarg[]){
+            {FF_FORMAT_ARG_TYPE_STRBUF, &cpu->name},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &cpu->vendor},
+            {FF_FORMAT_ARG_TYPE_UINT16, &cpu->coresPhysical},
+            {FF_FORMAT_ARG_TYPE_UINT16, &cpu->coresLogical},
+            {FF_FORMAT_ARG_TYPE_UINT16, &cpu->coresOnline},
+            {FF_FORMAT_ARG_TYPE_DOUBLE, &cpu->frequencyMin},
+            {FF_FORMAT_ARG_TYPE_DOUBLE, &cpu->frequencyMax},
+            {FF_FORMAT_ARG_TYPE_DOUBLE, &cpu->temperature}
+        });
     }
+}
+
+void ffGenerateCPUJsonResult(FF_MAYBE_UNUSED FFCPUOptions* options, FFCPUResult* cpu, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "name", &cpu->name);
+    ffJsonResultAddStrbuf(doc, obj, "vendor", &cpu->vendor);
+    yyjson_mut_val* cores = ffJsonResultAddObj(doc, obj, "cores");
+    yyjson_mut_obj_add_uint(doc, cores, "physical", cpu->coresPhysical);
+    yyjson_mut_obj_add_uint(doc, cores, "logical", cpu->coresLogical);
+    yyjson_mut_obj_add_uint(doc, cores, "online", cpu->coresOnline);
+    yyjson_mut_val* frequency = ffJsonResultAddObj(doc, obj, "frequency"); // GHz
+    ffJsonResultAddDouble(doc, frequency, "min", cpu->frequencyMin);
+    ffJsonResultAddDouble(doc, frequency, "max", cpu->frequencyMax);
+    ffJsonResultAddDouble(doc, obj, "temperature", cpu->temperature);
+}
+
+void ffDestroyCPUModuleResult(FFCPUResult* cpu)
+{
+    ffStrbufDestroy(&cpu->name);
+    ffStrbufDestroy(&cpu->vendor);
+}
+
+void ffPrintCPU(FFCPUOptions* options)
+{
+    FFCPUResult cpu;
+    const char* error = ffDetectCPUModule(options, &cpu);
 
-    ffStrbufDestroy(&cpu.name);
-    ffStrbufDestroy(&cpu.vendor);
+    if(error)
+        ffPrintError(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderCPUModule(options, &cpu);
+
+    ffDestroyCPUModuleResult(&cpu);
 }
 
 void ffInitCPUOptions(FFCPUOptions* options)
@@ -99,11 +151,8 @@ void ffDestroyCPUOptions(FFCPUOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseCPUJsonObject(yyjson_val* module)
+void ffParseCPUJsonObject(FFCPUOptions* options, yyjson_val* module)
 {
-    FFCPUOptions __attribute__((__cleanup__(ffDestroyCPUOptions))) options;
-    ffInitCPUOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -114,18 +163,16 @@ void ffParseCPUJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             if (ffStrEqualsIgnCase(key, "temp"))
             {
-                options.temp = yyjson_get_bool(val);
+                options->temp = yyjson_get_bool(val);
                 continue;
             }
 
-            ffPrintError(FF_CPU_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_CPU_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintCPU(&options);
 }
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/cpu/cpu.h"
 
 #define FF_CPU_MODULE_NAME "CPU"
 
 void ffPrintCPU(FFCPUOptions* options);
+const char* ffDetectCPUModule(FFCPUOptions* options, FFCPUResult* cpu);
+void ffRenderCPUModule(FFCPUOptions* options, FFCPUResult* cpu);
+void ffGenerateCPUJsonResult(FFCPUOptions* options, FFCPUResult* cpu, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyCPUModuleResult(FFCPUResult* cpu);
 void ffInitCPUOptions(FFCPUOptions* options);
 bool ffParseCPUCommandOptions(FFCPUOptions* options, const char* key, const char* value);
 void ffDestroyCPUOptions(FFCPUOptions* options);
-void ffParseCPUJsonObject(yyjson_val* module);
+void ffParseCPUJsonObject(FFCPUOptions* options, yyjson_val* module);
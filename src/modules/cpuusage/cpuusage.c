@@ -1,51 +1,269 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "common/bar.h"
+#include "common/cache.h"
+#include "common/scheduler.h"
+#include "common/time.h"
 #include "detection/cpuusage/cpuusage.h"
 #include "modules/cpuusage/cpuusage.h"
 #include "util/stringUtils.h"
 
 #define FF_CPUUSAGE_DISPLAY_NAME "CPU Usage"
-#define FF_CPUUSAGE_NUM_FORMAT_ARGS 1
+#define FF_CPUUSAGE_NUM_FORMAT_ARGS 9
 
-void ffPrintCPUUsage(FFCPUUsageOptions* options)
+// A sample stored by a previous run is used as the baseline if the one taken at startup is too recent, and it is at most this old
+#define FF_CPUUSAGE_MAX_CACHED_AGE 30000 // ms
+// Number of cores printed by {7}
+#define FF_CPUUSAGE_BUSIEST_COUNT 3
+
+// Samples are cached as a list. The first entry holds the sum of all CPUs and the tick the sample was taken; the other ones single CPUs
+typedef struct FFCpuUsageCacheEntry
+{
+    uint64_t tick;
+    FFCpuUsageCounters counters;
+} FFCpuUsageCacheEntry;
+
+static const FFCacheSchema cpuUsageCacheSchema = { .size = sizeof(FFCpuUsageCacheEntry) };
+
+static bool loadCachedSample(const FFstrbuf* cacheKey, FFCpuUsageSample* sample)
 {
-    double percentage = 0.0/0.0;
-    const char* error = ffGetCpuUsageResult(&percentage);
+    FF_LIST_AUTO_DESTROY entries = ffListCreate(sizeof(FFCpuUsageCacheEntry));
+    if(!ffCacheLoadList(FF_CPUUSAGE_MODULE_NAME, cacheKey, &cpuUsageCacheSchema, &entries) || entries.length == 0)
+        return false;
 
+    FFCpuUsageCacheEntry* first = ffListGet(&entries, 0);
+    sample->tick = first->tick;
+    sample->all = first->counters;
+    for(uint32_t i = 1; i < entries.length; ++i)
+        *(FFCpuUsageCounters*) ffListAdd(&sample->cores) = ((FFCpuUsageCacheEntry*) ffListGet(&entries, i))->counters;
+    return true;
+}
+
+static void storeSample(const FFstrbuf* cacheKey, const FFCpuUsageSample* sample)
+{
+    FF_LIST_AUTO_DESTROY entries = ffListCreate(sizeof(FFCpuUsageCacheEntry));
+    *(FFCpuUsageCacheEntry*) ffListAdd(&entries) = (FFCpuUsageCacheEntry) { .tick = sample->tick, .counters = sample->all };
+    FF_LIST_FOR_EACH(FFCpuUsageCounters, core, sample->cores)
+        *(FFCpuUsageCacheEntry*) ffListAdd(&entries) = (FFCpuUsageCacheEntry) { .counters = *core };
+    ffCacheStoreList(FF_CPUUSAGE_MODULE_NAME, cacheKey, &cpuUsageCacheSchema, &entries);
+}
+
+const char* ffDetectCPUUsageModule(FFCPUUsageOptions* options, FFCpuUsageResult* result)
+{
+    result->all = 0.0/0.0;
+    ffListInit(&result->cores, sizeof(FFCpuUsageCore));
+
+    FFCpuUsageSample prepared = { .cores = ffListCreate(sizeof(FFCpuUsageCounters)) };
+    const char* error = ffCpuUsageGetPreparedSample(&prepared);
     if(error)
     {
-        ffPrintError(FF_CPUUSAGE_DISPLAY_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
+        ffListDestroy(&prepared.cores);
+        return error;
+    }
+    const FFCpuUsageSample* baseline = &prepared;
+
+    // Take the second sample as late as possible, once every module before this one has printed
+    ffSchedulerWaitForOutput();
+
+    FF_STRBUF_AUTO_DESTROY cacheKey = ffStrbufCreate();
+    bool cache = ffCacheKeyInit(&cacheKey, &options->moduleArgs);
+
+    FFCpuUsageSample cached = { .cores = ffListCreate(sizeof(FFCpuUsageCounters)) };
+    uint64_t now = ffTimeGetTick();
+    if(cache && now - baseline->tick < FF_CPUUSAGE_MIN_INTERVAL &&
+        loadCachedSample(&cacheKey, &cached) &&
+        cached.tick < baseline->tick && now - cached.tick >= FF_CPUUSAGE_MIN_INTERVAL && now - cached.tick <= FF_CPUUSAGE_MAX_CACHED_AGE &&
+        cached.all.total < baseline->all.total && cached.all.inUse <= baseline->all.inUse
+    )
+        baseline = &cached;
+
+    FFCpuUsageSample sample = { .cores = ffListCreate(sizeof(FFCpuUsageCounters)) };
+    error = ffGetCpuUsageResult(baseline, &sample, result);
+
+    if(!error)
+    {
+        ffCpuUsageUpdatePreparedSample(&sample);
+        if(cache)
+            storeSample(&cacheKey, &sample);
+    }
+
+    ffListDestroy(&prepared.cores);
+    ffListDestroy(&cached.cores);
+    ffListDestroy(&sample.cores);
+    return error;
+}
+
+static void appendPercent(FFstrbuf* buffer, const char* name, uint32_t id, double usage)
+{
+    if(buffer->length > 0)
+        ffStrbufAppendS(buffer, ", ");
+    ffStrbufAppendF(buffer, "%s%u %.0f%%", name, (unsigned) id, usage);
+}
+
+static void appendBusiestCores(FFstrbuf* buffer, const FFlist* cores)
+{
+    // Selects the busiest ones without sorting; FF_CPUUSAGE_BUSIEST_COUNT is small
+    const FFCpuUsageCore* printed[FF_CPUUSAGE_BUSIEST_COUNT] = {};
+    for(uint32_t i = 0; i < FF_CPUUSAGE_BUSIEST_COUNT && i < cores->length; ++i)
+    {
+        const FFCpuUsageCore* busiest = NULL;
+        FF_LIST_FOR_EACH(FFCpuUsageCore, core, *cores)
+        {
+            if(busiest && core->usage <= busiest->usage)
+                continue;
+            if(i > 0 && (core->usage > printed[i - 1]->usage || (core->usage == printed[i - 1]->usage && core <= printed[i - 1])))
+                continue;
+            busiest = core;
+        }
+        printed[i] = busiest;
+        appendPercent(buffer, "cpu", busiest->id, busiest->usage);
+    }
+}
+
+static void appendNodes(FFstrbuf* buffer, const FFlist* cores)
+{
+    uint32_t maxNode = 0;
+    FF_LIST_FOR_EACH(FFCpuUsageCore, core, *cores)
+    {
+        if(core->node > maxNode)
+            maxNode = core->node;
+    }
+
+    for(uint32_t node = 0; node <= maxNode && cores->length > 0; ++node)
+    {
+        double sum = 0;
+        uint32_t count = 0;
+        FF_LIST_FOR_EACH(FFCpuUsageCore, core, *cores)
+        {
+            if(core->node != node)
+                continue;
+            sum += core->usage;
+            ++count;
+        }
+        if(count > 0)
+            appendPercent(buffer, "node", node, sum / count);
     }
+}
 
+static void appendCoreBars(FFstrbuf* buffer, const FFlist* cores)
+{
+    // One block character per CPU, its height showing the usage
+    static const char* const blocks[] = { "▁", "▂", "▃", "▄", "▅", "▆", "▇", "█" };
+    FF_LIST_FOR_EACH(FFCpuUsageCore, core, *cores)
+    {
+        uint32_t index = core->usage > 0 ? (uint32_t) (core->usage * 8 / 100) : 0;
+        ffStrbufAppendS(buffer, blocks[index < 8 ? index : 7]);
+    }
+}
+
+void ffRenderCPUUsageModule(FFCPUUsageOptions* options, FFCpuUsageResult* result)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_CPUUSAGE_DISPLAY_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
 
         FF_STRBUF_AUTO_DESTROY str = ffStrbufCreate();
         if(instance.config.percentType & FF_PERCENTAGE_TYPE_BAR_BIT)
-            ffAppendPercentBar(&str, (uint8_t)percentage, 0, 5, 8);
+            ffAppendPercentBar(&str, (uint8_t) result->all, 0, 5, 8);
         if(instance.config.percentType & FF_PERCENTAGE_TYPE_NUM_BIT)
         {
             if(str.length > 0)
                 ffStrbufAppendC(&str, ' ');
-            ffAppendPercentNum(&str, (uint8_t) percentage, 50, 80, str.length > 0);
+            ffAppendPercentNum(&str, (uint8_t) result->all, 50, 80, str.length > 0);
+        }
+        if(options->perCore && result->cores.length > 0)
+        {
+            if(str.length > 0)
+                ffStrbufAppendC(&str, ' ');
+            appendCoreBars(&str, &result->cores);
         }
         ffStrbufPutTo(&str, stdout);
     }
     else
     {
+        double avgCore = 0.0/0.0, minCore = 0.0/0.0, maxCore = 0.0/0.0;
+        uint32_t minCoreId = 0, maxCoreId = 0;
+        if(result->cores.length > 0)
+        {
+            double sum = 0;
+            minCore = 100;
+            maxCore = -1;
+            FF_LIST_FOR_EACH(FFCpuUsageCore, core, result->cores)
+            {
+                sum += core->usage;
+                if(core->usage < minCore)
+                {
+                    minCore = core->usage;
+                    minCoreId = core->id;
+                }
+                if(core->usage > maxCore)
+                {
+                    maxCore = core->usage;
+                    maxCoreId = core->id;
+                }
+            }
+            avgCore = sum / result->cores.length;
+        }
+
+        FF_STRBUF_AUTO_DESTROY busiest = ffStrbufCreate();
+        appendBusiestCores(&busiest, &result->cores);
+        FF_STRBUF_AUTO_DESTROY nodes = ffStrbufCreate();
+        appendNodes(&nodes, &result->cores);
+        FF_STRBUF_AUTO_DESTROY bars = ffStrbufCreate();
+        appendCoreBars(&bars, &result->cores);
+
         ffPrintFormat(FF_CPUUSAGE_DISPLAY_NAME, 0, &options->moduleArgs, FF_CPUUSAGE_NUM_FORMAT_ARGS, (FFformatarg[]){
-            {FF_FORMAT_ARG_TYPE_DOUBLE, &percentage}
+            {FF_FORMAT_ARG_TYPE_DOUBLE, &result->all},
+            {FF_FORMAT_ARG_TYPE_DOUBLE, &avgCore},
+            {FF_FORMAT_ARG_TYPE_DOUBLE, &minCore},
+            {FF_FORMAT_ARG_TYPE_UINT, &minCoreId},
+            {FF_FORMAT_ARG_TYPE_DOUBLE, &maxCore},
+            {FF_FORMAT_ARG_TYPE_UINT, &maxCoreId},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &busiest},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &nodes},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &bars},
         });
     }
 }
 
+void ffGenerateCPUUsageJsonResult(FF_MAYBE_UNUSED FFCPUUsageOptions* options, FFCpuUsageResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddDouble(doc, obj, "all", result->all);
+    yyjson_mut_val* cores = ffJsonResultAddArr(doc, obj, "cores");
+    FF_LIST_FOR_EACH(FFCpuUsageCore, core, result->cores)
+    {
+        yyjson_mut_val* item = yyjson_mut_arr_add_obj(doc, cores);
+        yyjson_mut_obj_add_uint(doc, item, "id", core->id);
+        yyjson_mut_obj_add_uint(doc, item, "node", core->node);
+        ffJsonResultAddDouble(doc, item, "usage", core->usage);
+    }
+}
+
+void ffDestroyCPUUsageModuleResult(FFCpuUsageResult* result)
+{
+    ffListDestroy(&result->cores);
+}
+
+void ffPrintCPUUsage(FFCPUUsageOptions* options)
+{
+    FFCpuUsageResult result;
+    const char* error = ffDetectCPUUsageModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_CPUUSAGE_DISPLAY_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderCPUUsageModule(options, &result);
+
+    ffDestroyCPUUsageModuleResult(&result);
+}
+
 void ffInitCPUUsageOptions(FFCPUUsageOptions* options)
 {
     options->moduleName = FF_CPUUSAGE_MODULE_NAME;
     ffOptionInitModuleArg(&options->moduleArgs);
+    options->perCore = false;
 }
 
 bool ffParseCPUUsageCommandOptions(FFCPUUsageOptions* options, const char* key, const char* value)
@@ -55,6 +273,12 @@ bool ffParseCPUUsageCommandOptions(FFCPUUsageOptions* options, const char* key,
     if (ffOptionParseModuleArgs(key, subKey, value, &options->moduleArgs))
         return true;
 
+    if (ffStrEqualsIgnCase(subKey, "per-core"))
+    {
+        options->perCore = ffOptionParseBoolean(value);
+        return true;
+    }
+
     return false;
 }
 
@@ -63,11 +287,8 @@ void ffDestroyCPUUsageOptions(FFCPUUsageOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseCPUUsageJsonObject(yyjson_val* module)
+void ffParseCPUUsageJsonObject(FFCPUUsageOptions* options, yyjson_val* module)
 {
-    FFCPUUsageOptions __attribute__((__cleanup__(ffDestroyCPUUsageOptions))) options;
-    ffInitCPUUsageOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -78,12 +299,16 @@ void ffParseCPUUsageJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_CPUUSAGE_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            if (ffStrEqualsIgnCase(key, "perCore"))
+            {
+                options->perCore = yyjson_get_bool(val);
+                continue;
+            }
+
+            ffPrintError(FF_CPUUSAGE_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintCPUUsage(&options);
 }
@@ -1,13 +1,18 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/cpuusage/cpuusage.h"
 
 #define FF_CPUUSAGE_MODULE_NAME "CPUUsage"
 
 void ffPrepareCPUUsage();
 
 void ffPrintCPUUsage(FFCPUUsageOptions* options);
+const char* ffDetectCPUUsageModule(FFCPUUsageOptions* options, FFCpuUsageResult* result);
+void ffRenderCPUUsageModule(FFCPUUsageOptions* options, FFCpuUsageResult* result);
+void ffGenerateCPUUsageJsonResult(FFCPUUsageOptions* options, FFCpuUsageResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyCPUUsageModuleResult(FFCpuUsageResult* result);
 void ffInitCPUUsageOptions(FFCPUUsageOptions* options);
 bool ffParseCPUUsageCommandOptions(FFCPUUsageOptions* options, const char* key, const char* value);
 void ffDestroyCPUUsageOptions(FFCPUUsageOptions* options);
-void ffParseCPUUsageJsonObject(yyjson_val* module);
+void ffParseCPUUsageJsonObject(FFCPUUsageOptions* options, yyjson_val* module);
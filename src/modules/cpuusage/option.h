@@ -8,4 +8,6 @@ typedef struct FFCPUUsageOptions
 {
     const char* moduleName;
     FFModuleArgs moduleArgs;
+
+    bool perCore;
 } FFCPUUsageOptions;
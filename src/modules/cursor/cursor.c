@@ -1,53 +1,79 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/cursor/cursor.h"
 #include "modules/cursor/cursor.h"
 #include "util/stringUtils.h"
 
 #define FF_CURSOR_NUM_FORMAT_ARGS 2
 
-void ffPrintCursor(FFCursorOptions* options)
+const char* ffDetectCursorModule(FF_MAYBE_UNUSED FFCursorOptions* options, FFCursorResult* result)
 {
-    FFCursorResult result;
-    ffStrbufInit(&result.error);
-    ffStrbufInit(&result.theme);
-    ffStrbufInit(&result.size);
+    ffStrbufInit(&result->error);
+    ffStrbufInit(&result->theme);
+    ffStrbufInit(&result->size);
 
-    ffDetectCursor(&result);
+    ffDetectCursor(result);
 
-    if(result.error.length)
-        ffPrintError(FF_CURSOR_MODULE_NAME, 0, &options->moduleArgs, "%s", result.error.chars);
-    else
+    if(result->error.length)
+        return result->error.chars;
+
+    ffStrbufRemoveIgnCaseEndS(&result->theme, "cursors");
+    ffStrbufRemoveIgnCaseEndS(&result->theme, "cursor");
+    ffStrbufTrimRight(&result->theme, '_');
+    ffStrbufTrimRight(&result->theme, '-');
+    if(result->theme.length == 0)
+        ffStrbufAppendS(&result->theme, "default");
+
+    return NULL;
+}
+
+void ffRenderCursorModule(FFCursorOptions* options, FFCursorResult* result)
+{
+    if(options->moduleArgs.outputFormat.length == 0)
     {
-        ffStrbufRemoveIgnCaseEndS(&result.theme, "cursors");
-        ffStrbufRemoveIgnCaseEndS(&result.theme, "cursor");
-        ffStrbufTrimRight(&result.theme, '_');
-        ffStrbufTrimRight(&result.theme, '-');
-        if(result.theme.length == 0)
-            ffStrbufAppendS(&result.theme, "default");
-
-        if(options->moduleArgs.outputFormat.length == 0)
-        {
-            ffPrintLogoAndKey(FF_CURSOR_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-            ffStrbufWriteTo(&result.theme, stdout);
+        ffPrintLogoAndKey(FF_CURSOR_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
+        ffStrbufWriteTo(&result->theme, stdout);
 
-            if(result.size.length > 0)
-                printf(" (%spx)", result.size.chars);
+        if(result->size.length > 0)
+            printf(" (%spx)", result->size.chars);
 
-            putchar('\n');
-        }
-        else
-        {
-            ffPrintFormat(FF_CURSOR_MODULE_NAME, 0, &options->moduleArgs, FF_CURSOR_NUM_FORMAT_ARGS, (FFformatarg[]){
-                {FF_FORMAT_ARG_TYPE_STRBUF, &result.theme},
-                {FF_FORMAT_ARG_TYPE_STRBUF, &result.size}
-            });
-        }
+        putchar('\n');
+    }
+    else
+    {
+        ffPrintFormat(FF_CURSOR_MODULE_NAME, 0, &options->moduleArgs, FF_CURSOR_NUM_FORMAT_ARGS, (FFformatarg[]){
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->theme},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->size}
+        });
     }
+}
+
+void ffGenerateCursorJsonResult(FF_MAYBE_UNUSED FFCursorOptions* options, FFCursorResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "theme", &result->theme);
+    ffJsonResultAddStrbuf(doc, obj, "size", &result->size);
+}
 
-    ffStrbufDestroy(&result.error);
-    ffStrbufDestroy(&result.theme);
-    ffStrbufDestroy(&result.size);
+void ffDestroyCursorModuleResult(FFCursorResult* result)
+{
+    ffStrbufDestroy(&result->error);
+    ffStrbufDestroy(&result->theme);
+    ffStrbufDestroy(&result->size);
+}
+
+void ffPrintCursor(FFCursorOptions* options)
+{
+    FFCursorResult result;
+    const char* error = ffDetectCursorModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_CURSOR_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderCursorModule(options, &result);
+
+    ffDestroyCursorModuleResult(&result);
 }
 
 void ffInitCursorOptions(FFCursorOptions* options)
@@ -71,11 +97,8 @@ void ffDestroyCursorOptions(FFCursorOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseCursorJsonObject(yyjson_val* module)
+void ffParseCursorJsonObject(FFCursorOptions* options, yyjson_val* module)
 {
-    FFCursorOptions __attribute__((__cleanup__(ffDestroyCursorOptions))) options;
-    ffInitCursorOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -86,12 +109,10 @@ void ffParseCursorJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_CURSOR_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_CURSOR_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintCursor(&options);
 }
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/cursor/cursor.h"
 
 #define FF_CURSOR_MODULE_NAME "Cursor"
 
 void ffPrintCursor(FFCursorOptions* options);
+const char* ffDetectCursorModule(FFCursorOptions* options, FFCursorResult* result);
+void ffRenderCursorModule(FFCursorOptions* options, FFCursorResult* result);
+void ffGenerateCursorJsonResult(FFCursorOptions* options, FFCursorResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyCursorModuleResult(FFCursorResult* result);
 void ffInitCursorOptions(FFCursorOptions* options);
 bool ffParseCursorCommandOptions(FFCursorOptions* options, const char* key, const char* value);
 void ffDestroyCursorOptions(FFCursorOptions* options);
-void ffParseCursorJsonObject(yyjson_val* module);
+void ffParseCursorJsonObject(FFCursorOptions* options, yyjson_val* module);
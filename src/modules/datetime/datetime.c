@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/datetime/datetime.h"
 #include "modules/datetime/datetime.h"
 #include "util/stringUtils.h"
@@ -7,46 +8,71 @@
 #define FF_DATETIME_DISPLAY_NAME "Date & Time"
 #define FF_DATETIME_NUM_FORMAT_ARGS 20
 
-void ffPrintDateTimeFormat(const char* moduleName, const FFModuleArgs* moduleArgs)
+const char* ffDetectDateTimeModule(FF_MAYBE_UNUSED FFDateTimeOptions* options, const FFDateTimeResult** result)
 {
-    const FFDateTimeResult* result = ffDetectDateTime();
-    ffPrintFormat(moduleName, 0, moduleArgs, FF_DATETIME_NUM_FORMAT_ARGS, (FFformatarg[]) {
-        {FF_FORMAT_ARG_TYPE_UINT16, &result->year}, // 1
-        {FF_FORMAT_ARG_TYPE_UINT8, &result->yearShort}, // 2
-        {FF_FORMAT_ARG_TYPE_UINT8, &result->month}, // 3
-        {FF_FORMAT_ARG_TYPE_STRBUF, &result->monthPretty}, // 4
-        {FF_FORMAT_ARG_TYPE_STRBUF, &result->monthName}, // 5
-        {FF_FORMAT_ARG_TYPE_STRBUF, &result->monthNameShort}, // 6
-        {FF_FORMAT_ARG_TYPE_UINT8, &result->week}, // 7
-        {FF_FORMAT_ARG_TYPE_STRBUF, &result->weekday}, // 8
-        {FF_FORMAT_ARG_TYPE_STRBUF, &result->weekdayShort}, // 9
-        {FF_FORMAT_ARG_TYPE_UINT16, &result->dayInYear}, // 10
-        {FF_FORMAT_ARG_TYPE_UINT8, &result->dayInMonth}, // 11
-        {FF_FORMAT_ARG_TYPE_UINT8, &result->dayInWeek}, // 12
-        {FF_FORMAT_ARG_TYPE_UINT8, &result->hour}, // 13
-        {FF_FORMAT_ARG_TYPE_STRBUF, &result->hourPretty}, // 14
-        {FF_FORMAT_ARG_TYPE_UINT8, &result->hour12}, // 15
-        {FF_FORMAT_ARG_TYPE_STRBUF, &result->hour12Pretty}, // 16
-        {FF_FORMAT_ARG_TYPE_UINT8, &result->minute}, // 17
-        {FF_FORMAT_ARG_TYPE_STRBUF, &result->minutePretty}, // 18
-        {FF_FORMAT_ARG_TYPE_UINT8, &result->second}, // 19
-        {FF_FORMAT_ARG_TYPE_STRBUF, &result->secondPretty} // 20
-    });
+    *result = ffDetectDateTime();
+    return NULL;
 }
 
-void ffPrintDateTime(FFDateTimeOptions* options)
+void ffRenderDateTimeModule(FFDateTimeOptions* options, const FFDateTimeResult** pResult)
 {
+    const FFDateTimeResult* result = *pResult;
+
     if(options->moduleArgs.outputFormat.length > 0)
     {
-        ffPrintDateTimeFormat(FF_DATETIME_DISPLAY_NAME, &options->moduleArgs);
+        ffPrintFormat(FF_DATETIME_DISPLAY_NAME, 0, &options->moduleArgs, FF_DATETIME_NUM_FORMAT_ARGS, (FFformatarg[]) {
+            {FF_FORMAT_ARG_TYPE_UINT16, &result->year}, // 1
+            {FF_FORMAT_ARG_TYPE_UINT8, &result->yearShort}, // 2
+            {FF_FORMAT_ARG_TYPE_UINT8, &result->month}, // 3
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->monthPretty}, // 4
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->monthName}, // 5
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->monthNameShort}, // 6
+            {FF_FORMAT_ARG_TYPE_UINT8, &result->week}, // 7
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->weekday}, // 8
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->weekdayShort}, // 9
+            {FF_FORMAT_ARG_TYPE_UINT16, &result->dayInYear}, // 10
+            {FF_FORMAT_ARG_TYPE_UINT8, &result->dayInMonth}, // 11
+            {FF_FORMAT_ARG_TYPE_UINT8, &result->dayInWeek}, // 12
+            {FF_FORMAT_ARG_TYPE_UINT8, &result->hour}, // 13
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->hourPretty}, // 14
+            {FF_FORMAT_ARG_TYPE_UINT8, &result->hour12}, // 15
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->hour12Pretty}, // 16
+            {FF_FORMAT_ARG_TYPE_UINT8, &result->minute}, // 17
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->minutePretty}, // 18
+            {FF_FORMAT_ARG_TYPE_UINT8, &result->second}, // 19
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->secondPretty} // 20
+        });
         return;
     }
 
-    const FFDateTimeResult* datetime = ffDetectDateTime();
     ffPrintLogoAndKey(FF_DATETIME_DISPLAY_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
 
     //yyyy-MM-dd HH:mm:ss
-    printf("%u-%s-%02u %s:%s:%s\n", datetime->year, datetime->monthPretty.chars, datetime->dayInMonth, datetime->hourPretty.chars, datetime->minutePretty.chars, datetime->secondPretty.chars);
+    printf("%u-%s-%02u %s:%s:%s\n", result->year, result->monthPretty.chars, result->dayInMonth, result->hourPretty.chars, result->minutePretty.chars, result->secondPretty.chars);
+}
+
+void ffGenerateDateTimeJsonResult(FF_MAYBE_UNUSED FFDateTimeOptions* options, const FFDateTimeResult** result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    const FFDateTimeResult* datetime = *result;
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    yyjson_mut_obj_add_uint(doc, obj, "year", datetime->year);
+    yyjson_mut_obj_add_uint(doc, obj, "month", datetime->month);
+    ffJsonResultAddStrbuf(doc, obj, "monthName", &datetime->monthName);
+    yyjson_mut_obj_add_uint(doc, obj, "week", datetime->week);
+    ffJsonResultAddStrbuf(doc, obj, "weekday", &datetime->weekday);
+    yyjson_mut_obj_add_uint(doc, obj, "dayInYear", datetime->dayInYear);
+    yyjson_mut_obj_add_uint(doc, obj, "dayInMonth", datetime->dayInMonth);
+    yyjson_mut_obj_add_uint(doc, obj, "dayInWeek", datetime->dayInWeek);
+    yyjson_mut_obj_add_uint(doc, obj, "hour", datetime->hour);
+    yyjson_mut_obj_add_uint(doc, obj, "minute", datetime->minute);
+    yyjson_mut_obj_add_uint(doc, obj, "second", datetime->second);
+}
+
+void ffPrintDateTime(FFDateTimeOptions* options)
+{
+    const FFDateTimeResult* result;
+    ffDetectDateTimeModule(options, &result);
+    ffRenderDateTimeModule(options, &result);
 }
 
 void ffInitDateTimeOptions(FFDateTimeOptions* options)
@@ -70,11 +96,8 @@ void ffDestroyDateTimeOptions(FFDateTimeOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseDateTimeJsonObject(yyjson_val* module)
+void ffParseDateTimeJsonObject(FFDateTimeOptions* options, yyjson_val* module)
 {
-    FFDateTimeOptions __attribute__((__cleanup__(ffDestroyDateTimeOptions))) options;
-    ffInitDateTimeOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -85,12 +108,10 @@ void ffParseDateTimeJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_DATETIME_DISPLAY_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_DATETIME_DISPLAY_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintDateTime(&options);
 }
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/datetime/datetime.h"
 
 #define FF_DATETIME_MODULE_NAME "DateTime"
 
 void ffPrintDateTime(FFDateTimeOptions* options);
+const char* ffDetectDateTimeModule(FFDateTimeOptions* options, const FFDateTimeResult** result);
+void ffRenderDateTimeModule(FFDateTimeOptions* options, const FFDateTimeResult** result);
+void ffGenerateDateTimeJsonResult(FFDateTimeOptions* options, const FFDateTimeResult** result, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitDateTimeOptions(FFDateTimeOptions* options);
 bool ffParseDateTimeCommandOptions(FFDateTimeOptions* options, const char* key, const char* value);
 void ffDestroyDateTimeOptions(FFDateTimeOptions* options);
-void ffParseDateTimeJsonObject(yyjson_val* module);
+void ffParseDateTimeJsonObject(FFDateTimeOptions* options, yyjson_val* module);
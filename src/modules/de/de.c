@@ -1,20 +1,25 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/displayserver/displayserver.h"
 #include "modules/de/de.h"
 #include "util/stringUtils.h"
 
 #define FF_DE_NUM_FORMAT_ARGS 3
 
-void ffPrintDE(FFDEOptions* options)
+const char* ffDetectDEModule(FF_MAYBE_UNUSED FFDEOptions* options, const FFDisplayServerResult** result)
 {
-    const FFDisplayServerResult* result = ffConnectDisplayServer();
+    *result = ffConnectDisplayServer();
 
-    if(result->dePrettyName.length == 0)
-    {
-        ffPrintError(FF_DE_MODULE_NAME, 0, &options->moduleArgs, "No DE found");
-        return;
-    }
+    if((*result)->dePrettyName.length == 0)
+        return "No DE found";
+
+    return NULL;
+}
+
+void ffRenderDEModule(FFDEOptions* options, const FFDisplayServerResult** pResult)
+{
+    const FFDisplayServerResult* result = *pResult;
 
     if(options->moduleArgs.outputFormat.length == 0)
     {
@@ -40,6 +45,26 @@ void ffPrintDE(FFDEOptions* options)
     }
 }
 
+void ffGenerateDEJsonResult(FF_MAYBE_UNUSED FFDEOptions* options, const FFDisplayServerResult** result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    const FFDisplayServerResult* ds = *result;
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "processName", &ds->deProcessName);
+    ffJsonResultAddStrbuf(doc, obj, "prettyName", &ds->dePrettyName);
+    ffJsonResultAddStrbuf(doc, obj, "version", &ds->deVersion);
+}
+
+void ffPrintDE(FFDEOptions* options)
+{
+    const FFDisplayServerResult* result;
+    const char* error = ffDetectDEModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_DE_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderDEModule(options, &result);
+}
+
 void ffInitDEOptions(FFDEOptions* options)
 {
     options->moduleName = FF_DE_MODULE_NAME;
@@ -61,11 +86,8 @@ void ffDestroyDEOptions(FFDEOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseDEJsonObject(yyjson_val* module)
+void ffParseDEJsonObject(FFDEOptions* options, yyjson_val* module)
 {
-    FFDEOptions __attribute__((__cleanup__(ffDestroyDEOptions))) options;
-    ffInitDEOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -76,12 +98,10 @@ void ffParseDEJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_DE_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_DE_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintDE(&options);
 }
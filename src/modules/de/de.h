@@ -1,11 +1,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/displayserver/displayserver.h"
 
 #define FF_DE_MODULE_NAME "DE"
 
 void ffPrintDE(FFDEOptions* options);
+const char* ffDetectDEModule(FFDEOptions* options, const FFDisplayServerResult** result);
+void ffRenderDEModule(FFDEOptions* options, const FFDisplayServerResult** result);
+void ffGenerateDEJsonResult(FFDEOptions* options, const FFDisplayServerResult** result, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitDEOptions(FFDEOptions* options);
 bool ffParseDECommandOptions(FFDEOptions* options, const char* key, const char* value);
 void ffDestroyDEOptions(FFDEOptions* options);
-void ffParseDEJsonObject(yyjson_val* module);
+void ffParseDEJsonObject(FFDEOptions* options, yyjson_val* module);
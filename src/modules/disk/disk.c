@@ -1,12 +1,13 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "common/parsing.h"
 #include "common/bar.h"
 #include "detection/disk/disk.h"
 #include "modules/disk/disk.h"
 #include "util/stringUtils.h"
 
-#define FF_DISK_NUM_FORMAT_ARGS 10
+#define FF_DISK_NUM_FORMAT_ARGS 12
 #pragma GCC diagnostic ignored "-Wsign-conversion"
 
 static void printDisk(FFDiskOptions* options, const FFDisk* disk)
@@ -19,7 +20,7 @@ static void printDisk(FFDiskOptions* options, const FFDisk* disk)
     }
     else
     {
-        ffParseFormatString(&key, &options->moduleArgs.key, 1, (FFformatarg[]){
+        ffFormatProgramRun(&key, &options->moduleArgs.keyProgram, 1, (FFformatarg[]){
             {FF_FORMAT_ARG_TYPE_STRBUF, &disk->mountpoint}
         });
     }
@@ -80,7 +81,7 @@ static void printDisk(FFDiskOptions* options, const FFDisk* disk)
 
         bool isExternal = !!(disk->type & FF_DISK_TYPE_EXTERNAL_BIT);
         bool isHidden = !!(disk->type & FF_DISK_TYPE_HIDDEN_BIT);
-        ffPrintFormatString(key.chars, 0, NULL, &options->moduleArgs.keyColor, &options->moduleArgs.outputFormat, FF_DISK_NUM_FORMAT_ARGS, (FFformatarg[]){
+        ffPrintFormatString(key.chars, 0, NULL, &options->moduleArgs.keyColor, &options->moduleArgs.outputFormatProgram, FF_DISK_NUM_FORMAT_ARGS, (FFformatarg[]){
             {FF_FORMAT_ARG_TYPE_STRBUF, &usedPretty},
             {FF_FORMAT_ARG_TYPE_STRBUF, &totalPretty},
             {FF_FORMAT_ARG_TYPE_UINT8, &bytesPercentage},
@@ -90,26 +91,25 @@ static void printDisk(FFDiskOptions* options, const FFDisk* disk)
             {FF_FORMAT_ARG_TYPE_BOOL, &isExternal},
             {FF_FORMAT_ARG_TYPE_BOOL, &isHidden},
             {FF_FORMAT_ARG_TYPE_STRBUF, &disk->filesystem},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &disk->name}
+            {FF_FORMAT_ARG_TYPE_STRBUF, &disk->name},
+            {FF_FORMAT_ARG_TYPE_UINT64, &disk->bytesUsed},
+            {FF_FORMAT_ARG_TYPE_UINT64, &disk->bytesTotal},
         });
     }
 }
 
-static void printMountpoint(FFDiskOptions* options, const FFlist* disks, const char* mountpoint)
+static const FFDisk* findMountpoint(const FFlist* disks, const char* mountpoint)
 {
     FF_LIST_FOR_EACH(FFDisk, disk, *disks)
     {
         if(ffStrbufEqualS(&disk->mountpoint, mountpoint))
-        {
-            printDisk(options, disk);
-            return;
-        }
+            return disk;
     }
-
-    ffPrintError(FF_DISK_MODULE_NAME, 0, &options->moduleArgs, "No disk found for mountpoint: %s", mountpoint);
+    return NULL;
 }
 
-static void printMountpoints(FFDiskOptions* options, const FFlist* disks)
+// Calls `callback` for each mountpoint of `--disk-folders`, with the disk mounted there or NULL
+static void forEachMountpoint(FFDiskOptions* options, const FFlist* disks, void (*callback)(FFDiskOptions* options, const char* mountpoint, const FFDisk* disk, void* data), void* data)
 {
     #ifdef _WIN32
     const char separator = ';';
@@ -126,12 +126,21 @@ static void printMountpoints(FFDiskOptions* options, const FFlist* disks)
         uint32_t colonIndex = ffStrbufNextIndexC(&mountpoints, startIndex, separator);
         mountpoints.chars[colonIndex] = '\0';
 
-        printMountpoint(options, disks, mountpoints.chars + startIndex);
+        const char* mountpoint = mountpoints.chars + startIndex;
+        callback(options, mountpoint, findMountpoint(disks, mountpoint), data);
 
         startIndex = colonIndex + 1;
     }
 }
 
+static void printMountpoint(FFDiskOptions* options, const char* mountpoint, const FFDisk* disk, FF_MAYBE_UNUSED void* data)
+{
+    if(disk)
+        printDisk(options, disk);
+    else
+        ffPrintError(FF_DISK_MODULE_NAME, 0, &options->moduleArgs, "No disk found for mountpoint: %s", mountpoint);
+}
+
 static void printAutodetected(FFDiskOptions* options, const FFlist* disks)
 {
     FF_LIST_FOR_EACH(FFDisk, disk, *disks)
@@ -143,31 +152,94 @@ static void printAutodetected(FFDiskOptions* options, const FFlist* disks)
     }
 }
 
-void ffPrintDisk(FFDiskOptions* options)
+const char* ffDetectDiskModule(FF_MAYBE_UNUSED FFDiskOptions* options, FFlist* disks)
 {
-    FF_LIST_AUTO_DESTROY disks = ffListCreate(sizeof (FFDisk));
-    const char* error = ffDetectDisks(&disks);
+    ffListInit(disks, sizeof(FFDisk));
+    return ffDetectDisks(disks);
+}
 
-    if(error)
-    {
-        ffPrintError(FF_DISK_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-    }
+void ffRenderDiskModule(FFDiskOptions* options, FFlist* disks)
+{
+    if(options->folders.length == 0)
+        printAutodetected(options, disks);
     else
+        forEachMountpoint(options, disks, printMountpoint, NULL);
+}
+
+static void addDiskJson(yyjson_mut_doc* doc, yyjson_mut_val* arr, const FFDisk* disk)
+{
+    yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+    ffJsonResultAddStrbuf(doc, obj, "mountpoint", &disk->mountpoint);
+    ffJsonResultAddStrbuf(doc, obj, "filesystem", &disk->filesystem);
+    ffJsonResultAddStrbuf(doc, obj, "name", &disk->name);
+
+    yyjson_mut_val* type = ffJsonResultAddArr(doc, obj, "type");
+    if(disk->type & FF_DISK_TYPE_REGULAR_BIT) yyjson_mut_arr_append(type, yyjson_mut_str(doc, "regular"));
+    if(disk->type & FF_DISK_TYPE_HIDDEN_BIT) yyjson_mut_arr_append(type, yyjson_mut_str(doc, "hidden"));
+    if(disk->type & FF_DISK_TYPE_EXTERNAL_BIT) yyjson_mut_arr_append(type, yyjson_mut_str(doc, "external"));
+    if(disk->type & FF_DISK_TYPE_SUBVOLUME_BIT) yyjson_mut_arr_append(type, yyjson_mut_str(doc, "subvolume"));
+    if(disk->type & FF_DISK_TYPE_UNKNOWN_BIT) yyjson_mut_arr_append(type, yyjson_mut_str(doc, "unknown"));
+
+    yyjson_mut_val* bytes = ffJsonResultAddObj(doc, obj, "bytes");
+    yyjson_mut_obj_add_uint(doc, bytes, "used", disk->bytesUsed);
+    yyjson_mut_obj_add_uint(doc, bytes, "total", disk->bytesTotal);
+    yyjson_mut_val* files = ffJsonResultAddObj(doc, obj, "files");
+    yyjson_mut_obj_add_uint(doc, files, "used", disk->filesUsed);
+    yyjson_mut_obj_add_uint(doc, files, "total", disk->filesTotal);
+}
+
+typedef struct FFDiskJsonData
+{
+    yyjson_mut_doc* doc;
+    yyjson_mut_val* arr;
+} FFDiskJsonData;
+
+static void addMountpointJson(FF_MAYBE_UNUSED FFDiskOptions* options, FF_MAYBE_UNUSED const char* mountpoint, const FFDisk* disk, void* data)
+{
+    FFDiskJsonData* jsonData = data;
+    if(disk)
+        addDiskJson(jsonData->doc, jsonData->arr, disk);
+}
+
+// Contains the disks that would be printed
+void ffGenerateDiskJsonResult(FFDiskOptions* options, FFlist* disks, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    if(options->folders.length == 0)
     {
-        if(options->folders.length == 0)
-            printAutodetected(options, &disks);
-        else
-            printMountpoints(options, &disks);
+        FF_LIST_FOR_EACH(FFDisk, disk, *disks)
+        {
+            if(disk->type & options->showTypes)
+                addDiskJson(doc, arr, disk);
+        }
     }
+    else
+        forEachMountpoint(options, disks, addMountpointJson, &(FFDiskJsonData) { doc, arr });
+}
 
-    FF_LIST_FOR_EACH(FFDisk, disk, disks)
+void ffDestroyDiskModuleResult(FFlist* disks)
+{
+    FF_LIST_FOR_EACH(FFDisk, disk, *disks)
     {
         ffStrbufDestroy(&disk->mountpoint);
         ffStrbufDestroy(&disk->filesystem);
         ffStrbufDestroy(&disk->name);
     }
+    ffListDestroy(disks);
 }
 
+void ffPrintDisk(FFDiskOptions* options)
+{
+    FFlist disks;
+    const char* error = ffDetectDiskModule(options, &disks);
+
+    if(error)
+        ffPrintError(FF_DISK_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderDiskModule(options, &disks);
+
+    ffDestroyDiskModuleResult(&disks);
+}
 
 void ffInitDiskOptions(FFDiskOptions* options)
 {
@@ -242,13 +314,11 @@ bool ffParseDiskCommandOptions(FFDiskOptions* options, const char* key, const ch
 void ffDestroyDiskOptions(FFDiskOptions* options)
 {
     ffOptionDestroyModuleArg(&options->moduleArgs);
+    ffStrbufDestroy(&options->folders);
 }
 
-void ffParseDiskJsonObject(yyjson_val* module)
+void ffParseDiskJsonObject(FFDiskOptions* options, yyjson_val* module)
 {
-    FFDiskOptions __attribute__((__cleanup__(ffDestroyDiskOptions))) options;
-    ffInitDiskOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -259,54 +329,52 @@ void ffParseDiskJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             if (ffStrEqualsIgnCase(key, "folders"))
             {
-                ffStrbufSetS(&options.folders, yyjson_get_str(val));
+                ffStrbufSetS(&options->folders, yyjson_get_str(val));
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "showExternal"))
             {
                 if (yyjson_get_bool(val))
-                    options.showTypes |= FF_DISK_TYPE_EXTERNAL_BIT;
+                    options->showTypes |= FF_DISK_TYPE_EXTERNAL_BIT;
                 else
-                    options.showTypes &= ~FF_DISK_TYPE_EXTERNAL_BIT;
+                    options->showTypes &= ~FF_DISK_TYPE_EXTERNAL_BIT;
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "showHidden"))
             {
                 if (yyjson_get_bool(val))
-                    options.showTypes |= FF_DISK_TYPE_HIDDEN_BIT;
+                    options->showTypes |= FF_DISK_TYPE_HIDDEN_BIT;
                 else
-                    options.showTypes &= ~FF_DISK_TYPE_HIDDEN_BIT;
+                    options->showTypes &= ~FF_DISK_TYPE_HIDDEN_BIT;
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "showSubvolumes"))
             {
                 if (yyjson_get_bool(val))
-                    options.showTypes |= FF_DISK_TYPE_SUBVOLUME_BIT;
+                    options->showTypes |= FF_DISK_TYPE_SUBVOLUME_BIT;
                 else
-                    options.showTypes &= ~FF_DISK_TYPE_SUBVOLUME_BIT;
+                    options->showTypes &= ~FF_DISK_TYPE_SUBVOLUME_BIT;
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "showUnknown"))
             {
                 if (yyjson_get_bool(val))
-                    options.showTypes |= FF_DISK_TYPE_UNKNOWN_BIT;
+                    options->showTypes |= FF_DISK_TYPE_UNKNOWN_BIT;
                 else
-                    options.showTypes &= ~FF_DISK_TYPE_UNKNOWN_BIT;
+                    options->showTypes &= ~FF_DISK_TYPE_UNKNOWN_BIT;
                 continue;
             }
 
-            ffPrintError(FF_DISK_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_DISK_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintDisk(&options);
 }
@@ -5,7 +5,11 @@
 #define FF_DISK_MODULE_NAME "Disk"
 
 void ffPrintDisk(FFDiskOptions* options);
+const char* ffDetectDiskModule(FFDiskOptions* options, FFlist* disks /* FFDisk */);
+void ffRenderDiskModule(FFDiskOptions* options, FFlist* disks);
+void ffGenerateDiskJsonResult(FFDiskOptions* options, FFlist* disks, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyDiskModuleResult(FFlist* disks);
 void ffInitDiskOptions(FFDiskOptions* options);
 bool ffParseDiskCommandOptions(FFDiskOptions* options, const char* key, const char* value);
 void ffDestroyDiskOptions(FFDiskOptions* options);
-void ffParseDiskJsonObject(yyjson_val* module);
+void ffParseDiskJsonObject(FFDiskOptions* options, yyjson_val* module);
@@ -1,25 +1,30 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/displayserver/displayserver.h"
 #include "modules/display/display.h"
 #include "util/stringUtils.h"
 
 #define FF_DISPLAY_NUM_FORMAT_ARGS 8
 
-void ffPrintDisplay(FFDisplayOptions* options)
+const char* ffDetectDisplayModule(FF_MAYBE_UNUSED FFDisplayOptions* options, const FFDisplayServerResult** result)
 {
     #ifdef __ANDROID__
-        ffPrintError(FF_DISPLAY_MODULE_NAME, 0, &instance.config.display.moduleArgs, "Display detection is not supported on Android");
-        return;
+        *result = NULL;
+        return "Display detection is not supported on Android";
     #endif
 
-    const FFDisplayServerResult* dsResult = ffConnectDisplayServer();
+    *result = ffConnectDisplayServer();
 
-    if(dsResult->displays.length == 0)
-    {
-        ffPrintError(FF_DISPLAY_MODULE_NAME, 0, &instance.config.display.moduleArgs, "Couldn't detect display");
-        return;
-    }
+    if((*result)->displays.length == 0)
+        return "Couldn't detect display";
+
+    return NULL;
+}
+
+void ffRenderDisplayModule(FFDisplayOptions* options, const FFDisplayServerResult** pResult)
+{
+    const FFDisplayServerResult* dsResult = *pResult;
 
     if (options->compactType != FF_DISPLAY_COMPACT_TYPE_NONE)
     {
@@ -66,7 +71,7 @@ void ffPrintDisplay(FFDisplayOptions* options)
             }
             else
             {
-                ffParseFormatString(&key, &options->moduleArgs.key, 1, (FFformatarg[]){
+                ffFormatProgramRun(&key, &options->moduleArgs.keyProgram, 1, (FFformatarg[]){
                     {FF_FORMAT_ARG_TYPE_UINT, &i},
                     {FF_FORMAT_ARG_TYPE_STRBUF, &result->name},
                     {FF_FORMAT_ARG_TYPE_STRING, displayType},
@@ -111,6 +116,39 @@ void ffPrintDisplay(FFDisplayOptions* options)
     }
 }
 
+void ffGenerateDisplayJsonResult(FF_MAYBE_UNUSED FFDisplayOptions* options, const FFDisplayServerResult** result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(FFDisplayResult, display, (*result)->displays)
+    {
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+        ffJsonResultAddStrbuf(doc, obj, "name", &display->name);
+        yyjson_mut_obj_add_uint(doc, obj, "id", display->id);
+        yyjson_mut_obj_add_uint(doc, obj, "width", display->width);
+        yyjson_mut_obj_add_uint(doc, obj, "height", display->height);
+        yyjson_mut_obj_add_uint(doc, obj, "scaledWidth", display->scaledWidth);
+        yyjson_mut_obj_add_uint(doc, obj, "scaledHeight", display->scaledHeight);
+        ffJsonResultAddDouble(doc, obj, "refreshRate", display->refreshRate);
+        yyjson_mut_obj_add_uint(doc, obj, "rotation", display->rotation);
+        yyjson_mut_obj_add_str(doc, obj, "type",
+            display->type == FF_DISPLAY_TYPE_BUILTIN ? "builtin" :
+            display->type == FF_DISPLAY_TYPE_EXTERNAL ? "external" :
+            "unknown");
+        yyjson_mut_obj_add_bool(doc, obj, "primary", display->primary);
+    }
+}
+
+void ffPrintDisplay(FFDisplayOptions* options)
+{
+    const FFDisplayServerResult* result;
+    const char* error = ffDetectDisplayModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_DISPLAY_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderDisplayModule(options, &result);
+}
+
 void ffInitDisplayOptions(FFDisplayOptions* options)
 {
     options->moduleName = FF_DISPLAY_MODULE_NAME;
@@ -151,11 +189,8 @@ void ffDestroyDisplayOptions(FFDisplayOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseDisplayJsonObject(yyjson_val* module)
+void ffParseDisplayJsonObject(FFDisplayOptions* options, yyjson_val* module)
 {
-    FFDisplayOptions __attribute__((__cleanup__(ffDestroyDisplayOptions))) options;
-    ffInitDisplayOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -166,7 +201,7 @@ void ffParseDisplayJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             if (ffStrEqualsIgnCase(key, "compactType"))
@@ -179,21 +214,19 @@ void ffParseDisplayJsonObject(yyjson_val* module)
                     {},
                 });
                 if (error)
-                    ffPrintError(FF_DISPLAY_MODULE_NAME, 0, &options.moduleArgs, "Invalid %s value: %s", key, error);
+                    ffPrintError(FF_DISPLAY_MODULE_NAME, 0, &options->moduleArgs, "Invalid %s value: %s", key, error);
                 else
-                    options.compactType = (FFDisplayCompactType) value;
+                    options->compactType = (FFDisplayCompactType) value;
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "preciseRefreshRate"))
             {
-                options.preciseRefreshRate = yyjson_get_bool(val);
+                options->preciseRefreshRate = yyjson_get_bool(val);
                 continue;
             }
 
-            ffPrintError(FF_DISPLAY_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_DISPLAY_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintDisplay(&options);
 }
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/displayserver/displayserver.h"
 
 #define FF_DISPLAY_MODULE_NAME "Display"
 
 void ffPrintDisplay(FFDisplayOptions* options);
+const char* ffDetectDisplayModule(FFDisplayOptions* options, const FFDisplayServerResult** result);
+void ffRenderDisplayModule(FFDisplayOptions* options, const FFDisplayServerResult** result);
+void ffGenerateDisplayJsonResult(FFDisplayOptions* options, const FFDisplayServerResult** result, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitDisplayOptions(FFDisplayOptions* options);
 bool ffParseDisplayCommandOptions(FFDisplayOptions* options, const char* key, const char* value);
 void ffDestroyDisplayOptions(FFDisplayOptions* options);
-void ffParseDisplayJsonObject(yyjson_val* module);
+void ffParseDisplayJsonObject(FFDisplayOptions* options, yyjson_val* module);
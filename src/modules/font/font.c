@@ -1,46 +1,67 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/font/font.h"
 #include "modules/font/font.h"
 #include "util/stringUtils.h"
 
 #define FF_FONT_NUM_FORMAT_ARGS (FF_DETECT_FONT_NUM_FONTS + 1)
 
-void ffPrintFont(FFFontOptions* options)
+const char* ffDetectFontModule(FF_MAYBE_UNUSED FFFontOptions* options, FFFontResult* font)
 {
-    FFFontResult font;
     for(uint32_t i = 0; i < FF_DETECT_FONT_NUM_FONTS; ++i)
-        ffStrbufInit(&font.fonts[i]);
-    ffStrbufInit(&font.display);
+        ffStrbufInit(&font->fonts[i]);
+    ffStrbufInit(&font->display);
 
-    const char* error = ffDetectFont(&font);
+    return ffDetectFont(font);
+}
 
-    if(error)
+void ffRenderFontModule(FFFontOptions* options, FFFontResult* font)
+{
+    if(options->moduleArgs.outputFormat.length == 0)
     {
-        ffPrintError(FF_FONT_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+        ffPrintLogoAndKey(FF_FONT_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
+        ffStrbufPutTo(&font->display, stdout);
     }
     else
     {
-        if(options->moduleArgs.outputFormat.length == 0)
-        {
-            ffPrintLogoAndKey(FF_FONT_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-            ffStrbufPutTo(&font.display, stdout);
-        }
-        else
-        {
-            ffPrintFormat(FF_FONT_MODULE_NAME, 0, &options->moduleArgs, FF_FONT_NUM_FORMAT_ARGS, (FFformatarg[]) {
-                {FF_FORMAT_ARG_TYPE_STRBUF, &font.fonts[0]},
-                {FF_FORMAT_ARG_TYPE_STRBUF, &font.fonts[1]},
-                {FF_FORMAT_ARG_TYPE_STRBUF, &font.fonts[2]},
-                {FF_FORMAT_ARG_TYPE_STRBUF, &font.fonts[3]},
-                {FF_FORMAT_ARG_TYPE_STRBUF, &font.display},
-            });
-        }
+        ffPrintFormat(FF_FONT_MODULE_NAME, 0, &options->moduleArgs, FF_FONT_NUM_FORMAT_ARGS, (FFformatarg[]) {
+            {FF_FORMAT_ARG_TYPE_STRBUF, &font->fonts[0]},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &font->fonts[1]},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &font->fonts[2]},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &font->fonts[3]},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &font->display},
+        });
     }
+}
+
+void ffGenerateFontJsonResult(FF_MAYBE_UNUSED FFFontOptions* options, FFFontResult* font, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    yyjson_mut_val* fonts = ffJsonResultAddArr(doc, obj, "fonts");
+    for(uint32_t i = 0; i < FF_DETECT_FONT_NUM_FONTS; ++i)
+        ffJsonResultAppendStrbuf(doc, fonts, &font->fonts[i]);
+    ffJsonResultAddStrbuf(doc, obj, "display", &font->display);
+}
 
-    ffStrbufDestroy(&font.display);
+void ffDestroyFontModuleResult(FFFontResult* font)
+{
+    ffStrbufDestroy(&font->display);
     for (uint32_t i = 0; i < FF_DETECT_FONT_NUM_FONTS; ++i)
-        ffStrbufDestroy(&font.fonts[i]);
+        ffStrbufDestroy(&font->fonts[i]);
+}
+
+void ffPrintFont(FFFontOptions* options)
+{
+    FFFontResult font;
+    const char* error = ffDetectFontModule(options, &font);
+
+    if(error)
+        ffPrintError(FF_FONT_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderFontModule(options, &font);
+
+    ffDestroyFontModuleResult(&font);
 }
 
 void ffInitFontOptions(FFFontOptions* options)
@@ -64,11 +85,8 @@ void ffDestroyFontOptions(FFFontOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseFontJsonObject(yyjson_val* module)
+void ffParseFontJsonObject(FFFontOptions* options, yyjson_val* module)
 {
-    FFFontOptions __attribute__((__cleanup__(ffDestroyFontOptions))) options;
-    ffInitFontOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -79,12 +97,10 @@ void ffParseFontJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_FONT_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_FONT_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintFont(&options);
 }
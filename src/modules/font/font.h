@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/font/font.h"
 
 #define FF_FONT_MODULE_NAME "Font"
 
 void ffPrintFont(FFFontOptions* options);
+const char* ffDetectFontModule(FFFontOptions* options, FFFontResult* font);
+void ffRenderFontModule(FFFontOptions* options, FFFontResult* font);
+void ffGenerateFontJsonResult(FFFontOptions* options, FFFontResult* font, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyFontModuleResult(FFFontResult* font);
 void ffInitFontOptions(FFFontOptions* options);
 bool ffParseFontCommandOptions(FFFontOptions* options, const char* key, const char* value);
 void ffDestroyFontOptions(FFFontOptions* options);
-void ffParseFontJsonObject(yyjson_val* module);
+void ffParseFontJsonObject(FFFontOptions* options, yyjson_val* module);
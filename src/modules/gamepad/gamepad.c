@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/gamepad/gamepad.h"
 #include "modules/gamepad/gamepad.h"
 #include "util/stringUtils.h"
@@ -22,31 +23,59 @@ static void printDevice(FFGamepadOptions* options, const FFGamepadDevice* device
     }
 }
 
-void ffPrintGamepad(FFGamepadOptions* options)
+const char* ffDetectGamepadModule(FF_MAYBE_UNUSED FFGamepadOptions* options, FFlist* devices)
 {
-    FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFGamepadDevice));
-
-    const char* error = ffDetectGamepad(&result);
+    ffListInit(devices, sizeof(FFGamepadDevice));
 
+    const char* error = ffDetectGamepad(devices);
     if(error)
-    {
-        ffPrintError(FF_GAMEPAD_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+        return error;
+
+    if(!devices->length)
+        return "No devices detected";
+
+    return NULL;
+}
 
-    if(!result.length)
+void ffRenderGamepadModule(FFGamepadOptions* options, FFlist* devices)
+{
+    uint8_t index = 0;
+    FF_LIST_FOR_EACH(FFGamepadDevice, device, *devices)
+        printDevice(options, device, devices->length > 1 ? ++index : 0);
+}
+
+void ffGenerateGamepadJsonResult(FF_MAYBE_UNUSED FFGamepadOptions* options, FFlist* devices, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(FFGamepadDevice, device, *devices)
     {
-        ffPrintError(FF_GAMEPAD_MODULE_NAME, 0, &options->moduleArgs, "No devices detected");
-        return;
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+        ffJsonResultAddStrbuf(doc, obj, "identifier", &device->identifier);
+        ffJsonResultAddStrbuf(doc, obj, "name", &device->name);
     }
+}
 
-    uint8_t index = 0;
-    FF_LIST_FOR_EACH(FFGamepadDevice, device, result)
+void ffDestroyGamepadModuleResult(FFlist* devices)
+{
+    FF_LIST_FOR_EACH(FFGamepadDevice, device, *devices)
     {
-        printDevice(options, device, result.length > 1 ? ++index : 0);
         ffStrbufDestroy(&device->identifier);
         ffStrbufDestroy(&device->name);
     }
+    ffListDestroy(devices);
+}
+
+void ffPrintGamepad(FFGamepadOptions* options)
+{
+    FFlist devices;
+    const char* error = ffDetectGamepadModule(options, &devices);
+
+    if(error)
+        ffPrintError(FF_GAMEPAD_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderGamepadModule(options, &devices);
+
+    ffDestroyGamepadModuleResult(&devices);
 }
 
 void ffInitGamepadOptions(FFGamepadOptions* options)
@@ -70,11 +99,8 @@ void ffDestroyGamepadOptions(FFGamepadOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseGamepadJsonObject(yyjson_val* module)
+void ffParseGamepadJsonObject(FFGamepadOptions* options, yyjson_val* module)
 {
-    FFGamepadOptions __attribute__((__cleanup__(ffDestroyGamepadOptions))) options;
-    ffInitGamepadOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -85,12 +111,10 @@ void ffParseGamepadJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_GAMEPAD_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_GAMEPAD_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintGamepad(&options);
 }
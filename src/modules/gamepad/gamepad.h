@@ -5,7 +5,11 @@
 #define FF_GAMEPAD_MODULE_NAME "Gamepad"
 
 void ffPrintGamepad(FFGamepadOptions* options);
+const char* ffDetectGamepadModule(FFGamepadOptions* options, FFlist* devices /* FFGamepadDevice */);
+void ffRenderGamepadModule(FFGamepadOptions* options, FFlist* devices);
+void ffGenerateGamepadJsonResult(FFGamepadOptions* options, FFlist* devices, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyGamepadModuleResult(FFlist* devices);
 void ffInitGamepadOptions(FFGamepadOptions* options);
 bool ffParseGamepadCommandOptions(FFGamepadOptions* options, const char* key, const char* value);
 void ffDestroyGamepadOptions(FFGamepadOptions* options);
-void ffParseGamepadJsonObject(yyjson_val* module);
+void ffParseGamepadJsonObject(FFGamepadOptions* options, yyjson_val* module);
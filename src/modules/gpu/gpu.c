@@ -2,6 +2,8 @@
 #include "common/parsing.h"
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "common/cache.h"
 #include "detection/host/host.h"
 #include "detection/gpu/gpu.h"
 #include "modules/gpu/gpu.h"
@@ -77,44 +79,129 @@ static void printGPUResult(FFGPUOptions* options, uint8_t index, const FFGPUResu
     }
 }
 
-void ffPrintGPU(FFGPUOptions* options)
+static void destroyGPU(FFGPUResult* gpu)
+{
+    ffStrbufDestroy(&gpu->vendor);
+    ffStrbufDestroy(&gpu->name);
+    ffStrbufDestroy(&gpu->driver);
+}
+
+static const FFCacheSchema gpuCacheSchema = FF_CACHE_SCHEMA(FFGPUResult,
+    offsetof(FFGPUResult, vendor),
+    offsetof(FFGPUResult, name),
+    offsetof(FFGPUResult, driver),
+);
+
+const char* ffDetectGPUModule(FFGPUOptions* options, FFlist* gpus)
 {
-    FF_LIST_AUTO_DESTROY gpus = ffListCreate(sizeof (FFGPUResult));
-    const char* error = ffDetectGPU(options, &gpus);
-    if (error)
+    ffListInit(gpus, sizeof(FFGPUResult));
+
+    // Temperatures and memory usage change all the time
+    FF_STRBUF_AUTO_DESTROY cacheKey = ffStrbufCreate();
+    bool cache = !options->temp && ffCacheKeyInit(&cacheKey, &options->moduleArgs);
+    if(cache)
     {
-        ffPrintError(FF_GPU_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
+        ffStrbufAppendF(&cacheKey, "%d:%d:%d\n", (int) options->forceVulkan, (int) options->hideType, (int) instance.config.allowSlowOperations);
+        if(ffCacheLoadList(FF_GPU_MODULE_NAME, &cacheKey, &gpuCacheSchema, gpus))
+            return NULL;
     }
 
-    FF_LIST_AUTO_DESTROY selectedGPUs;
-    ffListInitA(&selectedGPUs, sizeof(const FFGPUResult*), gpus.length);
+    const char* error = ffDetectGPU(options, gpus);
+    if(error)
+        return error;
 
-    FF_LIST_FOR_EACH(FFGPUResult, gpu, gpus)
+    uint32_t count = 0;
+    FF_LIST_FOR_EACH(FFGPUResult, gpu, *gpus)
     {
-        if(gpu->type == FF_GPU_TYPE_INTEGRATED && options->hideType == FF_GPU_TYPE_INTEGRATED)
+        if(
+            (gpu->type == FF_GPU_TYPE_INTEGRATED && options->hideType == FF_GPU_TYPE_INTEGRATED) ||
+            (gpu->type == FF_GPU_TYPE_DISCRETE && options->hideType == FF_GPU_TYPE_DISCRETE)
+        ) {
+            destroyGPU(gpu);
             continue;
+        }
 
-        if(gpu->type == FF_GPU_TYPE_DISCRETE && options->hideType == FF_GPU_TYPE_DISCRETE)
-            continue;
+        *(FFGPUResult*) ffListGet(gpus, count++) = *gpu;
 
-        * (const FFGPUResult**) ffListAdd(&selectedGPUs) = gpu;
+        if(gpu->dedicated.used != FF_GPU_VMEM_SIZE_UNSET || gpu->shared.used != FF_GPU_VMEM_SIZE_UNSET)
+            cache = false;
     }
+    gpus->length = count;
 
-    for(uint32_t i = 0; i < selectedGPUs.length; i++)
-        printGPUResult(options, selectedGPUs.length == 1 ? 0 : (uint8_t) (i + 1), * (const FFGPUResult**) ffListGet(&selectedGPUs, i));
+    if(gpus->length == 0)
+        return "No GPUs found";
 
-    if(selectedGPUs.length == 0)
-        ffPrintError(FF_GPU_MODULE_NAME, 0, &options->moduleArgs, "No GPUs found");
+    if(cache)
+        ffCacheStoreList(FF_GPU_MODULE_NAME, &cacheKey, &gpuCacheSchema, gpus);
 
-    FF_LIST_FOR_EACH(FFGPUResult, gpu, gpus)
+    return NULL;
+}
+
+void ffRenderGPUModule(FFGPUOptions* options, FFlist* gpus)
+{
+    for(uint32_t i = 0; i < gpus->length; i++)
+        printGPUResult(options, gpus->length == 1 ? 0 : (uint8_t) (i + 1), ffListGet(gpus, i));
+}
+
+static void addMemoryJson(yyjson_mut_doc* doc, yyjson_mut_val* obj, const char* key, const FFGPUMemory* memory)
+{
+    yyjson_mut_val* val = ffJsonResultAddObj(doc, obj, key);
+    if(memory->total == FF_GPU_VMEM_SIZE_UNSET)
+        yyjson_mut_obj_add_null(doc, val, "total");
+    else
+        yyjson_mut_obj_add_uint(doc, val, "total", memory->total);
+    if(memory->used == FF_GPU_VMEM_SIZE_UNSET)
+        yyjson_mut_obj_add_null(doc, val, "used");
+    else
+        yyjson_mut_obj_add_uint(doc, val, "used", memory->used);
+}
+
+void ffGenerateGPUJsonResult(FF_MAYBE_UNUSED FFGPUOptions* options, FFlist* gpus, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(FFGPUResult, gpu, *gpus)
     {
-        ffStrbufDestroy(&gpu->vendor);
-        ffStrbufDestroy(&gpu->name);
-        ffStrbufDestroy(&gpu->driver);
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+        yyjson_mut_obj_add_str(doc, obj, "type",
+            gpu->type == FF_GPU_TYPE_INTEGRATED ? "integrated" :
+            gpu->type == FF_GPU_TYPE_DISCRETE ? "discrete" :
+            "unknown");
+        ffJsonResultAddStrbuf(doc, obj, "vendor", &gpu->vendor);
+        ffJsonResultAddStrbuf(doc, obj, "name", &gpu->name);
+        ffJsonResultAddStrbuf(doc, obj, "driver", &gpu->driver);
+        ffJsonResultAddDouble(doc, obj, "temperature", gpu->temperature);
+
+        if(gpu->coreCount == FF_GPU_CORE_COUNT_UNSET)
+            yyjson_mut_obj_add_null(doc, obj, "coreCount");
+        else
+            yyjson_mut_obj_add_int(doc, obj, "coreCount", gpu->coreCount);
+
+        yyjson_mut_val* memory = ffJsonResultAddObj(doc, obj, "memory");
+        addMemoryJson(doc, memory, "dedicated", &gpu->dedicated);
+        addMemoryJson(doc, memory, "shared", &gpu->shared);
     }
 }
 
+void ffDestroyGPUModuleResult(FFlist* gpus)
+{
+    FF_LIST_FOR_EACH(FFGPUResult, gpu, *gpus)
+        destroyGPU(gpu);
+    ffListDestroy(gpus);
+}
+
+void ffPrintGPU(FFGPUOptions* options)
+{
+    FFlist gpus;
+    const char* error = ffDetectGPUModule(options, &gpus);
+
+    if(error)
+        ffPrintError(FF_GPU_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderGPUModule(options, &gpus);
+
+    ffDestroyGPUModuleResult(&gpus);
+}
+
 void ffInitGPUOptions(FFGPUOptions* options)
 {
     options->moduleName = FF_GPU_MODULE_NAME;
@@ -162,11 +249,8 @@ void ffDestroyGPUOptions(FFGPUOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseGPUJsonObject(yyjson_val* module)
+void ffParseGPUJsonObject(FFGPUOptions* options, yyjson_val* module)
 {
-    FFGPUOptions __attribute__((__cleanup__(ffDestroyGPUOptions))) options;
-    ffInitGPUOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -177,18 +261,18 @@ void ffParseGPUJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             if (ffStrEqualsIgnCase(key, "temp"))
             {
-                options.temp = yyjson_get_bool(val);
+                options->temp = yyjson_get_bool(val);
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "forceVulkan"))
             {
-                options.forceVulkan = yyjson_get_bool(val);
+                options->forceVulkan = yyjson_get_bool(val);
                 continue;
             }
 
@@ -202,15 +286,13 @@ void ffParseGPUJsonObject(yyjson_val* module)
                     {},
                 });
                 if (error)
-                    ffPrintError(FF_GPU_MODULE_NAME, 0, &options.moduleArgs, "Invalid %s value: %s", key, error);
+                    ffPrintError(FF_GPU_MODULE_NAME, 0, &options->moduleArgs, "Invalid %s value: %s", key, error);
                 else
-                    options.hideType = (FFGPUType) value;
+                    options->hideType = (FFGPUType) value;
                 continue;
             }
 
-            ffPrintError(FF_GPU_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_GPU_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintGPU(&options);
 }
@@ -5,7 +5,11 @@
 #define FF_GPU_MODULE_NAME "GPU"
 
 void ffPrintGPU(FFGPUOptions* options);
+const char* ffDetectGPUModule(FFGPUOptions* options, FFlist* gpus /* FFGPUResult */);
+void ffRenderGPUModule(FFGPUOptions* options, FFlist* gpus);
+void ffGenerateGPUJsonResult(FFGPUOptions* options, FFlist* gpus, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyGPUModuleResult(FFlist* gpus);
 void ffInitGPUOptions(FFGPUOptions* options);
 bool ffParseGPUCommandOptions(FFGPUOptions* options, const char* key, const char* value);
 void ffDestroyGPUOptions(FFGPUOptions* options);
-void ffParseGPUJsonObject(yyjson_val* module);
+void ffParseGPUJsonObject(FFGPUOptions* options, yyjson_val* module);
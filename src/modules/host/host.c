@@ -1,47 +1,63 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "common/cache.h"
 #include "detection/host/host.h"
 #include "modules/host/host.h"
 #include "util/stringUtils.h"
 
 #define FF_HOST_NUM_FORMAT_ARGS 5
 
-void ffPrintHost(FFHostOptions* options)
-{
-    FFHostResult host;
-    ffStrbufInit(&host.productFamily);
-    ffStrbufInit(&host.productName);
-    ffStrbufInit(&host.productVersion);
-    ffStrbufInit(&host.productSku);
-    ffStrbufInit(&host.sysVendor);
-    const char* error = ffDetectHost(&host);
+static const FFCacheSchema hostCacheSchema = FF_CACHE_SCHEMA(FFHostResult,
+    offsetof(FFHostResult, productFamily),
+    offsetof(FFHostResult, productName),
+    offsetof(FFHostResult, productVersion),
+    offsetof(FFHostResult, productSku),
+    offsetof(FFHostResult, sysVendor),
+);
 
+const char* ffDetectHostModule(FFHostOptions* options, FFHostResult* host)
+{
+    FF_STRBUF_AUTO_DESTROY cacheKey = ffStrbufCreate();
+    bool cache = ffCacheKeyInit(&cacheKey, &options->moduleArgs);
+    if(cache && ffCacheLoad(FF_HOST_MODULE_NAME, &cacheKey, &hostCacheSchema, host))
+        return NULL;
+
+    ffStrbufInit(&host->productFamily);
+    ffStrbufInit(&host->productName);
+    ffStrbufInit(&host->productVersion);
+    ffStrbufInit(&host->productSku);
+    ffStrbufInit(&host->sysVendor);
+
+    const char* error = ffDetectHost(host);
     if(error)
-    {
-        ffPrintError(FF_HOST_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        goto exit;
-    }
+        return error;
 
-    if(host.productFamily.length == 0 && host.productName.length == 0)
-    {
-        ffPrintError(FF_HOST_MODULE_NAME, 0, &options->moduleArgs, "neither product_family nor product_name is set by O.E.M.");
-        goto exit;
-    }
+    if(host->productFamily.length == 0 && host->productName.length == 0)
+        return "neither product_family nor product_name is set by O.E.M.";
+
+    if(cache)
+        ffCacheStore(FF_HOST_MODULE_NAME, &cacheKey, &hostCacheSchema, host);
+
+    return NULL;
+}
 
+void ffRenderHostModule(FFHostOptions* options, FFHostResult* host)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_HOST_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
 
         FF_STRBUF_AUTO_DESTROY output = ffStrbufCreate();
 
-        if(host.productName.length > 0)
-            ffStrbufAppend(&output, &host.productName);
+        if(host->productName.length > 0)
+            ffStrbufAppend(&output, &host->productName);
         else
-            ffStrbufAppend(&output, &host.productFamily);
+            ffStrbufAppend(&output, &host->productFamily);
 
-        if(host.productVersion.length > 0 && !ffStrbufIgnCaseEqualS(&host.productVersion, "none"))
+        if(host->productVersion.length > 0 && !ffStrbufIgnCaseEqualS(&host->productVersion, "none"))
         {
-            ffStrbufAppendF(&output, " (%s)", host.productVersion.chars);
+            ffStrbufAppendF(&output, " (%s)", host->productVersion.chars);
         }
 
         ffStrbufPutTo(&output, stdout);
@@ -49,20 +65,45 @@ void ffPrintHost(FFHostOptions* options)
     else
     {
         ffPrintFormat(FF_HOST_MODULE_NAME, 0, &options->moduleArgs, FF_HOST_NUM_FORMAT_ARGS, (FFformatarg[]) {
-            {FF_FORMAT_ARG_TYPE_STRBUF, &host.productFamily},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &host.productName},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &host.productVersion},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &host.productSku},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &host.sysVendor}
+            {FF_FORMAT_ARG_TYPE_STRBUF, &host->productFamily},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &host->productName},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &host->productVersion},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &host->productSku},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &host->sysVendor}
         });
     }
+}
+
+void ffGenerateHostJsonResult(FF_MAYBE_UNUSED FFHostOptions* options, FFHostResult* host, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "family", &host->productFamily);
+    ffJsonResultAddStrbuf(doc, obj, "name", &host->productName);
+    ffJsonResultAddStrbuf(doc, obj, "version", &host->productVersion);
+    ffJsonResultAddStrbuf(doc, obj, "sku", &host->productSku);
+    ffJsonResultAddStrbuf(doc, obj, "vendor", &host->sysVendor);
+}
 
-exit:
-    ffStrbufDestroy(&host.productFamily);
-    ffStrbufDestroy(&host.productName);
-    ffStrbufDestroy(&host.productVersion);
-    ffStrbufDestroy(&host.productSku);
-    ffStrbufDestroy(&host.sysVendor);
+void ffDestroyHostModuleResult(FFHostResult* host)
+{
+    ffStrbufDestroy(&host->productFamily);
+    ffStrbufDestroy(&host->productName);
+    ffStrbufDestroy(&host->productVersion);
+    ffStrbufDestroy(&host->productSku);
+    ffStrbufDestroy(&host->sysVendor);
+}
+
+void ffPrintHost(FFHostOptions* options)
+{
+    FFHostResult host;
+    const char* error = ffDetectHostModule(options, &host);
+
+    if(error)
+        ffPrintError(FF_HOST_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderHostModule(options, &host);
+
+    ffDestroyHostModuleResult(&host);
 }
 
 void ffInitHostOptions(FFHostOptions* options)
@@ -86,11 +127,8 @@ void ffDestroyHostOptions(FFHostOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseHostJsonObject(yyjson_val* module)
+void ffParseHostJsonObject(FFHostOptions* options, yyjson_val* module)
 {
-    FFHostOptions __attribute__((__cleanup__(ffDestroyHostOptions))) options;
-    ffInitHostOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -101,12 +139,10 @@ void ffParseHostJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_HOST_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_HOST_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintHost(&options);
 }
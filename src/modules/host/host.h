@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/host/host.h"
 
 #define FF_HOST_MODULE_NAME "Host"
 
 void ffPrintHost(FFHostOptions* options);
+const char* ffDetectHostModule(FFHostOptions* options, FFHostResult* host);
+void ffRenderHostModule(FFHostOptions* options, FFHostResult* host);
+void ffGenerateHostJsonResult(FFHostOptions* options, FFHostResult* host, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyHostModuleResult(FFHostResult* host);
 void ffInitHostOptions(FFHostOptions* options);
 bool ffParseHostCommandOptions(FFHostOptions* options, const char* key, const char* value);
 void ffDestroyHostOptions(FFHostOptions* options);
-void ffParseHostJsonObject(yyjson_val* module);
+void ffParseHostJsonObject(FFHostOptions* options, yyjson_val* module);
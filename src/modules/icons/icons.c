@@ -1,35 +1,56 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/icons/icons.h"
 #include "modules/icons/icons.h"
 #include "util/stringUtils.h"
 
 #define FF_ICONS_NUM_FORMAT_ARGS 1
 
-void ffPrintIcons(FFIconsOptions* options)
+const char* ffDetectIconsModule(FF_MAYBE_UNUSED FFIconsOptions* options, FFstrbuf* icons)
 {
-    FF_STRBUF_AUTO_DESTROY icons = ffStrbufCreate();
-    const char* error = ffDetectIcons(&icons);
-
-    if(error)
-    {
-        ffPrintError(FF_ICONS_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+    ffStrbufInit(icons);
+    return ffDetectIcons(icons);
+}
 
+void ffRenderIconsModule(FFIconsOptions* options, FFstrbuf* icons)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_ICONS_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        ffStrbufPutTo(&icons, stdout);
+        ffStrbufPutTo(icons, stdout);
     }
     else
     {
         ffPrintFormat(FF_ICONS_MODULE_NAME, 0, &options->moduleArgs, FF_ICONS_NUM_FORMAT_ARGS, (FFformatarg[]){
-            {FF_FORMAT_ARG_TYPE_STRBUF, &icons}
+            {FF_FORMAT_ARG_TYPE_STRBUF, icons}
         });
     }
 }
 
+void ffGenerateIconsJsonResult(FF_MAYBE_UNUSED FFIconsOptions* options, FFstrbuf* icons, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    ffJsonResultAddStrbuf(doc, module, "result", icons);
+}
+
+void ffDestroyIconsModuleResult(FFstrbuf* icons)
+{
+    ffStrbufDestroy(icons);
+}
+
+void ffPrintIcons(FFIconsOptions* options)
+{
+    FFstrbuf icons;
+    const char* error = ffDetectIconsModule(options, &icons);
+
+    if(error)
+        ffPrintError(FF_ICONS_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderIconsModule(options, &icons);
+
+    ffDestroyIconsModuleResult(&icons);
+}
+
 void ffInitIconsOptions(FFIconsOptions* options)
 {
     options->moduleName = FF_ICONS_MODULE_NAME;
@@ -51,11 +72,8 @@ void ffDestroyIconsOptions(FFIconsOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseIconsJsonObject(yyjson_val* module)
+void ffParseIconsJsonObject(FFIconsOptions* options, yyjson_val* module)
 {
-    FFIconsOptions __attribute__((__cleanup__(ffDestroyIconsOptions))) options;
-    ffInitIconsOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -66,12 +84,10 @@ void ffParseIconsJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_ICONS_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_ICONS_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintIcons(&options);
 }
@@ -5,7 +5,11 @@
 #define FF_ICONS_MODULE_NAME "Icons"
 
 void ffPrintIcons(FFIconsOptions* options);
+const char* ffDetectIconsModule(FFIconsOptions* options, FFstrbuf* icons);
+void ffRenderIconsModule(FFIconsOptions* options, FFstrbuf* icons);
+void ffGenerateIconsJsonResult(FFIconsOptions* options, FFstrbuf* icons, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyIconsModuleResult(FFstrbuf* icons);
 void ffInitIconsOptions(FFIconsOptions* options);
 bool ffParseIconsCommandOptions(FFIconsOptions* options, const char* key, const char* value);
 void ffDestroyIconsOptions(FFIconsOptions* options);
-void ffParseIconsJsonObject(yyjson_val* module);
+void ffParseIconsJsonObject(FFIconsOptions* options, yyjson_val* module);
@@ -1,20 +1,83 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "common/parsing.h"
+#include "common/root.h"
+#include "common/io/io.h"
 #include "modules/kernel/kernel.h"
 #include "util/stringUtils.h"
 
+#include <stdio.h>
+
+#ifndef _WIN32
+    #include <dirent.h>
+    #include <fcntl.h>
+#endif
+
 #define FF_KERNEL_NUM_FORMAT_ARGS 4
 
+#ifndef _WIN32
+
+static int compareReleases(const char* release1, const char* release2)
+{
+    FFVersion version1 = FF_VERSION_INIT, version2 = FF_VERSION_INIT;
+    sscanf(release1, "%u.%u.%u", &version1.major, &version1.minor, &version1.patch);
+    sscanf(release2, "%u.%u.%u", &version2.major, &version2.minor, &version2.patch);
+    int result = ffVersionCompare(&version1, &version2);
+    return result != 0 ? result : strcmp(release1, release2);
+}
+
+static bool findNewestRelease(void* data, int dirfd, const char* name, unsigned char type)
+{
+    FF_UNUSED(dirfd);
+    FFstrbuf* newest = data;
+    if(type == DT_DIR && (newest->length == 0 || compareReleases(name, newest->chars) > 0))
+        ffStrbufSetS(newest, name);
+    return true;
+}
+
+#endif
+
+// With `--root`, the running kernel says nothing about the root. The newest kernel with modules installed in it is used instead;
+// its version string is unknown
+static const char* getKernel(FFstrbuf* release, FFstrbuf* version)
+{
+    #ifndef _WIN32
+    if(instance.config.root.length > 0)
+    {
+        FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+        ffRootPathSet(&path, "/lib/modules");
+        ffDirForEachEntry(AT_FDCWD, path.chars, findNewestRelease, release);
+        ffRootPathSet(&path, "/usr/lib/modules");
+        ffDirForEachEntry(AT_FDCWD, path.chars, findNewestRelease, release);
+        return release->length > 0 ? NULL : "No kernel modules found in the root";
+    }
+    #endif
+
+    ffStrbufSet(release, &instance.state.platform.systemRelease);
+    ffStrbufSet(version, &instance.state.platform.systemVersion);
+    return NULL;
+}
+
 void ffPrintKernel(FFKernelOptions* options)
 {
+    FF_STRBUF_AUTO_DESTROY release = ffStrbufCreate();
+    FF_STRBUF_AUTO_DESTROY version = ffStrbufCreate();
+    const char* error = getKernel(&release, &version);
+    if(error)
+    {
+        ffPrintError(FF_KERNEL_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+        return;
+    }
+
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_KERNEL_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        ffStrbufWriteTo(&instance.state.platform.systemRelease, stdout);
+        ffStrbufWriteTo(&release, stdout);
 
         #ifdef _WIN32
-            if(instance.state.platform.systemVersion.length > 0)
-                printf(" (%s)", instance.state.platform.systemVersion.chars);
+            if(version.length > 0)
+                printf(" (%s)", version.chars);
         #endif
 
         putchar('\n');
@@ -23,13 +86,31 @@ void ffPrintKernel(FFKernelOptions* options)
     {
         ffPrintFormat(FF_KERNEL_MODULE_NAME, 0, &options->moduleArgs, FF_KERNEL_NUM_FORMAT_ARGS, (FFformatarg[]){
             {FF_FORMAT_ARG_TYPE_STRBUF, &instance.state.platform.systemName},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &instance.state.platform.systemRelease},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &instance.state.platform.systemVersion},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &release},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &version},
             {FF_FORMAT_ARG_TYPE_STRBUF, &instance.state.platform.systemArchitecture}
         });
     }
 }
 
+void ffGenerateKernelJsonResult(FF_MAYBE_UNUSED FFKernelOptions* options, FF_MAYBE_UNUSED void* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    FF_STRBUF_AUTO_DESTROY release = ffStrbufCreate();
+    FF_STRBUF_AUTO_DESTROY version = ffStrbufCreate();
+    const char* error = getKernel(&release, &version);
+    if(error)
+    {
+        yyjson_mut_obj_add_str(doc, module, "error", error);
+        return;
+    }
+
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "name", &instance.state.platform.systemName);
+    ffJsonResultAddStrbuf(doc, obj, "release", &release);
+    ffJsonResultAddStrbuf(doc, obj, "version", &version);
+    ffJsonResultAddStrbuf(doc, obj, "architecture", &instance.state.platform.systemArchitecture);
+}
+
 void ffInitKernelOptions(FFKernelOptions* options)
 {
     options->moduleName = FF_KERNEL_MODULE_NAME;
@@ -51,11 +132,8 @@ void ffDestroyKernelOptions(FFKernelOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseKernelJsonObject(yyjson_val* module)
+void ffParseKernelJsonObject(FFKernelOptions* options, yyjson_val* module)
 {
-    FFKernelOptions __attribute__((__cleanup__(ffDestroyKernelOptions))) options;
-    ffInitKernelOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -66,12 +144,10 @@ void ffParseKernelJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_KERNEL_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_KERNEL_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintKernel(&options);
 }
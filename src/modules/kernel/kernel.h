@@ -5,7 +5,8 @@
 #define FF_KERNEL_MODULE_NAME "Kernel"
 
 void ffPrintKernel(FFKernelOptions* options);
+void ffGenerateKernelJsonResult(FFKernelOptions* options, void* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitKernelOptions(FFKernelOptions* options);
 bool ffParseKernelCommandOptions(FFKernelOptions* options, const char* key, const char* value);
 void ffDestroyKernelOptions(FFKernelOptions* options);
-void ffParseKernelJsonObject(yyjson_val* module);
+void ffParseKernelJsonObject(FFKernelOptions* options, yyjson_val* module);
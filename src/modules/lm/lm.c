@@ -1,52 +1,76 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/lm/lm.h"
 #include "modules/lm/lm.h"
 #include "util/stringUtils.h"
 
 #define FF_LM_NUM_FORMAT_ARGS 3
 
-void ffPrintLM(FFLMOptions* options)
+const char* ffDetectLMModule(FF_MAYBE_UNUSED FFLMOptions* options, FFLMResult* result)
 {
-    FFLMResult result;
-    ffStrbufInit(&result.service);
-    ffStrbufInit(&result.type);
-    ffStrbufInit(&result.version);
-    const char* error = ffDetectLM(&result);
+    ffStrbufInit(&result->service);
+    ffStrbufInit(&result->type);
+    ffStrbufInit(&result->version);
 
+    const char* error = ffDetectLM(result);
     if(error)
-    {
-        ffPrintError(FF_LM_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+        return error;
 
-    if(result.service.length == 0)
-    {
-        ffPrintError(FF_LM_MODULE_NAME, 0, &options->moduleArgs, "No LM service found");
-        return;
-    }
+    if(result->service.length == 0)
+        return "No LM service found";
 
+    return NULL;
+}
+
+void ffRenderLMModule(FFLMOptions* options, FFLMResult* result)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_LM_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        ffStrbufWriteTo(&result.service, stdout);
-        if(result.version.length)
-            printf(" %s", result.version.chars);
-        if(result.type.length)
-            printf(" (%s)", result.type.chars);
+        ffStrbufWriteTo(&result->service, stdout);
+        if(result->version.length)
+            printf(" %s", result->version.chars);
+        if(result->type.length)
+            printf(" (%s)", result->type.chars);
         putchar('\n');
     }
     else
     {
         ffPrintFormat(FF_LM_MODULE_NAME, 0, &options->moduleArgs, FF_LM_NUM_FORMAT_ARGS, (FFformatarg[]){
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.service},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.type},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.version},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->service},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->type},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->version},
         });
     }
-    ffStrbufDestroy(&result.service);
-    ffStrbufDestroy(&result.type);
-    ffStrbufDestroy(&result.version);
+}
+
+void ffGenerateLMJsonResult(FF_MAYBE_UNUSED FFLMOptions* options, FFLMResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "service", &result->service);
+    ffJsonResultAddStrbuf(doc, obj, "type", &result->type);
+    ffJsonResultAddStrbuf(doc, obj, "version", &result->version);
+}
+
+void ffDestroyLMModuleResult(FFLMResult* result)
+{
+    ffStrbufDestroy(&result->service);
+    ffStrbufDestroy(&result->type);
+    ffStrbufDestroy(&result->version);
+}
+
+void ffPrintLM(FFLMOptions* options)
+{
+    FFLMResult result;
+    const char* error = ffDetectLMModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_LM_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderLMModule(options, &result);
+
+    ffDestroyLMModuleResult(&result);
 }
 
 void ffInitLMOptions(FFLMOptions* options)
@@ -70,11 +94,8 @@ void ffDestroyLMOptions(FFLMOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseLMJsonObject(yyjson_val* module)
+void ffParseLMJsonObject(FFLMOptions* options, yyjson_val* module)
 {
-    FFLMOptions __attribute__((__cleanup__(ffDestroyLMOptions))) options;
-    ffInitLMOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -85,12 +106,10 @@ void ffParseLMJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_LM_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_LM_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintLM(&options);
 }
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/lm/lm.h"
 
 #define FF_LM_MODULE_NAME "LM"
 
 void ffPrintLM(FFLMOptions* options);
+const char* ffDetectLMModule(FFLMOptions* options, FFLMResult* result);
+void ffRenderLMModule(FFLMOptions* options, FFLMResult* result);
+void ffGenerateLMJsonResult(FFLMOptions* options, FFLMResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyLMModuleResult(FFLMResult* result);
 void ffInitLMOptions(FFLMOptions* options);
 bool ffParseLMCommandOptions(FFLMOptions* options, const char* key, const char* value);
 void ffDestroyLMOptions(FFLMOptions* options);
-void ffParseLMJsonObject(yyjson_val* module);
+void ffParseLMJsonObject(FFLMOptions* options, yyjson_val* module);
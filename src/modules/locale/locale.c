@@ -1,35 +1,61 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/locale/locale.h"
 #include "modules/locale/locale.h"
 #include "util/stringUtils.h"
 
 #define FF_LOCALE_NUM_FORMAT_ARGS 1
 
-void ffPrintLocale(FFLocaleOptions* options)
+const char* ffDetectLocaleModule(FF_MAYBE_UNUSED FFLocaleOptions* options, FFstrbuf* locale)
 {
-    FF_STRBUF_AUTO_DESTROY locale = ffStrbufCreate();
+    ffStrbufInit(locale);
 
-    ffDetectLocale(&locale);
-    if(locale.length == 0)
-    {
-        ffPrintError(FF_LOCALE_MODULE_NAME, 0, &options->moduleArgs, "No locale found");
-        return;
-    }
+    ffDetectLocale(locale);
+    if(locale->length == 0)
+        return "No locale found";
 
+    return NULL;
+}
+
+void ffRenderLocaleModule(FFLocaleOptions* options, FFstrbuf* locale)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_LOCALE_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        ffStrbufPutTo(&locale, stdout);
+        ffStrbufPutTo(locale, stdout);
     }
     else
     {
         ffPrintFormat(FF_LOCALE_MODULE_NAME, 0, &options->moduleArgs, FF_LOCALE_NUM_FORMAT_ARGS, (FFformatarg[]){
-            {FF_FORMAT_ARG_TYPE_STRBUF, &locale}
+            {FF_FORMAT_ARG_TYPE_STRBUF, locale}
         });
     }
 }
 
+void ffGenerateLocaleJsonResult(FF_MAYBE_UNUSED FFLocaleOptions* options, FFstrbuf* locale, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    ffJsonResultAddStrbuf(doc, module, "result", locale);
+}
+
+void ffDestroyLocaleModuleResult(FFstrbuf* locale)
+{
+    ffStrbufDestroy(locale);
+}
+
+void ffPrintLocale(FFLocaleOptions* options)
+{
+    FFstrbuf locale;
+    const char* error = ffDetectLocaleModule(options, &locale);
+
+    if(error)
+        ffPrintError(FF_LOCALE_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderLocaleModule(options, &locale);
+
+    ffDestroyLocaleModuleResult(&locale);
+}
+
 void ffInitLocaleOptions(FFLocaleOptions* options)
 {
     options->moduleName = FF_LOCALE_MODULE_NAME;
@@ -51,11 +77,8 @@ void ffDestroyLocaleOptions(FFLocaleOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseLocaleJsonObject(yyjson_val* module)
+void ffParseLocaleJsonObject(FFLocaleOptions* options, yyjson_val* module)
 {
-    FFLocaleOptions __attribute__((__cleanup__(ffDestroyLocaleOptions))) options;
-    ffInitLocaleOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -66,12 +89,10 @@ void ffParseLocaleJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_LOCALE_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_LOCALE_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintLocale(&options);
 }
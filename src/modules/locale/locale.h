@@ -5,7 +5,11 @@
 #define FF_LOCALE_MODULE_NAME "Locale"
 
 void ffPrintLocale(FFLocaleOptions* options);
+const char* ffDetectLocaleModule(FFLocaleOptions* options, FFstrbuf* locale);
+void ffRenderLocaleModule(FFLocaleOptions* options, FFstrbuf* locale);
+void ffGenerateLocaleJsonResult(FFLocaleOptions* options, FFstrbuf* locale, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyLocaleModuleResult(FFstrbuf* locale);
 void ffInitLocaleOptions(FFLocaleOptions* options);
 bool ffParseLocaleCommandOptions(FFLocaleOptions* options, const char* key, const char* value);
 void ffDestroyLocaleOptions(FFLocaleOptions* options);
-void ffParseLocaleJsonObject(yyjson_val* module);
+void ffParseLocaleJsonObject(FFLocaleOptions* options, yyjson_val* module);
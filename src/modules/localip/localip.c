@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/localip/localip.h"
 #include "modules/localip/localip.h"
 #include "util/stringUtils.h"
@@ -25,7 +26,7 @@ static void formatKey(const FFLocalIpOptions* options, const FFLocalIpResult* ip
     else
     {
         ffStrbufClear(key);
-        ffParseFormatString(key, &options->moduleArgs.key, 2, (FFformatarg[]){
+        ffFormatProgramRun(key, &options->moduleArgs.keyProgram, 2, (FFformatarg[]){
             {FF_FORMAT_ARG_TYPE_STRBUF, &ip->name},
         });
     }
@@ -54,33 +55,30 @@ static void printIp(FFLocalIpResult* ip)
     }
 }
 
-void ffPrintLocalIp(FFLocalIpOptions* options)
+const char* ffDetectLocalIpModule(FFLocalIpOptions* options, FFlist* results)
 {
-    FF_LIST_AUTO_DESTROY results = ffListCreate(sizeof(FFLocalIpResult));
-
-    const char* error = ffDetectLocalIps(options, &results);
+    ffListInit(results, sizeof(FFLocalIpResult));
 
+    const char* error = ffDetectLocalIps(options, results);
     if(error)
-    {
-        ffPrintError(FF_LOCALIP_DISPLAY_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+        return error;
 
-    if(results.length == 0)
-    {
-        ffPrintError(FF_LOCALIP_DISPLAY_NAME, 0, &options->moduleArgs, "Failed to detect any IPs");
-        return;
-    }
+    if(results->length == 0)
+        return "Failed to detect any IPs";
 
-    ffListSort(&results, (const void*) sortIps);
+    ffListSort(results, (const void*) sortIps);
+    return NULL;
+}
 
+void ffRenderLocalIpModule(FFLocalIpOptions* options, FFlist* results)
+{
     if (options->showType & FF_LOCALIP_TYPE_COMPACT_BIT)
     {
         ffPrintLogoAndKey(FF_LOCALIP_DISPLAY_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
 
-        FF_LIST_FOR_EACH(FFLocalIpResult, ip, results)
+        FF_LIST_FOR_EACH(FFLocalIpResult, ip, *results)
         {
-            if ((void*) ip != (void*) results.data)
+            if ((void*) ip != (void*) results->data)
                 fputs(" - ", stdout);
             printIp(ip);
         }
@@ -90,7 +88,7 @@ void ffPrintLocalIp(FFLocalIpOptions* options)
     {
         FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
 
-        FF_LIST_FOR_EACH(FFLocalIpResult, ip, results)
+        FF_LIST_FOR_EACH(FFLocalIpResult, ip, *results)
         {
             formatKey(options, ip, &key);
             if(options->moduleArgs.outputFormat.length == 0)
@@ -101,7 +99,7 @@ void ffPrintLocalIp(FFLocalIpOptions* options)
             }
             else
             {
-                ffPrintFormatString(key.chars, 0, NULL, &options->moduleArgs.keyColor, &options->moduleArgs.outputFormat, FF_LOCALIP_NUM_FORMAT_ARGS, (FFformatarg[]){
+                ffPrintFormatString(key.chars, 0, NULL, &options->moduleArgs.keyColor, &options->moduleArgs.outputFormatProgram, FF_LOCALIP_NUM_FORMAT_ARGS, (FFformatarg[]){
                     {FF_FORMAT_ARG_TYPE_STRBUF, &ip->ipv4},
                     {FF_FORMAT_ARG_TYPE_STRBUF, &ip->ipv6},
                     {FF_FORMAT_ARG_TYPE_STRBUF, &ip->mac},
@@ -110,14 +108,44 @@ void ffPrintLocalIp(FFLocalIpOptions* options)
             }
         }
     }
+}
 
-    FF_LIST_FOR_EACH(FFLocalIpResult, ip, results)
+void ffGenerateLocalIpJsonResult(FF_MAYBE_UNUSED FFLocalIpOptions* options, FFlist* results, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(FFLocalIpResult, ip, *results)
+    {
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+        ffJsonResultAddStrbuf(doc, obj, "name", &ip->name);
+        ffJsonResultAddStrbuf(doc, obj, "ipv4", &ip->ipv4);
+        ffJsonResultAddStrbuf(doc, obj, "ipv6", &ip->ipv6);
+        ffJsonResultAddStrbuf(doc, obj, "mac", &ip->mac);
+    }
+}
+
+void ffDestroyLocalIpModuleResult(FFlist* results)
+{
+    FF_LIST_FOR_EACH(FFLocalIpResult, ip, *results)
     {
         ffStrbufDestroy(&ip->name);
         ffStrbufDestroy(&ip->ipv4);
         ffStrbufDestroy(&ip->ipv6);
         ffStrbufDestroy(&ip->mac);
     }
+    ffListDestroy(results);
+}
+
+void ffPrintLocalIp(FFLocalIpOptions* options)
+{
+    FFlist results;
+    const char* error = ffDetectLocalIpModule(options, &results);
+
+    if(error)
+        ffPrintError(FF_LOCALIP_DISPLAY_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderLocalIpModule(options, &results);
+
+    ffDestroyLocalIpModuleResult(&results);
 }
 
 void ffInitLocalIpOptions(FFLocalIpOptions* options)
@@ -196,11 +224,8 @@ void ffDestroyLocalIpOptions(FFLocalIpOptions* options)
     ffStrbufDestroy(&options->namePrefix);
 }
 
-void ffParseLocalIpJsonObject(yyjson_val* module)
+void ffParseLocalIpJsonObject(FFLocalIpOptions* options, yyjson_val* module)
 {
-    FFLocalIpOptions __attribute__((__cleanup__(ffDestroyLocalIpOptions))) options;
-    ffInitLocalIpOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -211,63 +236,61 @@ void ffParseLocalIpJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             if (ffStrEqualsIgnCase(key, "showIpv4"))
             {
                 if (yyjson_get_bool(val))
-                    options.showType |= FF_LOCALIP_TYPE_IPV4_BIT;
+                    options->showType |= FF_LOCALIP_TYPE_IPV4_BIT;
                 else
-                    options.showType &= ~FF_LOCALIP_TYPE_IPV4_BIT;
+                    options->showType &= ~FF_LOCALIP_TYPE_IPV4_BIT;
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "showIpv6"))
             {
                 if (yyjson_get_bool(val))
-                    options.showType |= FF_LOCALIP_TYPE_IPV6_BIT;
+                    options->showType |= FF_LOCALIP_TYPE_IPV6_BIT;
                 else
-                    options.showType &= ~FF_LOCALIP_TYPE_IPV6_BIT;
+                    options->showType &= ~FF_LOCALIP_TYPE_IPV6_BIT;
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "showMac"))
             {
                 if (yyjson_get_bool(val))
-                    options.showType |= FF_LOCALIP_TYPE_MAC_BIT;
+                    options->showType |= FF_LOCALIP_TYPE_MAC_BIT;
                 else
-                    options.showType &= ~FF_LOCALIP_TYPE_MAC_BIT;
+                    options->showType &= ~FF_LOCALIP_TYPE_MAC_BIT;
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "showLoop"))
             {
                 if (yyjson_get_bool(val))
-                    options.showType |= FF_LOCALIP_TYPE_LOOP_BIT;
+                    options->showType |= FF_LOCALIP_TYPE_LOOP_BIT;
                 else
-                    options.showType &= ~FF_LOCALIP_TYPE_LOOP_BIT;
+                    options->showType &= ~FF_LOCALIP_TYPE_LOOP_BIT;
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "compact"))
             {
                 if (yyjson_get_bool(val))
-                    options.showType |= FF_LOCALIP_TYPE_COMPACT_BIT;
+                    options->showType |= FF_LOCALIP_TYPE_COMPACT_BIT;
                 else
-                    options.showType &= ~FF_LOCALIP_TYPE_COMPACT_BIT;
+                    options->showType &= ~FF_LOCALIP_TYPE_COMPACT_BIT;
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "namePrefix"))
             {
-                ffStrbufSetS(&options.namePrefix, yyjson_get_str(val));
+                ffStrbufSetS(&options->namePrefix, yyjson_get_str(val));
                 continue;
             }
 
-            ffPrintError(FF_LOCALIP_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_LOCALIP_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintLocalIp(&options);
 }
@@ -5,7 +5,11 @@
 #define FF_LOCALIP_MODULE_NAME "LocalIp"
 
 void ffPrintLocalIp(FFLocalIpOptions* options);
+const char* ffDetectLocalIpModule(FFLocalIpOptions* options, FFlist* results /* FFLocalIpResult */);
+void ffRenderLocalIpModule(FFLocalIpOptions* options, FFlist* results);
+void ffGenerateLocalIpJsonResult(FFLocalIpOptions* options, FFlist* results, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyLocalIpModuleResult(FFlist* results);
 void ffInitLocalIpOptions(FFLocalIpOptions* options);
 bool ffParseLocalIpCommandOptions(FFLocalIpOptions* options, const char* key, const char* value);
 void ffDestroyLocalIpOptions(FFLocalIpOptions* options);
-void ffParseLocalIpJsonObject(yyjson_val* module);
+void ffParseLocalIpJsonObject(FFLocalIpOptions* options, yyjson_val* module);
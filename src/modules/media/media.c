@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/media/media.h"
 #include "modules/media/media.h"
 #include "util/stringUtils.h"
@@ -43,15 +44,19 @@ static bool artistInSongTitle(const FFstrbuf* song, const FFstrbuf* artist)
     return false;
 }
 
-void ffPrintMedia(FFMediaOptions* options)
+const char* ffDetectMediaModule(FF_MAYBE_UNUSED FFMediaOptions* options, const FFMediaResult** result)
 {
-    const FFMediaResult* media = ffDetectMedia();
+    *result = ffDetectMedia();
 
-    if(media->error.length > 0)
-    {
-        ffPrintError(FF_MEDIA_MODULE_NAME, 0, &options->moduleArgs, "%s", media->error.chars);
-        return;
-    }
+    if((*result)->error.length > 0)
+        return (*result)->error.chars;
+
+    return NULL;
+}
+
+void ffRenderMediaModule(FFMediaOptions* options, const FFMediaResult** result)
+{
+    const FFMediaResult* media = *result;
 
     FF_STRBUF_AUTO_DESTROY songPretty = ffStrbufCreateCopy(&media->song);
     const char* removeStrings[] = {
@@ -105,6 +110,30 @@ void ffPrintMedia(FFMediaOptions* options)
     }
 }
 
+void ffGenerateMediaJsonResult(FF_MAYBE_UNUSED FFMediaOptions* options, const FFMediaResult** result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    const FFMediaResult* media = *result;
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "playerId", &media->playerId);
+    ffJsonResultAddStrbuf(doc, obj, "player", &media->player);
+    ffJsonResultAddStrbuf(doc, obj, "song", &media->song);
+    ffJsonResultAddStrbuf(doc, obj, "artist", &media->artist);
+    ffJsonResultAddStrbuf(doc, obj, "album", &media->album);
+    ffJsonResultAddStrbuf(doc, obj, "url", &media->url);
+    ffJsonResultAddStrbuf(doc, obj, "status", &media->status);
+}
+
+void ffPrintMedia(FFMediaOptions* options)
+{
+    const FFMediaResult* media;
+    const char* error = ffDetectMediaModule(options, &media);
+
+    if(error)
+        ffPrintError(FF_MEDIA_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderMediaModule(options, &media);
+}
+
 void ffInitMediaOptions(FFMediaOptions* options)
 {
     options->moduleName = FF_MEDIA_MODULE_NAME;
@@ -126,11 +155,8 @@ void ffDestroyMediaOptions(FFMediaOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseMediaJsonObject(yyjson_val* module)
+void ffParseMediaJsonObject(FFMediaOptions* options, yyjson_val* module)
 {
-    FFMediaOptions __attribute__((__cleanup__(ffDestroyMediaOptions))) options;
-    ffInitMediaOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -141,12 +167,10 @@ void ffParseMediaJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_MEDIA_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_MEDIA_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintMedia(&options);
 }
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/media/media.h"
 
 #define FF_MEDIA_MODULE_NAME "Media"
 
 void ffPrintMedia(FFMediaOptions* options);
+const char* ffDetectMediaModule(FFMediaOptions* options, const FFMediaResult** result);
+void ffRenderMediaModule(FFMediaOptions* options, const FFMediaResult** result);
+void ffGenerateMediaJsonResult(FFMediaOptions* options, const FFMediaResult** result, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitMediaOptions(FFMediaOptions* options);
 bool ffParseMediaCommandOptions(FFMediaOptions* options, const char* key, const char* value);
 void ffDestroyMediaOptions(FFMediaOptions* options);
-void ffParseMediaJsonObject(yyjson_val* module);
+void ffParseMediaJsonObject(FFMediaOptions* options, yyjson_val* module);
@@ -1,38 +1,35 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "common/parsing.h"
 #include "common/bar.h"
 #include "detection/memory/memory.h"
 #include "modules/memory/memory.h"
 #include "util/stringUtils.h"
 
-#define FF_MEMORY_NUM_FORMAT_ARGS 3
+#define FF_MEMORY_NUM_FORMAT_ARGS 5
 
-void ffPrintMemory(FFMemoryOptions* options)
+const char* ffDetectMemoryModule(FF_MAYBE_UNUSED FFMemoryOptions* options, FFMemoryResult* storage)
 {
-    FFMemoryResult storage;
-    const char* error = ffDetectMemory(&storage);
-
-    if(error)
-    {
-        ffPrintError(FF_MEMORY_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+    return ffDetectMemory(storage);
+}
 
+void ffRenderMemoryModule(FFMemoryOptions* options, FFMemoryResult* storage)
+{
     FF_STRBUF_AUTO_DESTROY usedPretty = ffStrbufCreate();
-    ffParseSize(storage.bytesUsed, instance.config.binaryPrefixType, &usedPretty);
+    ffParseSize(storage->bytesUsed, instance.config.binaryPrefixType, &usedPretty);
 
     FF_STRBUF_AUTO_DESTROY totalPretty = ffStrbufCreate();
-    ffParseSize(storage.bytesTotal, instance.config.binaryPrefixType, &totalPretty);
+    ffParseSize(storage->bytesTotal, instance.config.binaryPrefixType, &totalPretty);
 
-    uint8_t percentage = storage.bytesTotal == 0
+    uint8_t percentage = storage->bytesTotal == 0
         ? 0
-        : (uint8_t) (((long double) storage.bytesUsed / (long double) storage.bytesTotal) * 100.0);
+        : (uint8_t) (((long double) storage->bytesUsed / (long double) storage->bytesTotal) * 100.0);
 
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_MEMORY_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        if (storage.bytesTotal == 0)
+        if (storage->bytesTotal == 0)
             puts("Disabled");
         else
         {
@@ -60,10 +57,30 @@ void ffPrintMemory(FFMemoryOptions* options)
             {FF_FORMAT_ARG_TYPE_STRBUF, &usedPretty},
             {FF_FORMAT_ARG_TYPE_STRBUF, &totalPretty},
             {FF_FORMAT_ARG_TYPE_UINT8, &percentage},
+            {FF_FORMAT_ARG_TYPE_UINT64, &storage->bytesUsed},
+            {FF_FORMAT_ARG_TYPE_UINT64, &storage->bytesTotal},
         });
     }
 }
 
+void ffGenerateMemoryJsonResult(FF_MAYBE_UNUSED FFMemoryOptions* options, FFMemoryResult* storage, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    yyjson_mut_obj_add_uint(doc, obj, "used", storage->bytesUsed);
+    yyjson_mut_obj_add_uint(doc, obj, "total", storage->bytesTotal);
+}
+
+void ffPrintMemory(FFMemoryOptions* options)
+{
+    FFMemoryResult storage;
+    const char* error = ffDetectMemoryModule(options, &storage);
+
+    if(error)
+        ffPrintError(FF_MEMORY_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderMemoryModule(options, &storage);
+}
+
 void ffInitMemoryOptions(FFMemoryOptions* options)
 {
     options->moduleName = FF_MEMORY_MODULE_NAME;
@@ -85,11 +102,8 @@ void ffDestroyMemoryOptions(FFMemoryOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseMemoryJsonObject(yyjson_val* module)
+void ffParseMemoryJsonObject(FFMemoryOptions* options, yyjson_val* module)
 {
-    FFMemoryOptions __attribute__((__cleanup__(ffDestroyMemoryOptions))) options;
-    ffInitMemoryOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -100,12 +114,10 @@ void ffParseMemoryJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_MEMORY_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_MEMORY_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintMemory(&options);
 }
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/memory/memory.h"
 
 #define FF_MEMORY_MODULE_NAME "Memory"
 
 void ffPrintMemory(FFMemoryOptions* options);
+const char* ffDetectMemoryModule(FFMemoryOptions* options, FFMemoryResult* storage);
+void ffRenderMemoryModule(FFMemoryOptions* options, FFMemoryResult* storage);
+void ffGenerateMemoryJsonResult(FFMemoryOptions* options, FFMemoryResult* storage, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitMemoryOptions(FFMemoryOptions* options);
 bool ffParseMemoryCommandOptions(FFMemoryOptions* options, const char* key, const char* value);
 void ffDestroyMemoryOptions(FFMemoryOptions* options);
-void ffParseMemoryJsonObject(yyjson_val* module);
+void ffParseMemoryJsonObject(FFMemoryOptions* options, yyjson_val* module);
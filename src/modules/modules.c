@@ -0,0 +1,377 @@
+#include "fastfetch.h"
+#include "modules/modules.h"
+#include "util/stringUtils.h"
+
+#include <ctype.h>
+
+#define FF_MODULE_INFO_OPTIONS(Name, field) \
+    .options = &instance.config.field, \
+    .optionsSize = sizeof(instance.config.field), \
+    .initOptions = (void*) ffInit##Name##Options, \
+    .destroyOptions = (void*) ffDestroy##Name##Options, \
+    .parseCommandOptions = (void*) ffParse##Name##CommandOptions, \
+    .parseJsonObject = (void*) ffParse##Name##JsonObject, \
+    .print = (void*) ffPrint##Name
+
+#define FF_MODULE_INFO_DETECT(Name, ResultType) \
+    .resultSize = sizeof(ResultType), \
+    .detect = (void*) ffDetect##Name##Module, \
+    .render = (void*) ffRender##Name##Module, \
+    .generateJson = (void*) ffGenerate##Name##JsonResult
+
+static void printBreak(FF_MAYBE_UNUSED void* options)
+{
+    ffPrintBreak();
+}
+
+const FFModuleInfo ffModuleInfos[] = {
+    {
+        .name = FF_BATTERY_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Battery, battery),
+        FF_MODULE_INFO_DETECT(Battery, FFlist),
+        .destroyResult = (void*) ffDestroyBatteryModuleResult,
+        .dynamic = true,
+    },
+    {
+        .name = FF_BIOS_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Bios, bios),
+        FF_MODULE_INFO_DETECT(Bios, FFBiosResult),
+        .destroyResult = (void*) ffDestroyBiosModuleResult,
+    },
+    {
+        .name = FF_BLUETOOTH_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Bluetooth, bluetooth),
+        FF_MODULE_INFO_DETECT(Bluetooth, FFlist),
+        .destroyResult = (void*) ffDestroyBluetoothModuleResult,
+    },
+    {
+        .name = FF_BOARD_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Board, board),
+        FF_MODULE_INFO_DETECT(Board, FFBoardResult),
+        .destroyResult = (void*) ffDestroyBoardModuleResult,
+    },
+    {
+        .name = FF_BREAK_MODULE_NAME,
+        .print = printBreak,
+    },
+    {
+        .name = FF_BRIGHTNESS_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Brightness, brightness),
+        FF_MODULE_INFO_DETECT(Brightness, FFlist),
+        .destroyResult = (void*) ffDestroyBrightnessModuleResult,
+    },
+    {
+        .name = FF_CHASSIS_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Chassis, chassis),
+        FF_MODULE_INFO_DETECT(Chassis, FFChassisResult),
+        .destroyResult = (void*) ffDestroyChassisModuleResult,
+    },
+    {
+        .name = FF_COLORS_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Colors, colors),
+    },
+    {
+        .name = FF_COMMAND_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Command, command),
+        FF_MODULE_INFO_DETECT(Command, FFstrbuf),
+        .destroyResult = (void*) ffDestroyCommandModuleResult,
+    },
+    {
+        .name = FF_CPU_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(CPU, cpu),
+        FF_MODULE_INFO_DETECT(CPU, FFCPUResult),
+        .destroyResult = (void*) ffDestroyCPUModuleResult,
+    },
+    {
+        .name = FF_CPUUSAGE_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(CPUUsage, cpuUsage),
+        FF_MODULE_INFO_DETECT(CPUUsage, FFCpuUsageResult),
+        .destroyResult = (void*) ffDestroyCPUUsageModuleResult,
+        .dynamic = true,
+    },
+    {
+        .name = FF_CURSOR_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Cursor, cursor),
+        FF_MODULE_INFO_DETECT(Cursor, FFCursorResult),
+        .destroyResult = (void*) ffDestroyCursorModuleResult,
+    },
+    {
+        .name = FF_CUSTOM_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Custom, custom),
+    },
+    {
+        .name = FF_DATETIME_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(DateTime, dateTime),
+        FF_MODULE_INFO_DETECT(DateTime, const FFDateTimeResult*),
+        .dynamic = true,
+    },
+    {
+        .name = FF_DE_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(DE, de),
+        FF_MODULE_INFO_DETECT(DE, const FFDisplayServerResult*),
+    },
+    {
+        .name = FF_DISK_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Disk, disk),
+        FF_MODULE_INFO_DETECT(Disk, FFlist),
+        .destroyResult = (void*) ffDestroyDiskModuleResult,
+        .dynamic = true,
+    },
+    {
+        .name = FF_DISPLAY_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Display, display),
+        FF_MODULE_INFO_DETECT(Display, const FFDisplayServerResult*),
+    },
+    {
+        .name = FF_FONT_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Font, font),
+        FF_MODULE_INFO_DETECT(Font, FFFontResult),
+        .destroyResult = (void*) ffDestroyFontModuleResult,
+    },
+    {
+        .name = FF_GAMEPAD_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Gamepad, gamepad),
+        FF_MODULE_INFO_DETECT(Gamepad, FFlist),
+        .destroyResult = (void*) ffDestroyGamepadModuleResult,
+    },
+    {
+        .name = FF_GPU_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(GPU, gpu),
+        FF_MODULE_INFO_DETECT(GPU, FFlist),
+        .destroyResult = (void*) ffDestroyGPUModuleResult,
+    },
+    {
+        .name = FF_HOST_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Host, host),
+        FF_MODULE_INFO_DETECT(Host, FFHostResult),
+        .destroyResult = (void*) ffDestroyHostModuleResult,
+    },
+    {
+        .name = FF_ICONS_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Icons, icons),
+        FF_MODULE_INFO_DETECT(Icons, FFstrbuf),
+        .destroyResult = (void*) ffDestroyIconsModuleResult,
+    },
+    {
+        .name = FF_KERNEL_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Kernel, kernel),
+        .generateJson = (void*) ffGenerateKernelJsonResult,
+    },
+    {
+        .name = FF_LM_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(LM, lm),
+        FF_MODULE_INFO_DETECT(LM, FFLMResult),
+        .destroyResult = (void*) ffDestroyLMModuleResult,
+    },
+    {
+        .name = FF_LOCALE_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Locale, locale),
+        FF_MODULE_INFO_DETECT(Locale, FFstrbuf),
+        .destroyResult = (void*) ffDestroyLocaleModuleResult,
+    },
+    {
+        .name = FF_LOCALIP_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(LocalIp, localIP),
+        FF_MODULE_INFO_DETECT(LocalIp, FFlist),
+        .destroyResult = (void*) ffDestroyLocalIpModuleResult,
+        .dynamic = true,
+    },
+    {
+        .name = FF_MEDIA_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Media, media),
+        FF_MODULE_INFO_DETECT(Media, const FFMediaResult*),
+    },
+    {
+        .name = FF_MEMORY_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Memory, memory),
+        FF_MODULE_INFO_DETECT(Memory, FFMemoryResult),
+        .dynamic = true,
+    },
+    {
+        .name = FF_OPENCL_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(OpenCL, openCL),
+        FF_MODULE_INFO_DETECT(OpenCL, FFOpenCLResult),
+        .destroyResult = (void*) ffDestroyOpenCLModuleResult,
+    },
+    {
+        .name = FF_OPENGL_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(OpenGL, openGL),
+        FF_MODULE_INFO_DETECT(OpenGL, FFOpenGLResult),
+        .destroyResult = (void*) ffDestroyOpenGLModuleResult,
+    },
+    {
+        .name = FF_OS_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(OS, os),
+        FF_MODULE_INFO_DETECT(OS, const FFOSResult*),
+    },
+    {
+        .name = FF_PACKAGES_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Packages, packages),
+        FF_MODULE_INFO_DETECT(Packages, FFPackagesResult),
+        .destroyResult = (void*) ffDestroyPackagesModuleResult,
+    },
+    {
+        .name = FF_PLAYER_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Player, player),
+        FF_MODULE_INFO_DETECT(Player, const FFMediaResult*),
+    },
+    {
+        .name = FF_POWERADAPTER_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(PowerAdapter, powerAdapter),
+        FF_MODULE_INFO_DETECT(PowerAdapter, FFlist),
+        .destroyResult = (void*) ffDestroyPowerAdapterModuleResult,
+    },
+    {
+        .name = FF_PROCESSES_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Processes, processes),
+        FF_MODULE_INFO_DETECT(Processes, uint32_t),
+        .dynamic = true,
+    },
+    {
+        .name = FF_PUBLICIP_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(PublicIp, publicIP),
+        FF_MODULE_INFO_DETECT(PublicIp, FFstrbuf),
+        .destroyResult = (void*) ffDestroyPublicIpModuleResult,
+    },
+    {
+        .name = FF_SENSORS_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Sensors, sensors),
+        FF_MODULE_INFO_DETECT(Sensors, FFlist),
+        .destroyResult = (void*) ffDestroySensorsModuleResult,
+        .dynamic = true,
+    },
+    {
+        .name = FF_SEPARATOR_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Separator, separator),
+    },
+    {
+        .name = FF_SHELL_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Shell, shell),
+        FF_MODULE_INFO_DETECT(Shell, const FFTerminalShellResult*),
+    },
+    {
+        .name = FF_SOUND_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Sound, sound),
+        FF_MODULE_INFO_DETECT(Sound, FFlist),
+        .destroyResult = (void*) ffDestroySoundModuleResult,
+    },
+    {
+        .name = FF_SWAP_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Swap, swap),
+        FF_MODULE_INFO_DETECT(Swap, FFSwapResult),
+        .dynamic = true,
+    },
+    {
+        .name = FF_TERMINAL_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Terminal, terminal),
+        FF_MODULE_INFO_DETECT(Terminal, const FFTerminalShellResult*),
+    },
+    {
+        .name = FF_TERMINALFONT_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(TerminalFont, terminalFont),
+        FF_MODULE_INFO_DETECT(TerminalFont, FFTerminalFontResult),
+        .destroyResult = (void*) ffDestroyTerminalFontModuleResult,
+    },
+    {
+        .name = FF_THEME_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Theme, theme),
+        FF_MODULE_INFO_DETECT(Theme, FFstrbuf),
+        .destroyResult = (void*) ffDestroyThemeModuleResult,
+    },
+    {
+        .name = FF_TITLE_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Title, title),
+        .generateJson = (void*) ffGenerateTitleJsonResult,
+    },
+    {
+        .name = FF_UPTIME_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Uptime, uptime),
+        FF_MODULE_INFO_DETECT(Uptime, uint64_t),
+        .dynamic = true,
+    },
+    {
+        .name = FF_USERS_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Users, users),
+        FF_MODULE_INFO_DETECT(Users, FFlist),
+        .destroyResult = (void*) ffDestroyUsersModuleResult,
+    },
+    {
+        .name = FF_VULKAN_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Vulkan, vulkan),
+        FF_MODULE_INFO_DETECT(Vulkan, const FFVulkanResult*),
+    },
+    {
+        .name = FF_WALLPAPER_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Wallpaper, wallpaper),
+        FF_MODULE_INFO_DETECT(Wallpaper, FFstrbuf),
+        .destroyResult = (void*) ffDestroyWallpaperModuleResult,
+    },
+    {
+        .name = FF_WEATHER_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Weather, weather),
+        FF_MODULE_INFO_DETECT(Weather, FFstrbuf),
+        .destroyResult = (void*) ffDestroyWeatherModuleResult,
+    },
+    {
+        .name = FF_WIFI_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(Wifi, wifi),
+        FF_MODULE_INFO_DETECT(Wifi, FFlist),
+        .destroyResult = (void*) ffDestroyWifiModuleResult,
+    },
+    {
+        .name = FF_WM_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(WM, wm),
+        FF_MODULE_INFO_DETECT(WM, const FFDisplayServerResult*),
+    },
+    {
+        .name = FF_WMTHEME_MODULE_NAME,
+        FF_MODULE_INFO_OPTIONS(WMTheme, wmTheme),
+        FF_MODULE_INFO_DETECT(WMTheme, FFstrbuf),
+        .destroyResult = (void*) ffDestroyWMThemeModuleResult,
+    },
+    {},
+};
+
+// Open addressing hash table of ffModuleInfos, keyed by the lower case module name
+#define FF_MODULE_INFO_TABLE_SIZE 128 // Power of 2, at least twice the number of modules
+
+static const FFModuleInfo* infoTable[FF_MODULE_INFO_TABLE_SIZE];
+
+static uint32_t hashName(const char* name, uint32_t length)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for(uint32_t i = 0; i < length; ++i)
+    {
+        hash ^= (uint8_t) tolower((unsigned char) name[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void ffInitModuleInfoTable(void)
+{
+    // Called again by ffInitInstance in children of --root-list
+    static bool init = false;
+    if (init) return;
+    init = true;
+
+    for(const FFModuleInfo* info = ffModuleInfos; info->name; ++info)
+    {
+        uint32_t index = hashName(info->name, (uint32_t) strlen(info->name)) & (FF_MODULE_INFO_TABLE_SIZE - 1);
+        while(infoTable[index])
+            index = (index + 1) & (FF_MODULE_INFO_TABLE_SIZE - 1);
+        infoTable[index] = info;
+    }
+}
+
+const FFModuleInfo* ffFindModuleInfo(const char* name, uint32_t length)
+{
+    uint32_t index = hashName(name, length) & (FF_MODULE_INFO_TABLE_SIZE - 1);
+    for(const FFModuleInfo* info; (info = infoTable[index]); index = (index + 1) & (FF_MODULE_INFO_TABLE_SIZE - 1))
+    {
+        if(strncasecmp(info->name, name, length) == 0 && info->name[length] == '\0')
+            return info;
+    }
+    return NULL;
+}
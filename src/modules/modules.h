@@ -38,6 +38,7 @@
 #include "modules/poweradapter/poweradapter.h"
 #include "modules/processes/processes.h"
 #include "modules/publicip/publicip.h"
+#include "modules/sensors/sensors.h"
 #include "modules/separator/separator.h"
 #include "modules/shell/shell.h"
 #include "modules/sound/sound.h"
@@ -54,3 +55,38 @@
 #include "modules/wifi/wifi.h"
 #include "modules/wm/wm.h"
 #include "modules/wmtheme/wmtheme.h"
+
+// Descriptor of a module. Modules that only display things (Title, Separator, Break, ...)
+// have no detect / render functions; use `print` for them.
+typedef struct FFModuleInfo
+{
+    const char* name;
+    void* options; // Global options in `instance.config`; NULL if the module has none
+    uint32_t optionsSize;
+    uint32_t resultSize; // Size of the result object passed to detect / render / destroyResult
+
+    void (*initOptions)(void* options);
+    void (*destroyOptions)(void* options);
+    bool (*parseCommandOptions)(void* options, const char* key, const char* value);
+    // Applies the keys of a module object of the JSON config to `options`, which initOptions has initialized
+    void (*parseJsonObject)(void* options, yyjson_val* module);
+
+    // Fills `result` (always initialized, even on failure) and returns an error message or NULL
+    const char* (*detect)(void* options, void* result);
+    void (*render)(void* options, void* result);
+    void (*destroyResult)(void* result); // May be NULL
+    void (*print)(void* options); // detect + render, printing the error if any
+    // Adds the successfully detected `result` to `module` as its "result" property, for `--format json`.
+    // `result` is NULL for modules without detect. NULL if the module can't be printed as JSON (Break, Colors, ...)
+    void (*generateJson)(void* options, void* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+
+    bool dynamic; // Its output changes while fastfetch runs; detected again on every `--watch` interval
+} FFModuleInfo;
+
+// Terminated by an entry whose name is NULL
+extern const FFModuleInfo ffModuleInfos[];
+
+// Must be called once before ffFindModuleInfo
+void ffInitModuleInfoTable(void);
+// Case insensitive. `name` doesn't need to be null terminated. Returns NULL if not found
+const FFModuleInfo* ffFindModuleInfo(const char* name, uint32_t length);
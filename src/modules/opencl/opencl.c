@@ -1,42 +1,64 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/opencl/opencl.h"
 #include "modules/opencl/opencl.h"
 #include "util/stringUtils.h"
 
 #define FF_OPENCL_NUM_FORMAT_ARGS 3
 
+const char* ffDetectOpenCLModule(FF_MAYBE_UNUSED FFOpenCLOptions* options, FFOpenCLResult* opencl)
+{
+    ffStrbufInit(&opencl->version);
+    ffStrbufInit(&opencl->device);
+    ffStrbufInit(&opencl->vendor);
+
+    return ffDetectOpenCL(opencl);
+}
+
+void ffRenderOpenCLModule(FFOpenCLOptions* options, FFOpenCLResult* opencl)
+{
+    if(options->moduleArgs.outputFormat.length == 0)
+    {
+        ffPrintLogoAndKey(FF_OPENCL_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
+        ffStrbufPutTo(&opencl->version, stdout);
+    }
+    else
+    {
+        ffPrintFormat(FF_OPENCL_MODULE_NAME, 0, &options->moduleArgs, FF_OPENCL_NUM_FORMAT_ARGS, (FFformatarg[]) {
+            {FF_FORMAT_ARG_TYPE_STRBUF, &opencl->version},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &opencl->device},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &opencl->vendor},
+        });
+    }
+}
+
+void ffGenerateOpenCLJsonResult(FF_MAYBE_UNUSED FFOpenCLOptions* options, FFOpenCLResult* opencl, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "version", &opencl->version);
+    ffJsonResultAddStrbuf(doc, obj, "device", &opencl->device);
+    ffJsonResultAddStrbuf(doc, obj, "vendor", &opencl->vendor);
+}
+
+void ffDestroyOpenCLModuleResult(FFOpenCLResult* opencl)
+{
+    ffStrbufDestroy(&opencl->version);
+    ffStrbufDestroy(&opencl->device);
+    ffStrbufDestroy(&opencl->vendor);
+}
+
 void ffPrintOpenCL(FFOpenCLOptions* options)
 {
     FFOpenCLResult opencl;
-    ffStrbufInit(&opencl.version);
-    ffStrbufInit(&opencl.device);
-    ffStrbufInit(&opencl.vendor);
-
-    const char* error = ffDetectOpenCL(&opencl);
+    const char* error = ffDetectOpenCLModule(options, &opencl);
 
     if(error != NULL)
         ffPrintError(FF_OPENCL_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
     else
-    {
-        if(options->moduleArgs.outputFormat.length == 0)
-        {
-            ffPrintLogoAndKey(FF_OPENCL_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-            ffStrbufPutTo(&opencl.version, stdout);
-        }
-        else
-        {
-            ffPrintFormat(FF_OPENCL_MODULE_NAME, 0, &options->moduleArgs, FF_OPENCL_NUM_FORMAT_ARGS, (FFformatarg[]) {
-                {FF_FORMAT_ARG_TYPE_STRBUF, &opencl.version},
-                {FF_FORMAT_ARG_TYPE_STRBUF, &opencl.device},
-                {FF_FORMAT_ARG_TYPE_STRBUF, &opencl.vendor},
-            });
-        }
-    }
+        ffRenderOpenCLModule(options, &opencl);
 
-    ffStrbufDestroy(&opencl.version);
-    ffStrbufDestroy(&opencl.device);
-    ffStrbufDestroy(&opencl.vendor);
+    ffDestroyOpenCLModuleResult(&opencl);
 }
 
 void ffInitOpenCLOptions(FFOpenCLOptions* options)
@@ -60,11 +82,8 @@ void ffDestroyOpenCLOptions(FFOpenCLOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseOpenCLJsonObject(yyjson_val* module)
+void ffParseOpenCLJsonObject(FFOpenCLOptions* options, yyjson_val* module)
 {
-    FFOpenCLOptions __attribute__((__cleanup__(ffDestroyOpenCLOptions))) options;
-    ffInitOpenCLOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -75,12 +94,10 @@ void ffParseOpenCLJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_OPENCL_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_OPENCL_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintOpenCL(&options);
 }
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/opencl/opencl.h"
 
 #define FF_OPENCL_MODULE_NAME "OpenCL"
 
 void ffPrintOpenCL(FFOpenCLOptions* options);
+const char* ffDetectOpenCLModule(FFOpenCLOptions* options, FFOpenCLResult* opencl);
+void ffRenderOpenCLModule(FFOpenCLOptions* options, FFOpenCLResult* opencl);
+void ffGenerateOpenCLJsonResult(FFOpenCLOptions* options, FFOpenCLResult* opencl, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyOpenCLModuleResult(FFOpenCLResult* opencl);
 void ffInitOpenCLOptions(FFOpenCLOptions* options);
 bool ffParseOpenCLCommandOptions(FFOpenCLOptions* options, const char* key, const char* value);
 void ffDestroyOpenCLOptions(FFOpenCLOptions* options);
-void ffParseOpenCLJsonObject(yyjson_val* module);
+void ffParseOpenCLJsonObject(FFOpenCLOptions* options, yyjson_val* module);
@@ -1,45 +1,68 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/opengl/opengl.h"
 #include "modules/opengl/opengl.h"
 #include "util/stringUtils.h"
 
 #define FF_OPENGL_NUM_FORMAT_ARGS 4
 
-void ffPrintOpenGL(FFOpenGLOptions* options)
+const char* ffDetectOpenGLModule(FFOpenGLOptions* options, FFOpenGLResult* result)
 {
-    FFOpenGLResult result;
-    ffStrbufInit(&result.version);
-    ffStrbufInit(&result.renderer);
-    ffStrbufInit(&result.vendor);
-    ffStrbufInit(&result.slv);
+    ffStrbufInit(&result->version);
+    ffStrbufInit(&result->renderer);
+    ffStrbufInit(&result->vendor);
+    ffStrbufInit(&result->slv);
 
-    const char* error = ffDetectOpenGL(&result);
-    if(error)
-    {
-        ffPrintError(FF_OPENGL_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+    return ffDetectOpenGL(options, result);
+}
 
+void ffRenderOpenGLModule(FFOpenGLOptions* options, FFOpenGLResult* result)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_OPENGL_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        puts(result.version.chars);
+        puts(result->version.chars);
     }
     else
     {
         ffPrintFormat(FF_OPENGL_MODULE_NAME, 0, &options->moduleArgs, FF_OPENGL_NUM_FORMAT_ARGS, (FFformatarg[]) {
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.version},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.renderer},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.vendor},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result.slv}
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->version},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->renderer},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->vendor},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &result->slv}
         });
     }
+}
+
+void ffGenerateOpenGLJsonResult(FF_MAYBE_UNUSED FFOpenGLOptions* options, FFOpenGLResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "version", &result->version);
+    ffJsonResultAddStrbuf(doc, obj, "renderer", &result->renderer);
+    ffJsonResultAddStrbuf(doc, obj, "vendor", &result->vendor);
+    ffJsonResultAddStrbuf(doc, obj, "slv", &result->slv);
+}
 
-    ffStrbufDestroy(&result.version);
-    ffStrbufDestroy(&result.renderer);
-    ffStrbufDestroy(&result.vendor);
-    ffStrbufDestroy(&result.slv);
+void ffDestroyOpenGLModuleResult(FFOpenGLResult* result)
+{
+    ffStrbufDestroy(&result->version);
+    ffStrbufDestroy(&result->renderer);
+    ffStrbufDestroy(&result->vendor);
+    ffStrbufDestroy(&result->slv);
+}
+
+void ffPrintOpenGL(FFOpenGLOptions* options)
+{
+    FFOpenGLResult result;
+    const char* error = ffDetectOpenGLModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_OPENGL_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderOpenGLModule(options, &result);
+
+    ffDestroyOpenGLModuleResult(&result);
 }
 
 void ffInitOpenGLOptions(FFOpenGLOptions* options)
@@ -80,11 +103,8 @@ void ffDestroyOpenGLOptions(FFOpenGLOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseOpenGLJsonObject(yyjson_val* module)
+void ffParseOpenGLJsonObject(FFOpenGLOptions* options, yyjson_val* module)
 {
-    FFOpenGLOptions __attribute__((__cleanup__(ffDestroyOpenGLOptions))) options;
-    ffInitOpenGLOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -95,7 +115,7 @@ void ffParseOpenGLJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             #if defined(__linux__) || defined(__FreeBSD__)
@@ -110,16 +130,14 @@ void ffParseOpenGLJsonObject(yyjson_val* module)
                     {},
                 });
                 if (error)
-                    ffPrintError(FF_OPENGL_MODULE_NAME, 0, &options.moduleArgs, "Invalid %s value: %s", key, error);
+                    ffPrintError(FF_OPENGL_MODULE_NAME, 0, &options->moduleArgs, "Invalid %s value: %s", key, error);
                 else
-                    options.library = (FFOpenGLLibrary) value;
+                    options->library = (FFOpenGLLibrary) value;
                 continue;
             }
             #endif
 
-            ffPrintError(FF_OPENGL_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_OPENGL_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintOpenGL(&options);
 }
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/opengl/opengl.h"
 
 #define FF_OPENGL_MODULE_NAME "OpenGL"
 
 void ffPrintOpenGL(FFOpenGLOptions* options);
+const char* ffDetectOpenGLModule(FFOpenGLOptions* options, FFOpenGLResult* result);
+void ffRenderOpenGLModule(FFOpenGLOptions* options, FFOpenGLResult* result);
+void ffGenerateOpenGLJsonResult(FFOpenGLOptions* options, FFOpenGLResult* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyOpenGLModuleResult(FFOpenGLResult* result);
 void ffInitOpenGLOptions(FFOpenGLOptions* options);
 bool ffParseOpenGLCommandOptions(FFOpenGLOptions* options, const char* key, const char* value);
 void ffDestroyOpenGLOptions(FFOpenGLOptions* options);
-void ffParseOpenGLJsonObject(yyjson_val* module);
+void ffParseOpenGLJsonObject(FFOpenGLOptions* options, yyjson_val* module);
@@ -37,6 +37,7 @@
 #include "modules/poweradapter/option.h"
 #include "modules/processes/option.h"
 #include "modules/publicip/option.h"
+#include "modules/sensors/option.h"
 #include "modules/separator/option.h"
 #include "modules/shell/option.h"
 #include "modules/sound/option.h"
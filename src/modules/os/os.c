@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "common/option.h"
 #include "detection/os/os.h"
 #include "modules/os/os.h"
@@ -96,15 +97,19 @@ static void buildOutputNixOS(const FFOSResult* os, FFstrbuf* result)
     }
 }
 
-void ffPrintOS(FFOSOptions* options)
+const char* ffDetectOSModule(FF_MAYBE_UNUSED FFOSOptions* options, const FFOSResult** pResult)
 {
-    const FFOSResult* os = ffDetectOS();
+    const FFOSResult* os = *pResult = ffDetectOS();
 
     if(os->name.length == 0 && os->prettyName.length == 0 && os->id.length == 0)
-    {
-        ffPrintError(FF_OS_MODULE_NAME, 0, &options->moduleArgs, "Could not detect OS");
-        return;
-    }
+        return "Could not detect OS";
+
+    return NULL;
+}
+
+void ffRenderOSModule(FFOSOptions* options, const FFOSResult** pResult)
+{
+    const FFOSResult* os = *pResult;
 
     if(options->moduleArgs.outputFormat.length == 0)
     {
@@ -137,6 +142,34 @@ void ffPrintOS(FFOSOptions* options)
     }
 }
 
+void ffGenerateOSJsonResult(FF_MAYBE_UNUSED FFOSOptions* options, const FFOSResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    const FFOSResult* os = *pResult;
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "name", &os->name);
+    ffJsonResultAddStrbuf(doc, obj, "prettyName", &os->prettyName);
+    ffJsonResultAddStrbuf(doc, obj, "id", &os->id);
+    ffJsonResultAddStrbuf(doc, obj, "idLike", &os->idLike);
+    ffJsonResultAddStrbuf(doc, obj, "variant", &os->variant);
+    ffJsonResultAddStrbuf(doc, obj, "variantID", &os->variantID);
+    ffJsonResultAddStrbuf(doc, obj, "version", &os->version);
+    ffJsonResultAddStrbuf(doc, obj, "versionID", &os->versionID);
+    ffJsonResultAddStrbuf(doc, obj, "codename", &os->codename);
+    ffJsonResultAddStrbuf(doc, obj, "buildID", &os->buildID);
+    ffJsonResultAddStrbuf(doc, obj, "architecture", &instance.state.platform.systemArchitecture);
+}
+
+void ffPrintOS(FFOSOptions* options)
+{
+    const FFOSResult* os;
+    const char* error = ffDetectOSModule(options, &os);
+
+    if(error)
+        ffPrintError(FF_OS_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderOSModule(options, &os);
+}
+
 void ffInitOSOptions(FFOSOptions* options)
 {
     options->moduleName = FF_OS_MODULE_NAME;
@@ -158,11 +191,8 @@ void ffDestroyOSOptions(FFOSOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseOSJsonObject(yyjson_val* module)
+void ffParseOSJsonObject(FFOSOptions* options, yyjson_val* module)
 {
-    FFOSOptions __attribute__((__cleanup__(ffDestroyOSOptions))) options;
-    ffInitOSOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -173,12 +203,10 @@ void ffParseOSJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_OS_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_OS_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintOS(&options);
 }
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/os/os.h"
 
 #define FF_OS_MODULE_NAME "OS"
 
 void ffPrintOS(FFOSOptions* options);
+const char* ffDetectOSModule(FFOSOptions* options, const FFOSResult** pResult);
+void ffRenderOSModule(FFOSOptions* options, const FFOSResult** pResult);
+void ffGenerateOSJsonResult(FFOSOptions* options, const FFOSResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitOSOptions(FFOSOptions* options);
 bool ffParseOSCommandOptions(FFOSOptions* options, const char* key, const char* value);
 void ffDestroyOSOptions(FFOSOptions* options);
-void ffParseOSJsonObject(yyjson_val* module);
+void ffParseOSJsonObject(FFOSOptions* options, yyjson_val* module);
@@ -1,45 +1,178 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "common/cache.h"
+#include "common/root.h"
+#include "detection/os/os.h"
 #include "detection/packages/packages.h"
 #include "modules/packages/packages.h"
 #include "util/stringUtils.h"
 
 #define FF_PACKAGES_NUM_FORMAT_ARGS 22
 
-void ffPrintPackages(FFPackagesOptions* options)
+static const FFCacheSchema packagesCacheSchema = FF_CACHE_SCHEMA(FFPackagesResult,
+    offsetof(FFPackagesResult, pacmanBranch),
+);
+
+static void appendCacheKeyPathS(FFstrbuf* key, const char* prefix, const char* path)
+{
+    FF_STRBUF_AUTO_DESTROY fullPath = ffStrbufCreateS(prefix);
+    ffStrbufAppendS(&fullPath, path);
+    ffCacheKeyAddFile(key, fullPath.chars);
+}
+
+// Adds the package databases read by ffDetectPackagesImpl. Installing or removing a package modifies at least one of them.
+// Returns false if they are not known for the current platform
+static bool appendPackagesCacheKey(FFstrbuf* key)
+{
+    #if defined(__linux__) || defined(__FreeBSD__)
+        // Every stratum has its own databases
+        if(ffStrbufIgnCaseEqualS(&ffDetectOS()->id, "bedrock"))
+            return false;
+
+        static const char* const paths[] = {
+            "/lib/apk/db/installed",
+            "/var/lib/dpkg/status",
+            "/var/cache/edb/counter", // Updated by portage on every merge
+            "/var/db/pkg",
+            "/var/db/pkg/local.sqlite",
+            "/var/lib/eopkg/package",
+            "/var/lib/flatpak/app",
+            "/var/lib/flatpak/runtime",
+            "/nix/var/nix/profiles/default",
+            "/run/current-system",
+            "/var/lib/pacman/local",
+            FASTFETCH_TARGET_DIR_ETC "/pacman-mirrors.conf",
+            "/var/log/packages",
+            "/var/lib/rpm",
+            "/var/lib/rpm/rpmdb.sqlite",
+            "/usr/lib/sysimage/rpm",
+            "/usr/lib/sysimage/rpm/Packages.db",
+            "/snap",
+            "/var/db/xbps",
+            "/home/linuxbrew/.linuxbrew/Caskroom",
+            "/home/linuxbrew/.linuxbrew/Cellar",
+        };
+        FF_STRBUF_AUTO_DESTROY baseDir = ffStrbufCreate();
+        ffRootPathSet(&baseDir, FASTFETCH_TARGET_DIR_ROOT);
+        for(uint32_t i = 0; i < sizeof(paths) / sizeof(paths[0]); ++i)
+            appendCacheKeyPathS(key, baseDir.chars, paths[i]);
+
+        // Package managers in the home directory are not counted with `--root`
+        if(instance.config.root.length > 0)
+            return true;
+
+        appendCacheKeyPathS(key, instance.state.platform.homeDir.chars, ".nix-profile");
+        appendCacheKeyPathS(key, instance.state.platform.homeDir.chars, ".local/share/flatpak/app");
+        appendCacheKeyPathS(key, instance.state.platform.homeDir.chars, ".local/share/flatpak/runtime");
+        return true;
+    #elif defined(__APPLE__)
+        const char* brewPrefix = getenv("HOMEBREW_PREFIX");
+        if(ffStrSet(brewPrefix))
+        {
+            appendCacheKeyPathS(key, brewPrefix, "/Caskroom");
+            appendCacheKeyPathS(key, brewPrefix, "/Cellar");
+        }
+        else
+        {
+            appendCacheKeyPathS(key, FASTFETCH_TARGET_DIR_ROOT, "/opt/homebrew/Caskroom");
+            appendCacheKeyPathS(key, FASTFETCH_TARGET_DIR_ROOT, "/opt/homebrew/Cellar");
+            appendCacheKeyPathS(key, FASTFETCH_TARGET_DIR_ROOT, "/usr/local/Caskroom");
+            appendCacheKeyPathS(key, FASTFETCH_TARGET_DIR_ROOT, "/usr/local/Cellar");
+        }
+
+        const char* portPrefix = getenv("MACPORTS_PREFIX");
+        appendCacheKeyPathS(key, ffStrSet(portPrefix) ? portPrefix : FASTFETCH_TARGET_DIR_ROOT "/opt/local", "/var/macports/software");
+        return true;
+    #else
+        FF_UNUSED(key);
+        return false;
+    #endif
+}
+
+const char* ffDetectPackagesModule(FFPackagesOptions* options, FFPackagesResult* counts)
 {
-    FFPackagesResult counts = {};
-    ffStrbufInit(&counts.pacmanBranch);
+    FF_STRBUF_AUTO_DESTROY cacheKey = ffStrbufCreate();
+    bool cache = ffCacheKeyInit(&cacheKey, &options->moduleArgs) && appendPackagesCacheKey(&cacheKey);
+    if(cache && ffCacheLoad(FF_PACKAGES_MODULE_NAME, &cacheKey, &packagesCacheSchema, counts))
+    {
+        // Nothing has been counted in this run
+        memset(counts->statUs, 0, sizeof(counts->statUs));
+        return NULL;
+    }
 
-    const char* error = ffDetectPackages(&counts);
+    *counts = (FFPackagesResult) {};
+    ffStrbufInit(&counts->pacmanBranch);
 
+    const char* error = ffDetectPackages(counts);
     if(error)
+        return error;
+
+    if(cache)
+        ffCacheStore(FF_PACKAGES_MODULE_NAME, &cacheKey, &packagesCacheSchema, counts);
+
+    return NULL;
+}
+
+// Indexed like the counters of FFPackagesResult
+static const char* const managerNames[FF_PACKAGES_NUM_MANAGERS] = {
+    "apk", "brew", "brew-cask", "choco", "dpkg", "emerge", "eopkg", "flatpak-system", "flatpak-user", "nix-default",
+    "nix-system", "nix-user", "pacman", "pkg", "pkgtool", "port", "rpm", "scoop", "snap", "xbps",
+};
+
+// With `--stat`, prints the time spent on each package manager, slowest first.
+// Managers that took less than 0.01ms (usually not installed) are omitted
+static void printManagerStat(FFPackagesOptions* options, const FFPackagesResult* counts)
+{
+    uint32_t order[FF_PACKAGES_NUM_MANAGERS];
+    uint32_t length = 0;
+    for(uint32_t i = 0; i < FF_PACKAGES_NUM_MANAGERS; ++i)
     {
-        ffPrintError(FF_PACKAGES_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+        if(counts->statUs[i] < 10)
+            continue;
+
+        uint32_t j = length++;
+        for(; j > 0 && counts->statUs[order[j - 1]] < counts->statUs[i]; --j)
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+
+    if(length == 0)
         return;
+
+    ffPrintLogoAndKey(FF_PACKAGES_MODULE_NAME " stat", 0, NULL, &options->moduleArgs.keyColor);
+    for(uint32_t i = 0; i < length; ++i)
+    {
+        if(i > 0)
+            fputs(", ", stdout);
+        printf("%s %.2fms", managerNames[order[i]], counts->statUs[order[i]] / 1000.0);
     }
+    putchar('\n');
+}
 
+void ffRenderPackagesModule(FFPackagesOptions* options, FFPackagesResult* counts)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_PACKAGES_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
 
         #define FF_PRINT_PACKAGE_NAME(var, name) \
-            if(counts.var > 0) \
+            if(counts->var > 0) \
             { \
-                printf("%u (%s)", counts.var, (name)); \
-                if((all -= counts.var) > 0) \
+                printf("%u (%s)", counts->var, (name)); \
+                if((all -= counts->var) > 0) \
                     printf(", "); \
             };
 
         #define FF_PRINT_PACKAGE(name) FF_PRINT_PACKAGE_NAME(name, #name)
 
-        uint32_t all = counts.all;
-        if(counts.pacman > 0)
+        uint32_t all = counts->all;
+        if(counts->pacman > 0)
         {
-            printf("%u (pacman)", counts.pacman);
-            if(counts.pacmanBranch.length > 0)
-                printf("[%s]", counts.pacmanBranch.chars);
-            if((all -= counts.pacman) > 0)
+            printf("%u (pacman)", counts->pacman);
+            if(counts->pacmanBranch.length > 0)
+                printf("[%s]", counts->pacmanBranch.chars);
+            if((all -= counts->pacman) > 0)
                 printf(", ");
         };
 
@@ -53,7 +186,7 @@ void ffPrintPackages(FFPackagesOptions* options)
         FF_PRINT_PACKAGE_NAME(nixDefault, "nix-default")
         FF_PRINT_PACKAGE(apk)
         FF_PRINT_PACKAGE(pkg)
-        FF_PRINT_PACKAGE_NAME(flatpakSystem, counts.flatpakUser ? "flatpak-system" : "flatpak")
+        FF_PRINT_PACKAGE_NAME(flatpakSystem, counts->flatpakUser ? "flatpak-system" : "flatpak")
         FF_PRINT_PACKAGE_NAME(flatpakUser, "flatpak-user")
         FF_PRINT_PACKAGE(snap)
         FF_PRINT_PACKAGE(brew)
@@ -68,32 +201,61 @@ void ffPrintPackages(FFPackagesOptions* options)
     else
     {
         ffPrintFormat(FF_PACKAGES_MODULE_NAME, 0, &options->moduleArgs, FF_PACKAGES_NUM_FORMAT_ARGS, (FFformatarg[]){
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.all},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.pacman},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &counts.pacmanBranch},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.dpkg},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.rpm},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.emerge},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.eopkg},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.xbps},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.nixSystem},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.nixUser},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.nixDefault},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.apk},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.pkg},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.flatpakSystem},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.flatpakUser},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.snap},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.brew},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.brewCask},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.port},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.scoop},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.choco},
-            {FF_FORMAT_ARG_TYPE_UINT, &counts.pkgtool},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->all},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->pacman},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &counts->pacmanBranch},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->dpkg},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->rpm},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->emerge},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->eopkg},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->xbps},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->nixSystem},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->nixUser},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->nixDefault},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->apk},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->pkg},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->flatpakSystem},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->flatpakUser},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->snap},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->brew},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->brewCask},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->port},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->scoop},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->choco},
+            {FF_FORMAT_ARG_TYPE_UINT, &counts->pkgtool},
         });
     }
 
-    ffStrbufDestroy(&counts.pacmanBranch);
+    if(__builtin_expect(instance.config.stat, false))
+        printManagerStat(options, counts);
+}
+
+void ffGeneratePackagesJsonResult(FF_MAYBE_UNUSED FFPackagesOptions* options, FFPackagesResult* counts, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    const uint32_t* count = &counts->apk;
+    for(uint32_t i = 0; i < FF_PACKAGES_NUM_MANAGERS; ++i)
+        yyjson_mut_obj_add_uint(doc, obj, managerNames[i], count[i]);
+    yyjson_mut_obj_add_uint(doc, obj, "all", counts->all);
+    ffJsonResultAddStrbuf(doc, obj, "pacmanBranch", &counts->pacmanBranch);
+}
+
+void ffDestroyPackagesModuleResult(FFPackagesResult* counts)
+{
+    ffStrbufDestroy(&counts->pacmanBranch);
+}
+
+void ffPrintPackages(FFPackagesOptions* options)
+{
+    FFPackagesResult counts;
+    const char* error = ffDetectPackagesModule(options, &counts);
+
+    if(error)
+        ffPrintError(FF_PACKAGES_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderPackagesModule(options, &counts);
+
+    ffDestroyPackagesModuleResult(&counts);
 }
 
 void ffInitPackagesOptions(FFPackagesOptions* options)
@@ -117,11 +279,8 @@ void ffDestroyPackagesOptions(FFPackagesOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParsePackagesJsonObject(yyjson_val* module)
+void ffParsePackagesJsonObject(FFPackagesOptions* options, yyjson_val* module)
 {
-    FFPackagesOptions __attribute__((__cleanup__(ffDestroyPackagesOptions))) options;
-    ffInitPackagesOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -132,12 +291,10 @@ void ffParsePackagesJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_PACKAGES_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_PACKAGES_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintPackages(&options);
 }
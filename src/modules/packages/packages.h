@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/packages/packages.h"
 
 #define FF_PACKAGES_MODULE_NAME "Packages"
 
 void ffPrintPackages(FFPackagesOptions* options);
+const char* ffDetectPackagesModule(FFPackagesOptions* options, FFPackagesResult* counts);
+void ffRenderPackagesModule(FFPackagesOptions* options, FFPackagesResult* counts);
+void ffGeneratePackagesJsonResult(FFPackagesOptions* options, FFPackagesResult* counts, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyPackagesModuleResult(FFPackagesResult* counts);
 void ffInitPackagesOptions(FFPackagesOptions* options);
 bool ffParsePackagesCommandOptions(FFPackagesOptions* options, const char* key, const char* value);
 void ffDestroyPackagesOptions(FFPackagesOptions* options);
-void ffParsePackagesJsonObject(yyjson_val* module);
+void ffParsePackagesJsonObject(FFPackagesOptions* options, yyjson_val* module);
@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/media/media.h"
 #include "modules/player/player.h"
 #include "util/stringUtils.h"
@@ -9,15 +10,19 @@
 #define FF_PLAYER_DISPLAY_NAME "Media Player"
 #define FF_PLAYER_NUM_FORMAT_ARGS 4
 
-void ffPrintPlayer(FFPlayerOptions* options)
+const char* ffDetectPlayerModule(FF_MAYBE_UNUSED FFPlayerOptions* options, const FFMediaResult** pResult)
 {
-    const FFMediaResult* media = ffDetectMedia();
+    *pResult = ffDetectMedia();
 
-    if(media->error.length > 0)
-    {
-        ffPrintError(FF_PLAYER_DISPLAY_NAME, 0, &options->moduleArgs, "%s", media->error.chars);
-        return;
-    }
+    if((*pResult)->error.length > 0)
+        return (*pResult)->error.chars;
+
+    return NULL;
+}
+
+void ffRenderPlayerModule(FFPlayerOptions* options, const FFMediaResult** pResult)
+{
+    const FFMediaResult* media = *pResult;
 
     FF_STRBUF_AUTO_DESTROY playerPretty = ffStrbufCreate();
 
@@ -73,6 +78,30 @@ void ffPrintPlayer(FFPlayerOptions* options)
     }
 }
 
+void ffGeneratePlayerJsonResult(FF_MAYBE_UNUSED FFPlayerOptions* options, const FFMediaResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    const FFMediaResult* media = *pResult;
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "playerId", &media->playerId);
+    ffJsonResultAddStrbuf(doc, obj, "player", &media->player);
+    ffJsonResultAddStrbuf(doc, obj, "song", &media->song);
+    ffJsonResultAddStrbuf(doc, obj, "artist", &media->artist);
+    ffJsonResultAddStrbuf(doc, obj, "album", &media->album);
+    ffJsonResultAddStrbuf(doc, obj, "url", &media->url);
+    ffJsonResultAddStrbuf(doc, obj, "status", &media->status);
+}
+
+void ffPrintPlayer(FFPlayerOptions* options)
+{
+    const FFMediaResult* media;
+    const char* error = ffDetectPlayerModule(options, &media);
+
+    if(error)
+        ffPrintError(FF_PLAYER_DISPLAY_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderPlayerModule(options, &media);
+}
+
 void ffInitPlayerOptions(FFPlayerOptions* options)
 {
     options->moduleName = FF_PLAYER_MODULE_NAME;
@@ -94,11 +123,8 @@ void ffDestroyPlayerOptions(FFPlayerOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParsePlayerJsonObject(yyjson_val* module)
+void ffParsePlayerJsonObject(FFPlayerOptions* options, yyjson_val* module)
 {
-    FFPlayerOptions __attribute__((__cleanup__(ffDestroyPlayerOptions))) options;
-    ffInitPlayerOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -109,12 +135,10 @@ void ffParsePlayerJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_PLAYER_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_PLAYER_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintPlayer(&options);
 }
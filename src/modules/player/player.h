@@ -2,11 +2,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/media/media.h"
 
 #define FF_PLAYER_MODULE_NAME "Player"
 
 void ffPrintPlayer(FFPlayerOptions* options);
+const char* ffDetectPlayerModule(FFPlayerOptions* options, const FFMediaResult** pResult);
+void ffRenderPlayerModule(FFPlayerOptions* options, const FFMediaResult** pResult);
+void ffGeneratePlayerJsonResult(FFPlayerOptions* options, const FFMediaResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitPlayerOptions(FFPlayerOptions* options);
 bool ffParsePlayerCommandOptions(FFPlayerOptions* options, const char* key, const char* value);
 void ffDestroyPlayerOptions(FFPlayerOptions* options);
-void ffParsePlayerJsonObject(yyjson_val* module);
+void ffParsePlayerJsonObject(FFPlayerOptions* options, yyjson_val* module);
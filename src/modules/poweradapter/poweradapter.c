@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/poweradapter/poweradapter.h"
 #include "modules/poweradapter/poweradapter.h"
 #include "util/stringUtils.h"
@@ -7,60 +8,93 @@
 #define FF_POWERADAPTER_DISPLAY_NAME "Power Adapter"
 #define FF_POWERADAPTER_MODULE_ARGS 5
 
-void ffPrintPowerAdapter(FFPowerAdapterOptions* options)
+const char* ffDetectPowerAdapterModule(FF_MAYBE_UNUSED FFPowerAdapterOptions* options, FFlist* results)
 {
-    FFlist results;
-    ffListInit(&results, sizeof(PowerAdapterResult));
-
-    const char* error = ffDetectPowerAdapterImpl(&results);
+    ffListInit(results, sizeof(PowerAdapterResult));
 
+    const char* error = ffDetectPowerAdapterImpl(results);
     if (error)
+        return error;
+
+    if(results->length == 0)
+        return "No power adapters found";
+
+    return NULL;
+}
+
+void ffRenderPowerAdapterModule(FFPowerAdapterOptions* options, FFlist* results)
+{
+    for(uint8_t i = 0; i < (uint8_t) results->length; i++)
     {
-        ffPrintError(FF_POWERADAPTER_DISPLAY_NAME, 0, &options->moduleArgs, "%s", error);
+        PowerAdapterResult* result = ffListGet(results, i);
+
+        if(result->watts == FF_POWERADAPTER_UNSET)
+            continue;
+
+        if(options->moduleArgs.outputFormat.length == 0)
+        {
+            ffPrintLogoAndKey(FF_POWERADAPTER_DISPLAY_NAME, i, &options->moduleArgs.key, &options->moduleArgs.keyColor);
+
+            if(result->name.length > 0)
+                puts(result->name.chars);
+            else if(result->watts == FF_POWERADAPTER_NOT_CONNECTED)
+                puts("not connected");
+            else
+                printf("%dW\n", result->watts);
+        }
+        else
+        {
+            ffPrintFormat(FF_POWERADAPTER_DISPLAY_NAME, i, &options->moduleArgs, FF_POWERADAPTER_MODULE_ARGS, (FFformatarg[]){
+                {FF_FORMAT_ARG_TYPE_INT, &result->watts},
+                {FF_FORMAT_ARG_TYPE_STRBUF, &result->name},
+                {FF_FORMAT_ARG_TYPE_STRBUF, &result->manufacturer},
+                {FF_FORMAT_ARG_TYPE_STRBUF, &result->modelName},
+                {FF_FORMAT_ARG_TYPE_STRBUF, &result->description},
+            });
+        }
     }
-    else if(results.length == 0)
+}
+
+void ffGeneratePowerAdapterJsonResult(FF_MAYBE_UNUSED FFPowerAdapterOptions* options, FFlist* results, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(PowerAdapterResult, item, *results)
     {
-        ffPrintError(FF_POWERADAPTER_DISPLAY_NAME, 0, &options->moduleArgs, "No power adapters found");
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+        ffJsonResultAddStrbuf(doc, obj, "description", &item->description);
+        ffJsonResultAddStrbuf(doc, obj, "name", &item->name);
+        ffJsonResultAddStrbuf(doc, obj, "modelName", &item->modelName);
+        ffJsonResultAddStrbuf(doc, obj, "manufacturer", &item->manufacturer);
+        if(item->watts == FF_POWERADAPTER_UNSET)
+            yyjson_mut_obj_add_null(doc, obj, "watts");
+        else
+            yyjson_mut_obj_add_int(doc, obj, "watts", item->watts);
     }
-    else
+}
+
+void ffDestroyPowerAdapterModuleResult(FFlist* results)
+{
+    FF_LIST_FOR_EACH(PowerAdapterResult, result, *results)
     {
-        for(uint8_t i = 0; i < (uint8_t) results.length; i++)
-        {
-            PowerAdapterResult* result = ffListGet(&results, i);
-
-            if(result->watts != FF_POWERADAPTER_UNSET)
-            {
-                if(options->moduleArgs.outputFormat.length == 0)
-                {
-                    ffPrintLogoAndKey(FF_POWERADAPTER_DISPLAY_NAME, i, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-
-                    if(result->name.length > 0)
-                        puts(result->name.chars);
-                    else if(result->watts == FF_POWERADAPTER_NOT_CONNECTED)
-                        puts("not connected");
-                    else
-                        printf("%dW\n", result->watts);
-                }
-                else
-                {
-                    ffPrintFormat(FF_POWERADAPTER_DISPLAY_NAME, i, &options->moduleArgs, FF_POWERADAPTER_MODULE_ARGS, (FFformatarg[]){
-                        {FF_FORMAT_ARG_TYPE_INT, &result->watts},
-                        {FF_FORMAT_ARG_TYPE_STRBUF, &result->name},
-                        {FF_FORMAT_ARG_TYPE_STRBUF, &result->manufacturer},
-                        {FF_FORMAT_ARG_TYPE_STRBUF, &result->modelName},
-                        {FF_FORMAT_ARG_TYPE_STRBUF, &result->description},
-                    });
-                }
-            }
-
-            ffStrbufDestroy(&result->manufacturer);
-            ffStrbufDestroy(&result->description);
-            ffStrbufDestroy(&result->modelName);
-            ffStrbufDestroy(&result->name);
-        }
+        ffStrbufDestroy(&result->manufacturer);
+        ffStrbufDestroy(&result->description);
+        ffStrbufDestroy(&result->modelName);
+        ffStrbufDestroy(&result->name);
     }
+    ffListDestroy(results);
+}
 
-    ffListDestroy(&results);
+void ffPrintPowerAdapter(FFPowerAdapterOptions* options)
+{
+    FFlist results;
+    const char* error = ffDetectPowerAdapterModule(options, &results);
+
+    if (error)
+        ffPrintError(FF_POWERADAPTER_DISPLAY_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderPowerAdapterModule(options, &results);
+
+    ffDestroyPowerAdapterModuleResult(&results);
 }
 
 void ffInitPowerAdapterOptions(FFPowerAdapterOptions* options)
@@ -84,11 +118,8 @@ void ffDestroyPowerAdapterOptions(FFPowerAdapterOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParsePowerAdapterJsonObject(yyjson_val* module)
+void ffParsePowerAdapterJsonObject(FFPowerAdapterOptions* options, yyjson_val* module)
 {
-    FFPowerAdapterOptions __attribute__((__cleanup__(ffDestroyPowerAdapterOptions))) options;
-    ffInitPowerAdapterOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -99,12 +130,10 @@ void ffParsePowerAdapterJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_POWERADAPTER_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_POWERADAPTER_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintPowerAdapter(&options);
 }
@@ -5,7 +5,11 @@
 #define FF_POWERADAPTER_MODULE_NAME "PowerAdapter"
 
 void ffPrintPowerAdapter(FFPowerAdapterOptions* options);
+const char* ffDetectPowerAdapterModule(FFPowerAdapterOptions* options, FFlist* results /* PowerAdapterResult */);
+void ffRenderPowerAdapterModule(FFPowerAdapterOptions* options, FFlist* results);
+void ffGeneratePowerAdapterJsonResult(FFPowerAdapterOptions* options, FFlist* results, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyPowerAdapterModuleResult(FFlist* results);
 void ffInitPowerAdapterOptions(FFPowerAdapterOptions* options);
 bool ffParsePowerAdapterCommandOptions(FFPowerAdapterOptions* options, const char* key, const char* value);
 void ffDestroyPowerAdapterOptions(FFPowerAdapterOptions* options);
-void ffParsePowerAdapterJsonObject(yyjson_val* module);
+void ffParsePowerAdapterJsonObject(FFPowerAdapterOptions* options, yyjson_val* module);
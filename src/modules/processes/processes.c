@@ -1,36 +1,50 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/processes/processes.h"
 #include "modules/processes/processes.h"
 #include "util/stringUtils.h"
 
 #define FF_PROCESSES_NUM_FORMAT_ARGS 1
 
-void ffPrintProcesses(FFProcessesOptions* options)
+const char* ffDetectProcessesModule(FF_MAYBE_UNUSED FFProcessesOptions* options, uint32_t* numProcesses)
 {
-    uint32_t numProcesses = 0;
-    const char* error = ffDetectProcesses(&numProcesses);
-
-    if(error)
-    {
-        ffPrintError(FF_PROCESSES_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+    *numProcesses = 0;
+    return ffDetectProcesses(numProcesses);
+}
 
+void ffRenderProcessesModule(FFProcessesOptions* options, uint32_t* numProcesses)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_PROCESSES_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
 
-        printf("%u\n", numProcesses);
+        printf("%u\n", *numProcesses);
     }
     else
     {
         ffPrintFormat(FF_PROCESSES_MODULE_NAME, 0, &options->moduleArgs, FF_PROCESSES_NUM_FORMAT_ARGS, (FFformatarg[]){
-            {FF_FORMAT_ARG_TYPE_UINT, &numProcesses}
+            {FF_FORMAT_ARG_TYPE_UINT, numProcesses}
         });
     }
 }
 
+void ffGenerateProcessesJsonResult(FF_MAYBE_UNUSED FFProcessesOptions* options, uint32_t* numProcesses, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_obj_add_uint(doc, module, "result", *numProcesses);
+}
+
+void ffPrintProcesses(FFProcessesOptions* options)
+{
+    uint32_t numProcesses;
+    const char* error = ffDetectProcessesModule(options, &numProcesses);
+
+    if(error)
+        ffPrintError(FF_PROCESSES_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderProcessesModule(options, &numProcesses);
+}
+
 void ffInitProcessesOptions(FFProcessesOptions* options)
 {
     options->moduleName = FF_PROCESSES_MODULE_NAME;
@@ -52,11 +66,8 @@ void ffDestroyProcessesOptions(FFProcessesOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseProcessesJsonObject(yyjson_val* module)
+void ffParseProcessesJsonObject(FFProcessesOptions* options, yyjson_val* module)
 {
-    FFProcessesOptions __attribute__((__cleanup__(ffDestroyProcessesOptions))) options;
-    ffInitProcessesOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -67,12 +78,10 @@ void ffParseProcessesJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_PROCESSES_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_PROCESSES_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintProcesses(&options);
 }
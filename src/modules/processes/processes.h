@@ -5,7 +5,10 @@
 #define FF_PROCESSES_MODULE_NAME "Processes"
 
 void ffPrintProcesses(FFProcessesOptions* options);
+const char* ffDetectProcessesModule(FFProcessesOptions* options, uint32_t* numProcesses);
+void ffRenderProcessesModule(FFProcessesOptions* options, uint32_t* numProcesses);
+void ffGenerateProcessesJsonResult(FFProcessesOptions* options, uint32_t* numProcesses, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitProcessesOptions(FFProcessesOptions* options);
 bool ffParseProcessesCommandOptions(FFProcessesOptions* options, const char* key, const char* value);
 void ffDestroyProcessesOptions(FFProcessesOptions* options);
-void ffParseProcessesJsonObject(yyjson_val* module);
+void ffParseProcessesJsonObject(FFProcessesOptions* options, yyjson_val* module);
@@ -11,4 +11,5 @@ typedef struct FFPublicIpOptions
 
     FFstrbuf url;
     uint32_t timeout;
+    uint32_t cacheTtl; // Seconds. 0 disables the response cache
 } FFPublicIpOptions;
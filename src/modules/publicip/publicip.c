@@ -1,5 +1,7 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "common/httpcache.h"
 #include "common/networking.h"
 #include "modules/publicip/publicip.h"
 #include "util/stringUtils.h"
@@ -9,63 +11,140 @@
 
 static FFNetworkingState state;
 static int status = -1;
+static FFHttpCacheStatus cacheStatus = FF_HTTP_CACHE_MISS;
+static FFstrbuf cachedBody;
 
-void ffPreparePublicIp(FFPublicIpOptions* options)
+static void getHostAndPath(const FFPublicIpOptions* options, FFstrbuf* host, FFstrbuf* path)
 {
     if (options->url.length == 0)
-        status = ffNetworkingSendHttpRequest(&state, "ipinfo.io", "/ip", NULL);
-    else
     {
-        FF_STRBUF_AUTO_DESTROY host = ffStrbufCreateCopy(&options->url);
-        ffStrbufSubstrAfterFirstS(&host, "://");
-        uint32_t pathStartIndex = ffStrbufFirstIndexC(&host, '/');
+        ffStrbufSetS(host, "ipinfo.io");
+        ffStrbufSetS(path, "/ip");
+        return;
+    }
 
-        FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
-        if(pathStartIndex != host.length)
+    ffStrbufSet(host, &options->url);
+    ffStrbufSubstrAfterFirstS(host, "://");
+    uint32_t pathStartIndex = ffStrbufFirstIndexC(host, '/');
+
+    if(pathStartIndex != host->length)
+    {
+        ffStrbufSetNS(path, host->length - pathStartIndex, host->chars + pathStartIndex);
+        ffStrbufSubstrBefore(host, pathStartIndex);
+    }
+    else
+        ffStrbufSetS(path, "/");
+}
+
+static void refreshCache(const FFPublicIpOptions* options, const FFstrbuf* host, const FFstrbuf* path)
+{
+    char timeout[16], cacheTtl[16];
+    snprintf(timeout, sizeof(timeout), "%u", options->timeout);
+    snprintf(cacheTtl, sizeof(cacheTtl), "%u", options->cacheTtl);
+
+    ffHttpCacheRefresh(host->chars, path->chars, FF_PUBLICIP_MODULE_NAME, (const char*[]) {
+        "--publicip-timeout", timeout,
+        "--publicip-cache-ttl", cacheTtl,
+        options->url.length > 0 ? "--publicip-url" : NULL, options->url.chars, // Ends the list early without a URL
+        NULL
+    });
+}
+
+void ffPreparePublicIp(FFPublicIpOptions* options)
+{
+    FF_STRBUF_AUTO_DESTROY host = ffStrbufCreate();
+    FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+    getHostAndPath(options, &host, &path);
+
+    if (options->cacheTtl > 0)
+    {
+        ffStrbufInit(&cachedBody);
+        cacheStatus = ffHttpCacheLoad(&options->moduleArgs, host.chars, path.chars, options->cacheTtl, &cachedBody);
+        if (cacheStatus == FF_HTTP_CACHE_STALE)
+            refreshCache(options, &host, &path);
+        if (cacheStatus != FF_HTTP_CACHE_MISS)
         {
-            ffStrbufAppendNS(&path, pathStartIndex, host.chars + (host.length - pathStartIndex));
-            host.length = pathStartIndex;
-            host.chars[pathStartIndex] = '\0';
+            status = 1;
+            return;
         }
-
-        status = ffNetworkingSendHttpRequest(&state, host.chars, path.length == 0 ? "/" : path.chars, NULL);
+        ffStrbufDestroy(&cachedBody);
     }
+
+    status = ffNetworkingSendHttpRequest(&state, host.chars, path.chars, NULL, options->timeout);
 }
 
-void ffPrintPublicIp(FFPublicIpOptions* options)
+const char* ffDetectPublicIpModule(FFPublicIpOptions* options, FFstrbuf* result)
 {
+    ffStrbufInitA(result, 4096);
+
     if (status == -1)
         ffPreparePublicIp(options);
 
-    if (status == 0)
+    if (cacheStatus != FF_HTTP_CACHE_MISS)
     {
-        ffPrintError(FF_PUBLICIP_DISPLAY_NAME, 0, &options->moduleArgs, "Failed to connect to an IP detection server");
-        return;
+        ffStrbufAppend(result, &cachedBody);
+        ffStrbufDestroy(&cachedBody);
+        return NULL;
     }
 
-    FF_STRBUF_AUTO_DESTROY result = ffStrbufCreateA(4096);
-    bool success = ffNetworkingRecvHttpResponse(&state, &result, options->timeout);
-    if (success) ffStrbufSubstrAfterFirstS(&result, "\r\n\r\n");
+    if (status == 0)
+        return "Failed to connect to an IP detection server";
 
-    if (!success || result.length == 0)
+    bool success = ffNetworkingRecvHttpResponse(&state, result);
+    if (success) ffStrbufSubstrAfterFirstS(result, "\r\n\r\n");
+
+    if (!success || result->length == 0)
+        return "Failed to receive the server response";
+
+    if (options->cacheTtl > 0)
     {
-        ffPrintError(FF_PUBLICIP_DISPLAY_NAME, 0, &options->moduleArgs, "Failed to receive the server response");
-        return;
+        FF_STRBUF_AUTO_DESTROY host = ffStrbufCreate();
+        FF_STRBUF_AUTO_DESTROY path = ffStrbufCreate();
+        getHostAndPath(options, &host, &path);
+        ffHttpCacheStore(&options->moduleArgs, host.chars, path.chars, result);
     }
 
+    return NULL;
+}
+
+void ffRenderPublicIpModule(FFPublicIpOptions* options, FFstrbuf* result)
+{
     if (options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_PUBLICIP_DISPLAY_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        ffStrbufPutTo(&result, stdout);
+        ffStrbufPutTo(result, stdout);
     }
     else
     {
         ffPrintFormat(FF_PUBLICIP_DISPLAY_NAME, 0, &options->moduleArgs, FF_PUBLICIP_NUM_FORMAT_ARGS, (FFformatarg[]) {
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result}
+            {FF_FORMAT_ARG_TYPE_STRBUF, result}
         });
     }
 }
 
+void ffGeneratePublicIpJsonResult(FF_MAYBE_UNUSED FFPublicIpOptions* options, FFstrbuf* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    ffJsonResultAddStrbuf(doc, module, "result", result);
+}
+
+void ffDestroyPublicIpModuleResult(FFstrbuf* result)
+{
+    ffStrbufDestroy(result);
+}
+
+void ffPrintPublicIp(FFPublicIpOptions* options)
+{
+    FFstrbuf result;
+    const char* error = ffDetectPublicIpModule(options, &result);
+
+    if (error)
+        ffPrintError(FF_PUBLICIP_DISPLAY_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderPublicIpModule(options, &result);
+
+    ffDestroyPublicIpModuleResult(&result);
+}
+
 void ffInitPublicIpOptions(FFPublicIpOptions* options)
 {
     options->moduleName = FF_PUBLICIP_MODULE_NAME;
@@ -73,6 +152,7 @@ void ffInitPublicIpOptions(FFPublicIpOptions* options)
 
     ffStrbufInit(&options->url);
     options->timeout = 0;
+    options->cacheTtl = 0;
 }
 
 bool ffParsePublicIpCommandOptions(FFPublicIpOptions* options, const char* key, const char* value)
@@ -94,6 +174,12 @@ bool ffParsePublicIpCommandOptions(FFPublicIpOptions* options, const char* key,
         return true;
     }
 
+    if (ffStrEqualsIgnCase(subKey, "cache-ttl"))
+    {
+        options->cacheTtl = ffOptionParseUInt32(key, value);
+        return true;
+    }
+
     return false;
 }
 
@@ -104,11 +190,8 @@ void ffDestroyPublicIpOptions(FFPublicIpOptions* options)
     ffStrbufDestroy(&options->url);
 }
 
-void ffParsePublicIpJsonObject(yyjson_val* module)
+void ffParsePublicIpJsonObject(FFPublicIpOptions* options, yyjson_val* module)
 {
-    FFPublicIpOptions __attribute__((__cleanup__(ffDestroyPublicIpOptions))) options;
-    ffInitPublicIpOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -119,24 +202,28 @@ void ffParsePublicIpJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             if (ffStrEqualsIgnCase(key, "url"))
             {
-                ffStrbufSetS(&options.url, yyjson_get_str(val));
+                ffStrbufSetS(&options->url, yyjson_get_str(val));
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "timeout"))
             {
-                options.timeout = (uint32_t) yyjson_get_uint(val);
+                options->timeout = (uint32_t) yyjson_get_uint(val);
+                continue;
+            }
+
+            if (ffStrEqualsIgnCase(key, "cacheTtl"))
+            {
+                options->cacheTtl = (uint32_t) yyjson_get_uint(val);
                 continue;
             }
 
-            ffPrintError(FF_PUBLICIP_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_PUBLICIP_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintPublicIp(&options);
 }
@@ -7,7 +7,11 @@
 void ffPreparePublicIp(FFPublicIpOptions* options);
 
 void ffPrintPublicIp(FFPublicIpOptions* options);
+const char* ffDetectPublicIpModule(FFPublicIpOptions* options, FFstrbuf* result);
+void ffRenderPublicIpModule(FFPublicIpOptions* options, FFstrbuf* result);
+void ffGeneratePublicIpJsonResult(FFPublicIpOptions* options, FFstrbuf* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyPublicIpModuleResult(FFstrbuf* result);
 void ffInitPublicIpOptions(FFPublicIpOptions* options);
 bool ffParsePublicIpCommandOptions(FFPublicIpOptions* options, const char* key, const char* value);
 void ffDestroyPublicIpOptions(FFPublicIpOptions* options);
-void ffParsePublicIpJsonObject(yyjson_val* module);
+void ffParsePublicIpJsonObject(FFPublicIpOptions* options, yyjson_val* module);
@@ -0,0 +1,11 @@
+#pragma once
+
+// This file will be included in "fastfetch.h", do NOT put unnecessary things here
+
+#include "common/option.h"
+
+typedef struct FFSensorsOptions
+{
+    const char* moduleName;
+    FFModuleArgs moduleArgs;
+} FFSensorsOptions;
@@ -0,0 +1,241 @@
+#include "common/printing.h"
+#include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "detection/sensors/sensors.h"
+#include "modules/sensors/sensors.h"
+#include "util/stringUtils.h"
+
+#define FF_SENSORS_NUM_FORMAT_ARGS 8
+
+static const struct
+{
+    const char* unit;
+    int8_t precision;
+} channelUnits[] = {
+    [FF_SENSOR_TYPE_TEMPERATURE] = { "°C", 1 },
+    [FF_SENSOR_TYPE_FAN] = { " RPM", 0 },
+    [FF_SENSOR_TYPE_POWER] = { " W", 1 },
+    [FF_SENSOR_TYPE_VOLTAGE] = { " V", 2 },
+};
+
+static void appendChannelLabel(FFstrbuf* buffer, const FFSensorChannel* channel)
+{
+    if(channel->label.length > 0)
+        ffStrbufAppend(buffer, &channel->label);
+    else
+    {
+        ffStrbufAppendS(buffer, ffSensorTypeToString(channel->type));
+        ffStrbufAppendUInt(buffer, channel->index);
+    }
+}
+
+// "Tctl 45.0°C, fan1 1200 RPM, PPT 15.2 W"
+static void appendReadings(FFstrbuf* buffer, const FFSensorChip* chip)
+{
+    FF_LIST_FOR_EACH(FFSensorChannel, channel, chip->channels)
+    {
+        if(channel->value != channel->value)
+            continue;
+
+        if(buffer->length > 0)
+            ffStrbufAppendS(buffer, ", ");
+        appendChannelLabel(buffer, channel);
+        ffStrbufAppendC(buffer, ' ');
+        ffStrbufAppendDouble(buffer, channel->value, channelUnits[channel->type].precision);
+        ffStrbufAppendS(buffer, channelUnits[channel->type].unit);
+    }
+}
+
+static void printChip(FFSensorsOptions* options, const FFSensorChip* chip, uint8_t index)
+{
+    FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
+
+    if(options->moduleArgs.key.length == 0)
+        ffStrbufAppendF(&key, "%s (%s)", FF_SENSORS_MODULE_NAME, chip->name.chars);
+    else
+    {
+        ffFormatProgramRun(&key, &options->moduleArgs.keyProgram, 3, (FFformatarg[]){
+            {FF_FORMAT_ARG_TYPE_UINT8, &index},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &chip->name},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &chip->device},
+        });
+    }
+
+    FF_STRBUF_AUTO_DESTROY readings = ffStrbufCreate();
+    appendReadings(&readings, chip);
+
+    if(options->moduleArgs.outputFormat.length == 0)
+    {
+        ffPrintLogoAndKey(key.chars, 0, NULL, &options->moduleArgs.keyColor);
+        ffStrbufPutTo(&readings, stdout);
+    }
+    else
+    {
+        // NaN if the chip has no such channel; passed as NULL then, so that they print nothing instead of "nan"
+        double maxTemp = 0.0/0.0, maxFan = 0.0/0.0, totalPower = 0.0/0.0;
+        FF_STRBUF_AUTO_DESTROY maxTempLabel = ffStrbufCreate();
+
+        FF_LIST_FOR_EACH(FFSensorChannel, channel, chip->channels)
+        {
+            if(channel->value != channel->value)
+                continue;
+
+            switch(channel->type)
+            {
+                case FF_SENSOR_TYPE_TEMPERATURE:
+                    if(!(channel->value <= maxTemp))
+                    {
+                        maxTemp = channel->value;
+                        ffStrbufClear(&maxTempLabel);
+                        appendChannelLabel(&maxTempLabel, channel);
+                    }
+                    break;
+                case FF_SENSOR_TYPE_FAN:
+                    if(!(channel->value <= maxFan))
+                        maxFan = channel->value;
+                    break;
+                case FF_SENSOR_TYPE_POWER:
+                    totalPower = totalPower == totalPower ? totalPower + channel->value : channel->value;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        ffPrintFormatString(key.chars, 0, NULL, &options->moduleArgs.keyColor, &options->moduleArgs.outputFormatProgram, FF_SENSORS_NUM_FORMAT_ARGS, (FFformatarg[]) {
+            {FF_FORMAT_ARG_TYPE_STRBUF, &chip->name},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &chip->device},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &readings},
+            {maxTemp == maxTemp ? FF_FORMAT_ARG_TYPE_DOUBLE : FF_FORMAT_ARG_TYPE_NULL, &maxTemp},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &maxTempLabel},
+            {maxFan == maxFan ? FF_FORMAT_ARG_TYPE_DOUBLE : FF_FORMAT_ARG_TYPE_NULL, &maxFan},
+            {totalPower == totalPower ? FF_FORMAT_ARG_TYPE_DOUBLE : FF_FORMAT_ARG_TYPE_NULL, &totalPower},
+            {FF_FORMAT_ARG_TYPE_UINT, &chip->channels.length},
+        });
+    }
+}
+
+const char* ffDetectSensorsModule(FF_MAYBE_UNUSED FFSensorsOptions* options, FFlist* chips)
+{
+    ffListInit(chips, sizeof(FFSensorChip));
+
+    // The index is shared with the CPU and GPU modules; copy it, so that the lock isn't held until rendering
+    const FFlist* sensorChips = ffSensorsLock(true);
+    FF_LIST_FOR_EACH(FFSensorChip, sensorChip, *sensorChips)
+    {
+        FFSensorChip* chip = ffListAdd(chips);
+        ffStrbufInitCopy(&chip->name, &sensorChip->name);
+        ffStrbufInitCopy(&chip->device, &sensorChip->device);
+        chip->deviceClass = sensorChip->deviceClass;
+        ffListInitA(&chip->channels, sizeof(FFSensorChannel), sensorChip->channels.length);
+        FF_LIST_FOR_EACH(FFSensorChannel, sensorChannel, sensorChip->channels)
+        {
+            FFSensorChannel* channel = ffListAdd(&chip->channels);
+            *channel = *sensorChannel;
+            ffStrbufInitCopy(&channel->label, &sensorChannel->label);
+        }
+    }
+    ffSensorsUnlock();
+
+    if(chips->length == 0)
+        return "No sensors found";
+
+    return NULL;
+}
+
+void ffRenderSensorsModule(FFSensorsOptions* options, FFlist* chips)
+{
+    uint8_t index = 0;
+    FF_LIST_FOR_EACH(FFSensorChip, chip, *chips)
+        printChip(options, chip, ++index);
+}
+
+void ffGenerateSensorsJsonResult(FF_MAYBE_UNUSED FFSensorsOptions* options, FFlist* chips, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(FFSensorChip, chip, *chips)
+    {
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+        ffJsonResultAddStrbuf(doc, obj, "name", &chip->name);
+        ffJsonResultAddStrbuf(doc, obj, "device", &chip->device);
+
+        yyjson_mut_val* channels = ffJsonResultAddArr(doc, obj, "channels");
+        FF_LIST_FOR_EACH(FFSensorChannel, channel, chip->channels)
+        {
+            yyjson_mut_val* channelObj = yyjson_mut_arr_add_obj(doc, channels);
+            yyjson_mut_obj_add_str(doc, channelObj, "type", ffSensorTypeToString(channel->type));
+            yyjson_mut_obj_add_uint(doc, channelObj, "index", channel->index);
+            ffJsonResultAddStrbuf(doc, channelObj, "label", &channel->label);
+            ffJsonResultAddDouble(doc, channelObj, "value", channel->value);
+            ffJsonResultAddDouble(doc, channelObj, "max", channel->max);
+            ffJsonResultAddDouble(doc, channelObj, "crit", channel->crit);
+        }
+    }
+}
+
+void ffDestroySensorsModuleResult(FFlist* chips)
+{
+    FF_LIST_FOR_EACH(FFSensorChip, chip, *chips)
+    {
+        ffStrbufDestroy(&chip->name);
+        ffStrbufDestroy(&chip->device);
+        FF_LIST_FOR_EACH(FFSensorChannel, channel, chip->channels)
+            ffStrbufDestroy(&channel->label);
+        ffListDestroy(&chip->channels);
+    }
+    ffListDestroy(chips);
+}
+
+void ffPrintSensors(FFSensorsOptions* options)
+{
+    FFlist chips;
+    const char* error = ffDetectSensorsModule(options, &chips);
+
+    if(error)
+        ffPrintError(FF_SENSORS_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderSensorsModule(options, &chips);
+
+    ffDestroySensorsModuleResult(&chips);
+}
+
+void ffInitSensorsOptions(FFSensorsOptions* options)
+{
+    options->moduleName = FF_SENSORS_MODULE_NAME;
+    ffOptionInitModuleArg(&options->moduleArgs);
+}
+
+bool ffParseSensorsCommandOptions(FFSensorsOptions* options, const char* key, const char* value)
+{
+    const char* subKey = ffOptionTestPrefix(key, FF_SENSORS_MODULE_NAME);
+    if (!subKey) return false;
+    if (ffOptionParseModuleArgs(key, subKey, value, &options->moduleArgs))
+        return true;
+
+    return false;
+}
+
+void ffDestroySensorsOptions(FFSensorsOptions* options)
+{
+    ffOptionDestroyModuleArg(&options->moduleArgs);
+}
+
+void ffParseSensorsJsonObject(FFSensorsOptions* options, yyjson_val* module)
+{
+    if (module)
+    {
+        yyjson_val *key_, *val;
+        size_t idx, max;
+        yyjson_obj_foreach(module, idx, max, key_, val)
+        {
+            const char* key = yyjson_get_str(key_);
+            if(ffStrEqualsIgnCase(key, "type"))
+                continue;
+
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
+                continue;
+
+            ffPrintError(FF_SENSORS_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
+        }
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "fastfetch.h"
+
+#define FF_SENSORS_MODULE_NAME "Sensors"
+
+void ffPrintSensors(FFSensorsOptions* options);
+const char* ffDetectSensorsModule(FFSensorsOptions* options, FFlist* chips /* FFSensorChip */);
+void ffRenderSensorsModule(FFSensorsOptions* options, FFlist* chips);
+void ffGenerateSensorsJsonResult(FFSensorsOptions* options, FFlist* chips, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroySensorsModuleResult(FFlist* chips);
+void ffInitSensorsOptions(FFSensorsOptions* options);
+bool ffParseSensorsCommandOptions(FFSensorsOptions* options, const char* key, const char* value);
+void ffDestroySensorsOptions(FFSensorsOptions* options);
+void ffParseSensorsJsonObject(FFSensorsOptions* options, yyjson_val* module);
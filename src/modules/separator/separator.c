@@ -5,6 +5,9 @@
 
 void ffPrintSeparator(FFSeparatorOptions* options)
 {
+    // Wait for our turn first, so that the title module has set titleLength
+    ffLogoPrintLine();
+
     uint32_t titleLength = instance.state.titleLength;
     if (titleLength == 0)
     {
@@ -15,8 +18,6 @@ void ffPrintSeparator(FFSeparatorOptions* options)
         );
     }
 
-    ffLogoPrintLine();
-
     if(options->string.length == 0)
     {
         ffPrintCharTimes('-', titleLength);
@@ -59,11 +60,8 @@ void ffDestroySeparatorOptions(FFSeparatorOptions* options)
     ffStrbufDestroy(&options->string);
 }
 
-void ffParseSeparatorJsonObject(yyjson_val* module)
+void ffParseSeparatorJsonObject(FFSeparatorOptions* options, yyjson_val* module)
 {
-    FFSeparatorOptions __attribute__((__cleanup__(ffDestroySeparatorOptions))) options;
-    ffInitSeparatorOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -76,13 +74,11 @@ void ffParseSeparatorJsonObject(yyjson_val* module)
 
             if (ffStrEqualsIgnCase(key, "string"))
             {
-                ffStrbufSetS(&options.string, yyjson_get_str(val));
+                ffStrbufSetS(&options->string, yyjson_get_str(val));
                 continue;
             }
 
             ffPrintErrorString(FF_SEPARATOR_MODULE_NAME, 0, NULL, NULL, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintSeparator(&options);
 }
@@ -1,20 +1,29 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/terminalshell/terminalshell.h"
 #include "modules/shell/shell.h"
 #include "util/stringUtils.h"
 
 #define FF_SHELL_NUM_FORMAT_ARGS 7
 
-void ffPrintShell(FFShellOptions* options)
+const char* ffDetectShellModule(FF_MAYBE_UNUSED FFShellOptions* options, const FFTerminalShellResult** pResult)
 {
-    const FFTerminalShellResult* result = ffDetectTerminalShell();
+    *pResult = ffDetectTerminalShell();
 
-    if(result->shellProcessName.length == 0)
-    {
-        ffPrintError(FF_SHELL_MODULE_NAME, 0, &options->moduleArgs, "Couldn't detect shell");
-        return;
-    }
+    // With `--root`, the shells installed in it are printed
+    if(instance.config.root.length > 0)
+        return (*pResult)->installedShells.length == 0 ? "No shells listed in /etc/shells of the root" : NULL;
+
+    if((*pResult)->shellProcessName.length == 0)
+        return "Couldn't detect shell";
+
+    return NULL;
+}
+
+void ffRenderShellModule(FFShellOptions* options, const FFTerminalShellResult** pResult)
+{
+    const FFTerminalShellResult* result = *pResult;
 
     if(options->moduleArgs.outputFormat.length == 0)
     {
@@ -43,6 +52,38 @@ void ffPrintShell(FFShellOptions* options)
     }
 }
 
+void ffGenerateShellJsonResult(FF_MAYBE_UNUSED FFShellOptions* options, const FFTerminalShellResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    const FFTerminalShellResult* result = *pResult;
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "exe", &result->shellExe);
+    yyjson_mut_obj_add_strcpy(doc, obj, "exeName", result->shellExeName ? result->shellExeName : "");
+    ffJsonResultAddStrbuf(doc, obj, "processName", &result->shellProcessName);
+    ffJsonResultAddStrbuf(doc, obj, "prettyName", &result->shellPrettyName);
+    ffJsonResultAddStrbuf(doc, obj, "version", &result->shellVersion);
+    yyjson_mut_obj_add_uint(doc, obj, "pid", result->shellPid);
+    ffJsonResultAddStrbuf(doc, obj, "userShellExe", &result->userShellExe);
+    ffJsonResultAddStrbuf(doc, obj, "userShellVersion", &result->userShellVersion);
+
+    if(instance.config.root.length > 0)
+    {
+        yyjson_mut_val* installed = ffJsonResultAddArr(doc, obj, "installed");
+        FF_LIST_FOR_EACH(FFstrbuf, shell, result->installedShells)
+            ffJsonResultAppendStrbuf(doc, installed, shell);
+    }
+}
+
+void ffPrintShell(FFShellOptions* options)
+{
+    const FFTerminalShellResult* result;
+    const char* error = ffDetectShellModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_SHELL_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderShellModule(options, &result);
+}
+
 void ffInitShellOptions(FFShellOptions* options)
 {
     options->moduleName = FF_SHELL_MODULE_NAME;
@@ -64,11 +105,8 @@ void ffDestroyShellOptions(FFShellOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseShellJsonObject(yyjson_val* module)
+void ffParseShellJsonObject(FFShellOptions* options, yyjson_val* module)
 {
-    FFShellOptions __attribute__((__cleanup__(ffDestroyShellOptions))) options;
-    ffInitShellOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -79,12 +117,10 @@ void ffParseShellJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_SHELL_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_SHELL_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintShell(&options);
 }
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/terminalshell/terminalshell.h"
 
 #define FF_SHELL_MODULE_NAME "Shell"
 
 void ffPrintShell(FFShellOptions* options);
+const char* ffDetectShellModule(FFShellOptions* options, const FFTerminalShellResult** pResult);
+void ffRenderShellModule(FFShellOptions* options, const FFTerminalShellResult** pResult);
+void ffGenerateShellJsonResult(FFShellOptions* options, const FFTerminalShellResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitShellOptions(FFShellOptions* options);
 bool ffParseShellCommandOptions(FFShellOptions* options, const char* key, const char* value);
 void ffDestroyShellOptions(FFShellOptions* options);
-void ffParseShellJsonObject(yyjson_val* module);
+void ffParseShellJsonObject(FFShellOptions* options, yyjson_val* module);
@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/sound/sound.h"
 #include "modules/sound/sound.h"
 #include "util/stringUtils.h"
@@ -37,51 +38,86 @@ static void printDevice(FFSoundOptions* options, const FFSoundDevice* device, ui
     }
 }
 
-void ffPrintSound(FFSoundOptions* options)
+static void destroyDevice(FFSoundDevice* device)
 {
-    FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFSoundDevice));
+    ffStrbufDestroy(&device->identifier);
+    ffStrbufDestroy(&device->name);
+}
 
-    const char* error = ffDetectSound(&result);
+const char* ffDetectSoundModule(FFSoundOptions* options, FFlist* devices)
+{
+    ffListInit(devices, sizeof(FFSoundDevice));
 
+    const char* error = ffDetectSound(devices);
     if(error)
-    {
-        ffPrintError(FF_SOUND_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
-
-    FF_LIST_AUTO_DESTROY filtered = ffListCreate(sizeof(FFSoundDevice*));
+        return error;
 
-    FF_LIST_FOR_EACH(FFSoundDevice, device, result)
+    uint32_t count = 0;
+    FF_LIST_FOR_EACH(FFSoundDevice, device, *devices)
     {
+        bool keep = true;
         switch (options->soundType)
         {
-            case FF_SOUND_TYPE_MAIN: if (!device->main) continue; break;
-            case FF_SOUND_TYPE_ACTIVE: if (!device->active) continue; break;
+            case FF_SOUND_TYPE_MAIN: keep = device->main; break;
+            case FF_SOUND_TYPE_ACTIVE: keep = device->active; break;
             case FF_SOUND_TYPE_ALL: break;
         }
 
-        *(FFSoundDevice**)ffListAdd(&filtered) = device;
+        if(keep)
+            *(FFSoundDevice*) ffListGet(devices, count++) = *device;
+        else
+            destroyDevice(device);
     }
+    devices->length = count;
 
-    if(filtered.length == 0)
-    {
-        ffPrintError(FF_SOUND_MODULE_NAME, 0, &options->moduleArgs, "No active sound devices found");
-        return;
-    }
+    if(devices->length == 0)
+        return "No active sound devices found";
+
+    return NULL;
+}
 
+void ffRenderSoundModule(FFSoundOptions* options, FFlist* devices)
+{
     uint8_t index = 1;
-    FF_LIST_FOR_EACH(FFSoundDevice*, device, filtered)
+    FF_LIST_FOR_EACH(FFSoundDevice, device, *devices)
     {
-        printDevice(options, *device, filtered.length == 1 ? 0 : index++);
+        printDevice(options, device, devices->length == 1 ? 0 : index++);
     }
+}
 
-    FF_LIST_FOR_EACH(FFSoundDevice, device, result)
+void ffGenerateSoundJsonResult(FF_MAYBE_UNUSED FFSoundOptions* options, FFlist* devices, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(FFSoundDevice, device, *devices)
     {
-        ffStrbufDestroy(&device->identifier);
-        ffStrbufDestroy(&device->name);
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+        ffJsonResultAddStrbuf(doc, obj, "identifier", &device->identifier);
+        ffJsonResultAddStrbuf(doc, obj, "name", &device->name);
+        yyjson_mut_obj_add_uint(doc, obj, "volume", device->volume);
+        yyjson_mut_obj_add_bool(doc, obj, "main", device->main);
+        yyjson_mut_obj_add_bool(doc, obj, "active", device->active);
     }
 }
 
+void ffDestroySoundModuleResult(FFlist* devices)
+{
+    FF_LIST_FOR_EACH(FFSoundDevice, device, *devices)
+        destroyDevice(device);
+    ffListDestroy(devices);
+}
+
+void ffPrintSound(FFSoundOptions* options)
+{
+    FFlist devices;
+    const char* error = ffDetectSoundModule(options, &devices);
+
+    if(error)
+        ffPrintError(FF_SOUND_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderSoundModule(options, &devices);
+
+    ffDestroySoundModuleResult(&devices);
+}
 
 void ffInitSoundOptions(FFSoundOptions* options)
 {
@@ -117,11 +153,8 @@ void ffDestroySoundOptions(FFSoundOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseSoundJsonObject(yyjson_val* module)
+void ffParseSoundJsonObject(FFSoundOptions* options, yyjson_val* module)
 {
-    FFSoundOptions __attribute__((__cleanup__(ffDestroySoundOptions))) options;
-    ffInitSoundOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -132,7 +165,7 @@ void ffParseSoundJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             if (ffStrEqualsIgnCase(key, "soundType"))
@@ -145,15 +178,13 @@ void ffParseSoundJsonObject(yyjson_val* module)
                     {},
                 });
                 if (error)
-                    ffPrintError(FF_SOUND_MODULE_NAME, 0, &options.moduleArgs, "Invalid %s value: %s", key, error);
+                    ffPrintError(FF_SOUND_MODULE_NAME, 0, &options->moduleArgs, "Invalid %s value: %s", key, error);
                 else
-                    options.soundType = (FFSoundType) value;
+                    options->soundType = (FFSoundType) value;
                 continue;
             }
 
-            ffPrintError(FF_SOUND_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_SOUND_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintSound(&options);
 }
@@ -5,7 +5,11 @@
 #define FF_SOUND_MODULE_NAME "Sound"
 
 void ffPrintSound(FFSoundOptions* options);
+const char* ffDetectSoundModule(FFSoundOptions* options, FFlist* devices /* FFSoundDevice */);
+void ffRenderSoundModule(FFSoundOptions* options, FFlist* devices);
+void ffGenerateSoundJsonResult(FFSoundOptions* options, FFlist* devices, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroySoundModuleResult(FFlist* devices);
 void ffInitSoundOptions(FFSoundOptions* options);
 bool ffParseSoundCommandOptions(FFSoundOptions* options, const char* key, const char* value);
 void ffDestroySoundOptions(FFSoundOptions* options);
-void ffParseSoundJsonObject(yyjson_val* module);
+void ffParseSoundJsonObject(FFSoundOptions* options, yyjson_val* module);
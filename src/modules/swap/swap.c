@@ -1,38 +1,35 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "common/parsing.h"
 #include "common/bar.h"
 #include "detection/swap/swap.h"
 #include "modules/swap/swap.h"
 #include "util/stringUtils.h"
 
-#define FF_SWAP_NUM_FORMAT_ARGS 3
+#define FF_SWAP_NUM_FORMAT_ARGS 5
 
-void ffPrintSwap(FFSwapOptions* options)
+const char* ffDetectSwapModule(FF_MAYBE_UNUSED FFSwapOptions* options, FFSwapResult* storage)
 {
-    FFSwapResult storage;
-    const char* error = ffDetectSwap(&storage);
-
-    if(error)
-    {
-        ffPrintError(FF_SWAP_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+    return ffDetectSwap(storage);
+}
 
+void ffRenderSwapModule(FFSwapOptions* options, FFSwapResult* storage)
+{
     FF_STRBUF_AUTO_DESTROY usedPretty = ffStrbufCreate();
-    ffParseSize(storage.bytesUsed, instance.config.binaryPrefixType, &usedPretty);
+    ffParseSize(storage->bytesUsed, instance.config.binaryPrefixType, &usedPretty);
 
     FF_STRBUF_AUTO_DESTROY totalPretty = ffStrbufCreate();
-    ffParseSize(storage.bytesTotal, instance.config.binaryPrefixType, &totalPretty);
+    ffParseSize(storage->bytesTotal, instance.config.binaryPrefixType, &totalPretty);
 
-    uint8_t percentage = storage.bytesTotal == 0
+    uint8_t percentage = storage->bytesTotal == 0
         ? 0
-        : (uint8_t) (((long double) storage.bytesUsed / (long double) storage.bytesTotal) * 100.0);
+        : (uint8_t) (((long double) storage->bytesUsed / (long double) storage->bytesTotal) * 100.0);
 
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_SWAP_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        if (storage.bytesTotal == 0)
+        if (storage->bytesTotal == 0)
             puts("Disabled");
         else
         {
@@ -60,10 +57,30 @@ void ffPrintSwap(FFSwapOptions* options)
             {FF_FORMAT_ARG_TYPE_STRBUF, &usedPretty},
             {FF_FORMAT_ARG_TYPE_STRBUF, &totalPretty},
             {FF_FORMAT_ARG_TYPE_UINT8, &percentage},
+            {FF_FORMAT_ARG_TYPE_UINT64, &storage->bytesUsed},
+            {FF_FORMAT_ARG_TYPE_UINT64, &storage->bytesTotal},
         });
     }
 }
 
+void ffGenerateSwapJsonResult(FF_MAYBE_UNUSED FFSwapOptions* options, FFSwapResult* storage, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    yyjson_mut_obj_add_uint(doc, obj, "used", storage->bytesUsed);
+    yyjson_mut_obj_add_uint(doc, obj, "total", storage->bytesTotal);
+}
+
+void ffPrintSwap(FFSwapOptions* options)
+{
+    FFSwapResult storage;
+    const char* error = ffDetectSwapModule(options, &storage);
+
+    if(error)
+        ffPrintError(FF_SWAP_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderSwapModule(options, &storage);
+}
+
 void ffInitSwapOptions(FFSwapOptions* options)
 {
     options->moduleName = FF_SWAP_MODULE_NAME;
@@ -85,11 +102,8 @@ void ffDestroySwapOptions(FFSwapOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseSwapJsonObject(yyjson_val* module)
+void ffParseSwapJsonObject(FFSwapOptions* options, yyjson_val* module)
 {
-    FFSwapOptions __attribute__((__cleanup__(ffDestroySwapOptions))) options;
-    ffInitSwapOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -100,12 +114,10 @@ void ffParseSwapJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_SWAP_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_SWAP_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintSwap(&options);
 }
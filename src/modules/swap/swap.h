@@ -1,11 +1,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/swap/swap.h"
 
 #define FF_SWAP_MODULE_NAME "Swap"
 
 void ffPrintSwap(FFSwapOptions* options);
+const char* ffDetectSwapModule(FFSwapOptions* options, FFSwapResult* storage);
+void ffRenderSwapModule(FFSwapOptions* options, FFSwapResult* storage);
+void ffGenerateSwapJsonResult(FFSwapOptions* options, FFSwapResult* storage, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitSwapOptions(FFSwapOptions* options);
 bool ffParseSwapCommandOptions(FFSwapOptions* options, const char* key, const char* value);
 void ffDestroySwapOptions(FFSwapOptions* options);
-void ffParseSwapJsonObject(yyjson_val* module);
+void ffParseSwapJsonObject(FFSwapOptions* options, yyjson_val* module);
@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/terminalshell/terminalshell.h"
 #include "modules/terminal/terminal.h"
 #include "util/stringUtils.h"
@@ -8,15 +9,19 @@
 
 #define FF_TERMINAL_NUM_FORMAT_ARGS 10
 
-void ffPrintTerminal(FFTerminalOptions* options)
+const char* ffDetectTerminalModule(FF_MAYBE_UNUSED FFTerminalOptions* options, const FFTerminalShellResult** pResult)
 {
-    const FFTerminalShellResult* result = ffDetectTerminalShell();
+    *pResult = ffDetectTerminalShell();
 
-    if(result->terminalProcessName.length == 0)
-    {
-        ffPrintError(FF_TERMINAL_MODULE_NAME, 0, &options->moduleArgs, "Couldn't detect terminal");
-        return;
-    }
+    if((*pResult)->terminalProcessName.length == 0)
+        return "Couldn't detect terminal";
+
+    return NULL;
+}
+
+void ffRenderTerminalModule(FFTerminalOptions* options, const FFTerminalShellResult** pResult)
+{
+    const FFTerminalShellResult* result = *pResult;
 
     if(options->moduleArgs.outputFormat.length == 0)
     {
@@ -44,6 +49,29 @@ void ffPrintTerminal(FFTerminalOptions* options)
     }
 }
 
+void ffGenerateTerminalJsonResult(FF_MAYBE_UNUSED FFTerminalOptions* options, const FFTerminalShellResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    const FFTerminalShellResult* result = *pResult;
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "exe", &result->terminalExe);
+    yyjson_mut_obj_add_strcpy(doc, obj, "exeName", result->terminalExeName ? result->terminalExeName : "");
+    ffJsonResultAddStrbuf(doc, obj, "processName", &result->terminalProcessName);
+    ffJsonResultAddStrbuf(doc, obj, "prettyName", &result->terminalPrettyName);
+    ffJsonResultAddStrbuf(doc, obj, "version", &result->terminalVersion);
+    yyjson_mut_obj_add_uint(doc, obj, "pid", result->terminalPid);
+}
+
+void ffPrintTerminal(FFTerminalOptions* options)
+{
+    const FFTerminalShellResult* result;
+    const char* error = ffDetectTerminalModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_TERMINAL_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderTerminalModule(options, &result);
+}
+
 void ffInitTerminalOptions(FFTerminalOptions* options)
 {
     options->moduleName = FF_TERMINAL_MODULE_NAME;
@@ -65,11 +93,8 @@ void ffDestroyTerminalOptions(FFTerminalOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseTerminalJsonObject(yyjson_val* module)
+void ffParseTerminalJsonObject(FFTerminalOptions* options, yyjson_val* module)
 {
-    FFTerminalOptions __attribute__((__cleanup__(ffDestroyTerminalOptions))) options;
-    ffInitTerminalOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -80,12 +105,10 @@ void ffParseTerminalJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_TERMINAL_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_TERMINAL_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintTerminal(&options);
 }
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/terminalshell/terminalshell.h"
 
 #define FF_TERMINAL_MODULE_NAME "Terminal"
 
 void ffPrintTerminal(FFTerminalOptions* options);
+const char* ffDetectTerminalModule(FFTerminalOptions* options, const FFTerminalShellResult** pResult);
+void ffRenderTerminalModule(FFTerminalOptions* options, const FFTerminalShellResult** pResult);
+void ffGenerateTerminalJsonResult(FFTerminalOptions* options, const FFTerminalShellResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitTerminalOptions(FFTerminalOptions* options);
 bool ffParseTerminalCommandOptions(FFTerminalOptions* options, const char* key, const char* value);
 void ffDestroyTerminalOptions(FFTerminalOptions* options);
-void ffParseTerminalJsonObject(yyjson_val* module);
+void ffParseTerminalJsonObject(FFTerminalOptions* options, yyjson_val* module);
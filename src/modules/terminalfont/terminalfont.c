@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/terminalfont/terminalfont.h"
 #include "modules/terminalfont/terminalfont.h"
 #include "util/stringUtils.h"
@@ -7,36 +8,63 @@
 #define FF_TERMINALFONT_DISPLAY_NAME "Terminal Font"
 #define FF_TERMINALFONT_NUM_FORMAT_ARGS 4
 
-void ffPrintTerminalFont(FFTerminalFontOptions* options)
+const char* ffDetectTerminalFontModule(FF_MAYBE_UNUSED FFTerminalFontOptions* options, FFTerminalFontResult* terminalFont)
 {
-    FFTerminalFontResult terminalFont;
-    ffFontInit(&terminalFont.font);
-    ffStrbufInit(&terminalFont.error);
+    ffFontInit(&terminalFont->font);
+    ffStrbufInit(&terminalFont->error);
 
-    if(!ffDetectTerminalFont(&terminalFont))
+    if(!ffDetectTerminalFont(terminalFont))
+        return terminalFont->error.chars;
+
+    return NULL;
+}
+
+void ffRenderTerminalFontModule(FFTerminalFontOptions* options, FFTerminalFontResult* terminalFont)
+{
+    if(options->moduleArgs.outputFormat.length == 0)
     {
-        ffPrintError(FF_TERMINALFONT_DISPLAY_NAME, 0, &options->moduleArgs, "%s", terminalFont.error.chars);
+        ffPrintLogoAndKey(FF_TERMINALFONT_DISPLAY_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
+        ffStrbufPutTo(&terminalFont->font.pretty, stdout);
     }
     else
     {
-        if(options->moduleArgs.outputFormat.length == 0)
-        {
-            ffPrintLogoAndKey(FF_TERMINALFONT_DISPLAY_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-            ffStrbufPutTo(&terminalFont.font.pretty, stdout);
-        }
-        else
-        {
-            ffPrintFormat(FF_TERMINALFONT_DISPLAY_NAME, 0, &options->moduleArgs, FF_TERMINALFONT_NUM_FORMAT_ARGS, (FFformatarg[]){
-                {FF_FORMAT_ARG_TYPE_STRBUF, &terminalFont.font.pretty},
-                {FF_FORMAT_ARG_TYPE_STRBUF, &terminalFont.font.name},
-                {FF_FORMAT_ARG_TYPE_STRBUF, &terminalFont.font.size},
-                {FF_FORMAT_ARG_TYPE_LIST,   &terminalFont.font.styles}
-            });
-        }
+        ffPrintFormat(FF_TERMINALFONT_DISPLAY_NAME, 0, &options->moduleArgs, FF_TERMINALFONT_NUM_FORMAT_ARGS, (FFformatarg[]){
+            {FF_FORMAT_ARG_TYPE_STRBUF, &terminalFont->font.pretty},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &terminalFont->font.name},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &terminalFont->font.size},
+            {FF_FORMAT_ARG_TYPE_LIST,   &terminalFont->font.styles}
+        });
     }
+}
 
-    ffStrbufDestroy(&terminalFont.error);
-    ffFontDestroy(&terminalFont.font);
+void ffGenerateTerminalFontJsonResult(FF_MAYBE_UNUSED FFTerminalFontOptions* options, FFTerminalFontResult* terminalFont, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "pretty", &terminalFont->font.pretty);
+    ffJsonResultAddStrbuf(doc, obj, "name", &terminalFont->font.name);
+    ffJsonResultAddStrbuf(doc, obj, "size", &terminalFont->font.size);
+    yyjson_mut_val* styles = ffJsonResultAddArr(doc, obj, "styles");
+    FF_LIST_FOR_EACH(FFstrbuf, style, terminalFont->font.styles)
+        ffJsonResultAppendStrbuf(doc, styles, style);
+}
+
+void ffDestroyTerminalFontModuleResult(FFTerminalFontResult* terminalFont)
+{
+    ffStrbufDestroy(&terminalFont->error);
+    ffFontDestroy(&terminalFont->font);
+}
+
+void ffPrintTerminalFont(FFTerminalFontOptions* options)
+{
+    FFTerminalFontResult terminalFont;
+    const char* error = ffDetectTerminalFontModule(options, &terminalFont);
+
+    if(error)
+        ffPrintError(FF_TERMINALFONT_DISPLAY_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderTerminalFontModule(options, &terminalFont);
+
+    ffDestroyTerminalFontModuleResult(&terminalFont);
 }
 
 void ffInitTerminalFontOptions(FFTerminalFontOptions* options)
@@ -60,11 +88,8 @@ void ffDestroyTerminalFontOptions(FFTerminalFontOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseTerminalFontJsonObject(yyjson_val* module)
+void ffParseTerminalFontJsonObject(FFTerminalFontOptions* options, yyjson_val* module)
 {
-    FFTerminalFontOptions __attribute__((__cleanup__(ffDestroyTerminalFontOptions))) options;
-    ffInitTerminalFontOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -75,12 +100,10 @@ void ffParseTerminalFontJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_TERMINALFONT_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_TERMINALFONT_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintTerminalFont(&options);
 }
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/terminalfont/terminalfont.h"
 
 #define FF_TERMINALFONT_MODULE_NAME "TerminalFont"
 
 void ffPrintTerminalFont(FFTerminalFontOptions* options);
+const char* ffDetectTerminalFontModule(FFTerminalFontOptions* options, FFTerminalFontResult* terminalFont);
+void ffRenderTerminalFontModule(FFTerminalFontOptions* options, FFTerminalFontResult* terminalFont);
+void ffGenerateTerminalFontJsonResult(FFTerminalFontOptions* options, FFTerminalFontResult* terminalFont, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyTerminalFontModuleResult(FFTerminalFontResult* terminalFont);
 void ffInitTerminalFontOptions(FFTerminalFontOptions* options);
 bool ffParseTerminalFontCommandOptions(FFTerminalFontOptions* options, const char* key, const char* value);
 void ffDestroyTerminalFontOptions(FFTerminalFontOptions* options);
-void ffParseTerminalFontJsonObject(yyjson_val* module);
+void ffParseTerminalFontJsonObject(FFTerminalFontOptions* options, yyjson_val* module);
@@ -1,35 +1,56 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/theme/theme.h"
 #include "modules/theme/theme.h"
 #include "util/stringUtils.h"
 
 #define FF_THEME_NUM_FORMAT_ARGS 1
 
-void ffPrintTheme(FFThemeOptions* options)
+const char* ffDetectThemeModule(FF_MAYBE_UNUSED FFThemeOptions* options, FFstrbuf* theme)
 {
-    FF_STRBUF_AUTO_DESTROY theme = ffStrbufCreate();
-    const char* error = ffDetectTheme(&theme);
-
-    if(error)
-    {
-        ffPrintError(FF_THEME_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+    ffStrbufInit(theme);
+    return ffDetectTheme(theme);
+}
 
+void ffRenderThemeModule(FFThemeOptions* options, FFstrbuf* theme)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_THEME_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        ffStrbufPutTo(&theme, stdout);
+        ffStrbufPutTo(theme, stdout);
     }
     else
     {
         ffPrintFormat(FF_THEME_MODULE_NAME, 0, &options->moduleArgs, FF_THEME_NUM_FORMAT_ARGS, (FFformatarg[]){
-            {FF_FORMAT_ARG_TYPE_STRBUF, &theme}
+            {FF_FORMAT_ARG_TYPE_STRBUF, theme}
         });
     }
 }
 
+void ffGenerateThemeJsonResult(FF_MAYBE_UNUSED FFThemeOptions* options, FFstrbuf* theme, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    ffJsonResultAddStrbuf(doc, module, "result", theme);
+}
+
+void ffDestroyThemeModuleResult(FFstrbuf* theme)
+{
+    ffStrbufDestroy(theme);
+}
+
+void ffPrintTheme(FFThemeOptions* options)
+{
+    FFstrbuf theme;
+    const char* error = ffDetectThemeModule(options, &theme);
+
+    if(error)
+        ffPrintError(FF_THEME_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderThemeModule(options, &theme);
+
+    ffDestroyThemeModuleResult(&theme);
+}
+
 void ffInitThemeOptions(FFThemeOptions* options)
 {
     options->moduleName = FF_THEME_MODULE_NAME;
@@ -51,11 +72,8 @@ void ffDestroyThemeOptions(FFThemeOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseThemeJsonObject(yyjson_val* module)
+void ffParseThemeJsonObject(FFThemeOptions* options, yyjson_val* module)
 {
-    FFThemeOptions __attribute__((__cleanup__(ffDestroyThemeOptions))) options;
-    ffInitThemeOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -66,12 +84,10 @@ void ffParseThemeJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_THEME_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_THEME_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintTheme(&options);
 }
@@ -5,7 +5,11 @@
 #define FF_THEME_MODULE_NAME "Theme"
 
 void ffPrintTheme(FFThemeOptions* options);
+const char* ffDetectThemeModule(FFThemeOptions* options, FFstrbuf* theme);
+void ffRenderThemeModule(FFThemeOptions* options, FFstrbuf* theme);
+void ffGenerateThemeJsonResult(FFThemeOptions* options, FFstrbuf* theme, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyThemeModuleResult(FFstrbuf* theme);
 void ffInitThemeOptions(FFThemeOptions* options);
 bool ffParseThemeCommandOptions(FFThemeOptions* options, const char* key, const char* value);
 void ffDestroyThemeOptions(FFThemeOptions* options);
-void ffParseThemeJsonObject(yyjson_val* module);
+void ffParseThemeJsonObject(FFThemeOptions* options, yyjson_val* module);
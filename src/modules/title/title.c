@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "modules/title/title.h"
 #include "util/textModifier.h"
 #include "util/stringUtils.h"
@@ -44,6 +45,15 @@ void ffPrintTitle(FFTitleOptions* options)
     instance.state.titleLength = instance.state.platform.userName.length + host->length + 1;
 }
 
+void ffGenerateTitleJsonResult(FFTitleOptions* options, FF_MAYBE_UNUSED void* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "userName", &instance.state.platform.userName);
+    ffJsonResultAddStrbuf(doc, obj, "hostName", options->fqdn ? &instance.state.platform.domainName : &instance.state.platform.hostName);
+    ffJsonResultAddStrbuf(doc, obj, "homeDir", &instance.state.platform.homeDir);
+    ffJsonResultAddStrbuf(doc, obj, "userShell", &instance.state.platform.userShell);
+}
+
 void ffInitTitleOptions(FFTitleOptions* options)
 {
     options->moduleName = FF_TITLE_MODULE_NAME;
@@ -72,11 +82,8 @@ void ffDestroyTitleOptions(FFTitleOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseTitleJsonObject(yyjson_val* module)
+void ffParseTitleJsonObject(FFTitleOptions* options, yyjson_val* module)
 {
-    FFTitleOptions __attribute__((__cleanup__(ffDestroyTitleOptions))) options;
-    ffInitTitleOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -87,18 +94,16 @@ void ffParseTitleJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             if (ffStrEqualsIgnCase(key, "fqdn"))
             {
-                options.fqdn = yyjson_get_bool(val);
+                options->fqdn = yyjson_get_bool(val);
                 continue;
             }
 
             ffPrintErrorString(FF_TITLE_MODULE_NAME, 0, NULL, NULL, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintTitle(&options);
 }
@@ -5,7 +5,8 @@
 #define FF_TITLE_MODULE_NAME "Title"
 
 void ffPrintTitle(FFTitleOptions* options);
+void ffGenerateTitleJsonResult(FFTitleOptions* options, void* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitTitleOptions(FFTitleOptions* options);
 bool ffParseTitleCommandOptions(FFTitleOptions* options, const char* key, const char* value);
 void ffDestroyTitleOptions(FFTitleOptions* options);
-void ffParseTitleJsonObject(yyjson_val* module);
+void ffParseTitleJsonObject(FFTitleOptions* options, yyjson_val* module);
@@ -1,27 +1,24 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/uptime/uptime.h"
 #include "modules/uptime/uptime.h"
 #include "util/stringUtils.h"
 
 #define FF_UPTIME_NUM_FORMAT_ARGS 4
 
-void ffPrintUptime(FFUptimeOptions* options)
+const char* ffDetectUptimeModule(FF_MAYBE_UNUSED FFUptimeOptions* options, uint64_t* uptime)
 {
-    uint64_t uptime;
-
-    const char* error = ffDetectUptime(&uptime);
-
-    if(error)
-    {
-        ffPrintError(FF_UPTIME_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+    *uptime = 0;
+    return ffDetectUptime(uptime);
+}
 
-    uint32_t days    = (uint32_t)  uptime / 86400;
-    uint32_t hours   = (uint32_t) (uptime - (days * 86400)) / 3600;
-    uint32_t minutes = (uint32_t) (uptime - (days * 86400) - (hours * 3600)) / 60;
-    uint32_t seconds = (uint32_t)  uptime - (days * 86400) - (hours * 3600) - (minutes * 60);
+void ffRenderUptimeModule(FFUptimeOptions* options, uint64_t* uptime)
+{
+    uint32_t days    = (uint32_t)  *uptime / 86400;
+    uint32_t hours   = (uint32_t) (*uptime - (days * 86400)) / 3600;
+    uint32_t minutes = (uint32_t) (*uptime - (days * 86400) - (hours * 3600)) / 60;
+    uint32_t seconds = (uint32_t)  *uptime - (days * 86400) - (hours * 3600) - (minutes * 60);
 
     if(options->moduleArgs.outputFormat.length == 0)
     {
@@ -79,6 +76,22 @@ void ffPrintUptime(FFUptimeOptions* options)
     }
 }
 
+void ffGenerateUptimeJsonResult(FF_MAYBE_UNUSED FFUptimeOptions* options, uint64_t* uptime, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_obj_add_uint(doc, module, "result", *uptime); // Seconds
+}
+
+void ffPrintUptime(FFUptimeOptions* options)
+{
+    uint64_t uptime;
+    const char* error = ffDetectUptimeModule(options, &uptime);
+
+    if(error)
+        ffPrintError(FF_UPTIME_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderUptimeModule(options, &uptime);
+}
+
 void ffInitUptimeOptions(FFUptimeOptions* options)
 {
     options->moduleName = FF_UPTIME_MODULE_NAME;
@@ -100,11 +113,8 @@ void ffDestroyUptimeOptions(FFUptimeOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseUptimeJsonObject(yyjson_val* module)
+void ffParseUptimeJsonObject(FFUptimeOptions* options, yyjson_val* module)
 {
-    FFUptimeOptions __attribute__((__cleanup__(ffDestroyUptimeOptions))) options;
-    ffInitUptimeOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -115,12 +125,10 @@ void ffParseUptimeJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_UPTIME_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_UPTIME_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintUptime(&options);
 }
@@ -5,7 +5,10 @@
 #define FF_UPTIME_MODULE_NAME "Uptime"
 
 void ffPrintUptime(FFUptimeOptions* options);
+const char* ffDetectUptimeModule(FFUptimeOptions* options, uint64_t* uptime);
+void ffRenderUptimeModule(FFUptimeOptions* options, uint64_t* uptime);
+void ffGenerateUptimeJsonResult(FFUptimeOptions* options, uint64_t* uptime, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitUptimeOptions(FFUptimeOptions* options);
 bool ffParseUptimeCommandOptions(FFUptimeOptions* options, const char* key, const char* value);
 void ffDestroyUptimeOptions(FFUptimeOptions* options);
-void ffParseUptimeJsonObject(yyjson_val* module);
+void ffParseUptimeJsonObject(FFUptimeOptions* options, yyjson_val* module);
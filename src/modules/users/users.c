@@ -1,33 +1,26 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/users/users.h"
 #include "modules/users/users.h"
 #include "util/stringUtils.h"
 
 #define FF_USERS_NUM_FORMAT_ARGS 1
 
-void ffPrintUsers(FFUsersOptions* options)
+const char* ffDetectUsersModule(FF_MAYBE_UNUSED FFUsersOptions* options, FFlist* users)
 {
-    FF_LIST_AUTO_DESTROY users = ffListCreate(sizeof(FFstrbuf));
-
-    FF_STRBUF_AUTO_DESTROY error = ffStrbufCreate();
-
-    ffDetectUsers(&users, &error);
-
-    if(error.length > 0)
-    {
-        ffPrintError(FF_USERS_MODULE_NAME, 0, &options->moduleArgs, "%*s", error.length, error.chars);
-        return;
-    }
+    ffListInit(users, sizeof(FFstrbuf));
+    return ffDetectUsers(users);
+}
 
+void ffRenderUsersModule(FFUsersOptions* options, FFlist* users)
+{
     FF_STRBUF_AUTO_DESTROY result = ffStrbufCreate();
-    for(uint32_t i = 0; i < users.length; ++i)
+    FF_LIST_FOR_EACH(FFstrbuf, user, *users)
     {
-        if(i > 0)
+        if(result.length > 0)
             ffStrbufAppendS(&result, ", ");
-        FFstrbuf* user = (FFstrbuf*)ffListGet(&users, i);
         ffStrbufAppend(&result, user);
-        ffStrbufDestroy(user);
     }
 
     if(options->moduleArgs.outputFormat.length == 0)
@@ -43,6 +36,33 @@ void ffPrintUsers(FFUsersOptions* options)
     }
 }
 
+void ffGenerateUsersJsonResult(FF_MAYBE_UNUSED FFUsersOptions* options, FFlist* users, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(FFstrbuf, user, *users)
+        ffJsonResultAppendStrbuf(doc, arr, user);
+}
+
+void ffDestroyUsersModuleResult(FFlist* users)
+{
+    FF_LIST_FOR_EACH(FFstrbuf, user, *users)
+        ffStrbufDestroy(user);
+    ffListDestroy(users);
+}
+
+void ffPrintUsers(FFUsersOptions* options)
+{
+    FFlist users;
+    const char* error = ffDetectUsersModule(options, &users);
+
+    if(error)
+        ffPrintError(FF_USERS_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderUsersModule(options, &users);
+
+    ffDestroyUsersModuleResult(&users);
+}
+
 void ffInitUsersOptions(FFUsersOptions* options)
 {
     options->moduleName = FF_USERS_MODULE_NAME;
@@ -64,11 +84,8 @@ void ffDestroyUsersOptions(FFUsersOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseUsersJsonObject(yyjson_val* module)
+void ffParseUsersJsonObject(FFUsersOptions* options, yyjson_val* module)
 {
-    FFUsersOptions __attribute__((__cleanup__(ffDestroyUsersOptions))) options;
-    ffInitUsersOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -79,12 +96,10 @@ void ffParseUsersJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_USERS_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_USERS_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintUsers(&options);
 }
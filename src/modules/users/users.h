@@ -5,7 +5,11 @@
 #define FF_USERS_MODULE_NAME "Users"
 
 void ffPrintUsers(FFUsersOptions* options);
+const char* ffDetectUsersModule(FFUsersOptions* options, FFlist* users /* FFstrbuf */);
+void ffRenderUsersModule(FFUsersOptions* options, FFlist* users);
+void ffGenerateUsersJsonResult(FFUsersOptions* options, FFlist* users, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyUsersModuleResult(FFlist* users);
 void ffInitUsersOptions(FFUsersOptions* options);
 bool ffParseUsersCommandOptions(FFUsersOptions* options, const char* key, const char* value);
 void ffDestroyUsersOptions(FFUsersOptions* options);
-void ffParseUsersJsonObject(yyjson_val* module);
+void ffParseUsersJsonObject(FFUsersOptions* options, yyjson_val* module);
@@ -1,20 +1,22 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "detection/gpu/gpu.h"
 #include "detection/vulkan/vulkan.h"
 #include "modules/vulkan/vulkan.h"
 #include "util/stringUtils.h"
 
 #define FF_VULKAN_NUM_FORMAT_ARGS 3
 
-void ffPrintVulkan(FFVulkanOptions* options)
+const char* ffDetectVulkanModule(FF_MAYBE_UNUSED FFVulkanOptions* options, const FFVulkanResult** pResult)
 {
-    const FFVulkanResult* vulkan = ffDetectVulkan();
+    *pResult = ffDetectVulkan();
+    return (*pResult)->error;
+}
 
-    if(vulkan->error)
-    {
-        ffPrintError(FF_VULKAN_MODULE_NAME, 0, &options->moduleArgs, "%s", vulkan->error);
-        return;
-    }
+void ffRenderVulkanModule(FFVulkanOptions* options, const FFVulkanResult** pResult)
+{
+    const FFVulkanResult* vulkan = *pResult;
 
     if(options->moduleArgs.outputFormat.length == 0)
     {
@@ -43,6 +45,35 @@ void ffPrintVulkan(FFVulkanOptions* options)
     }
 }
 
+void ffGenerateVulkanJsonResult(FF_MAYBE_UNUSED FFVulkanOptions* options, const FFVulkanResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    const FFVulkanResult* vulkan = *pResult;
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "driver", &vulkan->driver);
+    ffJsonResultAddStrbuf(doc, obj, "apiVersion", &vulkan->apiVersion);
+    ffJsonResultAddStrbuf(doc, obj, "conformanceVersion", &vulkan->conformanceVersion);
+    yyjson_mut_val* gpus = ffJsonResultAddArr(doc, obj, "gpus");
+    FF_LIST_FOR_EACH(FFGPUResult, gpu, vulkan->gpus)
+    {
+        yyjson_mut_val* item = yyjson_mut_arr_add_obj(doc, gpus);
+        ffJsonResultAddStrbuf(doc, item, "name", &gpu->name);
+        ffJsonResultAddStrbuf(doc, item, "vendor", &gpu->vendor);
+        ffJsonResultAddStrbuf(doc, item, "driver", &gpu->driver);
+        yyjson_mut_obj_add_uint(doc, item, "deviceId", gpu->vulkanDeviceId);
+    }
+}
+
+void ffPrintVulkan(FFVulkanOptions* options)
+{
+    const FFVulkanResult* vulkan;
+    const char* error = ffDetectVulkanModule(options, &vulkan);
+
+    if(error)
+        ffPrintError(FF_VULKAN_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderVulkanModule(options, &vulkan);
+}
+
 void ffInitVulkanOptions(FFVulkanOptions* options)
 {
     options->moduleName = FF_VULKAN_MODULE_NAME;
@@ -64,11 +95,8 @@ void ffDestroyVulkanOptions(FFVulkanOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseVulkanJsonObject(yyjson_val* module)
+void ffParseVulkanJsonObject(FFVulkanOptions* options, yyjson_val* module)
 {
-    FFVulkanOptions __attribute__((__cleanup__(ffDestroyVulkanOptions))) options;
-    ffInitVulkanOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -79,12 +107,10 @@ void ffParseVulkanJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_VULKAN_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_VULKAN_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintVulkan(&options);
 }
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/vulkan/vulkan.h"
 
 #define FF_VULKAN_MODULE_NAME "Vulkan"
 
 void ffPrintVulkan(FFVulkanOptions* options);
+const char* ffDetectVulkanModule(FFVulkanOptions* options, const FFVulkanResult** pResult);
+void ffRenderVulkanModule(FFVulkanOptions* options, const FFVulkanResult** pResult);
+void ffGenerateVulkanJsonResult(FFVulkanOptions* options, const FFVulkanResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitVulkanOptions(FFVulkanOptions* options);
 bool ffParseVulkanCommandOptions(FFVulkanOptions* options, const char* key, const char* value);
 void ffDestroyVulkanOptions(FFVulkanOptions* options);
-void ffParseVulkanJsonObject(yyjson_val* module);
+void ffParseVulkanJsonObject(FFVulkanOptions* options, yyjson_val* module);
@@ -1,32 +1,30 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/wallpaper/wallpaper.h"
 #include "modules/wallpaper/wallpaper.h"
 #include "util/stringUtils.h"
 
 #define FF_WALLPAPER_NUM_FORMAT_ARGS 2
 
-void ffPrintWallpaper(FFWallpaperOptions* options)
+const char* ffDetectWallpaperModule(FF_MAYBE_UNUSED FFWallpaperOptions* options, FFstrbuf* fullpath)
 {
-    FF_STRBUF_AUTO_DESTROY fullpath = ffStrbufCreate();
-    const char* error = ffDetectWallpaper(&fullpath);
+    ffStrbufInit(fullpath);
+    return ffDetectWallpaper(fullpath);
+}
 
-    const uint32_t index = ffStrbufLastIndexC(&fullpath,
+void ffRenderWallpaperModule(FFWallpaperOptions* options, FFstrbuf* fullpath)
+{
+    const uint32_t index = ffStrbufLastIndexC(fullpath,
         #ifndef _WIN32
         '/'
         #else
         '\\'
         #endif
     ) + 1;
-    const char* filename = index >= fullpath.length
-        ? fullpath.chars
-        : fullpath.chars + index;
-
-    if(error)
-    {
-        ffPrintError(FF_WALLPAPER_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
+    const char* filename = index >= fullpath->length
+        ? fullpath->chars
+        : fullpath->chars + index;
 
     if(options->moduleArgs.outputFormat.length == 0)
     {
@@ -37,11 +35,34 @@ void ffPrintWallpaper(FFWallpaperOptions* options)
     {
         ffPrintFormat(FF_WALLPAPER_MODULE_NAME, 0, &options->moduleArgs, FF_WALLPAPER_NUM_FORMAT_ARGS, (FFformatarg[]){
             {FF_FORMAT_ARG_TYPE_STRING, filename},
-            {FF_FORMAT_ARG_TYPE_STRBUF, &fullpath},
+            {FF_FORMAT_ARG_TYPE_STRBUF, fullpath},
         });
     }
 }
 
+void ffGenerateWallpaperJsonResult(FF_MAYBE_UNUSED FFWallpaperOptions* options, FFstrbuf* fullpath, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    ffJsonResultAddStrbuf(doc, module, "result", fullpath);
+}
+
+void ffDestroyWallpaperModuleResult(FFstrbuf* fullpath)
+{
+    ffStrbufDestroy(fullpath);
+}
+
+void ffPrintWallpaper(FFWallpaperOptions* options)
+{
+    FFstrbuf fullpath;
+    const char* error = ffDetectWallpaperModule(options, &fullpath);
+
+    if(error)
+        ffPrintError(FF_WALLPAPER_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderWallpaperModule(options, &fullpath);
+
+    ffDestroyWallpaperModuleResult(&fullpath);
+}
+
 void ffInitWallpaperOptions(FFWallpaperOptions* options)
 {
     options->moduleName = FF_WALLPAPER_MODULE_NAME;
@@ -63,11 +84,8 @@ void ffDestroyWallpaperOptions(FFWallpaperOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseWallpaperJsonObject(yyjson_val* module)
+void ffParseWallpaperJsonObject(FFWallpaperOptions* options, yyjson_val* module)
 {
-    FFWallpaperOptions __attribute__((__cleanup__(ffDestroyWallpaperOptions))) options;
-    ffInitWallpaperOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -78,12 +96,10 @@ void ffParseWallpaperJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_WALLPAPER_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_WALLPAPER_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintWallpaper(&options);
 }
@@ -5,7 +5,11 @@
 #define FF_WALLPAPER_MODULE_NAME "Wallpaper"
 
 void ffPrintWallpaper(FFWallpaperOptions* options);
+const char* ffDetectWallpaperModule(FFWallpaperOptions* options, FFstrbuf* fullpath);
+void ffRenderWallpaperModule(FFWallpaperOptions* options, FFstrbuf* fullpath);
+void ffGenerateWallpaperJsonResult(FFWallpaperOptions* options, FFstrbuf* fullpath, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyWallpaperModuleResult(FFstrbuf* fullpath);
 void ffInitWallpaperOptions(FFWallpaperOptions* options);
 bool ffParseWallpaperCommandOptions(FFWallpaperOptions* options, const char* key, const char* value);
 void ffDestroyWallpaperOptions(FFWallpaperOptions* options);
-void ffParseWallpaperJsonObject(yyjson_val* module);
+void ffParseWallpaperJsonObject(FFWallpaperOptions* options, yyjson_val* module);
@@ -1,5 +1,7 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
+#include "common/httpcache.h"
 #include "common/networking.h"
 #include "modules/weather/weather.h"
 #include "util/stringUtils.h"
@@ -8,48 +10,118 @@
 
 static FFNetworkingState state;
 static int status = -1;
+static FFHttpCacheStatus cacheStatus = FF_HTTP_CACHE_MISS;
+static FFstrbuf cachedBody;
+
+#define FF_WEATHER_HOST "wttr.in"
+
+static void refreshCache(const FFWeatherOptions* options, const FFstrbuf* path)
+{
+    char timeout[16], cacheTtl[16];
+    snprintf(timeout, sizeof(timeout), "%u", options->timeout);
+    snprintf(cacheTtl, sizeof(cacheTtl), "%u", options->cacheTtl);
+
+    ffHttpCacheRefresh(FF_WEATHER_HOST, path->chars, FF_WEATHER_MODULE_NAME, (const char*[]) {
+        "--weather-timeout", timeout,
+        "--weather-cache-ttl", cacheTtl,
+        "--weather-output-format", options->outputFormat.chars,
+        NULL
+    });
+}
 
 void ffPrepareWeather(FFWeatherOptions* options)
 {
     FF_STRBUF_AUTO_DESTROY path = ffStrbufCreateS("/?format=");
     ffStrbufAppend(&path, &options->outputFormat);
-    status = ffNetworkingSendHttpRequest(&state, "wttr.in", path.chars, "User-Agent: curl/0.0.0\r\n");
+
+    if(options->cacheTtl > 0)
+    {
+        ffStrbufInit(&cachedBody);
+        cacheStatus = ffHttpCacheLoad(&options->moduleArgs, FF_WEATHER_HOST, path.chars, options->cacheTtl, &cachedBody);
+        if(cacheStatus == FF_HTTP_CACHE_STALE)
+            refreshCache(options, &path);
+        if(cacheStatus != FF_HTTP_CACHE_MISS)
+        {
+            status = 1;
+            return;
+        }
+        ffStrbufDestroy(&cachedBody);
+    }
+
+    status = ffNetworkingSendHttpRequest(&state, FF_WEATHER_HOST, path.chars, "User-Agent: curl/0.0.0\r\n", options->timeout);
 }
 
-void ffPrintWeather(FFWeatherOptions* options)
+const char* ffDetectWeatherModule(FFWeatherOptions* options, FFstrbuf* result)
 {
+    ffStrbufInitA(result, 4096);
+
     if(status == -1)
         ffPrepareWeather(options);
 
-    if(status == 0)
+    if(cacheStatus != FF_HTTP_CACHE_MISS)
     {
-        ffPrintError(FF_WEATHER_MODULE_NAME, 0, &options->moduleArgs, "Failed to connect to 'wttr.in'");
-        return;
+        ffStrbufAppend(result, &cachedBody);
+        ffStrbufDestroy(&cachedBody);
+        return NULL;
     }
 
-    FF_STRBUF_AUTO_DESTROY result = ffStrbufCreateA(4096);
-    bool success = ffNetworkingRecvHttpResponse(&state, &result, options->timeout);
-    if (success) ffStrbufSubstrAfterFirstS(&result, "\r\n\r\n");
+    if(status == 0)
+        return "Failed to connect to '" FF_WEATHER_HOST "'";
+
+    bool success = ffNetworkingRecvHttpResponse(&state, result);
+    if (success) ffStrbufSubstrAfterFirstS(result, "\r\n\r\n");
+
+    if(!success || result->length == 0)
+        return "Failed to receive the server response";
 
-    if(!success || result.length == 0)
+    if(options->cacheTtl > 0)
     {
-        ffPrintError(FF_WEATHER_MODULE_NAME, 0, &options->moduleArgs, "Failed to receive the server response");
-        return;
+        FF_STRBUF_AUTO_DESTROY path = ffStrbufCreateS("/?format=");
+        ffStrbufAppend(&path, &options->outputFormat);
+        ffHttpCacheStore(&options->moduleArgs, FF_WEATHER_HOST, path.chars, result);
     }
 
+    return NULL;
+}
+
+void ffRenderWeatherModule(FFWeatherOptions* options, FFstrbuf* result)
+{
     if(options->moduleArgs.outputFormat.length == 0)
     {
         ffPrintLogoAndKey(FF_WEATHER_MODULE_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-        ffStrbufPutTo(&result, stdout);
+        ffStrbufPutTo(result, stdout);
     }
     else
     {
         ffPrintFormat(FF_WEATHER_MODULE_NAME, 0, &options->moduleArgs, FF_WEATHER_NUM_FORMAT_ARGS, (FFformatarg[]) {
-            {FF_FORMAT_ARG_TYPE_STRBUF, &result}
+            {FF_FORMAT_ARG_TYPE_STRBUF, result}
         });
     }
 }
 
+void ffGenerateWeatherJsonResult(FF_MAYBE_UNUSED FFWeatherOptions* options, FFstrbuf* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    ffJsonResultAddStrbuf(doc, module, "result", result);
+}
+
+void ffDestroyWeatherModuleResult(FFstrbuf* result)
+{
+    ffStrbufDestroy(result);
+}
+
+void ffPrintWeather(FFWeatherOptions* options)
+{
+    FFstrbuf result;
+    const char* error = ffDetectWeatherModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_WEATHER_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderWeatherModule(options, &result);
+
+    ffDestroyWeatherModuleResult(&result);
+}
+
 void ffInitWeatherOptions(FFWeatherOptions* options)
 {
     options->moduleName = FF_WEATHER_MODULE_NAME;
@@ -57,6 +129,7 @@ void ffInitWeatherOptions(FFWeatherOptions* options)
 
     ffStrbufInitS(&options->outputFormat, "%t+-+%C+(%l)");
     options->timeout = 0;
+    options->cacheTtl = 0;
 }
 
 bool ffParseWeatherCommandOptions(FFWeatherOptions* options, const char* key, const char* value)
@@ -78,6 +151,12 @@ bool ffParseWeatherCommandOptions(FFWeatherOptions* options, const char* key, co
         return true;
     }
 
+    if (ffStrEqualsIgnCase(subKey, "cache-ttl"))
+    {
+        options->cacheTtl = ffOptionParseUInt32(key, value);
+        return true;
+    }
+
     return false;
 }
 
@@ -88,11 +167,8 @@ void ffDestroyWeatherOptions(FFWeatherOptions* options)
     ffStrbufDestroy(&options->outputFormat);
 }
 
-void ffParseWeatherJsonObject(yyjson_val* module)
+void ffParseWeatherJsonObject(FFWeatherOptions* options, yyjson_val* module)
 {
-    FFWeatherOptions __attribute__((__cleanup__(ffDestroyWeatherOptions))) options;
-    ffInitWeatherOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -103,24 +179,28 @@ void ffParseWeatherJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
             if (ffStrEqualsIgnCase(key, "outputFormat"))
             {
-                ffStrbufSetS(&options.outputFormat, yyjson_get_str(val));
+                ffStrbufSetS(&options->outputFormat, yyjson_get_str(val));
                 continue;
             }
 
             if (ffStrEqualsIgnCase(key, "timeout"))
             {
-                options.timeout = (uint32_t) yyjson_get_uint(val);
+                options->timeout = (uint32_t) yyjson_get_uint(val);
                 continue;
             }
 
-            ffPrintError(FF_WEATHER_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            if (ffStrEqualsIgnCase(key, "cacheTtl"))
+            {
+                options->cacheTtl = (uint32_t) yyjson_get_uint(val);
+                continue;
+            }
+
+            ffPrintError(FF_WEATHER_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintWeather(&options);
 }
@@ -7,7 +7,11 @@
 void ffPrepareWeather(FFWeatherOptions* options);
 
 void ffPrintWeather(FFWeatherOptions* options);
+const char* ffDetectWeatherModule(FFWeatherOptions* options, FFstrbuf* result);
+void ffRenderWeatherModule(FFWeatherOptions* options, FFstrbuf* result);
+void ffGenerateWeatherJsonResult(FFWeatherOptions* options, FFstrbuf* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyWeatherModuleResult(FFstrbuf* result);
 void ffInitWeatherOptions(FFWeatherOptions* options);
 bool ffParseWeatherCommandOptions(FFWeatherOptions* options, const char* key, const char* value);
 void ffDestroyWeatherOptions(FFWeatherOptions* options);
-void ffParseWeatherJsonObject(yyjson_val* module);
+void ffParseWeatherJsonObject(FFWeatherOptions* options, yyjson_val* module);
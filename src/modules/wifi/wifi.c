@@ -1,31 +1,32 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/wifi/wifi.h"
 #include "modules/wifi/wifi.h"
 #include "util/stringUtils.h"
 
 #define FF_WIFI_NUM_FORMAT_ARGS 10
 
-void ffPrintWifi(FFWifiOptions* options)
+const char* ffDetectWifiModule(FF_MAYBE_UNUSED FFWifiOptions* options, FFlist* result)
 {
-    FF_LIST_AUTO_DESTROY result = ffListCreate(sizeof(FFWifiResult));
+    ffListInit(result, sizeof(FFWifiResult));
 
-    const char* error = ffDetectWifi(&result);
+    const char* error = ffDetectWifi(result);
     if(error)
-    {
-        ffPrintError(FF_WIFI_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
-        return;
-    }
-    if(!result.length)
-    {
-        ffPrintError(FF_WIFI_MODULE_NAME, 0, &options->moduleArgs, "No Wifi interfaces found");
-        return;
-    }
+        return error;
+
+    if(!result->length)
+        return "No Wifi interfaces found";
+
+    return NULL;
+}
 
-    for(uint32_t index = 0; index < result.length; ++index)
+void ffRenderWifiModule(FFWifiOptions* options, FFlist* result)
+{
+    for(uint32_t index = 0; index < result->length; ++index)
     {
-        FFWifiResult* item = (FFWifiResult*)ffListGet(&result, index);
-        uint8_t moduleIndex = result.length == 1 ? 0 : (uint8_t)(index + 1);
+        FFWifiResult* item = (FFWifiResult*)ffListGet(result, index);
+        uint8_t moduleIndex = result->length == 1 ? 0 : (uint8_t)(index + 1);
 
         if(options->moduleArgs.outputFormat.length == 0)
         {
@@ -59,7 +60,36 @@ void ffPrintWifi(FFWifiOptions* options)
                 {FF_FORMAT_ARG_TYPE_STRBUF, &item->conn.security},
             });
         }
+    }
+}
+
+void ffGenerateWifiJsonResult(FF_MAYBE_UNUSED FFWifiOptions* options, FFlist* result, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    yyjson_mut_val* arr = ffJsonResultAddArr(doc, module, "result");
+    FF_LIST_FOR_EACH(FFWifiResult, item, *result)
+    {
+        yyjson_mut_val* obj = yyjson_mut_arr_add_obj(doc, arr);
+
+        yyjson_mut_val* inf = ffJsonResultAddObj(doc, obj, "inf");
+        ffJsonResultAddStrbuf(doc, inf, "description", &item->inf.description);
+        ffJsonResultAddStrbuf(doc, inf, "status", &item->inf.status);
 
+        yyjson_mut_val* conn = ffJsonResultAddObj(doc, obj, "conn");
+        ffJsonResultAddStrbuf(doc, conn, "status", &item->conn.status);
+        ffJsonResultAddStrbuf(doc, conn, "ssid", &item->conn.ssid);
+        ffJsonResultAddStrbuf(doc, conn, "macAddress", &item->conn.macAddress);
+        ffJsonResultAddStrbuf(doc, conn, "protocol", &item->conn.protocol);
+        ffJsonResultAddStrbuf(doc, conn, "security", &item->conn.security);
+        ffJsonResultAddDouble(doc, conn, "signalQuality", item->conn.signalQuality);
+        ffJsonResultAddDouble(doc, conn, "rxRate", item->conn.rxRate);
+        ffJsonResultAddDouble(doc, conn, "txRate", item->conn.txRate);
+    }
+}
+
+void ffDestroyWifiModuleResult(FFlist* result)
+{
+    FF_LIST_FOR_EACH(FFWifiResult, item, *result)
+    {
         ffStrbufDestroy(&item->inf.description);
         ffStrbufDestroy(&item->inf.status);
         ffStrbufDestroy(&item->conn.status);
@@ -68,6 +98,20 @@ void ffPrintWifi(FFWifiOptions* options)
         ffStrbufDestroy(&item->conn.protocol);
         ffStrbufDestroy(&item->conn.security);
     }
+    ffListDestroy(result);
+}
+
+void ffPrintWifi(FFWifiOptions* options)
+{
+    FFlist result;
+    const char* error = ffDetectWifiModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_WIFI_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderWifiModule(options, &result);
+
+    ffDestroyWifiModuleResult(&result);
 }
 
 void ffInitWifiOptions(FFWifiOptions* options)
@@ -91,11 +135,8 @@ void ffDestroyWifiOptions(FFWifiOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseWifiJsonObject(yyjson_val* module)
+void ffParseWifiJsonObject(FFWifiOptions* options, yyjson_val* module)
 {
-    FFWifiOptions __attribute__((__cleanup__(ffDestroyWifiOptions))) options;
-    ffInitWifiOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -106,12 +147,10 @@ void ffParseWifiJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_WIFI_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_WIFI_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintWifi(&options);
 }
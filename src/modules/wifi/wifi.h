@@ -5,7 +5,11 @@
 #define FF_WIFI_MODULE_NAME "Wifi"
 
 void ffPrintWifi(FFWifiOptions* options);
+const char* ffDetectWifiModule(FFWifiOptions* options, FFlist* result /* FFWifiResult */);
+void ffRenderWifiModule(FFWifiOptions* options, FFlist* result);
+void ffGenerateWifiJsonResult(FFWifiOptions* options, FFlist* result, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyWifiModuleResult(FFlist* result);
 void ffInitWifiOptions(FFWifiOptions* options);
 bool ffParseWifiCommandOptions(FFWifiOptions* options, const char* key, const char* value);
 void ffDestroyWifiOptions(FFWifiOptions* options);
-void ffParseWifiJsonObject(yyjson_val* module);
+void ffParseWifiJsonObject(FFWifiOptions* options, yyjson_val* module);
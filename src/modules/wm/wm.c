@@ -1,20 +1,25 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/displayserver/displayserver.h"
 #include "modules/wm/wm.h"
 #include "util/stringUtils.h"
 
 #define FF_WM_NUM_FORMAT_ARGS 3
 
-void ffPrintWM(FFWMOptions* options)
+const char* ffDetectWMModule(FF_MAYBE_UNUSED FFWMOptions* options, const FFDisplayServerResult** pResult)
 {
-    const FFDisplayServerResult* result = ffConnectDisplayServer();
+    *pResult = ffConnectDisplayServer();
 
-    if(result->wmPrettyName.length == 0)
-    {
-        ffPrintError(FF_WM_MODULE_NAME, 0, &options->moduleArgs, "No WM found");
-        return;
-    }
+    if((*pResult)->wmPrettyName.length == 0)
+        return "No WM found";
+
+    return NULL;
+}
+
+void ffRenderWMModule(FFWMOptions* options, const FFDisplayServerResult** pResult)
+{
+    const FFDisplayServerResult* result = *pResult;
 
     if(options->moduleArgs.outputFormat.length == 0)
     {
@@ -41,6 +46,26 @@ void ffPrintWM(FFWMOptions* options)
     }
 }
 
+void ffGenerateWMJsonResult(FF_MAYBE_UNUSED FFWMOptions* options, const FFDisplayServerResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    const FFDisplayServerResult* ds = *pResult;
+    yyjson_mut_val* obj = ffJsonResultAddObj(doc, module, "result");
+    ffJsonResultAddStrbuf(doc, obj, "processName", &ds->wmProcessName);
+    ffJsonResultAddStrbuf(doc, obj, "prettyName", &ds->wmPrettyName);
+    ffJsonResultAddStrbuf(doc, obj, "protocolName", &ds->wmProtocolName);
+}
+
+void ffPrintWM(FFWMOptions* options)
+{
+    const FFDisplayServerResult* result;
+    const char* error = ffDetectWMModule(options, &result);
+
+    if(error)
+        ffPrintError(FF_WM_MODULE_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderWMModule(options, &result);
+}
+
 void ffInitWMOptions(FFWMOptions* options)
 {
     options->moduleName = FF_WM_MODULE_NAME;
@@ -62,11 +87,8 @@ void ffDestroyWMOptions(FFWMOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseWMJsonObject(yyjson_val* module)
+void ffParseWMJsonObject(FFWMOptions* options, yyjson_val* module)
 {
-    FFWMOptions __attribute__((__cleanup__(ffDestroyWMOptions))) options;
-    ffInitWMOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -77,12 +99,10 @@ void ffParseWMJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_WM_MODULE_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_WM_MODULE_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintWM(&options);
 }
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "fastfetch.h"
+#include "detection/displayserver/displayserver.h"
 
 #define FF_WM_MODULE_NAME "WM"
 
 void ffPrintWM(FFWMOptions* options);
+const char* ffDetectWMModule(FFWMOptions* options, const FFDisplayServerResult** pResult);
+void ffRenderWMModule(FFWMOptions* options, const FFDisplayServerResult** pResult);
+void ffGenerateWMJsonResult(FFWMOptions* options, const FFDisplayServerResult** pResult, yyjson_mut_doc* doc, yyjson_mut_val* module);
 void ffInitWMOptions(FFWMOptions* options);
 bool ffParseWMCommandOptions(FFWMOptions* options, const char* key, const char* value);
 void ffDestroyWMOptions(FFWMOptions* options);
-void ffParseWMJsonObject(yyjson_val* module);
+void ffParseWMJsonObject(FFWMOptions* options, yyjson_val* module);
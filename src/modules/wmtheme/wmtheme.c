@@ -1,5 +1,6 @@
 #include "common/printing.h"
 #include "common/jsonconfig.h"
+#include "common/jsonresult.h"
 #include "detection/wmtheme/wmtheme.h"
 #include "modules/wmtheme/wmtheme.h"
 #include "util/stringUtils.h"
@@ -7,29 +8,54 @@
 #define FF_WMTHEME_DISPLAY_NAME "WM Theme"
 #define FF_WMTHEME_NUM_FORMAT_ARGS 1
 
-void ffPrintWMTheme(FFWMThemeOptions* options)
+const char* ffDetectWMThemeModule(FF_MAYBE_UNUSED FFWMThemeOptions* options, FFstrbuf* themeOrError)
 {
-    FF_STRBUF_AUTO_DESTROY themeOrError = ffStrbufCreate();
-    if(ffDetectWmTheme(&themeOrError))
+    ffStrbufInit(themeOrError);
+
+    if(!ffDetectWmTheme(themeOrError))
+        return themeOrError->chars;
+
+    return NULL;
+}
+
+void ffRenderWMThemeModule(FFWMThemeOptions* options, FFstrbuf* theme)
+{
+    if(options->moduleArgs.outputFormat.length == 0)
     {
-        if(options->moduleArgs.outputFormat.length == 0)
-        {
-            ffPrintLogoAndKey(FF_WMTHEME_DISPLAY_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
-            puts(themeOrError.chars);
-        }
-        else
-        {
-            ffPrintFormat(FF_WMTHEME_DISPLAY_NAME, 0, &options->moduleArgs, FF_WMTHEME_NUM_FORMAT_ARGS, (FFformatarg[]){
-                {FF_FORMAT_ARG_TYPE_STRBUF, &themeOrError}
-            });
-        }
+        ffPrintLogoAndKey(FF_WMTHEME_DISPLAY_NAME, 0, &options->moduleArgs.key, &options->moduleArgs.keyColor);
+        puts(theme->chars);
     }
     else
     {
-        ffPrintError(FF_WMTHEME_DISPLAY_NAME, 0, &options->moduleArgs, "%*s", themeOrError.length, themeOrError.chars);
+        ffPrintFormat(FF_WMTHEME_DISPLAY_NAME, 0, &options->moduleArgs, FF_WMTHEME_NUM_FORMAT_ARGS, (FFformatarg[]){
+            {FF_FORMAT_ARG_TYPE_STRBUF, theme}
+        });
     }
 }
 
+void ffGenerateWMThemeJsonResult(FF_MAYBE_UNUSED FFWMThemeOptions* options, FFstrbuf* theme, yyjson_mut_doc* doc, yyjson_mut_val* module)
+{
+    ffJsonResultAddStrbuf(doc, module, "result", theme);
+}
+
+void ffDestroyWMThemeModuleResult(FFstrbuf* themeOrError)
+{
+    ffStrbufDestroy(themeOrError);
+}
+
+void ffPrintWMTheme(FFWMThemeOptions* options)
+{
+    FFstrbuf themeOrError;
+    const char* error = ffDetectWMThemeModule(options, &themeOrError);
+
+    if(error)
+        ffPrintError(FF_WMTHEME_DISPLAY_NAME, 0, &options->moduleArgs, "%s", error);
+    else
+        ffRenderWMThemeModule(options, &themeOrError);
+
+    ffDestroyWMThemeModuleResult(&themeOrError);
+}
+
 void ffInitWMThemeOptions(FFWMThemeOptions* options)
 {
     options->moduleName = FF_WMTHEME_MODULE_NAME;
@@ -51,11 +77,8 @@ void ffDestroyWMThemeOptions(FFWMThemeOptions* options)
     ffOptionDestroyModuleArg(&options->moduleArgs);
 }
 
-void ffParseWMThemeJsonObject(yyjson_val* module)
+void ffParseWMThemeJsonObject(FFWMThemeOptions* options, yyjson_val* module)
 {
-    FFWMThemeOptions __attribute__((__cleanup__(ffDestroyWMThemeOptions))) options;
-    ffInitWMThemeOptions(&options);
-
     if (module)
     {
         yyjson_val *key_, *val;
@@ -66,12 +89,10 @@ void ffParseWMThemeJsonObject(yyjson_val* module)
             if(ffStrEqualsIgnCase(key, "type"))
                 continue;
 
-            if (ffJsonConfigParseModuleArgs(key, val, &options.moduleArgs))
+            if (ffJsonConfigParseModuleArgs(key, val, &options->moduleArgs))
                 continue;
 
-            ffPrintError(FF_WMTHEME_DISPLAY_NAME, 0, &options.moduleArgs, "Unknown JSON key %s", key);
+            ffPrintError(FF_WMTHEME_DISPLAY_NAME, 0, &options->moduleArgs, "Unknown JSON key %s", key);
         }
     }
-
-    ffPrintWMTheme(&options);
 }
@@ -5,7 +5,11 @@
 #define FF_WMTHEME_MODULE_NAME "WMTheme"
 
 void ffPrintWMTheme(FFWMThemeOptions* options);
+const char* ffDetectWMThemeModule(FFWMThemeOptions* options, FFstrbuf* themeOrError);
+void ffRenderWMThemeModule(FFWMThemeOptions* options, FFstrbuf* theme);
+void ffGenerateWMThemeJsonResult(FFWMThemeOptions* options, FFstrbuf* theme, yyjson_mut_doc* doc, yyjson_mut_val* module);
+void ffDestroyWMThemeModuleResult(FFstrbuf* themeOrError);
 void ffInitWMThemeOptions(FFWMThemeOptions* options);
 bool ffParseWMThemeCommandOptions(FFWMThemeOptions* options, const char* key, const char* value);
 void ffDestroyWMThemeOptions(FFWMThemeOptions* options);
-void ffParseWMThemeJsonObject(yyjson_val* module);
+void ffParseWMThemeJsonObject(FFWMThemeOptions* options, yyjson_val* module);
@@ -163,6 +163,454 @@ void ffStrbufAppendSUntilC(FFstrbuf* strbuf, const char* value, char until)
         ffStrbufAppendNS(strbuf, (uint32_t) (end - value), value);
 }
 
+static const char digitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+void ffStrbufAppendUInt(FFstrbuf* strbuf, uint64_t value)
+{
+    uint32_t length = 1;
+    for(uint64_t rest = value; rest >= 10; rest /= 10)
+        ++length;
+
+    ffStrbufEnsureFree(strbuf, length);
+    char* end = strbuf->chars + strbuf->length + length;
+    *end = '\0';
+    strbuf->length += length;
+
+    while(value >= 100)
+    {
+        end -= 2;
+        memcpy(end, digitPairs + (value % 100) * 2, 2);
+        value /= 100;
+    }
+    if(value >= 10)
+        memcpy(end - 2, digitPairs + value * 2, 2);
+    else
+        end[-1] = (char) ('0' + value);
+}
+
+void ffStrbufAppendSInt(FFstrbuf* strbuf, int64_t value)
+{
+    if(value < 0)
+    {
+        ffStrbufAppendC(strbuf, '-');
+        ffStrbufAppendUInt(strbuf, 0 - (uint64_t) value);
+    }
+    else
+        ffStrbufAppendUInt(strbuf, (uint64_t) value);
+}
+
+// Floating point numbers are converted with the algorithm of Steele & White ("Dragon4"): the exact value is
+// a fraction of two big integers, digits are taken from it one by one. The integers live on the stack;
+// 40 limbs hold the largest intermediate value (about 2^1130, for subnormal doubles)
+
+#define FF_BIGINT_LIMBS 40
+
+typedef struct FFBigInt
+{
+    uint32_t length;
+    uint32_t limbs[FF_BIGINT_LIMBS]; // Least significant first, without leading zeros
+} FFBigInt;
+
+static void bigSet(FFBigInt* a, uint64_t value)
+{
+    a->length = 0;
+    for(; value > 0; value >>= 32)
+        a->limbs[a->length++] = (uint32_t) value;
+}
+
+static int bigCompare(const FFBigInt* a, const FFBigInt* b)
+{
+    if(a->length != b->length)
+        return a->length > b->length ? 1 : -1;
+    for(uint32_t i = a->length; i-- > 0;)
+    {
+        if(a->limbs[i] != b->limbs[i])
+            return a->limbs[i] > b->limbs[i] ? 1 : -1;
+    }
+    return 0;
+}
+
+static void bigAdd(FFBigInt* result, const FFBigInt* a, const FFBigInt* b)
+{
+    if(a->length < b->length)
+    {
+        const FFBigInt* temp = a;
+        a = b;
+        b = temp;
+    }
+
+    uint64_t carry = 0;
+    uint32_t i = 0;
+    for(; i < a->length; ++i)
+    {
+        carry += (uint64_t) a->limbs[i] + (i < b->length ? b->limbs[i] : 0);
+        result->limbs[i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+    if(carry > 0)
+        result->limbs[i++] = (uint32_t) carry;
+    result->length = i;
+}
+
+// a -= b, requires a >= b
+static void bigSubtract(FFBigInt* a, const FFBigInt* b)
+{
+    uint64_t borrow = 0;
+    for(uint32_t i = 0; i < a->length; ++i)
+    {
+        uint64_t difference = (uint64_t) a->limbs[i] - (i < b->length ? b->limbs[i] : 0) - borrow;
+        a->limbs[i] = (uint32_t) difference;
+        borrow = difference >> 63;
+    }
+    while(a->length > 0 && a->limbs[a->length - 1] == 0)
+        --a->length;
+}
+
+static void bigMultiply(FFBigInt* a, uint32_t factor)
+{
+    uint64_t carry = 0;
+    for(uint32_t i = 0; i < a->length; ++i)
+    {
+        carry += (uint64_t) a->limbs[i] * factor;
+        a->limbs[i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+    if(carry > 0)
+    {
+        assert(a->length < FF_BIGINT_LIMBS);
+        a->limbs[a->length++] = (uint32_t) carry;
+    }
+}
+
+static void bigMultiplyPow10(FFBigInt* a, uint32_t exponent)
+{
+    static const uint32_t pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+    for(; exponent >= 9; exponent -= 9)
+        bigMultiply(a, pow10[9]);
+    if(exponent > 0)
+        bigMultiply(a, pow10[exponent]);
+}
+
+static void bigShiftLeft(FFBigInt* a, uint32_t bits)
+{
+    if(a->length == 0)
+        return;
+
+    uint32_t words = bits / 32;
+    bits %= 32;
+    assert(a->length + words + 1 <= FF_BIGINT_LIMBS);
+
+    a->limbs[a->length + words] = 0;
+    for(uint32_t i = a->length; i-- > 0;)
+    {
+        if(bits > 0)
+            a->limbs[i + words + 1] |= a->limbs[i] >> (32 - bits);
+        a->limbs[i + words] = a->limbs[i] << bits;
+    }
+    for(uint32_t i = 0; i < words; ++i)
+        a->limbs[i] = 0;
+
+    a->length += words + 1;
+    while(a->length > 0 && a->limbs[a->length - 1] == 0)
+        --a->length;
+}
+
+static void bigSetPow2(FFBigInt* a, uint32_t exponent)
+{
+    bigSet(a, 1);
+    bigShiftLeft(a, exponent);
+}
+
+// r = r * 10 % s, returns r * 10 / s. Requires r < s
+static char bigNextDigit(FFBigInt* r, const FFBigInt* s)
+{
+    bigMultiply(r, 10);
+
+    if(r->length <= 2 && s->length <= 2)
+    {
+        // Values of common magnitudes, e.g. sizes and percentages
+        uint64_t r64 = r->length == 0 ? 0 : r->length == 1 ? r->limbs[0] : ((uint64_t) r->limbs[1] << 32 | r->limbs[0]);
+        uint64_t s64 = s->length == 1 ? s->limbs[0] : ((uint64_t) s->limbs[1] << 32 | s->limbs[0]);
+        char digit = (char) (r64 / s64);
+        bigSet(r, r64 % s64);
+        return digit;
+    }
+
+    char digit = 0;
+    for(; bigCompare(r, s) >= 0; ++digit)
+        bigSubtract(r, s);
+    return digit;
+}
+
+typedef enum FFDigitsMode
+{
+    FF_DIGITS_SHORTEST, // As few digits as needed to read back as the same value
+    FF_DIGITS_FIXED, // `count` digits after the decimal point
+    FF_DIGITS_SIGNIFICANT, // `count` significant digits
+} FFDigitsMode;
+
+// 309 digits before the point of the largest double, 127 after it
+#define FF_DIGITS_MAX 448
+
+// Writes the digits of `mantissa * 2^exponent` (> 0), rounded as requested, to `digits` and returns their number.
+// The value is 0.<digits> * 10^*point. Trailing zeros may be left out
+static uint32_t generateDigits(uint64_t mantissa, int32_t exponent, bool unequalGaps, FFDigitsMode mode, int32_t count, char* digits, int32_t* point)
+{
+    // r / s is the value, mMinus / mPlus half the distances to the neighbouring floating point numbers.
+    // Everything is doubled (quadrupled if the gap below is smaller, at powers of 2) to keep them integers
+    FFBigInt r, s, mMinus, mPlus, temp;
+    uint32_t shift = unequalGaps ? 2 : 1;
+    if(exponent >= 0)
+    {
+        bigSet(&r, mantissa);
+        bigShiftLeft(&r, (uint32_t) exponent + shift);
+        bigSet(&s, 1u << shift);
+        bigSetPow2(&mMinus, (uint32_t) exponent);
+        bigSetPow2(&mPlus, (uint32_t) exponent + shift - 1);
+    }
+    else
+    {
+        bigSet(&r, mantissa << shift);
+        bigSetPow2(&s, (uint32_t) -exponent + shift);
+        bigSet(&mMinus, 1);
+        bigSet(&mPlus, 1u << (shift - 1));
+    }
+
+    // k = ceil(log10(value)), estimated from the bit length. It may be one too small, see below
+    int32_t bits = exponent + 63 - __builtin_clzll(mantissa);
+    int32_t k = (int32_t) ((double) bits * 0.30102999566398114 + (bits > 0 ? 0.9999999999 : 0));
+    if(k >= 0)
+        bigMultiplyPow10(&s, (uint32_t) k);
+    else
+    {
+        bigMultiplyPow10(&r, (uint32_t) -k);
+        bigMultiplyPow10(&mMinus, (uint32_t) -k);
+        bigMultiplyPow10(&mPlus, (uint32_t) -k);
+    }
+
+    // Ties between neighbours round to the even mantissa, so a boundary still reads back as the value if it is even
+    const bool even = (mantissa & 1) == 0;
+    for(;;)
+    {
+        int cmp;
+        if(mode == FF_DIGITS_SHORTEST)
+        {
+            bigAdd(&temp, &r, &mPlus);
+            cmp = bigCompare(&temp, &s);
+            if(even ? cmp < 0 : cmp <= 0)
+                break;
+        }
+        else if(bigCompare(&r, &s) < 0)
+            break;
+        bigMultiply(&s, 10);
+        ++k;
+    }
+    *point = k;
+
+    uint32_t length = 0;
+    if(mode == FF_DIGITS_SHORTEST)
+    {
+        for(;;)
+        {
+            char digit = bigNextDigit(&r, &s);
+            bigMultiply(&mMinus, 10);
+            bigMultiply(&mPlus, 10);
+
+            int cmpLow = bigCompare(&r, &mMinus);
+            bigAdd(&temp, &r, &mPlus);
+            int cmpHigh = bigCompare(&temp, &s);
+            bool low = even ? cmpLow <= 0 : cmpLow < 0;
+            bool high = even ? cmpHigh >= 0 : cmpHigh > 0;
+
+            if(low && high)
+            {
+                temp = r;
+                bigShiftLeft(&temp, 1);
+                int cmp = bigCompare(&temp, &s);
+                if(cmp > 0 || (cmp == 0 && (digit & 1)))
+                    ++digit;
+            }
+            else if(high)
+                ++digit;
+
+            digits[length++] = (char) ('0' + digit);
+            if(low || high)
+                return length;
+        }
+    }
+
+    int32_t wanted = mode == FF_DIGITS_FIXED ? k + count : count;
+    if(wanted < 0)
+        return 0; // Less than half of the last digit
+    assert(wanted < FF_DIGITS_MAX);
+
+    for(; length < (uint32_t) wanted; ++length)
+        digits[length] = (char) ('0' + bigNextDigit(&r, &s));
+
+    // Round half to even, like printf does with exact values
+    bigShiftLeft(&r, 1);
+    int cmp = bigCompare(&r, &s);
+    if(cmp > 0 || (cmp == 0 && length > 0 && ((digits[length - 1] - '0') & 1)))
+    {
+        uint32_t i = length;
+        while(i > 0 && digits[i - 1] == '9')
+            digits[--i] = '0';
+        if(i > 0)
+            ++digits[i - 1];
+        else
+        {
+            // 99.9 => 100.0: the digits are all zero now
+            digits[0] = '1';
+            length = length > 0 ? length : 1;
+            ++*point;
+        }
+    }
+    return length;
+}
+
+static void appendZeros(FFstrbuf* strbuf, int32_t count)
+{
+    for(; count > 0; --count)
+        ffStrbufAppendC(strbuf, '0');
+}
+
+// 0.<digits> * 10^point, with `decimals` digits after the point
+static void appendPositional(FFstrbuf* strbuf, const char* digits, int32_t length, int32_t point, int32_t decimals)
+{
+    if(point <= 0)
+        ffStrbufAppendC(strbuf, '0');
+    else if(length >= point)
+        ffStrbufAppendNS(strbuf, (uint32_t) point, digits);
+    else
+    {
+        ffStrbufAppendNS(strbuf, (uint32_t) length, digits);
+        appendZeros(strbuf, point - length);
+    }
+
+    if(decimals <= 0)
+        return;
+
+    ffStrbufAppendC(strbuf, '.');
+    int32_t leadingZeros = point < 0 ? (-point < decimals ? -point : decimals) : 0;
+    appendZeros(strbuf, leadingZeros);
+    int32_t start = point > 0 ? point : 0;
+    int32_t available = length - start;
+    int32_t rest = decimals - leadingZeros;
+    if(available > rest)
+        available = rest;
+    if(available > 0)
+        ffStrbufAppendNS(strbuf, (uint32_t) available, digits + start);
+    else
+        available = 0;
+    appendZeros(strbuf, rest - available);
+}
+
+// d.ddde+XX like %e, or positional if -4 <= XX < `maxExponent`. Trailing zeros are removed
+static void appendCompact(FFstrbuf* strbuf, const char* digits, int32_t length, int32_t point, int32_t maxExponent)
+{
+    while(length > 1 && digits[length - 1] == '0')
+        --length;
+
+    int32_t exponent = point - 1;
+    if(exponent >= -4 && exponent < maxExponent)
+    {
+        appendPositional(strbuf, digits, length, point, length - point);
+        return;
+    }
+
+    ffStrbufAppendC(strbuf, digits[0]);
+    if(length > 1)
+    {
+        ffStrbufAppendC(strbuf, '.');
+        ffStrbufAppendNS(strbuf, (uint32_t) length - 1, digits + 1);
+    }
+    ffStrbufAppendC(strbuf, 'e');
+    ffStrbufAppendC(strbuf, exponent < 0 ? '-' : '+');
+    if(exponent > -10 && exponent < 10)
+        ffStrbufAppendC(strbuf, '0');
+    ffStrbufAppendUInt(strbuf, (uint64_t) (exponent < 0 ? -exponent : exponent));
+}
+
+// `bits` is an IEEE 754 binary floating point number with the given numbers of mantissa and exponent bits
+static void appendFloating(FFstrbuf* strbuf, uint64_t bits, uint32_t mantissaBits, uint32_t exponentBits, FFDigitsMode mode, int32_t count)
+{
+    const uint64_t fraction = bits & ((1ull << mantissaBits) - 1);
+    const uint32_t biased = (uint32_t) (bits >> mantissaBits) & ((1u << exponentBits) - 1);
+    const int32_t bias = (1 << (exponentBits - 1)) - 1;
+
+    if(bits >> (mantissaBits + exponentBits))
+        ffStrbufAppendC(strbuf, '-');
+
+    if(biased == (1u << exponentBits) - 1)
+    {
+        ffStrbufAppendS(strbuf, fraction ? "nan" : "inf");
+        return;
+    }
+
+    if(biased == 0 && fraction == 0)
+    {
+        ffStrbufAppendC(strbuf, '0');
+        if(mode == FF_DIGITS_FIXED && count > 0)
+        {
+            ffStrbufAppendC(strbuf, '.');
+            appendZeros(strbuf, count);
+        }
+        return;
+    }
+
+    uint64_t mantissa = biased == 0 ? fraction : fraction | (1ull << mantissaBits);
+    int32_t exponent = (biased == 0 ? 1 : (int32_t) biased) - bias - (int32_t) mantissaBits;
+    bool unequalGaps = biased > 1 && fraction == 0;
+
+    char digits[FF_DIGITS_MAX];
+    int32_t point;
+    int32_t length = (int32_t) generateDigits(mantissa, exponent, unequalGaps, mode, count, digits, &point);
+
+    if(mode == FF_DIGITS_FIXED)
+        appendPositional(strbuf, digits, length, point, count);
+    else if(mode == FF_DIGITS_SIGNIFICANT)
+        appendCompact(strbuf, digits, length, point, count);
+    else
+        appendCompact(strbuf, digits, length, point, 17);
+}
+
+void ffStrbufAppendDouble(FFstrbuf* strbuf, double value, int8_t precision)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    appendFloating(strbuf, bits, 52, 11, precision < 0 ? FF_DIGITS_SHORTEST : FF_DIGITS_FIXED, precision);
+}
+
+void ffStrbufAppendDoubleG(FFstrbuf* strbuf, double value, uint8_t precision)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    appendFloating(strbuf, bits, 52, 11, FF_DIGITS_SIGNIFICANT, precision == 0 ? 1 : precision);
+}
+
+void ffStrbufAppendFloat(FFstrbuf* strbuf, float value, int8_t precision)
+{
+    if(precision >= 0)
+    {
+        ffStrbufAppendDouble(strbuf, value, precision);
+        return;
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    appendFloating(strbuf, bits, 23, 8, FF_DIGITS_SHORTEST, -1);
+}
+
 void ffStrbufSetF(FFstrbuf* strbuf, const char* format, ...)
 {
     assert(format != NULL);
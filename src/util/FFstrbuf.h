@@ -47,6 +47,17 @@ FF_C_PRINTF(2, 3) void ffStrbufAppendF(FFstrbuf* strbuf, const char* format, ...
 void ffStrbufAppendVF(FFstrbuf* strbuf, const char* format, va_list arguments);
 void ffStrbufAppendSUntilC(FFstrbuf* strbuf, const char* value, char until);
 
+// Number formatting without printf: digits are written into the buffer, nothing else is allocated.
+// Doubles are converted exactly (the output matches glibc printf, rounding ties to even)
+void ffStrbufAppendUInt(FFstrbuf* strbuf, uint64_t value);
+void ffStrbufAppendSInt(FFstrbuf* strbuf, int64_t value);
+// Like %.*f. If `precision` < 0, the shortest text that reads back as `value`
+void ffStrbufAppendDouble(FFstrbuf* strbuf, double value, int8_t precision);
+// Like %.*g
+void ffStrbufAppendDoubleG(FFstrbuf* strbuf, double value, uint8_t precision);
+// Like ffStrbufAppendDouble, but the shortest text is the one that reads back as the float `value`
+void ffStrbufAppendFloat(FFstrbuf* strbuf, float value, int8_t precision);
+
 void ffStrbufPrependNS(FFstrbuf* strbuf, uint32_t length, const char* value);
 
 void ffStrbufSetNS(FFstrbuf* strbuf, uint32_t length, const char* value);
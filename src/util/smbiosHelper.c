@@ -1,5 +1,9 @@
 #include "smbiosHelper.h"
 
+#ifdef __linux__
+    #include "common/io/sysfs.h"
+#endif
+
 bool ffIsSmbiosValueSet(FFstrbuf* value)
 {
     return
@@ -24,3 +28,19 @@ bool ffIsSmbiosValueSet(FFstrbuf* value)
         !ffStrbufIgnCaseEqualS(value, "N/A")
     ;
 }
+
+#ifdef __linux__
+int ffSmbiosOpenDmiDir(void)
+{
+    int dirfd = ffSysfsOpenDir(AT_FDCWD, "/sys/devices/virtual/dmi/id");
+    if(dirfd < 0)
+        dirfd = ffSysfsOpenDir(AT_FDCWD, "/sys/class/dmi/id");
+    return dirfd;
+}
+
+void ffSmbiosReadDmiValue(int dmiDirFd, const char* name, FFstrbuf* buffer)
+{
+    ffSysfsReadAttr(dmiDirFd, name, buffer);
+    ffCleanUpSmbiosValue(buffer);
+}
+#endif
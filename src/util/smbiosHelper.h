@@ -12,4 +12,11 @@ static inline void ffCleanUpSmbiosValue(FFstrbuf* value)
         ffStrbufClear(value);
 }
 
+#ifdef __linux__
+// Opens /sys/devices/virtual/dmi/id (or its alias /sys/class/dmi/id). Returns -1 on failure
+int ffSmbiosOpenDmiDir(void);
+// Reads DMI attribute `name` (e.g. "product_name"); cleared if it isn't set
+void ffSmbiosReadDmiValue(int dmiDirFd, const char* name, FFstrbuf* buffer);
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,155 @@
+// Compares formatting with ffParseFormatString (parsed for every item) with a FFformatProgram compiled once,
+// over generated Disk and LocalIP like argument lists.
+// Usage: fastfetch-benchmark-format [<items> [<iterations>]]
+// Defaults to 10000 items and 20 iterations.
+
+#include "common/format.h"
+#include "common/time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct DiskItem
+{
+    FFstrbuf mountpoint;
+    FFstrbuf filesystem;
+    FFstrbuf usedPretty;
+    FFstrbuf totalPretty;
+    uint8_t percentage;
+    bool removable;
+} DiskItem;
+
+typedef struct InterfaceItem
+{
+    FFstrbuf name;
+    FFstrbuf ipv4;
+    FFstrbuf mac;
+    uint32_t mtu;
+} InterfaceItem;
+
+typedef void (*FormatFunc)(FFstrbuf* buffer, const FFstrbuf* format, const FFformatProgram* program, uint32_t numArgs, const FFformatarg* arguments);
+
+static void formatParse(FFstrbuf* buffer, const FFstrbuf* format, const FFformatProgram* program, uint32_t numArgs, const FFformatarg* arguments)
+{
+    (void) program;
+    ffParseFormatString(buffer, format, numArgs, arguments);
+}
+
+static void formatProgram(FFstrbuf* buffer, const FFstrbuf* format, const FFformatProgram* program, uint32_t numArgs, const FFformatarg* arguments)
+{
+    (void) format;
+    ffFormatProgramRun(buffer, program, numArgs, arguments);
+}
+
+static uint64_t runDisks(FormatFunc func, const FFstrbuf* format, const FFformatProgram* program, const FFlist* disks, FFstrbuf* buffer)
+{
+    uint64_t length = 0;
+    FF_LIST_FOR_EACH(DiskItem, disk, *disks)
+    {
+        ffStrbufClear(buffer);
+        func(buffer, format, program, 6, (FFformatarg[]) {
+            {FF_FORMAT_ARG_TYPE_STRBUF, &disk->mountpoint},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &disk->filesystem},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &disk->usedPretty},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &disk->totalPretty},
+            {FF_FORMAT_ARG_TYPE_UINT8, &disk->percentage},
+            {FF_FORMAT_ARG_TYPE_BOOL, &disk->removable},
+        });
+        length += buffer->length;
+    }
+    return length;
+}
+
+static uint64_t runInterfaces(FormatFunc func, const FFstrbuf* format, const FFformatProgram* program, const FFlist* interfaces, FFstrbuf* buffer)
+{
+    uint64_t length = 0;
+    FF_LIST_FOR_EACH(InterfaceItem, item, *interfaces)
+    {
+        ffStrbufClear(buffer);
+        func(buffer, format, program, 4, (FFformatarg[]) {
+            {FF_FORMAT_ARG_TYPE_STRBUF, &item->name},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &item->ipv4},
+            {FF_FORMAT_ARG_TYPE_STRBUF, &item->mac},
+            {FF_FORMAT_ARG_TYPE_UINT, &item->mtu},
+        });
+        length += buffer->length;
+    }
+    return length;
+}
+
+static void run(const char* name, FormatFunc func, const FFstrbuf* diskFormat, const FFstrbuf* interfaceFormat, const FFlist* disks, const FFlist* interfaces, uint32_t iterations)
+{
+    FF_STRBUF_AUTO_DESTROY buffer = ffStrbufCreateA(256);
+    FFformatProgram diskProgram, interfaceProgram;
+    ffFormatProgramInit(&diskProgram);
+    ffFormatProgramInit(&interfaceProgram);
+
+    uint64_t length = 0;
+    uint64_t start = ffTimeGetTickUs();
+    // Compiling is part of the measurement, as it is part of loading the config
+    ffFormatProgramCompile(&diskProgram, diskFormat);
+    ffFormatProgramCompile(&interfaceProgram, interfaceFormat);
+    for(uint32_t i = 0; i < iterations; ++i)
+    {
+        length += runDisks(func, diskFormat, &diskProgram, disks, &buffer);
+        length += runInterfaces(func, interfaceFormat, &interfaceProgram, interfaces, &buffer);
+    }
+    uint64_t elapsed = ffTimeGetTickUs() - start;
+
+    printf("%-8s %llu bytes, %.3f ms per iteration\n", name, (unsigned long long) length, (double) elapsed / 1000.0 / iterations);
+
+    ffFormatProgramDestroy(&diskProgram);
+    ffFormatProgramDestroy(&interfaceProgram);
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t items = 10000;
+    uint32_t iterations = 20;
+    if(argc >= 2)
+        items = (uint32_t) strtoul(argv[1], NULL, 10);
+    if(argc >= 3)
+        iterations = (uint32_t) strtoul(argv[2], NULL, 10);
+    if(iterations == 0)
+        iterations = 1;
+
+    FF_LIST_AUTO_DESTROY disks = ffListCreate(sizeof(DiskItem));
+    FF_LIST_AUTO_DESTROY interfaces = ffListCreate(sizeof(InterfaceItem));
+    for(uint32_t i = 0; i < items; ++i)
+    {
+        DiskItem* disk = ffListAdd(&disks);
+        ffStrbufInitF(&disk->mountpoint, "/mnt/volume-%u", i);
+        ffStrbufInitS(&disk->filesystem, i % 3 == 0 ? "ext4" : i % 3 == 1 ? "btrfs" : "xfs");
+        ffStrbufInitF(&disk->usedPretty, "%.2f GiB", (i + 1) * (i % 100) / 100.0);
+        ffStrbufInitF(&disk->totalPretty, "%u GiB", i + 1);
+        disk->percentage = (uint8_t) (i % 100);
+        disk->removable = i % 7 == 0;
+
+        InterfaceItem* item = ffListAdd(&interfaces);
+        ffStrbufInitF(&item->name, "eth%u", i);
+        ffStrbufInitF(&item->ipv4, "10.%u.%u.%u/24", (i >> 16) & 0xFF, (i >> 8) & 0xFF, i & 0xFF);
+        ffStrbufInitF(&item->mac, "02:00:00:%02x:%02x:%02x", (i >> 16) & 0xFF, (i >> 8) & 0xFF, i & 0xFF);
+        item->mtu = 1500;
+    }
+
+    FF_STRBUF_AUTO_DESTROY diskFormat = ffStrbufCreateS("{1} ({2}): {3} / {4} ({5}%){?6} [Removable]{/6}");
+    FF_STRBUF_AUTO_DESTROY interfaceFormat = ffStrbufCreateS("{#1}{1}{#}: {2}{?3} ({3}){?} mtu {4}");
+
+    run("parse", formatParse, &diskFormat, &interfaceFormat, &disks, &interfaces, iterations);
+    run("program", formatProgram, &diskFormat, &interfaceFormat, &disks, &interfaces, iterations);
+
+    FF_LIST_FOR_EACH(DiskItem, disk, disks)
+    {
+        ffStrbufDestroy(&disk->mountpoint);
+        ffStrbufDestroy(&disk->filesystem);
+        ffStrbufDestroy(&disk->usedPretty);
+        ffStrbufDestroy(&disk->totalPretty);
+    }
+    FF_LIST_FOR_EACH(InterfaceItem, item, interfaces)
+    {
+        ffStrbufDestroy(&item->name);
+        ffStrbufDestroy(&item->ipv4);
+        ffStrbufDestroy(&item->mac);
+    }
+    return 0;
+}
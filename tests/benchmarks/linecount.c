@@ -0,0 +1,103 @@
+// Compares ffCountFileLinesWithPrefix with the getline + strstr loop packages_linux.c used before.
+// Usage: fastfetch-benchmark-linecount [<file> <prefix> [<iterations>]]
+// Without arguments, a dpkg status like file with 5000 packages is generated and used.
+
+#include "common/io/io.h"
+#include "common/time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static uint32_t countGetline(const char* fileName, const char* needle)
+{
+    FILE* file = fopen(fileName, "r");
+    if(file == NULL)
+        return 0;
+
+    uint32_t count = 0;
+    char* line = NULL;
+    size_t len = 0;
+    while(getline(&line, &len, file) != EOF)
+    {
+        if(strstr(line, needle) != NULL)
+            ++count;
+    }
+
+    free(line);
+    fclose(file);
+    return count;
+}
+
+static void generateDpkgStatus(const char* fileName)
+{
+    FF_STRBUF_AUTO_DESTROY content = ffStrbufCreateA(8 * 1024 * 1024);
+    for(uint32_t i = 0; i < 5000; ++i)
+    {
+        ffStrbufAppendF(&content,
+            "Package: package-%u\n"
+            "Status: install ok installed\n"
+            "Priority: optional\n"
+            "Section: libs\n"
+            "Installed-Size: %u\n"
+            "Maintainer: Someone <someone@example.org>\n"
+            "Architecture: amd64\n"
+            "Version: 1.%u-1\n"
+            "Depends: libc6 (>= 2.34), libfoo%u (>= 1.0)\n"
+            "Description: Package number %u\n"
+            " A long description, spread over multiple lines, like most real packages have.\n"
+            " It mentions words like Status: and Package: sometimes, but not at the beginning of a line.\n"
+            " .\n"
+            " This is the last line of the description.\n\n",
+            i, i * 7, i, i % 10, i
+        );
+    }
+    ffWriteFileBuffer(fileName, &content);
+}
+
+typedef uint32_t (*CountFunc)(const char* fileName, const char* prefix);
+
+static uint32_t countSIMD(const char* fileName, const char* prefix)
+{
+    return ffCountFileLinesWithPrefix(fileName, prefix, false);
+}
+
+static void run(const char* name, CountFunc func, const char* fileName, const char* prefix, uint32_t iterations)
+{
+    uint32_t count = 0;
+    uint64_t start = ffTimeGetTickUs();
+    for(uint32_t i = 0; i < iterations; ++i)
+        count = func(fileName, prefix);
+    uint64_t elapsed = ffTimeGetTickUs() - start;
+
+    printf("%-10s count %u, %.3f ms per iteration\n", name, count, (double) elapsed / 1000.0 / iterations);
+}
+
+int main(int argc, char** argv)
+{
+    const char* fileName = "fastfetch-benchmark-linecount.txt";
+    const char* prefix = "Status: ";
+    uint32_t iterations = 100;
+
+    if(argc >= 3)
+    {
+        fileName = argv[1];
+        prefix = argv[2];
+        if(argc >= 4)
+            iterations = (uint32_t) strtoul(argv[3], NULL, 10);
+    }
+    else
+        generateDpkgStatus(fileName);
+
+    if(iterations == 0)
+        iterations = 1;
+
+    // Warm up the page cache
+    countGetline(fileName, prefix);
+
+    run("getline", countGetline, fileName, prefix, iterations);
+    run("simd", countSIMD, fileName, prefix, iterations);
+
+    if(argc < 3)
+        remove(fileName);
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "fastfetch.h"
+#include "common/cache.h"
+#include "common/httpcache.h"
+#include "util/textModifier.h"
+
+#include <ftw.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+__attribute__((__noreturn__))
+static void testFailed(const FFstrbuf* data, const char* expression, int lineNo)
+{
+    fputs(FASTFETCH_TEXT_MODIFIER_ERROR, stderr);
+    fprintf(stderr, "[%d] %s, data:", lineNo, expression);
+    ffStrbufWriteTo(data, stderr);
+    fputs(FASTFETCH_TEXT_MODIFIER_RESET, stderr);
+    fputc('\n', stderr);
+    exit(1);
+}
+
+#define VERIFY(expression) if(!(expression)) testFailed(&data, #expression, __LINE__)
+
+typedef struct TestResult
+{
+    uint32_t number;
+    FFstrbuf text;
+} TestResult;
+
+static const FFCacheSchema testSchema = FF_CACHE_SCHEMA(TestResult, offsetof(TestResult, text));
+
+// Stores `text` as the last member of an entry, so that its last byte is the last byte of the file, and loads it again
+static bool roundTrip(const char* text, FFstrbuf* data)
+{
+    FF_STRBUF_AUTO_DESTROY key = ffStrbufCreate();
+    if(!ffCacheKeyInitPersistent(&key))
+        return false;
+    ffStrbufAppendS(&key, "test\n");
+
+    TestResult stored = { .number = 42 };
+    ffStrbufInitS(&stored.text, text);
+    ffCacheStore("Test", &key, &testSchema, &stored);
+    ffStrbufDestroy(&stored.text);
+
+    TestResult loaded;
+    if(!ffCacheLoad("Test", &key, &testSchema, &loaded))
+        return false;
+
+    ffStrbufSet(data, &loaded.text);
+    ffStrbufDestroy(&loaded.text);
+    return loaded.number == 42;
+}
+
+static int removeEntry(const char* path, const struct stat* st, int type, struct FTW* ftw)
+{
+    FF_UNUSED(st, type, ftw);
+    return remove(path);
+}
+
+int main(void)
+{
+    FF_STRBUF_AUTO_DESTROY data = ffStrbufCreate();
+
+    char cacheDir[] = "/tmp/fastfetch-test-cache-XXXXXX";
+    VERIFY(mkdtemp(cacheDir) != NULL);
+    instance.config.cache = true;
+    ffStrbufInitF(&instance.state.platform.cacheDir, "%s/", cacheDir);
+
+    VERIFY(roundTrip("hello", &data));
+    VERIFY(ffStrbufEqualS(&data, "hello"));
+
+    // Entries ending with whitespace must not be trimmed
+
+    VERIFY(roundTrip("hello\n", &data));
+    VERIFY(ffStrbufEqualS(&data, "hello\n"));
+    VERIFY(roundTrip("hello ", &data));
+    VERIFY(ffStrbufEqualS(&data, "hello "));
+    VERIFY(roundTrip("", &data));
+    VERIFY(ffStrbufEqualS(&data, ""));
+
+    // --recache ignores existing entries
+
+    instance.config.recache = true;
+    VERIFY(!roundTrip("hello", &data));
+    instance.config.recache = false;
+
+    // HTTP responses usually end with a newline; they must be fresh hits, not misses
+
+    FFModuleArgs moduleArgs = { .cache = true };
+    FF_STRBUF_AUTO_DESTROY body = ffStrbufCreateS("1.2.3.4\n");
+    ffHttpCacheStore(&moduleArgs, "example.com", "/ip", &body);
+    ffStrbufClear(&data);
+    VERIFY(ffHttpCacheLoad(&moduleArgs, "example.com", "/ip", 3600, &data) == FF_HTTP_CACHE_FRESH);
+    VERIFY(ffStrbufEqualS(&data, "1.2.3.4\n"));
+    ffStrbufClear(&data);
+    VERIFY(ffHttpCacheLoad(&moduleArgs, "example.com", "/ip", 0, &data) == FF_HTTP_CACHE_STALE);
+    VERIFY(ffStrbufEqualS(&data, "1.2.3.4\n"));
+    VERIFY(ffHttpCacheLoad(&moduleArgs, "example.com", "/other", 3600, &data) == FF_HTTP_CACHE_MISS);
+
+    nftw(cacheDir, removeEntry, 8, FTW_DEPTH | FTW_PHYS);
+    ffStrbufDestroy(&instance.state.platform.cacheDir);
+
+    //Success
+    puts("\033[32mAll tests passed!"FASTFETCH_TEXT_MODIFIER_RESET);
+}
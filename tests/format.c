@@ -0,0 +1,83 @@
+#include "common/format.h"
+#include "util/textModifier.h"
+#include "util/stringUtils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+__attribute__((__noreturn__))
+static void testFailed(const FFstrbuf* strbuf, const char* expression, int lineNo)
+{
+    fputs(FASTFETCH_TEXT_MODIFIER_ERROR, stderr);
+    fprintf(stderr, "[%d] %s, strbuf:", lineNo, expression);
+    ffStrbufWriteTo(strbuf, stderr);
+    fputs(FASTFETCH_TEXT_MODIFIER_RESET, stderr);
+    fputc('\n', stderr);
+    exit(1);
+}
+
+#define VERIFY(expression) if(!(expression)) testFailed(&strbuf, #expression, __LINE__)
+
+static const char* name = "fastfetch";
+static const uint32_t number = 42;
+static const double ratio = 0.5;
+static const double missing = 0.0/0.0;
+
+// Formats with the arguments "fastfetch", 42, 0.5 and NULL. The text modifier reset appended to every result is removed
+static const char* format(FFstrbuf* strbuf, const char* formatstr)
+{
+    FF_STRBUF_AUTO_DESTROY format = ffStrbufCreateS(formatstr);
+    ffStrbufClear(strbuf);
+    ffParseFormatString(strbuf, &format, 4, (FFformatarg[]) {
+        {FF_FORMAT_ARG_TYPE_STRING, name},
+        {FF_FORMAT_ARG_TYPE_UINT, &number},
+        {FF_FORMAT_ARG_TYPE_DOUBLE, &ratio},
+        {FF_FORMAT_ARG_TYPE_NULL, &missing},
+    });
+    if(ffStrbufEndsWithS(strbuf, FASTFETCH_TEXT_MODIFIER_RESET))
+        ffStrbufSubstrBefore(strbuf, strbuf->length - (uint32_t) (sizeof(FASTFETCH_TEXT_MODIFIER_RESET) - 1));
+    return strbuf->chars;
+}
+
+#define VERIFY_FORMAT(formatstr, expected) VERIFY(ffStrEquals(format(&strbuf, formatstr), expected))
+
+int main(void)
+{
+    FF_STRBUF_AUTO_DESTROY strbuf = ffStrbufCreate();
+
+    //indexes
+    VERIFY_FORMAT("{1} {2} {3}", "fastfetch 42 0.5");
+    VERIFY_FORMAT("{} {} {}", "fastfetch 42 0.5");
+    VERIFY_FORMAT("{2} {}", "42 fastfetch");
+    VERIFY_FORMAT("[{4}]", "[]");
+
+    //invalid indexes are printed as is
+    VERIFY_FORMAT("{0} {5} {-1} {a}", "{0} {5} {-1} {a}");
+    VERIFY_FORMAT("{} {} {} {} {}", "fastfetch 42 0.5  {}");
+
+    //escaping and unclosed placeholders
+    VERIFY_FORMAT("{{1}", "{1}");
+    VERIFY_FORMAT("a{", "afastfetch");
+    VERIFY_FORMAT("{2", "42");
+
+    //conditions
+    VERIFY_FORMAT("{?2}set{?}", "set");
+    VERIFY_FORMAT("{?4}set{?}", "");
+    VERIFY_FORMAT("{/4}unset{/}", "unset");
+    VERIFY_FORMAT("{1}{-}{2}", "fastfetch");
+
+    //specs
+    VERIFY_FORMAT("{3:.2f}", "0.50");
+    VERIFY_FORMAT("{2:>5}|", "   42|");
+    VERIFY_FORMAT("{1:*^11}", "*fastfetch*");
+    VERIFY_FORMAT("{1:.4}", "fast");
+    VERIFY_FORMAT("{2:}", "42");
+    VERIFY_FORMAT("{2:?}", "{2:?}");
+
+    //a spec needs an index
+    VERIFY_FORMAT("{:}", "{:}");
+    VERIFY_FORMAT("{:.2f} {}", "{:.2f} fastfetch");
+
+    //Success
+    puts("\033[32mAll tests passed!"FASTFETCH_TEXT_MODIFIER_RESET);
+}
@@ -0,0 +1,95 @@
+#include "common/io/io.h"
+#include "util/textModifier.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+__attribute__((__noreturn__))
+static void testFailed(const FFstrbuf* data, const char* expression, int lineNo)
+{
+    fputs(FASTFETCH_TEXT_MODIFIER_ERROR, stderr);
+    fprintf(stderr, "[%d] %s, data:", lineNo, expression);
+    ffStrbufWriteTo(data, stderr);
+    fputs(FASTFETCH_TEXT_MODIFIER_RESET, stderr);
+    fputc('\n', stderr);
+    exit(1);
+}
+
+#define VERIFY(expression) if(!(expression)) testFailed(&data, #expression, __LINE__)
+
+static uint32_t countNaive(const char* data, size_t length, const char* prefix, bool allowIndentation)
+{
+    size_t prefixLength = strlen(prefix);
+    uint32_t count = 0;
+    size_t lineStart = 0;
+    while(lineStart < length)
+    {
+        size_t start = lineStart;
+        if(allowIndentation)
+        {
+            while(start < length && (data[start] == ' ' || data[start] == '\t'))
+                ++start;
+        }
+        if(length - start >= prefixLength && memcmp(data + start, prefix, prefixLength) == 0)
+            ++count;
+
+        const char* next = memchr(data + lineStart, '\n', length - lineStart);
+        if(!next)
+            break;
+        lineStart = (size_t) (next - data) + 1;
+    }
+    return count;
+}
+
+int main(void)
+{
+    FF_STRBUF_AUTO_DESTROY data = ffStrbufCreate();
+
+    //empty
+    VERIFY(ffCountLinesWithPrefix("", 0, "C:Q", false) == 0);
+    VERIFY(ffCountLinesWithPrefix("C:Q", 3, "", false) == 0);
+
+    //anchored
+    ffStrbufSetS(&data, "C:Q1\nP:foo\nC:Q2\n xC:Q3\nC:Q");
+    VERIFY(ffCountLinesWithPrefix(data.chars, data.length, "C:Q", false) == 3);
+    VERIFY(ffCountLinesWithPrefix(data.chars, data.length - 1, "C:Q", false) == 2);
+
+    //indentation
+    ffStrbufSetS(&data, "<key>state</key>\n\t<string>installed</string>\n    <string>installed</string>\n<string>installed</string>\nx <string>installed</string>\n");
+    VERIFY(ffCountLinesWithPrefix(data.chars, data.length, "<string>installed</string>", true) == 3);
+    VERIFY(ffCountLinesWithPrefix(data.chars, data.length, "<string>installed</string>", false) == 1);
+
+    //random data, to cover every alignment and the tails of the vector loops
+    srand(42);
+    static const char alphabet[] = "SStatus: \n\n\t x";
+    for(uint32_t round = 0; round < 2000; ++round)
+    {
+        ffStrbufClear(&data);
+        uint32_t length = (uint32_t) rand() % 300;
+        for(uint32_t i = 0; i < length; ++i)
+            ffStrbufAppendC(&data, alphabet[rand() % (int) (sizeof(alphabet) - 1)]);
+
+        for(uint32_t offset = 0; offset < 4 && offset <= data.length; ++offset)
+        {
+            const char* chars = data.chars + offset;
+            size_t size = data.length - offset;
+            VERIFY(ffCountLinesWithPrefix(chars, size, "Status: ", false) == countNaive(chars, size, "Status: ", false));
+            VERIFY(ffCountLinesWithPrefix(chars, size, "S", false) == countNaive(chars, size, "S", false));
+            VERIFY(ffCountLinesWithPrefix(chars, size, "St", true) == countNaive(chars, size, "St", true));
+        }
+    }
+
+    //file, large enough to be mapped
+    ffStrbufClear(&data);
+    for(uint32_t i = 0; i < 10000; ++i)
+        ffStrbufAppendS(&data, "Package: foo\nStatus: install ok installed\nDescription: Status: none\n");
+    const char* path = "fastfetch-test-linecount.txt";
+    VERIFY(ffWriteFileBuffer(path, &data));
+    VERIFY(ffCountFileLinesWithPrefix(path, "Status: ", false) == 10000);
+    remove(path);
+    VERIFY(ffCountFileLinesWithPrefix(path, "Status: ", false) == 0);
+
+    //Success
+    puts("\033[32mAll tests passed!"FASTFETCH_TEXT_MODIFIER_RESET);
+}
@@ -0,0 +1,212 @@
+#include "common/networking.h"
+#include "common/time.h"
+#include "util/textModifier.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+__attribute__((__noreturn__))
+static void testFailed(const FFstrbuf* data, const char* expression, int lineNo)
+{
+    fputs(FASTFETCH_TEXT_MODIFIER_ERROR, stderr);
+    fprintf(stderr, "[%d] %s, data:", lineNo, expression);
+    ffStrbufWriteTo(data, stderr);
+    fputs(FASTFETCH_TEXT_MODIFIER_RESET, stderr);
+    fputc('\n', stderr);
+    exit(1);
+}
+
+#define VERIFY(expression) if(!(expression)) testFailed(&data, #expression, __LINE__)
+
+// A minimal stand-in server. Every path has a fixed response
+
+static uint32_t acceptedConnections;
+
+static void startThread(void* (*func)(void*), int fd)
+{
+    pthread_t thread;
+    if(pthread_create(&thread, NULL, func, (void*) (intptr_t) fd) == 0)
+        pthread_detach(thread);
+}
+
+static void sendString(int fd, const char* str)
+{
+    ssize_t sent = send(fd, str, strlen(str), MSG_NOSIGNAL);
+    FF_UNUSED(sent);
+}
+
+static void* serveConnection(void* param)
+{
+    intptr_t fd = (intptr_t) param;
+    FF_STRBUF_AUTO_DESTROY request = ffStrbufCreate();
+    while(true)
+    {
+        uint32_t end;
+        while((end = ffStrbufFirstIndexS(&request, "\r\n\r\n")) == request.length)
+        {
+            char buffer[1024];
+            ssize_t received = recv((int) fd, buffer, sizeof(buffer), 0);
+            if(received <= 0)
+                goto exit;
+            ffStrbufAppendNS(&request, (uint32_t) received, buffer);
+        }
+
+        const char* path = request.chars + strlen("GET ");
+        if(strncmp(path, "/length ", strlen("/length ")) == 0)
+            sendString((int) fd, "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello");
+        else if(strncmp(path, "/chunked ", strlen("/chunked ")) == 0)
+        {
+            // Split over several packets, to make the client parse partial chunks
+            sendString((int) fd, "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n3\r\nhe");
+            ffTimeSleep(20);
+            sendString((int) fd, "l\r\n2;ext=1\r\nlo\r\n");
+            ffTimeSleep(20);
+            sendString((int) fd, "0\r\n\r\n");
+        }
+        else if(strncmp(path, "/close ", strlen("/close ")) == 0)
+        {
+            sendString((int) fd, "HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nbye");
+            goto exit;
+        }
+        else if(strncmp(path, "/slow ", strlen("/slow ")) == 0)
+        {
+            ffTimeSleep(2000);
+            goto exit;
+        }
+        else
+            sendString((int) fd, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n");
+
+        ffStrbufSubstrAfter(&request, end + 3);
+    }
+
+exit:
+    close((int) fd);
+    return NULL;
+}
+
+static void* runServer(void* param)
+{
+    int listenFd = (int) (intptr_t) param;
+    while(true)
+    {
+        int fd = accept(listenFd, NULL, NULL);
+        if(fd < 0)
+            continue;
+        __atomic_add_fetch(&acceptedConnections, 1, __ATOMIC_SEQ_CST);
+        startThread(serveConnection, fd);
+    }
+    return NULL;
+}
+
+static bool startServer(int family, char* host, size_t hostSize)
+{
+    int fd = socket(family, SOCK_STREAM, 0);
+    if(fd < 0)
+        return false;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &(int) { 1 }, sizeof(int));
+
+    struct sockaddr_storage addr = {};
+    socklen_t length;
+    if(family == AF_INET)
+    {
+        struct sockaddr_in* in = (struct sockaddr_in*) &addr;
+        in->sin_family = AF_INET;
+        in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        length = sizeof(*in);
+    }
+    else
+    {
+        struct sockaddr_in6* in6 = (struct sockaddr_in6*) &addr;
+        in6->sin6_family = AF_INET6;
+        in6->sin6_addr = in6addr_loopback;
+        length = sizeof(*in6);
+    }
+
+    if(bind(fd, (struct sockaddr*) &addr, length) != 0 || listen(fd, 16) != 0 || getsockname(fd, (struct sockaddr*) &addr, &length) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    if(family == AF_INET)
+        snprintf(host, hostSize, "127.0.0.1:%u", ntohs(((struct sockaddr_in*) &addr)->sin_port));
+    else
+        snprintf(host, hostSize, "[::1]:%u", ntohs(((struct sockaddr_in6*) &addr)->sin6_port));
+
+    startThread(runServer, fd);
+    return true;
+}
+
+static bool get(const char* host, const char* path, uint32_t timeout, FFstrbuf* body)
+{
+    ffStrbufClear(body);
+    bool success = ffNetworkingGetHttp(host, path, timeout, NULL, body);
+    ffStrbufSubstrAfterFirstS(body, "\r\n\r\n");
+    return success;
+}
+
+int main(void)
+{
+    FF_STRBUF_AUTO_DESTROY data = ffStrbufCreate();
+
+    char host[64];
+    VERIFY(startServer(AF_INET, host, sizeof(host)));
+
+    // Content-Length, then reuse of the kept alive connection
+
+    VERIFY(get(host, "/length", 1000, &data));
+    VERIFY(ffStrbufEqualS(&data, "hello"));
+    VERIFY(get(host, "/chunked", 1000, &data));
+    VERIFY(ffStrbufEqualS(&data, "hello"));
+    VERIFY(!get(host, "/missing", 1000, &data));
+    VERIFY(__atomic_load_n(&acceptedConnections, __ATOMIC_SEQ_CST) == 1);
+
+    // Connection: close, and reconnecting after it
+
+    VERIFY(get(host, "/close", 1000, &data));
+    VERIFY(ffStrbufEqualS(&data, "bye"));
+    VERIFY(get(host, "/length", 1000, &data));
+    VERIFY(ffStrbufEqualS(&data, "hello"));
+    VERIFY(__atomic_load_n(&acceptedConnections, __ATOMIC_SEQ_CST) == 2);
+
+    // Concurrent requests; the slow one must not delay the others, and must time out
+
+    FFNetworkingState slow, length, chunked;
+    uint64_t start = ffTimeGetTick();
+    VERIFY(ffNetworkingSendHttpRequest(&slow, host, "/slow", NULL, 300));
+    VERIFY(ffNetworkingSendHttpRequest(&length, host, "/length", NULL, 1000));
+    VERIFY(ffNetworkingSendHttpRequest(&chunked, host, "/chunked", NULL, 1000));
+
+    ffStrbufClear(&data);
+    VERIFY(ffNetworkingRecvHttpResponse(&chunked, &data));
+    VERIFY(ffStrbufEndsWithS(&data, "\r\n\r\nhello"));
+    ffStrbufClear(&data);
+    VERIFY(ffNetworkingRecvHttpResponse(&length, &data));
+    VERIFY(ffStrbufEndsWithS(&data, "\r\n\r\nhello"));
+    VERIFY(ffTimeGetTick() - start < 300);
+
+    ffStrbufClear(&data);
+    VERIFY(!ffNetworkingRecvHttpResponse(&slow, &data));
+    VERIFY(ffTimeGetTick() - start < 1000);
+
+    // Unreachable port; a refused connection fails fast
+
+    VERIFY(!get("127.0.0.1:1", "/", 1000, &data));
+
+    // IPv6, if the machine has it
+
+    if(startServer(AF_INET6, host, sizeof(host)))
+    {
+        VERIFY(get(host, "/chunked", 1000, &data));
+        VERIFY(ffStrbufEqualS(&data, "hello"));
+    }
+
+    //Success
+    puts("\033[32mAll tests passed!"FASTFETCH_TEXT_MODIFIER_RESET);
+}
@@ -216,6 +216,38 @@ int main(void)
 
     ffStrbufDestroy(&strbuf);
 
+    //appendUInt, appendSInt
+    ffStrbufInit(&strbuf);
+    ffStrbufAppendUInt(&strbuf, 0);
+    ffStrbufAppendC(&strbuf, ' ');
+    ffStrbufAppendUInt(&strbuf, UINT64_MAX);
+    ffStrbufAppendC(&strbuf, ' ');
+    ffStrbufAppendSInt(&strbuf, INT64_MIN);
+    ffStrbufAppendC(&strbuf, ' ');
+    ffStrbufAppendSInt(&strbuf, 42);
+    VERIFY(ffStrbufEqualS(&strbuf, "0 18446744073709551615 -9223372036854775808 42"));
+
+    //appendDouble (%f, ties to even), appendDoubleG (%g), shortest
+    ffStrbufClear(&strbuf);
+    ffStrbufAppendDouble(&strbuf, 0.125, 2);
+    ffStrbufAppendC(&strbuf, ' ');
+    ffStrbufAppendDouble(&strbuf, 99.96, 1);
+    ffStrbufAppendC(&strbuf, ' ');
+    ffStrbufAppendDouble(&strbuf, -0.0, 0);
+    ffStrbufAppendC(&strbuf, ' ');
+    ffStrbufAppendDoubleG(&strbuf, 1.0 / 3.0, 6);
+    ffStrbufAppendC(&strbuf, ' ');
+    ffStrbufAppendDoubleG(&strbuf, 1234567.0, 6);
+    ffStrbufAppendC(&strbuf, ' ');
+    ffStrbufAppendDouble(&strbuf, 0.1 + 0.2, -1);
+    ffStrbufAppendC(&strbuf, ' ');
+    ffStrbufAppendFloat(&strbuf, 0.1f, -1);
+    ffStrbufAppendC(&strbuf, ' ');
+    ffStrbufAppendDouble(&strbuf, 1e300, -1);
+    VERIFY(ffStrbufEqualS(&strbuf, "0.12 100.0 -0 0.333333 1.23457e+06 0.30000000000000004 0.1 1e+300"));
+
+    ffStrbufDestroy(&strbuf);
+
     {
         FF_STRBUF_AUTO_DESTROY testCreate = ffStrbufCreateS("TEST");
         VERIFY(ffStrbufEqualS(&testCreate, "TEST"));